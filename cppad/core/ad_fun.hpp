@@ -43,12 +43,19 @@ $childtable%
 	cppad/core/optimize.hpp%
 	example/abs_normal/abs_normal.omh%
 	cppad/core/fun_check.hpp%
-	cppad/core/check_for_nan.hpp
+	cppad/core/fun_work.hpp%
+	cppad/core/fun_batch.hpp%
+	cppad/core/fun_jit.hpp%
+	cppad/core/check_for_nan.hpp%
+	cppad/core/forward_stream.hpp%
+	cppad/core/parallel_sweep.hpp%
+	cppad/core/internal_sparsity.hpp
 %$$
 
 $end
 */
 # include <cppad/local/subgraph/info.hpp>
+# include <cppad/local/sparse_cache.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -67,6 +74,8 @@ It does it calculations using \c Base operations.
 
 template <class Base>
 class ADFun {
+	// fun_jit creates C source code using the private information
+	friend class fun_jit;
 // ------------------------------------------------------------
 // Private member variables
 private:
@@ -76,6 +85,21 @@ private:
 	/// Check for nan's and report message to user (default value is true).
 	bool check_for_nan_;
 
+	/// Use the pre-decoded operator stream for zero order forward
+	/// (default value is false).
+	bool forward_stream_;
+
+	/// Number of threads used by the parallel sweeps (default value is one).
+	size_t parallel_sweep_;
+
+	/// Internal representation used for sparsity patterns
+	/// (default value is empty; i.e., chosen by internal_bool).
+	std::string internal_sparsity_;
+
+	/// Function that reports the choices made when internal_sparsity_
+	/// is "auto" (default value is null; i.e., no reports).
+	void (*internal_sparsity_report_)(const char*, bool, double);
+
 	/// If zero, ignoring comparison operators. Otherwise is the
 	/// compare change count at which to store the operator index.
 	size_t compare_change_count_;
@@ -108,6 +132,10 @@ private:
 	/// tape address and parameter flag for the dependent variables
 	CppAD::vector<size_t> dep_taddr_;
 
+	/// number of operators changed by each simplification during the
+	/// previous optimize (empty if not optimized)
+	CppAD::vector<size_t> simplify_count_;
+
 	/// which dependent variables are actually parameters
 	CppAD::vector<bool>   dep_parameter_;
 
@@ -134,6 +162,11 @@ private:
 	/// for_jac_sparse_set_.n_set() != 0  implies for_sparse_pack_ is empty.
 	local::sparse_list for_jac_sparse_set_;
 
+	/// Hybrid results of the forward mode Jacobian sparsity calculations
+	/// for_jac_sparse_hybrid_.n_set() != 0  implies other sparsity results
+	/// are empty
+	local::sparse_hybrid for_jac_sparse_hybrid_;
+
 	/// subgraph information for this object
 	local::subgraph::subgraph_info subgraph_info_;
 
@@ -142,6 +175,19 @@ private:
 	/// Not in subgraph_info_ because it depends on Base.
 	local::pod_vector_maybe<Base> subgraph_partial_;
 
+	/// used by the sparsity calculations that are split between a team.
+	/// Declared here to avoid reallocation for each sparsity calculation.
+	/// Holds the sparsity patterns for each block of the possible elements.
+	CppAD::vector<local::sparse_pack> sparse_team_block_;
+
+	/// used by the reverse Hessian sparsity calculations that are split
+	/// between a team. Holds the reverse Jacobian flags for each thread.
+	local::pod_vector<bool> sparse_team_rev_jac_;
+
+	/// sparsity patterns and coloring information saved by the user
+	/// (cleared when the operation sequence changes).
+	local::sparse_cache sparse_cache_;
+
 // ------------------------------------------------------------
 // Private member functions
 
@@ -149,6 +195,22 @@ private:
 	template <typename ADvector>
 	void Dependent(local::ADTape<Base> *tape, const ADvector &y);
 
+	/// hash code for the structure of the operation sequence
+	/// (see doxygen in sparse_cache.hpp)
+	size_t structure_hash(void) const;
+
+	// ------------------------------------------------------------
+	// choose internal_bool when internal_sparsity_ is "auto"
+	// (see doxygen in internal_sparsity.hpp)
+	template <class SizeVector>
+	bool internal_sparsity_auto(
+		const char*                  routine     ,
+		bool                         forward     ,
+		bool                         dependency  ,
+		bool                         transpose   ,
+		const sparse_rc<SizeVector>& pattern_in
+	);
+
 	// ------------------------------------------------------------
 	// vector of bool version of ForSparseJac
 	// (see doxygen in for_sparse_jac.hpp)
@@ -308,10 +370,40 @@ public:
 	/// get check_for_nan
 	bool check_for_nan(void) const;
 
+	/// set forward_stream
+	void forward_stream(bool value);
+
+	/// get forward_stream
+	bool forward_stream(void) const;
+
+	/// set parallel_sweep
+	void parallel_sweep(size_t num_threads);
+
+	/// get parallel_sweep
+	size_t parallel_sweep(void) const;
+
+	/// set internal_sparsity
+	void internal_sparsity(const std::string& name);
+
+	/// set internal_sparsity and the function that reports automatic choices
+	void internal_sparsity(
+		const std::string& name                             ,
+		void (*report)(const char* , bool , double)
+	);
+
+	/// get internal_sparsity
+	const std::string& internal_sparsity(void) const;
+
 	/// assign a new operation sequence
 	template <typename ADvector>
 	void Dependent(const ADvector &x, const ADvector &y);
 
+	/// write the operation sequence to a binary file
+	void to_file(const std::string& file_name) const;
+
+	/// read an operation sequence from a binary file
+	void from_file(const std::string& file_name);
+
 	/// new_dynamic user API
 	template <typename VectorBase>
 	void new_dynamic(const VectorBase& dynamic);
@@ -330,6 +422,30 @@ public:
 	template <typename VectorBase>
 	VectorBase Reverse(size_t p, const VectorBase &v);
 
+	/// forward mode using a separate work space (does not change this object)
+	template <typename VectorBase>
+	VectorBase Forward(
+		size_t q, const VectorBase& xq, fun_work<Base>& work
+	) const;
+
+	/// reverse mode using a separate work space (does not change this object)
+	template <typename VectorBase>
+	VectorBase Reverse(
+		size_t q, const VectorBase& w, fun_work<Base>& work
+	) const;
+
+	/// zero order forward mode for a batch of points
+	template <typename BaseVector>
+	BaseVector forward_batch(
+		size_t K, const BaseVector& xb, fun_work<Base>& work
+	) const;
+
+	/// first order reverse mode for a batch of points
+	template <typename BaseVector>
+	BaseVector reverse_batch(
+		const BaseVector& wb, fun_work<Base>& work
+	) const;
+
 	// ---------------------------------------------------------------------
 	// Jacobian sparsity
 	template <typename VectorSet>
@@ -400,6 +516,39 @@ public:
 		sparse_hes_work&                     work
 	);
 	// ---------------------------------------------------------------------
+	// sparsity pattern and coloring cache
+	// (see doxygen in sparse_cache.hpp)
+	template <typename SizeVector>
+	void sparse_cache_store(
+		const std::string&           name             ,
+		const sparse_rc<SizeVector>& pattern
+	);
+	void sparse_cache_store(
+		const std::string&           name             ,
+		const sparse_jac_work&       work
+	);
+	void sparse_cache_store(
+		const std::string&           name             ,
+		const sparse_hes_work&       work
+	);
+	template <typename SizeVector>
+	bool sparse_cache_find(
+		const std::string&           name             ,
+		sparse_rc<SizeVector>&       pattern
+	) const;
+	bool sparse_cache_find(
+		const std::string&           name             ,
+		sparse_jac_work&             work
+	) const;
+	bool sparse_cache_find(
+		const std::string&           name             ,
+		sparse_hes_work&             work
+	) const;
+	void sparse_cache_to_file(const std::string& file_name) const;
+	bool sparse_cache_from_file(const std::string& file_name);
+	void sparse_cache_clear(void)
+	{	sparse_cache_.clear(); }
+	// ---------------------------------------------------------------------
 	template <typename BoolVector, typename SizeVector>
 	void subgraph_sparsity(
 		const BoolVector&            select_domain    ,
@@ -499,7 +648,9 @@ public:
 
 	/// amount of memory used for vector of set Jacobain sparsity pattern
 	size_t size_forward_set(void) const
-	{	return for_jac_sparse_set_.memory(); }
+	{	return for_jac_sparse_set_.memory()
+		+ for_jac_sparse_hybrid_.memory();
+	}
 
 	/// free memory used for Jacobain sparsity pattern
 	void size_forward_set(size_t zero)
@@ -508,6 +659,7 @@ public:
 			"size_forward_bool: argument not equal to zero"
 		);
 		for_jac_sparse_set_.resize(0, 0);
+		for_jac_sparse_hybrid_.resize(0, 0);
 	}
 
 	/// number of operators in the operation sequence
@@ -704,6 +856,10 @@ public:
 	// (see doxygen documentation in optimize.hpp)
 	void optimize( const std::string& options = "" );
 
+	// number of operators changed by an optimizer simplification
+	// (see doxygen documentation in optimize.hpp)
+	size_t simplify_count(const std::string& rewrite) const;
+
 	// create abs-normal representation of the function f(x)
 	void abs_normal_fun( ADFun& g, ADFun& a ) const;
 
@@ -729,7 +885,8 @@ public:
 	size_t Memory(void) const
 	{	size_t pervar  = cap_order_taylor_ * sizeof(Base)
 		+ for_jac_sparse_pack_.memory()
-		+ for_jac_sparse_set_.memory();
+		+ for_jac_sparse_set_.memory()
+		+ for_jac_sparse_hybrid_.memory();
 		size_t total   = num_var_tape_  * pervar;
 		total         += play_.size_op_seq();
 		total         += play_.size_random();
@@ -761,10 +918,15 @@ public:
 } // END_CPPAD_NAMESPACE
 
 // non-user interfaces
+# include <cppad/local/sweep/forward0_stream.hpp>
 # include <cppad/local/sweep/forward0.hpp>
+# include <cppad/local/sweep/forward_level.hpp>
 # include <cppad/local/sweep/forward1.hpp>
 # include <cppad/local/sweep/forward2.hpp>
+# include <cppad/local/sweep/forward_batch.hpp>
 # include <cppad/local/sweep/reverse.hpp>
+# include <cppad/local/sweep/reverse_batch.hpp>
+# include <cppad/local/sweep/reverse_level.hpp>
 # include <cppad/local/sweep/for_jac.hpp>
 # include <cppad/local/sweep/rev_jac.hpp>
 # include <cppad/local/sweep/rev_hes.hpp>
@@ -776,7 +938,11 @@ public:
 # include <cppad/core/dependent.hpp>
 # include <cppad/core/fun_construct.hpp>
 # include <cppad/core/abort_recording.hpp>
+# include <cppad/core/fun_file.hpp>
 # include <cppad/core/fun_eval.hpp>
+# include <cppad/core/fun_work.hpp>
+# include <cppad/core/fun_batch.hpp>
+# include <cppad/core/fun_jit.hpp>
 # include <cppad/core/drivers.hpp>
 # include <cppad/core/fun_check.hpp>
 # include <cppad/core/omp_max_thread.hpp>
@@ -271,6 +271,7 @@ void ADFun<Base>::Dependent(local::ADTape<Base> *tape, const ADvector &y)
 
 	// some size_t values in ad_fun.hpp
 	has_been_optimized_        = false;
+	simplify_count_.clear();
 	compare_change_count_      = 1;
 	compare_change_number_     = 0;
 	compare_change_op_index_   = 0;
@@ -306,9 +307,17 @@ void ADFun<Base>::Dependent(local::ADTape<Base> *tape, const ADvector &y)
 		ind_taddr_[j] = j+1;
 	}
 
-	// for_jac_sparse_pack_, for_jac_sparse_set_
+	// for_jac_sparse_pack_, for_jac_sparse_set_, for_jac_sparse_hybrid_
 	for_jac_sparse_pack_.resize(0, 0);
 	for_jac_sparse_set_.resize(0,0);
+	for_jac_sparse_hybrid_.resize(0,0);
+
+	// sparse_team_block_, sparse_team_rev_jac_
+	sparse_team_block_.clear();
+	sparse_team_rev_jac_.clear();
+
+	// sparse_cache_ (it is for the previous operation sequence)
+	sparse_cache_.clear();
 
 	// resize subgraph_info_
 	subgraph_info_.resize(
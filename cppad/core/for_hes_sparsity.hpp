@@ -87,6 +87,10 @@ if and only if $latex s_i$$ is possibly non-zero.
 $head internal_bool$$
 If this is true, calculations are done with sets represented by a vector
 of boolean values. Otherwise, a vector of sets of integers is used.
+This argument is ignored when
+$cref/internal_sparsity/internal_sparsity/name/hybrid/$$ is $code "hybrid"$$
+and it is chosen automatically when it is
+$cref/auto/internal_sparsity/name/auto/$$.
 
 $head pattern_out$$
 This argument has prototype
@@ -147,6 +151,7 @@ is a sparsity pattern for for s.
 \param internal_bool
 If this is true, calculations are done with sets represented by a vector
 of boolean values. Otherwise, a vector of standard sets is used.
+This is ignored when internal_sparsity_ is "hybrid".
 
 \param pattern_out
 The return value is a sparsity pattern for H(x) where
@@ -180,8 +185,75 @@ void ADFun<Base>::for_hes_sparsity(
 	bool transpose  = false;
 	bool dependency = false;
 	//
+	if( internal_sparsity_ == "auto" )
+	{	// sample the forward Jacobian sparsity for the selected domain
+		size_t nnz = 0;
+		for(size_t j = 0; j < n; j++)
+			if( select_domain[j] )
+				++nnz;
+		sparse_rc<SizeVector> identity(n, n, nnz);
+		size_t k = 0;
+		for(size_t j = 0; j < n; j++)
+			if( select_domain[j] )
+				identity.set(k++, j, j);
+		internal_bool = internal_sparsity_auto(
+			"for_hes_sparsity", true, dependency, transpose, identity
+		);
+	}
 	sparse_rc<SizeVector> pattern_tmp;
-	if( internal_bool )
+	if( internal_sparsity_ == "hybrid" )
+	{	// forward Jacobian sparsity pattern for independent variables
+		local::sparse_hybrid internal_for_jac;
+		internal_for_jac.resize(num_var_tape_, n + 1 );
+		for(size_t j = 0; j < n; j++) if( select_domain[j] )
+		{	CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < n + 1 );
+			// use add_element when only adding one element per set
+			internal_for_jac.add_element( ind_taddr_[j] , ind_taddr_[j] );
+		}
+		// forward Jacobian sparsity for all variables on tape
+		local::sweep::for_jac<addr_t>(
+			&play_,
+			dependency,
+			n,
+			num_var_tape_,
+			internal_for_jac
+		);
+		// reverse Jacobian sparsity pattern for select_range
+		local::sparse_hybrid internal_rev_jac;
+		internal_rev_jac.resize(num_var_tape_, 1);
+		for(size_t i = 0; i < m; i++) if( select_range[i] )
+		{	CPPAD_ASSERT_UNKNOWN( dep_taddr_[i] < num_var_tape_ );
+			// use add_element when only adding one element per set
+			internal_rev_jac.add_element( dep_taddr_[i] , 0 );
+		}
+		// reverse Jacobian sparsity for all variables on tape
+		local::sweep::rev_jac<addr_t>(
+			&play_,
+			dependency,
+			n,
+			num_var_tape_,
+			internal_rev_jac
+		);
+		// internal vector of sets that will hold Hessian
+		local::sparse_hybrid internal_for_hes;
+		internal_for_hes.resize(n + 1, n + 1);
+		//
+		// compute forward Hessian sparsity pattern
+		local::sweep::for_hes<addr_t>(
+			&play_,
+			n,
+			num_var_tape_,
+			internal_for_jac,
+			internal_rev_jac,
+			internal_for_hes
+		);
+		//
+		// put the result in pattern_tmp
+		get_internal_sparsity(
+			transpose, ind_taddr_, internal_for_hes, pattern_tmp
+		);
+	}
+	else if( internal_bool )
 	{	// forward Jacobian sparsity pattern for independent variables
 		local::sparse_pack internal_for_jac;
 		internal_for_jac.resize(num_var_tape_, n + 1 );
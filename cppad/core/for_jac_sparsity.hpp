@@ -14,6 +14,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 /*
 $begin for_jac_sparsity$$
 $spell
+	cplusplus
 	Jacobian
 	jac
 	bool
@@ -72,7 +73,8 @@ sets $icode k$$ to the amount of memory (in unsigned character units)
 used to store the
 $cref/boolean vector/glossary/Sparsity Pattern/Boolean Vector/$$
 sparsity patterns.
-If $icode internal_bool$$ if false, $icode k$$ will be zero.
+If $icode internal_bool$$ if false,
+or $cref internal_sparsity$$ is not empty, $icode k$$ will be zero.
 Otherwise it will be non-zero.
 If you do not need this information for $cref RevSparseHes$$
 calculations, it can be deleted
@@ -91,7 +93,8 @@ sets $icode k$$ to the amount of memory (in unsigned character units)
 used to store the
 $cref/vector of sets/glossary/Sparsity Pattern/Vector of Sets/$$
 sparsity patterns.
-If $icode internal_bool$$ if true, $icode k$$ will be zero.
+If $icode internal_bool$$ if true,
+and $cref internal_sparsity$$ is empty, $icode k$$ will be zero.
 Otherwise it will be non-zero.
 If you do not need this information for future $cref rev_hes_sparsity$$
 calculations, it can be deleted
@@ -132,6 +135,10 @@ $codei%
 %$$
 If this is true, calculations are done with sets represented by a vector
 of boolean values. Otherwise, a vector of sets of integers is used.
+This argument is ignored when
+$cref/internal_sparsity/internal_sparsity/name/hybrid/$$ is $code "hybrid"$$
+and it is chosen automatically when it is
+$cref/auto/internal_sparsity/name/auto/$$.
 
 $head pattern_out$$
 This argument has prototype
@@ -153,20 +160,49 @@ In this case, $icode pattern_out$$ is a sparsity pattern for
 $latex F^{(1)} ( x )$$  ( $latex F^{(1)} (x)^\R{T}$$ )
 if $icode transpose$$ is false (true).
 
+$head Parallel$$
+If $icode%f%.parallel_sweep()%$$ is greater than one
+and $icode internal_bool$$ is true,
+the $latex \ell$$ columns of $latex R$$ are split into blocks
+and the blocks are split between a team of
+$cref/parallel_sweep/parallel_sweep/$$ threads.
+Each thread does a complete sweep for its block using its own
+vector of boolean values and the blocks are stored in $icode f$$
+after the team is done.
+Each block contains at least as many columns as there are
+bits in a $code size_t$$ value
+and the blocks use as much memory as the pattern stored in $icode f$$.
+The memory for the blocks is kept in $icode f$$
+and reused by the next sparsity calculation that uses a team.
+It is freed when the operation sequence in $icode f$$ changes
+(e.g., by $cref optimize$$)
+and when $icode%f%.parallel_sweep(%num_threads%)%$$ is called
+with $icode num_threads$$ less than two.
+The team is not used when there is only one block,
+when $icode f$$ contains $cref atomic$$ function or $cref VecAD$$ operations,
+or when $code __cplusplus < 201100$$.
+In these cases, the sweep is done by the current thread.
+This also applies to the older interface $cref ForSparseJac$$
+when its sparsity patterns are vectors of boolean values.
+
 $head Example$$
 $children%
-	example/sparse/for_jac_sparsity.cpp
+	example/sparse/for_jac_sparsity.cpp%
+	example/sparse/sparsity_team.cpp
 %$$
 The file
 $cref for_jac_sparsity.cpp$$
 contains an example and test of this operation.
 It returns true if it succeeds and false otherwise.
+The file $cref sparsity_team.cpp$$ is an example and test that
+uses a team of threads for the sweeps.
 
 $end
 -----------------------------------------------------------------------------
 */
 # include <cppad/core/ad_fun.hpp>
 # include <cppad/local/sparse_internal.hpp>
+# include <cppad/local/sweep/sparse_team.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 
@@ -197,6 +233,7 @@ This is used by the optimizer to obtain the correct dependency relations.
 \param internal_bool
 If this is true, calculations are done with sets represented by a vector
 of boolean values. Othewise, a vector of standard sets is used.
+This is ignored when internal_sparsity_ is "hybrid".
 
 \param pattern_out
 The value of transpose is false (true),
@@ -229,13 +266,49 @@ void ADFun<Base>::for_jac_sparsity(
 		"for_jac_sparsity: number rows in R "
 		"is not equal number of independent variables."
 	);
+	if( internal_sparsity_ == "auto" )
+	{	internal_bool = internal_sparsity_auto(
+			"for_jac_sparsity", true, dependency, transpose, pattern_in
+		);
+	}
 	bool zero_empty  = true;
 	bool input_empty = true;
-	if( internal_bool )
+	if( internal_sparsity_ == "hybrid" )
+	{	// allocate memory for hybrid sparsity calculation
+		// (sparsity pattern is emtpy after a resize)
+		for_jac_sparse_hybrid_.resize(num_var_tape_, ell);
+		for_jac_sparse_pack_.resize(0, 0);
+		for_jac_sparse_set_.resize(0, 0);
+		//
+		// set sparsity patttern for independent variables
+		local::set_internal_sparsity(
+			zero_empty              ,
+			input_empty             ,
+			transpose               ,
+			ind_taddr_              ,
+			for_jac_sparse_hybrid_  ,
+			pattern_in
+		);
+
+		// compute sparsity for other variables
+		local::sweep::for_jac<addr_t>(
+			&play_,
+			dependency,
+			n,
+			num_var_tape_,
+			for_jac_sparse_hybrid_
+		);
+		// get the ouput pattern
+		local::get_internal_sparsity(
+			transpose, dep_taddr_, for_jac_sparse_hybrid_, pattern_out
+		);
+	}
+	else if( internal_bool )
 	{	// allocate memory for bool sparsity calculation
 		// (sparsity pattern is emtpy after a resize)
 		for_jac_sparse_pack_.resize(num_var_tape_, ell);
 		for_jac_sparse_set_.resize(0, 0);
+		for_jac_sparse_hybrid_.resize(0, 0);
 		//
 		// set sparsity patttern for independent variables
 		local::set_internal_sparsity(
@@ -248,7 +321,18 @@ void ADFun<Base>::for_jac_sparsity(
 		);
 
 		// compute sparsity for other variables
-		local::sweep::for_jac<addr_t>(
+		bool done = false;
+		if( parallel_sweep_ > 1 ) done = local::sweep::for_jac_team<addr_t>(
+			&play_,
+			dependency,
+			n,
+			num_var_tape_,
+			ind_taddr_,
+			parallel_sweep_,
+			sparse_team_block_,
+			for_jac_sparse_pack_
+		);
+		if( ! done ) local::sweep::for_jac<addr_t>(
 			&play_,
 			dependency,
 			n,
@@ -266,6 +350,7 @@ void ADFun<Base>::for_jac_sparsity(
 		// (sparsity pattern is emtpy after a resize)
 		for_jac_sparse_set_.resize(num_var_tape_, ell);
 		for_jac_sparse_pack_.resize(0, 0);
+		for_jac_sparse_hybrid_.resize(0, 0);
 		//
 		// set sparsity patttern for independent variables
 		local::set_internal_sparsity(
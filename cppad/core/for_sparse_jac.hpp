@@ -220,6 +220,7 @@ $end
 */
 
 # include <cppad/local/std_set.hpp>
+# include <cppad/local/sweep/sparse_team.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -305,7 +306,18 @@ void ADFun<Base>::ForSparseJacCase(
 		for_jac_sparse_pack_.process_post( ind_taddr_[j] );
 
 	// evaluate the sparsity patterns
-	local::sweep::for_jac<addr_t>(
+	bool done = false;
+	if( parallel_sweep_ > 1 ) done = local::sweep::for_jac_team<addr_t>(
+		&play_,
+		dependency,
+		n,
+		num_var_tape_,
+		ind_taddr_,
+		parallel_sweep_,
+		sparse_team_block_,
+		for_jac_sparse_pack_
+	);
+	if( ! done ) local::sweep::for_jac<addr_t>(
 		&play_,
 		dependency,
 		n,
@@ -568,6 +580,7 @@ VectorSet ADFun<Base>::ForSparseJac(
 	// free all memory currently in sparsity patterns
 	for_jac_sparse_pack_.resize(0, 0);
 	for_jac_sparse_set_.resize(0, 0);
+	for_jac_sparse_hybrid_.resize(0, 0);
 
 	ForSparseJacCase(
 		Set_type()  ,
@@ -671,6 +684,7 @@ void ADFun<Base>::ForSparseJacCheckpoint(
 	// free all memory currently in sparsity patterns
 	for_jac_sparse_pack_.resize(0, 0);
 	for_jac_sparse_set_.resize(0, 0);
+	for_jac_sparse_hybrid_.resize(0, 0);
 
 	// allocate new sparsity pattern
 	for_jac_sparse_set_.resize(num_var_tape_, q);
@@ -16,6 +16,8 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 # include <cppad/core/capacity_order.hpp>
 # include <cppad/core/num_skip.hpp>
 # include <cppad/core/check_for_nan.hpp>
+# include <cppad/core/forward_stream.hpp>
+# include <cppad/core/parallel_sweep.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -154,8 +156,22 @@ VectorBase ADFun<Base>::Forward(
 	// evaluate the derivatives
 	CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_.num_op_rec() );
 	CPPAD_ASSERT_UNKNOWN( load_op_.size()  == play_.num_load_op_rec() );
-	if( q == 0 )
-	{	local::sweep::forward0(&play_, s, true,
+	bool done = false;
+	if( (parallel_sweep_ > 1) & (p == q) & (q <= 1) )
+	{	// level schedule (only computed once for each recording)
+		local::sweep::level_schedule_setup(&play_);
+		done = local::sweep::forward_level(&play_, s, true, q, C,
+			taylor_.data(), cskip_op_.data(), parallel_sweep_,
+			compare_change_count_,
+			compare_change_number_,
+			compare_change_op_index_
+		);
+	}
+	if( (! done) & (q == 0) )
+	{	// pre-decoded operators (only computed once for each recording)
+		if( forward_stream_ )
+			local::sweep::forward0_stream_setup(&play_);
+		local::sweep::forward0(&play_, s, true,
 			n, num_var_tape_, C,
 			taylor_.data(), cskip_op_.data(), load_op_,
 			compare_change_count_,
@@ -163,7 +179,7 @@ VectorBase ADFun<Base>::Forward(
 			compare_change_op_index_
 		);
 	}
-	else
+	else if( ! done )
 	{	local::sweep::forward1(&play_, s, true, p, q,
 			n, num_var_tape_, C,
 			taylor_.data(), cskip_op_.data(), load_op_,
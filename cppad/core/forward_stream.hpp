@@ -0,0 +1,124 @@
+# ifndef CPPAD_CORE_FORWARD_STREAM_HPP
+# define CPPAD_CORE_FORWARD_STREAM_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin forward_stream$$
+$spell
+	const
+	bool
+	VecAD
+	mmap
+$$
+$section Pre-Decode Operators For Zero Order Forward Mode$$
+
+$head Syntax$$
+$icode%f%.forward_stream(%b%)
+%$$
+$icode%b% = %f%.forward_stream()
+%$$
+
+$head Purpose$$
+Zero order forward mode usually decodes each operator in the
+operation sequence, during each call, to determine its arguments,
+its results, and the function that computes it.
+If this setting is true, the first call to
+$cref/f.Forward(0, x)/forward_zero/$$ for an operation sequence
+creates a list of its operators with this information already decoded.
+Subsequent zero order forward mode calculations use this list.
+This includes those that use a $cref fun_work$$ space for $icode f$$.
+
+$head f$$
+For the syntax where $icode b$$ is an argument,
+$icode f$$ has prototype
+$codei%
+	ADFun<%Base%> %f%
+%$$
+For the syntax where $icode b$$ is the result,
+$icode f$$ has prototype
+$codei%
+	const ADFun<%Base%> %f%
+%$$
+
+$head b$$
+This argument or result has prototype
+$codei%
+	bool %b%
+%$$
+If it is true (false), the list is (is not) used by future zero order
+forward mode calculations.
+Setting it to false frees the memory for the list.
+
+$head Default$$
+The value for this setting after construction of $icode f$$ is false.
+The value of this setting is not affected by calling
+$cref Dependent$$ for this function object.
+
+$head Memory$$
+The list uses four pointer size values for each operator in the
+operation sequence; e.g., 32 bytes per operator on a 64 bit system.
+The list belongs to $icode f$$. It is not shared with copies of $icode f$$
+and it is not in the memory map created by
+$cref/from_file/fun_file/$$.
+It is freed when the operation sequence in $icode f$$ changes; e.g., by
+$cref optimize$$.
+
+$head Restrictions$$
+The list is not used for operation sequences that contain
+$cref VecAD$$ or $cref atomic$$ operations.
+
+$head Example$$
+$children%
+	example/general/forward_stream.cpp
+%$$
+The file
+$cref forward_stream.cpp$$
+contains an example and test of this operation.
+It returns true if it succeeds and false otherwise.
+
+$end
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file forward_stream.hpp
+Set and get the forward_stream setting.
+*/
+
+/*!
+Set forward_stream
+
+\param value
+if true, zero order forward mode creates and uses the pre-decoded
+operator stream (see sweep::forward0_stream_setup).
+If false, the memory for the stream is freed.
+*/
+template <class Base>
+void ADFun<Base>::forward_stream(bool value)
+{	forward_stream_ = value;
+	if( ! value )
+		play_.op_stream().clear();
+}
+
+/*!
+Get forward_stream
+
+\return
+current value of forward_stream_.
+*/
+template <class Base>
+bool ADFun<Base>::forward_stream(void) const
+{	return forward_stream_; }
+
+} // END_CPPAD_NAMESPACE
+
+# endif
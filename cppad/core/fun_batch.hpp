@@ -0,0 +1,415 @@
+# ifndef CPPAD_CORE_FUN_BATCH_HPP
+# define CPPAD_CORE_FUN_BATCH_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin fun_batch$$
+$spell
+	const
+	xb
+	yb
+	wb
+	dwb
+	Taylor
+	VecAD
+$$
+
+$section Evaluating a Function at a Batch of Points$$
+
+$head Syntax$$
+$icode%yb% = %f%.forward_batch(%K%, %xb%, %work%)
+%$$
+$icode%dwb% = %f%.reverse_batch(%wb%, %work%)
+%$$
+
+$head Purpose$$
+We use $latex F : \B{R}^n \rightarrow \B{R}^m$$ to denote the
+function corresponding to $icode f$$.
+The syntax above computes $latex F( x^\ell )$$ for
+$latex \ell = 0 , \ldots , K-1$$ using one pass through the
+operation sequence.
+For each operation, the values for all the points are computed
+in a loop that the compiler can vectorize.
+This should be faster than $icode K$$ calls to
+$cref/Forward(0, x)/forward_zero/$$.
+The $code reverse_batch$$ syntax computes the corresponding derivatives
+$latex w^\ell \cdot F^{(1)} ( x^\ell )$$
+using one pass through the operation sequence;
+i.e., it is the batch version of $cref/Reverse(1, w)/reverse_one/$$.
+
+$head f$$
+The object $icode f$$ has prototype
+$codei%
+	const ADFun<%Base%> %f%
+%$$
+None of the information stored in $icode f$$ is changed by this routine.
+
+$head K$$
+This argument has prototype
+$codei%
+	size_t %K%
+%$$
+and is the number of points in the batch.
+It must be greater than zero.
+
+$head xb$$
+This argument has prototype
+$codei%
+	const %BaseVector%& %xb%
+%$$
+and size $icode%K% * %n%$$.
+For $latex \ell = 0 , \ldots , K-1$$ and $latex j = 0 , \ldots , n-1$$,
+$codei%
+	%xb%[ %ell% * %n% + %j% ] = %x%_j^%ell%
+%$$
+
+$head yb$$
+The return value has prototype
+$codei%
+	%BaseVector% %yb%
+%$$
+and size $icode%K% * %m%$$.
+For $latex \ell = 0 , \ldots , K-1$$ and $latex i = 0 , \ldots , m-1$$,
+$codei%
+	%yb%[ %ell% * %m% + %i% ] = %F%_i ( %x%^%ell% )
+%$$
+
+$head wb$$
+This argument has prototype
+$codei%
+	const %BaseVector%& %wb%
+%$$
+and size $icode%K% * %m%$$ where $icode K$$ is its value
+in the previous call to $code forward_batch$$ using $icode work$$.
+For $latex \ell = 0 , \ldots , K-1$$ and $latex i = 0 , \ldots , m-1$$,
+$codei%
+	%wb%[ %ell% * %m% + %i% ] = %w%_i^%ell%
+%$$
+
+$head dwb$$
+The return value has prototype
+$codei%
+	%BaseVector% %dwb%
+%$$
+and size $icode%K% * %n%$$.
+For $latex \ell = 0 , \ldots , K-1$$ and $latex j = 0 , \ldots , n-1$$,
+$latex \[
+	dwb[ \ell * n + j ] =
+	\sum_{i=0}^{m-1} w_i^\ell \D{ F_i }{ x_j } ( x^\ell )
+\] $$
+
+$head work$$
+This argument has prototype
+$codei%
+	fun_work<%Base%>& %work%
+%$$
+see $cref fun_work$$.
+Upon return from $code forward_batch$$,
+it contains the values of all the variables
+for all the points in the batch.
+These values are used by $code reverse_batch$$.
+They cannot be used by
+$cref/Forward/fun_work/Forward/$$ or $cref/Reverse/fun_work/Reverse/$$.
+
+$head Memory$$
+The memory used by $icode work$$ is proportional to $icode K$$ times
+the number of variables $cref/f.size_var()/seq_property/size_var/$$.
+If this is larger than the cache, it may be faster to split
+the points into smaller batches.
+Reusing the same $icode work$$ for each batch avoids reallocating
+this memory.
+
+$head BaseVector$$
+The type $icode BaseVector$$ must be a $cref SimpleVector$$ class with
+$cref/elements of type/SimpleVector/Elements of Specified Type/$$
+$icode Base$$.
+
+$head Restrictions$$
+$list number$$
+The $cref/compare_change/fun_work/compare_change_number/$$ information
+is not computed and $cref PrintFor$$ operations do not generate output.
+$lnext
+If the operation sequence contains $cref VecAD$$ operations or
+$cref atomic$$ function calls, the points are evaluated one at a time
+(the results are the same, but this is not faster than calling
+$code Forward$$ or $code Reverse$$ for each point).
+$lend
+
+$children%
+	example/general/fun_batch.cpp
+%$$
+$head Example$$
+The file
+$cref fun_batch.cpp$$
+contains an example and test of these operations.
+It returns true if it succeeds and false otherwise.
+
+$end
+------------------------------------------------------------------------------
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file fun_batch.hpp
+Evaluate a function, and its derivative, at a batch of points.
+*/
+
+/*!
+Zero order forward mode for a batch of points.
+
+\tparam Base
+base type for the operator; i.e., this operation sequence was recorded
+using AD< Base > and computations by this routine are done using type Base.
+
+\tparam BaseVector
+is a Simple Vector class with elements of type Base.
+
+\param K
+is the number of points in the batch.
+
+\param xb
+is the value of the independent variables for each point;
+xb[ ell * n + j ] is the j-th component of the ell-th point.
+
+\param work
+Upon return, work.taylor_[ K * i + ell ] is the value of the i-th variable
+for the ell-th point and work.num_batch_ is K.
+
+\return
+the value of the dependent variables for each point;
+yb[ ell * m + i ] is the i-th component for the ell-th point.
+*/
+template <typename Base>
+template <typename BaseVector>
+BaseVector ADFun<Base>::forward_batch(
+	size_t               K     ,
+	const BaseVector&    xb    ,
+	fun_work<Base>&      work  ) const
+{	// temporary indices
+	size_t i, j, ell;
+
+	// number of independent variables
+	size_t n = ind_taddr_.size();
+
+	// number of dependent variables
+	size_t m = dep_taddr_.size();
+
+	// check BaseVector is Simple Vector class with Base type elements
+	CheckSimpleVector<Base, BaseVector>();
+
+	CPPAD_ASSERT_KNOWN(
+		K > 0,
+		"forward_batch(K, xb, work): K is zero"
+	);
+	CPPAD_ASSERT_KNOWN(
+		size_t(xb.size()) == K * n,
+		"forward_batch(K, xb, work): xb.size() is not equal K * n"
+	);
+
+	// check if work was last used with a different function
+	size_t num_op = play_.num_op_rec();
+	if( work.num_var_ != num_var_tape_ || work.cskip_op_.size() != num_op )
+	{	work.clear();
+		work.num_var_ = num_var_tape_;
+		work.cskip_op_.resize(num_op);
+		for(i = 0; i < num_op; i++)
+			work.cskip_op_[i] = false;
+	}
+	if( work.load_op_.size() != play_.num_load_op_rec() )
+		work.load_op_.resize( play_.num_load_op_rec() );
+
+	// the batch replaces any Taylor coefficients in work
+	work.num_order_ = 0;
+	work.cap_order_ = 0;
+	work.num_batch_ = 0;
+	work.taylor_.resize(num_var_tape_ * K);
+	Base* taylor = work.taylor_.data();
+
+	// the variable with index zero is not used (avoid uninitialized values)
+	for(ell = 0; ell < K; ell++)
+		taylor[ell] = CppAD::numeric_limits<Base>::quiet_NaN();
+
+	// set the values for independent variables
+	for(j = 0; j < n; j++)
+	{	CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
+		CPPAD_ASSERT_UNKNOWN( play_.GetOp( ind_taddr_[j] ) == local::InvOp );
+		for(ell = 0; ell < K; ell++)
+			taylor[ K * ind_taddr_[j] + ell ] = xb[ ell * n + j ];
+	}
+
+	// evaluate all the points in one pass through the operation sequence
+	bool ok = local::sweep::forward_batch(
+		&play_, n, num_var_tape_, K, taylor
+	);
+	if( ! ok )
+	{	// evaluate one point at a time
+		local::pod_vector_maybe<Base> taylor_one(num_var_tape_);
+		size_t compare_change_count    = 0;
+		size_t compare_change_number   = 0;
+		size_t compare_change_op_index = 0;
+		for(ell = 0; ell < K; ell++)
+		{	for(i = 0; i < num_var_tape_; i++)
+				taylor_one[i] = CppAD::numeric_limits<Base>::quiet_NaN();
+			for(j = 0; j < n; j++)
+				taylor_one[ ind_taddr_[j] ] = xb[ ell * n + j ];
+			local::sweep::forward0(&play_, std::cout, false,
+				n, num_var_tape_, 1,
+				taylor_one.data(), work.cskip_op_.data(), work.load_op_,
+				compare_change_count,
+				compare_change_number,
+				compare_change_op_index
+			);
+			for(i = 0; i < num_var_tape_; i++)
+				taylor[ K * i + ell ] = taylor_one[i];
+		}
+	}
+	work.num_batch_ = K;
+
+	// return the values for the dependent variables
+	BaseVector yb(K * m);
+	for(i = 0; i < m; i++)
+	{	CPPAD_ASSERT_UNKNOWN( dep_taddr_[i] < num_var_tape_  );
+		for(ell = 0; ell < K; ell++)
+			yb[ ell * m + i ] = taylor[ K * dep_taddr_[i] + ell ];
+	}
+	return yb;
+}
+
+/*!
+First order reverse mode for a batch of points.
+
+\tparam Base
+base type for the operator; i.e., this operation sequence was recorded
+using AD< Base > and computations by this routine are done using type Base.
+
+\tparam BaseVector
+is a Simple Vector class with elements of type Base.
+
+\param wb
+is the weighting vector for each point;
+wb[ ell * m + i ] is the i-th component for the ell-th point.
+
+\param work
+contains the values computed by a previous call to forward_batch;
+i.e., work.num_batch_ is the number of points K.
+
+\return
+the derivative of the weighted sum for each point;
+dwb[ ell * n + j ] is the partial with respect to the j-th component
+of the ell-th point.
+*/
+template <typename Base>
+template <typename BaseVector>
+BaseVector ADFun<Base>::reverse_batch(
+	const BaseVector&    wb    ,
+	fun_work<Base>&      work  ) const
+{	// temporary indices
+	size_t i, j, ell;
+
+	// number of independent variables
+	size_t n = ind_taddr_.size();
+
+	// number of dependent variables
+	size_t m = dep_taddr_.size();
+
+	// number of points in the batch
+	size_t K = work.num_batch_;
+
+	// check BaseVector is Simple Vector class with Base type elements
+	CheckSimpleVector<Base, BaseVector>();
+
+	CPPAD_ASSERT_KNOWN(
+		work.num_var_ == num_var_tape_ && K > 0,
+		"reverse_batch(wb, work): work does not contain the values"
+		" computed by\nforward_batch(K, xb, work) for this function."
+	);
+	CPPAD_ASSERT_KNOWN(
+		size_t(wb.size()) == K * m,
+		"reverse_batch(wb, work): wb.size() is not equal K * m"
+	);
+	const Base* taylor = work.taylor_.data();
+
+	// initialize the partials to zero
+	work.partial_.resize(num_var_tape_ * K);
+	Base* partial = work.partial_.data();
+	for(i = 0; i < num_var_tape_ * K; i++)
+		partial[i] = Base(0);
+
+	// set the dependent variable directions
+	// (use += because two dependent variables can point to same location)
+	for(i = 0; i < m; i++)
+	{	CPPAD_ASSERT_UNKNOWN( dep_taddr_[i] < num_var_tape_  );
+		for(ell = 0; ell < K; ell++)
+			partial[ K * dep_taddr_[i] + ell ] += wb[ ell * m + i ];
+	}
+
+	// differentiate all the points in one pass through the operation sequence
+	bool ok = local::sweep::reverse_batch(
+		&play_, n, num_var_tape_, K, taylor, partial
+	);
+
+	// return the derivative values
+	BaseVector dwb(K * n);
+	if( ok )
+	{	for(j = 0; j < n; j++)
+		{	CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
+			for(ell = 0; ell < K; ell++)
+				dwb[ ell * n + j ] = partial[ K * ind_taddr_[j] + ell ];
+		}
+		return dwb;
+	}
+
+	// differentiate one point at a time
+	// (VecAD load operators depend on the point so recompute zero order)
+	local::pod_vector_maybe<Base> taylor_one(num_var_tape_);
+	local::pod_vector_maybe<Base> partial_one(num_var_tape_);
+	size_t compare_change_count    = 0;
+	size_t compare_change_number   = 0;
+	size_t compare_change_op_index = 0;
+	for(ell = 0; ell < K; ell++)
+	{	for(i = 0; i < num_var_tape_; i++)
+		{	taylor_one[i]  = CppAD::numeric_limits<Base>::quiet_NaN();
+			partial_one[i] = Base(0);
+		}
+		for(j = 0; j < n; j++)
+			taylor_one[ ind_taddr_[j] ] = taylor[ K * ind_taddr_[j] + ell ];
+		local::sweep::forward0(&play_, std::cout, false,
+			n, num_var_tape_, 1,
+			taylor_one.data(), work.cskip_op_.data(), work.load_op_,
+			compare_change_count,
+			compare_change_number,
+			compare_change_op_index
+		);
+		for(i = 0; i < m; i++)
+			partial_one[ dep_taddr_[i] ] += wb[ ell * m + i ];
+		local::play::const_sequential_iterator play_itr = play_.end();
+		local::sweep::reverse(
+			0,
+			n,
+			num_var_tape_,
+			&play_,
+			1,
+			taylor_one.data(),
+			1,
+			partial_one.data(),
+			work.cskip_op_.data(),
+			work.load_op_,
+			play_itr
+		);
+		for(j = 0; j < n; j++)
+			dwb[ ell * n + j ] = partial_one[ ind_taddr_[j] ];
+	}
+	return dwb;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -245,6 +245,10 @@ template <typename Base>
 ADFun<Base>::ADFun(void) :
 has_been_optimized_(false),
 check_for_nan_(true) ,
+forward_stream_(false) ,
+parallel_sweep_(1) ,
+internal_sparsity_("") ,
+internal_sparsity_report_(CPPAD_NULL) ,
 compare_change_count_(1),
 compare_change_number_(0),
 compare_change_op_index_(0),
@@ -281,6 +285,10 @@ void ADFun<Base>::operator=(const ADFun<Base>& f)
 	// size_t objects
 	has_been_optimized_        = f.has_been_optimized_;
 	check_for_nan_             = f.check_for_nan_;
+	forward_stream_            = f.forward_stream_;
+	parallel_sweep_            = f.parallel_sweep_;
+	internal_sparsity_         = f.internal_sparsity_;
+	internal_sparsity_report_  = f.internal_sparsity_report_;
 	compare_change_count_      = f.compare_change_count_;
 	compare_change_number_     = f.compare_change_number_;
 	compare_change_op_index_   = f.compare_change_op_index_;
@@ -294,6 +302,8 @@ void ADFun<Base>::operator=(const ADFun<Base>& f)
 	ind_taddr_                 = f.ind_taddr_;
 	dep_taddr_.resize(m);
 	dep_taddr_                 = f.dep_taddr_;
+	simplify_count_.resize( f.simplify_count_.size() );
+	simplify_count_            = f.simplify_count_;
 	dep_parameter_.resize(m);
 	dep_parameter_             = f.dep_parameter_;
 	//
@@ -341,6 +351,31 @@ void ADFun<Base>::operator=(const ADFun<Base>& f)
 			);
 		}
 	}
+	//
+	// sparse_hybrid
+	for_jac_sparse_hybrid_.resize(0, 0);
+	n_set = f.for_jac_sparse_hybrid_.n_set();
+	end   = f.for_jac_sparse_hybrid_.end();
+	if( n_set > 0 )
+	{	CPPAD_ASSERT_UNKNOWN( n_set == num_var_tape_  );
+		CPPAD_ASSERT_UNKNOWN( f.for_jac_sparse_pack_.n_set() == 0 );
+		CPPAD_ASSERT_UNKNOWN( f.for_jac_sparse_set_.n_set() == 0 );
+		for_jac_sparse_hybrid_.resize(n_set, end);
+		for(i = 0; i < num_var_tape_; i++)
+		{	for_jac_sparse_hybrid_.assignment(
+				i                       ,
+				i                       ,
+				f.for_jac_sparse_hybrid_
+			);
+		}
+	}
+	//
+	// sparse_team (work space for the previous operation sequence)
+	sparse_team_block_.clear();
+	sparse_team_rev_jac_.clear();
+	//
+	// sparse_cache
+	sparse_cache_              = f.sparse_cache_;
 }
 
 /*!
@@ -422,6 +457,10 @@ ADFun<Base>::ADFun(const VectorAD &x, const VectorAD &y)
 
 	// ad_fun.hpp member values not set by dependent
 	check_for_nan_       = true;
+	forward_stream_      = false;
+	parallel_sweep_      = 1;
+	internal_sparsity_   = "";
+	internal_sparsity_report_ = CPPAD_NULL;
 
 	// allocate memory for one zero order taylor_ coefficient
 	CPPAD_ASSERT_UNKNOWN( num_order_taylor_ == 0 );
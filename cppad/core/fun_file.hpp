@@ -0,0 +1,375 @@
+# ifndef CPPAD_CORE_FUN_FILE_HPP
+# define CPPAD_CORE_FUN_FILE_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin fun_file$$
+$spell
+	const
+	std
+	mmap
+	Taylor
+	dyn
+$$
+
+$section Save and Load an Operation Sequence Using a Binary File$$
+
+$head Syntax$$
+$icode%f%.to_file(%file_name%)
+%$$
+$icode%g%.from_file(%file_name%)
+%$$
+
+$head Purpose$$
+Recording a large operation sequence can take much longer than
+evaluating it.
+The $code to_file$$ function saves the operation sequence in $icode f$$
+to a binary file and the $code from_file$$ function loads it into
+$icode g$$ without recording it again.
+
+$head f$$
+The object $icode f$$ has prototype
+$codei%
+	const ADFun<%Base%> %f%
+%$$
+
+$head g$$
+The object $icode g$$ has prototype
+$codei%
+	ADFun<%Base%> %g%
+%$$
+The operation sequence that was stored in $icode g$$ is lost and
+it is replaced by the operation sequence in $icode file_name$$.
+After this operation, $icode%g%.size_order()%$$ is zero
+(there are no Taylor coefficients stored in $icode g$$).
+
+$head file_name$$
+This argument has prototype
+$codei%
+	const std::string& %file_name%
+%$$
+It is the name of the file that the operation sequence is written to
+(read from).
+
+$head Base$$
+The $cref/Base/glossary/Base Type/$$ type must be plain old data;
+e.g., $code float$$ or $code double$$.
+The file format depends on the size of $icode Base$$, the size of
+$cref/cppad_tape_addr_type/cmake/cppad_tape_addr_type/$$,
+and the byte order of the system.
+It is an error to load a file that was written on a system where these
+are different (or written by a different version of the file format).
+The file format version changes whenever the operator codes change;
+e.g., files written before the cumulative product operator was added
+can not be loaded.
+
+$head Memory Map$$
+If the system supports the $code mmap$$ function,
+$code from_file$$ maps the file into memory using read only access.
+The operators, operator arguments, and other information that does not
+change during evaluation of $icode g$$, are used in place
+(they are not copied into $icode g$$).
+Hence many processes can load the same file and share one copy of it
+in physical memory.
+The $cref/parameters/seq_property/size_par/$$ are copied because their
+values can be changed by $cref new_dynamic$$.
+The file must not be changed while $icode g$$ is using it.
+
+$head Errors$$
+If the file cannot be written (read),
+or it does not contain an operation sequence in the expected format,
+an $cref/error/ErrorHandler/$$ is generated.
+The file should not come from an untrusted source because,
+when $code NDEBUG$$ is defined, the operator arguments are not checked.
+
+$children%
+	example/general/fun_file.cpp
+%$$
+$head Example$$
+The file $cref fun_file.cpp$$
+contains an example and test of this operation.
+It returns true if it succeeds and false otherwise.
+
+$end
+*/
+# include <fstream>
+# include <cppad/configure.hpp>
+
+# if CPPAD_HAS_MMAP
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <fcntl.h>
+# include <unistd.h>
+# endif
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file fun_file.hpp
+Save and load an ADFun operation sequence using a binary file.
+*/
+
+/// version number for the binary file format used by ADFun::to_file
+/// (must change whenever the values in the OpCode enum change)
+# define CPPAD_FUN_FILE_VERSION 2
+
+/// number of elements in the information section of the binary file
+# define CPPAD_FUN_FILE_N_INFO 10
+
+/*!
+Write the operation sequence in this ADFun object to a binary file.
+
+\param file_name
+is the name of the file we are writing.
+
+\par Format
+The file is a sequence of sections (see local::play::binary_write).
+The first section is the characters "CppAD ADFun file".
+The next section is an information vector containing the file version,
+the size of the types used by the file, and ADFun size_t values.
+This is followed by the ind_taddr_, dep_taddr_, dep_parameter_ sections
+and the sections for the player (see local::player::to_binary).
+*/
+template <class Base>
+void ADFun<Base>::to_file(const std::string& file_name) const
+{	CPPAD_ASSERT_KNOWN(
+		local::is_pod<Base>(),
+		"f.to_file: Base is not plain old data"
+	);
+	CPPAD_ASSERT_KNOWN(
+		num_var_tape_ > 0,
+		"f.to_file: f does not contain an operation sequence"
+	);
+	size_t n = ind_taddr_.size();
+	size_t m = dep_taddr_.size();
+	//
+	std::ofstream os(file_name.c_str(), std::ios::out | std::ios::binary);
+	if( ! os )
+	{	std::string msg = "f.to_file: cannot open " + file_name;
+		ErrorHandler::Call(true, __LINE__, __FILE__, "os", msg.c_str() );
+		return;
+	}
+	//
+	// magic
+	const char* magic = "CppAD ADFun file";
+	local::play::binary_write(os, std::strlen(magic), magic);
+	//
+	// info
+	size_t info[CPPAD_FUN_FILE_N_INFO];
+	info[0] = CPPAD_FUN_FILE_VERSION;
+	info[1] = sizeof(Base);
+	info[2] = sizeof(addr_t);
+	info[3] = sizeof(local::opcode_t);
+	info[4] = sizeof(bool);
+	info[5] = n;
+	info[6] = m;
+	info[7] = num_var_tape_;
+	info[8] = size_t( has_been_optimized_ );
+	info[9] = 0; // reserved
+	local::play::binary_write(os, CPPAD_FUN_FILE_N_INFO, info);
+	//
+	// ind_taddr_, dep_taddr_, dep_parameter_
+	local::play::binary_write(os, n, ind_taddr_.data() );
+	local::play::binary_write(os, m, dep_taddr_.data() );
+	local::pod_vector<bool> dep_parameter(m);
+	for(size_t i = 0; i < m; ++i)
+		dep_parameter[i] = dep_parameter_[i];
+	local::play::binary_write(os, m, dep_parameter.data() );
+	//
+	// play_
+	play_.to_binary(os);
+	//
+	os.close();
+	if( ! os )
+	{	std::string msg = "f.to_file: error writing " + file_name;
+		ErrorHandler::Call(true, __LINE__, __FILE__, "os", msg.c_str() );
+	}
+	return;
+}
+
+/*!
+Replace the operation sequence in this ADFun object by one in a binary file.
+
+\param file_name
+is the name of the file we are reading.
+It must have been written by ADFun::to_file.
+If CPPAD_HAS_MMAP is true, the file is mapped into memory and the player
+uses the map in place. Otherwise, the file is read into memory and copied.
+*/
+template <class Base>
+void ADFun<Base>::from_file(const std::string& file_name)
+{	CPPAD_ASSERT_KNOWN(
+		local::is_pod<Base>(),
+		"g.from_file: Base is not plain old data"
+	);
+	std::string msg = "g.from_file: cannot read " + file_name;
+	//
+	// begin, end, map_ptr, map_size
+	const char* begin    = CPPAD_NULL;
+	const char* end      = CPPAD_NULL;
+	void*       map_ptr  = CPPAD_NULL;
+	size_t      map_size = 0;
+# if CPPAD_HAS_MMAP
+	int fd = open(file_name.c_str(), O_RDONLY);
+	struct stat file_stat;
+	bool ok = fd >= 0;
+	if( ok )
+		ok = fstat(fd, &file_stat) == 0 && 0 < file_stat.st_size;
+	if( ok )
+	{	map_size = size_t( file_stat.st_size );
+		map_ptr  = mmap(CPPAD_NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		ok       = map_ptr != MAP_FAILED;
+		if( ! ok )
+			map_ptr = CPPAD_NULL;
+	}
+	if( fd >= 0 )
+		close(fd);
+	if( ! ok )
+	{	ErrorHandler::Call(true, __LINE__, __FILE__, "mmap", msg.c_str() );
+		return;
+	}
+	begin = reinterpret_cast<const char*>( map_ptr );
+	end   = begin + map_size;
+# else
+	local::pod_vector<char> buffer;
+	std::ifstream is(
+		file_name.c_str(), std::ios::in | std::ios::binary | std::ios::ate
+	);
+	if( is )
+	{	size_t size = size_t( is.tellg() );
+		buffer.resize(size);
+		is.seekg(0, std::ios::beg);
+		is.read(buffer.data(), std::streamsize(size) );
+	}
+	if( ! is || buffer.size() == 0 )
+	{	ErrorHandler::Call(true, __LINE__, __FILE__, "is", msg.c_str() );
+		return;
+	}
+	begin = buffer.data();
+	end   = begin + buffer.size();
+# endif
+	msg = "g.from_file: " + file_name + " is not a valid ADFun file";
+	//
+	// magic
+	const char* ptr = begin;
+	local::pod_vector<char> magic;
+	bool ok_file = local::play::binary_read(ptr, end, true, magic);
+	ok_file     &= magic.size() == std::strlen("CppAD ADFun file");
+	if( ok_file ) ok_file = std::strncmp(
+		magic.data(), "CppAD ADFun file", magic.size()
+	) == 0;
+	//
+	// info
+	local::pod_vector<size_t> info;
+	if( ok_file )
+	{	ok_file  = local::play::binary_read(ptr, end, true, info);
+		ok_file &= info.size() == CPPAD_FUN_FILE_N_INFO;
+	}
+	if( ok_file )
+	{	ok_file &= info[0] == CPPAD_FUN_FILE_VERSION;
+		ok_file &= info[1] == sizeof(Base);
+		ok_file &= info[2] == sizeof(addr_t);
+		ok_file &= info[3] == sizeof(local::opcode_t);
+		ok_file &= info[4] == sizeof(bool);
+	}
+	//
+	// ind_taddr, dep_taddr, dep_parameter
+	local::pod_vector<size_t> ind_taddr, dep_taddr;
+	local::pod_vector<bool>   dep_parameter;
+	if( ok_file )
+	{	ok_file &= local::play::binary_read(ptr, end, true, ind_taddr);
+		ok_file &= local::play::binary_read(ptr, end, true, dep_taddr);
+		ok_file &= local::play::binary_read(ptr, end, true, dep_parameter);
+	}
+	if( ok_file )
+	{	ok_file &= ind_taddr.size()     == info[5];
+		ok_file &= dep_taddr.size()     == info[6];
+		ok_file &= dep_parameter.size() == info[6];
+	}
+	//
+	// play_ (takes ownership of the memory map when it succeeds)
+	bool play_owns_map = false;
+	if( ok_file )
+	{	ok_file       = play_.from_binary(ptr, end, map_ptr, map_size);
+		play_owns_map = ok_file;
+	}
+	if( ok_file )
+		ok_file = play_.num_var_rec() == info[7];
+	if( ok_file )
+	{	for(size_t j = 0; j < ind_taddr.size(); ++j)
+		{	ok_file &= ind_taddr[j] < info[7];
+			if( ok_file )
+				ok_file &= play_.GetOp( ind_taddr[j] ) == local::InvOp;
+		}
+		for(size_t i = 0; i < dep_taddr.size(); ++i)
+			ok_file &= dep_taddr[i] < info[7];
+	}
+	if( ! ok_file )
+	{	// this frees the memory map if play_ owns it
+		play_.Erase();
+# if CPPAD_HAS_MMAP
+		if( ! play_owns_map )
+			munmap(map_ptr, map_size);
+# endif
+		num_var_tape_ = 0;
+		ErrorHandler::Call(true, __LINE__, __FILE__, "ok_file", msg.c_str());
+		return;
+	}
+	// ---------------------------------------------------------------------
+	// set the ad_fun.hpp private member data (see Dependent)
+	// ---------------------------------------------------------------------
+	size_t n = ind_taddr.size();
+	size_t m = dep_taddr.size();
+	has_been_optimized_        = info[8] != 0;
+	simplify_count_.clear();
+	compare_change_count_      = 1;
+	compare_change_number_     = 0;
+	compare_change_op_index_   = 0;
+	num_order_taylor_          = 0;
+	cap_order_taylor_          = 0;
+	num_direction_taylor_      = 0;
+	num_var_tape_              = info[7];
+	//
+	ind_taddr_.resize(n);
+	for(size_t j = 0; j < n; ++j)
+		ind_taddr_[j] = ind_taddr[j];
+	dep_taddr_.resize(m);
+	dep_parameter_.resize(m);
+	for(size_t i = 0; i < m; ++i)
+	{	dep_taddr_[i]     = dep_taddr[i];
+		dep_parameter_[i] = dep_parameter[i];
+	}
+	//
+	taylor_.resize(0);
+	cskip_op_.resize( play_.num_op_rec() );
+	load_op_.resize( play_.num_load_op_rec() );
+	//
+	for_jac_sparse_pack_.resize(0, 0);
+	for_jac_sparse_set_.resize(0,0);
+	for_jac_sparse_hybrid_.resize(0,0);
+	sparse_team_block_.clear();
+	sparse_team_rev_jac_.clear();
+	sparse_cache_.clear();
+	//
+	subgraph_info_.resize(
+		ind_taddr_.size(),   // n_dep
+		dep_taddr_.size(),   // n_ind
+		play_.num_op_rec(),  // n_op
+		play_.num_var_rec()  // n_var
+	);
+	return;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# undef CPPAD_FUN_FILE_VERSION
+# undef CPPAD_FUN_FILE_N_INFO
+# endif
@@ -0,0 +1,507 @@
+# ifndef CPPAD_CORE_FUN_JIT_HPP
+# define CPPAD_CORE_FUN_JIT_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin fun_jit$$
+$spell
+	jit
+	const
+	dir
+	cmd
+	dlopen
+	dw
+	fPIC
+	Cpp
+	cppad
+	hpp
+	msg
+	hex
+	tmp
+	lm
+$$
+
+$section Compiling a Function to Native Code$$
+
+$head Syntax$$
+$codei%fun_jit %jit%
+%$$
+$icode%msg% = %jit%.compile(%f%, %cache_dir%, %compile_cmd%)
+%$$
+$icode%y% = %jit%.forward(%x%)
+%$$
+$icode%dw% = %jit%.reverse(%x%, %w%)
+%$$
+$icode%jit%.clear()
+%$$
+
+$head Purpose$$
+The $cref/Forward/forward_zero/$$ and $cref/Reverse/reverse_one/$$
+routines interpret the operation sequence stored in a function object.
+If a function is evaluated a very large number of times,
+it may be faster to convert its operation sequence to
+straight line C source code, compile it with the system compiler,
+and load the resulting shared object.
+This object does this for zero order forward and first order reverse mode.
+
+$head CPPAD_HAS_DLOPEN$$
+If the preprocessor symbol $code CPPAD_HAS_DLOPEN$$ is zero,
+this system does not support loading shared objects
+and $icode%jit%.compile%$$ always returns an error message.
+
+$head f$$
+This object has prototype
+$codei%
+	const ADFun<double>& %f%
+%$$
+The following operations are not supported:
+$cref VecAD$$, $cref Discrete$$, and $cref atomic$$ functions.
+The current value of the $cref/dynamic/Independent/dynamic/$$ parameters
+in $icode f$$ is used.
+
+$head cache_dir$$
+This argument has prototype
+$codei%
+	const std::string& %cache_dir%
+%$$
+and its default value is $code "."$$.
+The C source and shared object files are stored in this directory with
+names of the form
+$codei%
+	%cache_dir%/cppad_jit_%hex%.c
+	%cache_dir%/cppad_jit_%hex%.so
+%$$
+where $icode hex$$ is a hash code for the operation sequence.
+If these files already exist, and the C source matches the
+source for $icode f$$, the shared object is reused without
+calling the compiler.
+
+$head compile_cmd$$
+This argument has prototype
+$codei%
+	const std::string& %compile_cmd%
+%$$
+and its default value is $code "cc -O1 -fPIC -shared"$$.
+The following command is used to create the shared object:
+$codei%
+	%compile_cmd% '%c_tmp%' -o '%so_tmp%' -lm
+%$$
+where $icode c_tmp$$ and $icode so_tmp$$ are temporary file names,
+in $icode cache_dir$$, that are unique to this process and $icode jit$$
+object.
+The file names are quoted so that $icode cache_dir$$ can contain
+spaces and other special shell characters.
+When the command succeeds, the temporary files are renamed to the
+shared object and C source file names above.
+Hence processes that compile the same function at the same time
+do not write to the same files.
+
+$head msg$$
+The return value has prototype
+$codei%
+	std::string %msg%
+%$$
+If it is empty, $icode jit$$ can be used to evaluate $icode f$$.
+Otherwise, it is an error message and $icode jit$$ is empty.
+If $icode f$$ has the same operation sequence as the previous successful
+call to $icode%jit%.compile%$$, only the parameters are updated.
+Hence this call is fast after
+$cref/new_dynamic/new_dynamic/$$ changes the dynamic parameters.
+
+$head Vector$$
+The type $icode Vector$$ must be a $cref SimpleVector$$ class with
+$cref/elements of type/SimpleVector/Elements of Specified Type/$$
+$code double$$.
+
+$head x$$
+This argument has prototype
+$codei%
+	const %Vector%& %x%
+%$$
+and size $icode n$$ equal to the domain dimension for $icode f$$.
+It specifies the argument value at which to evaluate $icode f$$.
+
+$head y$$
+The return value has prototype
+$codei%
+	%Vector% %y%
+%$$
+and is the value of the function at $icode x$$; i.e.,
+$codei%
+	%y% = %f%.Forward(0, %x%)
+%$$
+except that the Taylor coefficients in $icode f$$ are not changed.
+
+$head w$$
+This argument has prototype
+$codei%
+	const %Vector%& %w%
+%$$
+and size $icode m$$ equal to the range dimension for $icode f$$.
+
+$head dw$$
+The return value has prototype
+$codei%
+	%Vector% %dw%
+%$$
+and is the derivative of $latex w^T f(x)$$ with respect to $latex x$$; i.e.,
+$codei%
+	%f%.Forward(0, %x%)
+	%dw% = %f%.Reverse(1, %w%)
+%$$
+except that the Taylor coefficients in $icode f$$ are not changed.
+
+$head Comparisons$$
+The result of comparison operators are not checked; i.e.,
+$cref compare_change$$ information is not computed.
+Conditional expressions are evaluated using the current argument value
+(the same as for $cref/forward/forward_zero/$$).
+
+$head clear$$
+This unloads the shared object and frees the memory used by $icode jit$$.
+This is also done when $icode jit$$ is destroyed.
+
+$head Parallel Mode$$
+The $icode jit$$ object holds the values of the variables during
+an evaluation. Hence each thread should use its own $icode jit$$ object.
+
+$children%
+	example/general/fun_jit.cpp
+%$$
+$head Example$$
+The file
+$cref fun_jit.cpp$$
+contains an example and test of these operations.
+It returns true if it succeeds and false otherwise.
+
+$end
+------------------------------------------------------------------------------
+*/
+# include <cstdio>
+# include <cstdlib>
+# include <fstream>
+# include <sstream>
+# include <string>
+# include <cppad/local/sweep/csrc.hpp>
+
+# if CPPAD_HAS_DLOPEN
+# include <dlfcn.h>
+# include <unistd.h>
+# endif
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file fun_jit.hpp
+Compile a function object to native code.
+*/
+
+/*!
+Class used to hold a function object that has been compiled to native code.
+*/
+class fun_jit {
+private:
+	/// type of the zero order forward function in the shared object
+	typedef void (*forward_fun_t)(
+		const double* p, const double* x, double* y, double* v
+	);
+	/// type of the first order reverse function in the shared object
+	typedef void (*reverse_fun_t)(
+		const double* p, const double* x, const double* w,
+		double* y, double* dw, double* v, double* pv
+	);
+
+	/// handle for the shared object (null if not loaded)
+	void* handle_;
+
+	/// hash code for the C source corresponding to the shared object
+	size_t hash_;
+
+	/// number of independent variables
+	size_t n_;
+
+	/// number of dependent variables
+	size_t m_;
+
+	/// zero order forward function in the shared object
+	forward_fun_t forward_;
+
+	/// first order reverse function in the shared object
+	reverse_fun_t reverse_;
+
+	/// value of the parameters
+	CppAD::vector<double> par_;
+
+	/// value of the variables
+	CppAD::vector<double> var_;
+
+	/// partial derivative with respect to the variables
+	CppAD::vector<double> partial_;
+
+	/// FNV-1a hash code for a string
+	static size_t hash_code(const std::string& source)
+	{	size_t result = size_t(2166136261u);
+		for(size_t i = 0; i < source.size(); i++)
+		{	result ^= size_t( static_cast<unsigned char>(source[i]) );
+			result *= size_t(16777619u);
+		}
+		return result;
+	}
+
+	/// quote a string so that the shell treats it as one word
+	static std::string shell_quote(const std::string& word)
+	{	std::string result = "'";
+		for(size_t i = 0; i < word.size(); i++)
+		{	if( word[i] == '\'' )
+				result += "'\\''";
+			else
+				result += word[i];
+		}
+		result += "'";
+		return result;
+	}
+
+	/// contents of a file (empty if it cannot be read)
+	static std::string read_file(const std::string& file_name)
+	{	std::ifstream file( file_name.c_str() );
+		std::ostringstream os;
+		if( file )
+			os << file.rdbuf();
+		return os.str();
+	}
+
+	/// copy the parameters in a function object
+	void set_par(const ADFun<double>& f)
+	{	size_t num_par = f.play_.num_par_rec();
+		par_.resize(num_par);
+		for(size_t i = 0; i < num_par; i++)
+			par_[i] = f.play_.GetPar(i);
+	}
+
+	// not implemented
+	fun_jit(const fun_jit&);
+	fun_jit& operator=(const fun_jit&);
+public:
+	/// constructor
+	fun_jit(void)
+	: handle_(CPPAD_NULL)
+	, hash_(0)
+	, n_(0)
+	, m_(0)
+	, forward_(CPPAD_NULL)
+	, reverse_(CPPAD_NULL)
+	{ }
+	/// destructor
+	~fun_jit(void)
+	{	clear(); }
+	/// unload the shared object and free the memory used by this object
+	void clear(void)
+	{
+# if CPPAD_HAS_DLOPEN
+		if( handle_ != CPPAD_NULL )
+			dlclose(handle_);
+# endif
+		handle_  = CPPAD_NULL;
+		hash_    = 0;
+		n_       = 0;
+		m_       = 0;
+		forward_ = CPPAD_NULL;
+		reverse_ = CPPAD_NULL;
+		par_.clear();
+		var_.clear();
+		partial_.clear();
+	}
+	/*!
+	Compile a function object and load the corresponding shared object.
+
+	\param f
+	is the function object.
+
+	\param cache_dir
+	is the directory where the C source and shared object are stored.
+
+	\param compile_cmd
+	is the command used to compile the C source.
+
+	\return
+	is empty if no error occurred. Otherwise it is an error message
+	and this object is empty.
+	*/
+	std::string compile(
+		const ADFun<double>& f                                     ,
+		const std::string&   cache_dir   = "."                     ,
+		const std::string&   compile_cmd = "cc -O1 -fPIC -shared"  )
+	{	// C source code for this function
+		std::ostringstream os;
+		std::string msg = local::sweep::csrc(
+			os, &f.play_, f.ind_taddr_, f.dep_taddr_
+		);
+		if( msg != "" )
+		{	clear();
+			return msg;
+		}
+		std::string source = os.str();
+		size_t      hash   = hash_code(source);
+		//
+		// check if this operation sequence is already loaded
+		if( handle_ != CPPAD_NULL && hash == hash_ )
+		{	set_par(f);
+			return "";
+		}
+		clear();
+# if ! CPPAD_HAS_DLOPEN
+		return "fun_jit::compile: CPPAD_HAS_DLOPEN is false";
+# else
+		// file names
+		std::ostringstream hex;
+		hex << std::hex << hash;
+		std::string base    = cache_dir + "/cppad_jit_" + hex.str();
+		std::string c_file  = base + ".c";
+		std::string so_file = base + ".so";
+		//
+		// check for shared object corresponding to this source in cache
+		bool use_cache = read_file(c_file) == source;
+		if( use_cache )
+			use_cache = std::ifstream( so_file.c_str() ).good();
+		if( ! use_cache )
+		{	// temporary file names unique to this process and object
+			std::ostringstream unique;
+			unique << "_" << getpid() << "_" << this;
+			std::string c_tmp  = base + unique.str() + ".c";
+			std::string so_tmp = base + unique.str() + ".so";
+			//
+			// write the C source
+			std::ofstream file( c_tmp.c_str() );
+			file << source;
+			file.close();
+			if( ! file )
+			{	std::remove( c_tmp.c_str() );
+				return "fun_jit::compile: cannot write " + c_tmp;
+			}
+			//
+			// compile the C source
+			std::string cmd = compile_cmd + " " + shell_quote(c_tmp);
+			cmd            += " -o " + shell_quote(so_tmp) + " -lm";
+			if( std::system( cmd.c_str() ) != 0 )
+			{	std::remove( c_tmp.c_str() );
+				std::remove( so_tmp.c_str() );
+				return "fun_jit::compile: the following command failed\n"
+					+ cmd;
+			}
+			// move the shared object into place before the source so that
+			// a matching source file implies the shared object exists
+			bool ok = std::rename( so_tmp.c_str(), so_file.c_str() ) == 0;
+			if( ok )
+				ok = std::rename( c_tmp.c_str(), c_file.c_str() ) == 0;
+			if( ! ok )
+			{	std::remove( c_tmp.c_str() );
+				std::remove( so_tmp.c_str() );
+				return "fun_jit::compile: cannot create " + so_file;
+			}
+		}
+		//
+		// load the shared object
+		handle_ = dlopen(so_file.c_str(), RTLD_NOW | RTLD_LOCAL);
+		if( handle_ == CPPAD_NULL )
+			return "fun_jit::compile: dlopen failed for " + so_file;
+		void* forward = dlsym(handle_, "cppad_jit_forward");
+		void* reverse = dlsym(handle_, "cppad_jit_reverse");
+		if( forward == CPPAD_NULL || reverse == CPPAD_NULL )
+		{	clear();
+			return "fun_jit::compile: dlsym failed for " + so_file;
+		}
+		// conversion from object pointer to function pointer
+		*reinterpret_cast<void**>(&forward_) = forward;
+		*reinterpret_cast<void**>(&reverse_) = reverse;
+		//
+		hash_ = hash;
+		n_    = f.Domain();
+		m_    = f.Range();
+		var_.resize( f.size_var() );
+		partial_.resize( f.size_var() );
+		set_par(f);
+		return "";
+# endif
+	}
+	/*!
+	Zero order forward mode using the compiled function.
+
+	\param x
+	is the value of the independent variables.
+
+	\return
+	is the corresponding value of the dependent variables.
+	*/
+	template <class Vector>
+	Vector forward(const Vector& x)
+	{	CheckSimpleVector<double, Vector>();
+		CPPAD_ASSERT_KNOWN(
+			forward_ != CPPAD_NULL,
+			"fun_jit::forward: compile has not succeeded"
+		);
+		CPPAD_ASSERT_KNOWN(
+			size_t( x.size() ) == n_,
+			"fun_jit::forward: x.size() not equal domain dimension"
+		);
+		CppAD::vector<double> xv(n_), yv(m_);
+		for(size_t j = 0; j < n_; j++)
+			xv[j] = x[j];
+		forward_(par_.data(), xv.data(), yv.data(), var_.data());
+		Vector y(m_);
+		for(size_t i = 0; i < m_; i++)
+			y[i] = yv[i];
+		return y;
+	}
+	/*!
+	First order reverse mode using the compiled function.
+
+	\param x
+	is the value of the independent variables.
+
+	\param w
+	is the weighting vector for the dependent variables.
+
+	\return
+	is the derivative of w^T f(x) with respect to x.
+	*/
+	template <class Vector>
+	Vector reverse(const Vector& x, const Vector& w)
+	{	CheckSimpleVector<double, Vector>();
+		CPPAD_ASSERT_KNOWN(
+			reverse_ != CPPAD_NULL,
+			"fun_jit::reverse: compile has not succeeded"
+		);
+		CPPAD_ASSERT_KNOWN(
+			size_t( x.size() ) == n_,
+			"fun_jit::reverse: x.size() not equal domain dimension"
+		);
+		CPPAD_ASSERT_KNOWN(
+			size_t( w.size() ) == m_,
+			"fun_jit::reverse: w.size() not equal range dimension"
+		);
+		CppAD::vector<double> xv(n_), wv(m_), yv(m_), dwv(n_);
+		for(size_t j = 0; j < n_; j++)
+			xv[j] = x[j];
+		for(size_t i = 0; i < m_; i++)
+			wv[i] = w[i];
+		reverse_(
+			par_.data(), xv.data(), wv.data(),
+			yv.data(), dwv.data(), var_.data(), partial_.data()
+		);
+		Vector dw(n_);
+		for(size_t j = 0; j < n_; j++)
+			dw[j] = dwv[j];
+		return dw;
+	}
+};
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -0,0 +1,486 @@
+# ifndef CPPAD_CORE_FUN_WORK_HPP
+# define CPPAD_CORE_FUN_WORK_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin fun_work$$
+$spell
+	const
+	xq
+	yq
+	dw
+	Taylor
+	std
+	cskip
+	op
+$$
+
+$section Evaluating a Shared Function Using a Separate Work Space$$
+
+$head Syntax$$
+$codei%fun_work<%Base%> %work%
+%$$
+$icode%yq% = %f%.Forward(%q%, %xq%, %work%)
+%$$
+$icode%dw% = %f%.Reverse(%q%, %w%, %work%)
+%$$
+$icode%work%.clear()
+%$$
+$icode%c% = %work%.size_order()
+%$$
+$icode%number% = %work%.compare_change_number()
+%$$
+
+$head Purpose$$
+The $cref/Forward/forward_order/$$ and $cref/Reverse/reverse_any/$$
+routines store Taylor coefficients, and other information that
+depends on the argument values, in the function object $icode f$$.
+Hence, each thread must use a different copy of $icode f$$.
+The syntax above stores this information in $icode work$$ instead of
+$icode f$$.
+This enables the same function object, and hence the same
+operation sequence, to be used by multiple threads at the same time
+(using a different work space for each thread).
+
+$head f$$
+The object $icode f$$ has prototype
+$codei%
+	const ADFun<%Base%> %f%
+%$$
+None of the information stored in $icode f$$ is changed by these
+routines.
+For example, the Taylor coefficients stored in $icode f$$,
+and the value of $icode%f%.size_order()%$$, do not change.
+
+$head work$$
+This object has prototype
+$codei%
+	fun_work<%Base%> %work%
+%$$
+It holds the Taylor coefficients, and other information,
+that would otherwise be stored in $icode f$$.
+A work space can be used with any function object.
+If it is used with a function that has a different number of variables
+or operators than the previous use,
+it is cleared before it is used.
+
+$head Forward$$
+The arguments $icode q$$, $icode xq$$ and the return value $icode yq$$
+are the same as for $cref/Forward(q, xq)/forward_order/$$
+with the following exceptions:
+$list number$$
+The Taylor coefficients of order less than $icode q$$ are the ones
+stored in $icode work$$ (not in $icode f$$).
+$lnext
+Output generated by $cref PrintFor$$ operations is written to
+$code std::cout$$.
+$lend
+
+$head Reverse$$
+The arguments $icode q$$, $icode w$$, and the return value $icode dw$$
+are the same as for $cref/Reverse(q, w)/reverse_any/$$
+except that the Taylor coefficients used are the ones
+stored in $icode work$$ (not in $icode f$$).
+
+$head clear$$
+This frees the memory used by $icode work$$.
+
+$head size_order$$
+The return value $icode c$$ has prototype
+$codei%
+	size_t %c%
+%$$
+and is the number of Taylor coefficient orders stored in $icode work$$;
+see $cref size_order$$.
+
+$head compare_change_number$$
+The return value $icode number$$ has prototype
+$codei%
+	size_t %number%
+%$$
+and is the number of comparison operators that changed during the
+previous zero order forward mode calculation using $icode work$$;
+see $cref/number/compare_change/number/$$.
+The value $icode%f%.compare_change_count%$$ is used for the
+$cref/count/compare_change/count/$$ in this calculation.
+
+$head Parallel Mode$$
+The Taylor coefficients are stored in memory that is allocated
+using $cref thread_alloc$$.
+Hence the usual restrictions for using CppAD in
+$cref/parallel mode/ta_in_parallel/$$ apply; e.g.,
+$cref parallel_ad$$ must be called before the threads use $icode f$$.
+The work space $icode work$$ should only be used by one thread.
+In addition, the following operations change $icode f$$ and must not be
+done while other threads are using it:
+$cref/new_dynamic/new_dynamic/$$,
+$cref Dependent$$,
+$cref/optimize/optimize/$$, and
+$cref/from_file/fun_file/$$.
+
+$children%
+	example/general/fun_work.cpp
+%$$
+$head Example$$
+The file
+$cref fun_work.cpp$$
+contains an example and test of these operations.
+It returns true if it succeeds and false otherwise.
+
+$end
+------------------------------------------------------------------------------
+*/
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/local/play/sequential_iterator.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file fun_work.hpp
+Evaluate a function object without changing it.
+*/
+
+/*!
+Class used to hold the information that depends on the argument values
+during Forward and Reverse mode calculations.
+*/
+template <class Base>
+class fun_work {
+	// ADFun uses the private information in this class
+	friend class ADFun<Base>;
+private:
+	/// number of variables in the function last used with this work space
+	size_t num_var_;
+
+	/// number of Taylor coefficient orders stored in taylor_
+	size_t num_order_;
+
+	/// maximum number of Taylor coefficient orders that fit in taylor_
+	size_t cap_order_;
+
+	/// number of points when taylor_ contains a batch (zero otherwise)
+	size_t num_batch_;
+
+	/// number of comparison operators that changed during last zero order
+	size_t compare_change_number_;
+
+	/// Taylor coefficients; taylor_[ cap_order_ * i + k ] is order k
+	/// for the i-th variable
+	local::pod_vector_maybe<Base> taylor_;
+
+	/// which operations can be conditionally skipped
+	local::pod_vector<bool> cskip_op_;
+
+	/// variable index corresponding to each load instruction
+	local::pod_vector<addr_t> load_op_;
+
+	/// partial derivatives used by reverse mode
+	local::pod_vector_maybe<Base> partial_;
+public:
+	/// constructor
+	fun_work(void)
+	: num_var_(0)
+	, num_order_(0)
+	, cap_order_(0)
+	, num_batch_(0)
+	, compare_change_number_(0)
+	{ }
+	/// free the memory used by this work space
+	void clear(void)
+	{	num_var_               = 0;
+		num_order_             = 0;
+		cap_order_             = 0;
+		num_batch_             = 0;
+		compare_change_number_ = 0;
+		taylor_.clear();
+		cskip_op_.clear();
+		load_op_.clear();
+		partial_.clear();
+	}
+	/// number of Taylor coefficient orders stored in this work space
+	size_t size_order(void) const
+	{	return num_order_; }
+	/// number of comparisons that changed during last zero order forward
+	size_t compare_change_number(void) const
+	{	return compare_change_number_; }
+};
+// ----------------------------------------------------------------------------
+/*!
+Forward mode using a separate work space.
+
+\tparam Base
+base type for the operator; i.e., this operation sequence was recorded
+using AD< Base > and computations by this routine are done using type Base.
+
+\tparam VectorBase
+is a Simple Vector class with elements of type Base.
+
+\param q
+is the highest order for this forward mode computation.
+
+\param xq
+contains Taylor coefficients for the independent variables;
+see Forward(q, xq, s) for its specifications.
+
+\param work
+On input, it contains the Taylor coefficients of order less than q
+(when xq.size() is equal to n).
+Upon return, it contains the Taylor coefficients up to order q.
+
+\return
+contains Taylor coefficients for the dependent variables;
+see Forward(q, xq, s) for its specifications.
+*/
+template <typename Base>
+template <typename VectorBase>
+VectorBase ADFun<Base>::Forward(
+	size_t              q     ,
+	const VectorBase&   xq    ,
+	fun_work<Base>&     work  ) const
+{	// temporary indices
+	size_t i, j, k;
+
+	// number of independent variables
+	size_t n = ind_taddr_.size();
+
+	// number of dependent variables
+	size_t m = dep_taddr_.size();
+
+	// check Vector is Simple Vector class with Base type elements
+	CheckSimpleVector<Base, VectorBase>();
+
+	CPPAD_ASSERT_KNOWN(
+		size_t(xq.size()) == n || size_t(xq.size()) == n*(q+1),
+		"Forward(q, xq, work): xq.size() is not equal n or n*(q+1)"
+	);
+
+	// lowest order we are computing
+	size_t p = q + 1 - size_t(xq.size()) / n;
+	CPPAD_ASSERT_UNKNOWN( p == 0 || p == q );
+
+	// check if work was last used with a different function
+	size_t num_op = play_.num_op_rec();
+	if( work.num_var_ != num_var_tape_ || work.cskip_op_.size() != num_op )
+	{	work.clear();
+		work.num_var_ = num_var_tape_;
+		work.cskip_op_.resize(num_op);
+		for(i = 0; i < num_op; i++)
+			work.cskip_op_[i] = false;
+	}
+	if( work.load_op_.size() != play_.num_load_op_rec() )
+		work.load_op_.resize( play_.num_load_op_rec() );
+	// check if work contains a batch of zero order coefficients
+	if( work.num_batch_ > 0 )
+	{	work.num_order_ = 0;
+		work.cap_order_ = 0;
+		work.num_batch_ = 0;
+	}
+	CPPAD_ASSERT_KNOWN(
+		q <= work.num_order_ || p == 0,
+		"Forward(q, xq, work): Number of Taylor coefficient orders stored in"
+		" work\nis less than q and xq.size() != n*(q+1)."
+	);
+
+	// does work.taylor_ need more orders
+	if( work.cap_order_ <= q )
+	{	size_t c = std::max(q + 1, 2 * work.cap_order_);
+		local::pod_vector_maybe<Base> taylor(num_var_tape_ * c);
+		if( p > 0 )
+		{	// copy the orders that are inputs
+			for(i = 0; i < num_var_tape_; i++)
+			{	for(k = 0; k < p; k++)
+					taylor[c * i + k] = work.taylor_[work.cap_order_ * i + k];
+			}
+		}
+		work.taylor_.swap(taylor);
+		work.cap_order_ = c;
+	}
+	CPPAD_ASSERT_UNKNOWN( work.cap_order_ > q );
+
+	// short hand notation for order capacity
+	size_t C = work.cap_order_;
+	Base*  taylor = work.taylor_.data();
+
+	// initialize the orders we are computing (see Forward(q, xq, s))
+	for(j = 0; j < num_var_tape_; j++)
+	{	for(k = p; k <= q; k++)
+			taylor[C * j + k] = CppAD::numeric_limits<Base>::quiet_NaN();
+	}
+
+	// set Taylor coefficients for independent variables
+	for(j = 0; j < n; j++)
+	{	CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
+		CPPAD_ASSERT_UNKNOWN( play_.GetOp( ind_taddr_[j] ) == local::InvOp );
+		if( p == q )
+			taylor[ C * ind_taddr_[j] + q] = xq[j];
+		else
+		{	for(k = 0; k <= q; k++)
+				taylor[ C * ind_taddr_[j] + k] = xq[ (q+1)*j + k];
+		}
+	}
+
+	// evaluate the derivatives
+	size_t compare_change_op_index = 0;
+	if( q == 0 )
+	{	local::sweep::forward0(&play_, std::cout, true,
+			n, num_var_tape_, C,
+			taylor, work.cskip_op_.data(), work.load_op_,
+			compare_change_count_,
+			work.compare_change_number_,
+			compare_change_op_index
+		);
+	}
+	else
+	{	size_t compare_change_number = 0;
+		local::sweep::forward1(&play_, std::cout, true, p, q,
+			n, num_var_tape_, C,
+			taylor, work.cskip_op_.data(), work.load_op_,
+			compare_change_count_,
+			compare_change_number,
+			compare_change_op_index
+		);
+		if( p == 0 )
+			work.compare_change_number_ = compare_change_number;
+	}
+
+	// return Taylor coefficients for dependent variables
+	VectorBase yq;
+	if( p == q )
+	{	yq.resize(m);
+		for(i = 0; i < m; i++)
+			yq[i] = taylor[ C * dep_taddr_[i] + q];
+	}
+	else
+	{	yq.resize(m * (q+1) );
+		for(i = 0; i < m; i++)
+		{	for(k = 0; k <= q; k++)
+				yq[ (q+1) * i + k] = taylor[ C * dep_taddr_[i] + k ];
+		}
+	}
+
+	// now we have q + 1 Taylor coefficient orders per variable
+	work.num_order_ = q + 1;
+
+	return yq;
+}
+/*!
+Reverse mode using a separate work space.
+
+\tparam Base
+base type for the operator; i.e., this operation sequence was recorded
+using AD< Base > and computations by this routine are done using type Base.
+
+\tparam VectorBase
+is a Simple Vector class with elements of type Base.
+
+\param q
+is the number of the number of Taylor coefficients that are being
+differentiated (per variable).
+
+\param w
+is the weighting for each of the Taylor coefficients corresponding
+to dependent variables; see Reverse(q, w) for its specifications.
+
+\param work
+contains the Taylor coefficients computed by previous calls to
+Forward(q, xq, work).
+
+\return
+the derivative of the weighted sum; see Reverse(q, w).
+*/
+template <typename Base>
+template <typename VectorBase>
+VectorBase ADFun<Base>::Reverse(
+	size_t              q     ,
+	const VectorBase&   w     ,
+	fun_work<Base>&     work  ) const
+{	// temporary indices
+	size_t i, j, k;
+
+	// number of independent variables
+	size_t n = ind_taddr_.size();
+
+	// number of dependent variables
+	size_t m = dep_taddr_.size();
+
+	// check VectorBase is Simple Vector class with Base type elements
+	CheckSimpleVector<Base, VectorBase>();
+
+	CPPAD_ASSERT_KNOWN(
+		size_t(w.size()) == m || size_t(w.size()) == (m * q),
+		"Reverse(q, w, work): w.size() is not equal to m or m * q"
+	);
+	CPPAD_ASSERT_KNOWN(
+		q > 0,
+		"Reverse(q, w, work): q is not greater than zero."
+	);
+	CPPAD_ASSERT_KNOWN(
+		work.num_var_ == num_var_tape_ && work.num_order_ >= q,
+		"Reverse(q, w, work): Less than q Taylor coefficients are"
+		" currently stored in work for this function."
+	);
+
+	// initialize entire partial matrix to zero
+	work.partial_.resize(num_var_tape_ * q);
+	Base* partial = work.partial_.data();
+	for(i = 0; i < num_var_tape_ * q; i++)
+		partial[i] = Base(0);
+
+	// set the dependent variable direction
+	// (use += because two dependent variables can point to same location)
+	for(i = 0; i < m; i++)
+	{	CPPAD_ASSERT_UNKNOWN( dep_taddr_[i] < num_var_tape_  );
+		if( size_t(w.size()) == m )
+			partial[dep_taddr_[i] * q + q - 1] += w[i];
+		else
+		{	for(k = 0; k < q; k++)
+				partial[ dep_taddr_[i] * q + k ] = w[i * q + k ];
+		}
+	}
+
+	// evaluate the derivatives
+	CPPAD_ASSERT_UNKNOWN( work.cskip_op_.size() == play_.num_op_rec() );
+	CPPAD_ASSERT_UNKNOWN( work.load_op_.size()  == play_.num_load_op_rec() );
+	local::play::const_sequential_iterator play_itr = play_.end();
+	local::sweep::reverse(
+		q - 1,
+		n,
+		num_var_tape_,
+		&play_,
+		work.cap_order_,
+		work.taylor_.data(),
+		q,
+		partial,
+		work.cskip_op_.data(),
+		work.load_op_,
+		play_itr
+	);
+
+	// return the derivative values
+	VectorBase value(n * q);
+	for(j = 0; j < n; j++)
+	{	CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
+		if( size_t(w.size()) == m )
+		{	for(k = 0; k < q; k++)
+				value[j * q + k ] =
+					partial[ind_taddr_[j] * q + q - 1 - k];
+		}
+		else
+		{	for(k = 0; k < q; k++)
+				value[j * q + k ] =
+					partial[ind_taddr_[j] * q + k];
+		}
+	}
+	return value;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -0,0 +1,282 @@
+# ifndef CPPAD_CORE_INTERNAL_SPARSITY_HPP
+# define CPPAD_CORE_INTERNAL_SPARSITY_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin internal_sparsity$$
+$spell
+	const
+	CppAD
+	bool
+	jac
+	hes
+	bitmap
+	bitmaps
+	std
+$$
+$section Choosing the Internal Representation for Sparsity Patterns$$
+
+$head Syntax$$
+$icode%f%.internal_sparsity(%name%)
+%$$
+$icode%f%.internal_sparsity(%name%, %report%)
+%$$
+$icode%name% = %f%.internal_sparsity()
+%$$
+
+$head Purpose$$
+The sparsity pattern calculations
+$cref for_jac_sparsity$$,
+$cref rev_jac_sparsity$$,
+$cref for_hes_sparsity$$, and
+$cref rev_hes_sparsity$$
+represent the sparsity pattern for each variable in the operation sequence
+by an internal set of integers.
+The argument $icode internal_bool$$ to these routines chooses between
+a vector of boolean values, which uses one bit for every possible element,
+and a singly linked list, which uses two $code size_t$$ values for every
+element that is present.
+This setting can choose a third representation that is better than both
+for large functions where some of the sets are dense and others are sparse.
+It can also choose between the first two automatically.
+
+$head f$$
+For the syntax where $icode name$$ is an argument,
+$icode f$$ has prototype
+$codei%
+	ADFun<%Base%> %f%
+%$$
+For the syntax where $icode name$$ is the result,
+$icode f$$ has prototype
+$codei%
+	const ADFun<%Base%> %f%
+%$$
+
+$head name$$
+This argument or result has prototype
+$codei%
+	const std::string& %name%
+%$$
+The possible values for $icode name$$ are listed below:
+
+$subhead Empty$$
+If $icode name$$ is the empty string,
+the $icode internal_bool$$ argument chooses the representation.
+
+$subhead hybrid$$
+If $icode name$$ is $code "hybrid"$$, the $icode internal_bool$$ argument
+is ignored.
+The elements of a set are grouped into blocks of $latex 2^{16}$$
+possible elements.
+The elements in a block are stored as a sorted array of 16 bit values
+if there are at most 4096 of them, and as a bitmap with $latex 2^{16}$$
+bits otherwise.
+(This is similar to the Roaring bitmaps representation.)
+The blocks for a set are contiguous in memory.
+A sparse set uses about 16 bits per element and
+a dense set uses at most one bit per possible element
+(plus one $code size_t$$ value for each non-empty block).
+
+$subhead auto$$
+If $icode name$$ is $code "auto"$$, the $icode internal_bool$$ argument
+is ignored and its value is chosen for each call to
+$cref for_jac_sparsity$$, $cref rev_jac_sparsity$$ and
+$cref for_hes_sparsity$$ as follows:
+If the number of possible elements in each set is at most the
+number of bits in a $code size_t$$ value, $icode internal_bool$$ is true.
+Otherwise, a sparsity calculation with a sample of at most that many
+columns is done using a vector of boolean values.
+This takes about the same time as one operation sequence sweep.
+The sample is used to estimate the fraction of possible elements
+$icode fill$$ that are in each set.
+The value $icode internal_bool$$ is true if the estimated memory for
+a vector of boolean values is less than or equal the estimated memory
+for a vector of sets of integers.
+The following call to $cref rev_hes_sparsity$$ uses the same representation
+as the previous call to $cref for_jac_sparsity$$.
+
+$head report$$
+This argument has prototype
+$codei%
+	void (*%report%)(const char* %routine%, bool %internal_bool%, double %fill%)
+%$$
+If it is not null, it is called every time a value for
+$icode internal_bool$$ is chosen because $icode name$$ is $code "auto"$$.
+The syntax $icode%f%.internal_sparsity(%name%)%$$ sets $icode report$$
+to null.
+
+$subhead routine$$
+is the name of the routine that made the choice; e.g.,
+$code "for_jac_sparsity"$$.
+
+$subhead internal_bool$$
+is the value chosen for $icode internal_bool$$.
+
+$subhead fill$$
+is the estimated fraction of the possible elements that are in each set.
+It is $code -1$$ if no estimate was necessary.
+
+$head Default$$
+The value for this setting after construction of $icode f$$ is
+the empty string and $icode report$$ is null.
+The value of this setting is not affected by calling
+$cref Dependent$$ for this function object.
+
+$head rev_hes_sparsity$$
+The representation used by $cref rev_hes_sparsity$$ must be the same as
+the one used by the previous call to $cref for_jac_sparsity$$.
+This is automatic when $icode name$$ is $code "auto"$$.
+
+$head Example$$
+$children%
+	example/sparse/internal_sparsity.cpp
+%$$
+The file
+$cref internal_sparsity.cpp$$
+contains an example and test of this operation.
+It returns true if it succeeds and false otherwise.
+
+$end
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file internal_sparsity.hpp
+Set and get the internal representation used for sparsity patterns.
+*/
+
+/*!
+Set internal_sparsity
+
+\param name
+is the name of the internal representation; i.e., empty, "hybrid", or "auto".
+*/
+template <class Base>
+void ADFun<Base>::internal_sparsity(const std::string& name)
+{	internal_sparsity(name, CPPAD_NULL); }
+
+/*!
+Set internal_sparsity and the function that reports automatic choices
+
+\param name
+is the name of the internal representation; i.e., empty, "hybrid", or "auto".
+
+\param report
+if not null, this function is called with the routine name,
+the value chosen for internal_bool, and the estimated fill,
+each time a choice is made because name is "auto".
+*/
+template <class Base>
+void ADFun<Base>::internal_sparsity(
+	const std::string& name                          ,
+	void (*report)(const char* , bool , double)      )
+{	CPPAD_ASSERT_KNOWN(
+		name == "" || name == "hybrid" || name == "auto",
+		"internal_sparsity: name is not empty, hybrid, or auto"
+	);
+	internal_sparsity_        = name;
+	internal_sparsity_report_ = report;
+}
+
+/*!
+Get internal_sparsity
+
+\return
+current value of internal_sparsity_.
+*/
+template <class Base>
+const std::string& ADFun<Base>::internal_sparsity(void) const
+{	return internal_sparsity_; }
+
+/*!
+Choose internal_bool for a sparsity calculation when internal_sparsity_
+is "auto".
+
+\tparam SizeVector
+is the simple vector with elements of type size_t
+that is used for the input sparsity pattern.
+
+\param routine
+is the name of the routine that is making the choice.
+
+\param forward
+if true (false), the choice is for a forward (reverse) Jacobian sparsity
+calculation and the rows of the internal pattern corresponding to
+pattern_in are ind_taddr_ (dep_taddr_).
+
+\param dependency
+is the dependency argument for the Jacobian sparsity sweep.
+
+\param transpose
+is the transpose argument for set_internal_sparsity with pattern_in.
+
+\param pattern_in
+is the sparsity pattern for the independent (dependent) variables.
+
+\return
+is the value chosen for internal_bool.
+*/
+template <class Base>
+template <class SizeVector>
+bool ADFun<Base>::internal_sparsity_auto(
+	const char*                  routine     ,
+	bool                         forward     ,
+	bool                         dependency  ,
+	bool                         transpose   ,
+	const sparse_rc<SizeVector>& pattern_in  )
+{	CPPAD_ASSERT_UNKNOWN( internal_sparsity_ == "auto" );
+	//
+	// number of possible elements in each set
+	size_t end = pattern_in.nc();
+	if( transpose )
+		end = pattern_in.nr();
+	//
+	// maximum number of columns in the sample (one sparse_pack word)
+	size_t n_sample = std::numeric_limits<size_t>::digits;
+	//
+	bool   internal_bool = true;
+	double fill          = -1.0;
+	if( end > n_sample )
+	{	// sample every stride-th column of pattern_in
+		size_t stride = (end + n_sample - 1) / n_sample;
+		n_sample      = (end + stride - 1) / stride;
+		//
+		local::sparse_pack sample;
+		sample.resize(num_var_tape_, n_sample);
+		if( forward )
+		{	local::set_sample_sparsity(
+				stride, transpose, ind_taddr_, sample, pattern_in
+			);
+			local::sweep::for_jac<addr_t>(
+				&play_, dependency, Domain(), num_var_tape_, sample
+			);
+		}
+		else
+		{	local::set_sample_sparsity(
+				stride, transpose, dep_taddr_, sample, pattern_in
+			);
+			local::sweep::rev_jac<addr_t>(
+				&play_, dependency, Domain(), num_var_tape_, sample
+			);
+		}
+		fill          = local::sparsity_fill(sample);
+		internal_bool = local::sparsity_choose_bool(fill, end);
+	}
+	if( internal_sparsity_report_ != CPPAD_NULL )
+		internal_sparsity_report_(routine, internal_bool, fill);
+	//
+	return internal_bool;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
@@ -99,7 +99,8 @@ size_t ADFun<Base>::number_skip(void)
 			size_t num_op = user_m + user_n + 1;
 			for(size_t i = 0; i < num_op; i++)
 			{	CPPAD_ASSERT_UNKNOWN(
-					op != local::CSkipOp && op != local::CSumOp
+					op != local::CSkipOp && op != local::CSumOp &&
+					op != local::CProdOp
 				);
 				(++itr).op_info(op, arg, i_var);
 				if( skip_call )
@@ -111,7 +112,10 @@ size_t ADFun<Base>::number_skip(void)
 		{	if( cskip_op_[ itr.op_index() ] )
 				num_var_skip += NumRes(op);
 			//
-			if( (op == local::CSkipOp) | (op == local::CSumOp) )
+			bool variable_arg = op == local::CSkipOp;
+			variable_arg     |= op == local::CSumOp;
+			variable_arg     |= op == local::CProdOp;
+			if( variable_arg )
 				itr.correct_before_increment();
 		}
 	}
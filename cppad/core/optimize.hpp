@@ -27,6 +27,8 @@ $spell
 	const
 	onetape
 	op
+	exp
+	cout
 $$
 
 $section Optimize an ADFun Object Tape$$
@@ -38,6 +40,8 @@ $icode%f%.optimize()
 %$$
 $icode%f%.optimize(%options%)
 %$$
+$icode%count% = %f%.simplify_count(%rewrite%)
+%$$
 
 $head Purpose$$
 The operation sequence corresponding to an $cref ADFun$$ object can
@@ -89,6 +93,139 @@ $cref PrintFor$$ operations will be removed form the optimized function.
 These operators are useful for reporting problems evaluating derivatives
 at independent variable values different from those used to record a function.
 
+$subhead no_simplify$$
+If the sub-string $code no_simplify$$ appears in $icode options$$,
+none of the algebraic
+$cref/simplifications/optimize/Simplify/$$ are done.
+
+$subhead simplify$$
+If the sub-string $code simplify$$ appears in $icode options$$
+(and $code no_simplify$$ does not),
+the algebraic simplifications that may change the function or
+derivative values are also done; see
+$cref/value changes/optimize/Simplify/Value Changes/$$.
+
+$head Parallel$$
+If $cref/f.parallel_sweep(num_threads)/parallel_sweep/$$ was called with
+$icode num_threads$$ greater than one,
+the operation sequence is split into $icode num_threads$$ segments
+and a team of threads determines which parameters are used by each segment.
+The other passes through the operation sequence are sequential.
+The optimized operation sequence does not depend on $icode num_threads$$.
+
+$head Dynamic Parameters$$
+The operations that compute the
+$cref/dynamic parameters/glossary/Parameter/Dynamic/$$ are also optimized.
+A dynamic parameter that does not depend on the independent
+dynamic parameters is converted to a constant; e.g.,
+$codei%CondExpLt(%c%, %d%, %p%, %q%)%$$ where $icode c$$ and $icode d$$
+are constants.
+A dynamic parameter that is equal to one of its arguments is removed; e.g.,
+$icode%p% * 1%$$ and $icode%p% + 0%$$.
+A dynamic parameter with the same operator and arguments as a previous one
+is removed; e.g., the second of two $icode%sin%(%p%)%$$ calculations.
+This reduces the number of dynamic parameters that are evaluated by
+each call to $cref new_dynamic$$.
+
+$head Simplify$$
+The following algebraic simplifications are done
+where $icode x$$ is a variable and $icode c$$, $icode d$$ are constants
+(or dynamic parameters that are converted to constants, see above).
+The $code mul_one$$ and $code add_zero$$ simplifications
+do not change function or derivative values and are done by default.
+The other simplifications are only done when the
+$cref/simplify/optimize/options/simplify/$$ option is present:
+$table
+$icode rewrite$$ $cnext Operations $cnext Replaced By $rnext
+$code mul_one$$ $cnext
+	$icode%x%*1%$$, $codei%1*%x%$$, $icode%x%/1%$$,
+	$codei%azmul(%x%, 1)%$$, $codei%azmul(1, %x%)%$$ $cnext
+	$icode x$$
+$rnext
+$code add_zero$$ $cnext
+	$icode%x%+0%$$, $codei%0+%x%$$, $icode%x%-0%$$ $cnext
+	$icode x$$
+$rnext
+$code exp_log$$ $cnext
+	$codei%exp( log(%x%) )%$$ $cnext
+	$icode x$$
+$rnext
+$code pow_two$$ $cnext
+	$codei%pow(%x%, 2)%$$ $cnext
+	$icode%x%*%x%$$
+$rnext
+$code div_con$$ $cnext
+	$icode%x%/%c%$$ $cnext
+	$codei%(1/%c%)*%x%$$
+$rnext
+$code mul_chain$$ $cnext
+	$icode%c%*(%d%*%x%)%$$ $cnext
+	$codei%(%c%*%d%)*%x%$$
+$tend
+The $code mul_chain$$ case applies to chains of any length.
+
+$subhead Value Changes$$
+The following simplifications may change function or derivative values:
+$list number$$
+The $code div_con$$ and $code mul_chain$$ results may differ by rounding.
+$lnext
+The factors in a
+$cref/cumulative product/optimize/Cumulative Product/$$
+are multiplied in a different order
+(and the result may differ by rounding).
+$lnext
+The $code exp_log$$ result is $icode x$$ when $icode x$$ is not positive
+(where the original value is $code nan$$).
+$lnext
+The $code pow_two$$ derivatives are finite when $icode x$$ is not positive
+(where the original derivatives are $code nan$$).
+$lend
+
+$subhead simplify_count$$
+The argument $icode rewrite$$ has prototype
+$codei%
+	const std::string& %rewrite%
+%$$
+It must be one of the names in the table above.
+The return value $icode count$$ has prototype
+$codei%
+	size_t %count%
+%$$
+It is the number of operators in $icode f$$ that were changed by
+the $icode rewrite$$ simplification during the previous call to
+$icode%f%.optimize%$$.
+It is zero if $icode f$$ has not been optimized,
+or if its operation sequence was loaded using
+$cref/from_file/fun_file/$$ (the counts are not stored in the file).
+
+$head Cumulative Product$$
+A chain of multiplications, where each intermediate result is
+only used once by the next multiplication
+and is not a dependent variable, is replaced by one cumulative product
+operator; e.g., $codei%%x0% * %x1% * %x2% * %x3%$$.
+By default, only chains where each multiplication has one argument
+that is also in the chain are replaced,
+so the cumulative product is evaluated in the same order as the original
+operations and gives the same values.
+If the $cref/simplify/optimize/options/simplify/$$ option is present,
+chains of any shape are replaced;
+e.g., $codei%2 * (%x0% * %x1%) * (%x2% * %x3%)%$$.
+In this case the constant factors in the chain are multiplied together and
+the dynamic parameter factors are kept as arguments to the operator.
+This is similar to the way chains of additions and subtractions
+are replaced by cumulative summations; see
+$cref/cumulative_sum.cpp/optimize_cumulative_sum.cpp/$$.
+
+$head Memory$$
+The $cref/Taylor coefficients/size_order/$$, sparsity patterns,
+and other information computed from the current operation sequence
+are freed before the optimized operation sequence is created.
+The work space used by the optimizer is freed as soon as it is no longer
+needed and the memory for the optimized operation sequence is reserved
+before it is created (instead of growing as it is recorded).
+Thus the peak memory used by $code optimize$$ is close to
+the memory for the old and new operation sequences.
+
 $head Examples$$
 $children%
 	example/optimize/forward_active.cpp
@@ -98,6 +235,7 @@ $children%
 	%example/optimize/conditional_skip.cpp
 	%example/optimize/nest_conditional.cpp
 	%example/optimize/cumulative_sum.cpp
+	%example/optimize/cumulative_product.cpp
 %$$
 $table
 $cref/forward_active.cpp/optimize_forward_active.cpp/$$ $cnext
@@ -120,6 +258,9 @@ $cref/nest_conditional.cpp/optimize_nest_conditional.cpp/$$ $cnext
 $rnext
 $cref/cumulative_sum.cpp/optimize_cumulative_sum.cpp/$$ $cnext
 	$title optimize_cumulative_sum.cpp$$
+$rnext
+$cref/cumulative_product.cpp/optimize_cumulative_product.cpp/$$ $cnext
+	$title optimize_cumulative_product.cpp$$
 $tend
 
 $head Efficiency$$
@@ -175,7 +316,7 @@ If $cref/NDEBUG/Faq/Speed/NDEBUG/$$ is not defined,
 and $cref/f.size_order()/size_order/$$ is greater than zero,
 a $cref forward_zero$$ calculation is done using the optimized version
 of $icode f$$ and the results are checked to see that they are
-the same as before.
+the same as before (results that were $code nan$$ are not checked).
 If they are not the same, the
 $cref ErrorHandler$$ is called with a known error message
 related to $icode%f%.optimize()%$$.
@@ -213,6 +354,15 @@ These operators are necessary for the compare_change function to be
 be meaningful in the resulting recording.
 On the other hand, they are not necessary and take extra time
 when compare_change is not used.
+\li
+If the sub-string "no_print_for_op" appears,
+then print forward (PriOp) operators will be removed from the optimized tape.
+\li
+If the sub-string "no_simplify" appears,
+the algebraic simplifications are not done.
+\li
+If the sub-string "simplify" appears,
+the simplifications that may change values are also done.
 */
 template <class Base>
 void ADFun<Base>::optimize(const std::string& options)
@@ -254,24 +404,44 @@ void ADFun<Base>::optimize(const std::string& options)
 	}
 # endif
 
+	// Free the memory for information that is computed from the current
+	// recording before creating the optimized recording
+	// (none of it is valid for the optimized recording).
+	for_jac_sparse_pack_.resize(0, 0);
+	for_jac_sparse_set_.resize(0,0);
+	for_jac_sparse_hybrid_.resize(0,0);
+	sparse_team_block_.clear();
+	sparse_team_rev_jac_.clear();
+	sparse_cache_.clear();
+	taylor_.clear();
+	num_order_taylor_     = 0;
+	cap_order_taylor_     = 0;
+	cskip_op_.clear();
+	subgraph_info_.resize(0, 0, 0, 0);
+	play_.op_stream().clear();
+	play_.level_schedule().clear();
+
+	// number of threads used to determine which parameters are used
+	size_t num_threads = std::max(parallel_sweep_, size_t(1));
+
 	// create the optimized recording
 	switch( play_.address_type() )
 	{
 		case local::play::unsigned_short_enum:
 		local::optimize::optimize_run<unsigned short>(
-			options, n, dep_taddr_, &play_, &rec
+			options, n, dep_taddr_, &play_, &rec, simplify_count_, num_threads
 		);
 		break;
 
 		case local::play::unsigned_int_enum:
 		local::optimize::optimize_run<unsigned int>(
-			options, n, dep_taddr_, &play_, &rec
+			options, n, dep_taddr_, &play_, &rec, simplify_count_, num_threads
 		);
 		break;
 
 		case local::play::size_t_enum:
 		local::optimize::optimize_run<size_t>(
-			options, n, dep_taddr_, &play_, &rec
+			options, n, dep_taddr_, &play_, &rec, simplify_count_, num_threads
 		);
 		break;
 
@@ -288,16 +458,6 @@ void ADFun<Base>::optimize(const std::string& options)
 	// set flag so this function knows it has been optimized
 	has_been_optimized_ = true;
 
-	// free memory allocated for sparse Jacobian calculation
-	// (the results are no longer valid)
-	for_jac_sparse_pack_.resize(0, 0);
-	for_jac_sparse_set_.resize(0,0);
-
-	// free old Taylor coefficient memory
-	taylor_.clear();
-	num_order_taylor_     = 0;
-	cap_order_taylor_     = 0;
-
 	// resize and initilaize conditional skip vector
 	// (must use player size because it now has the recoreder information)
 	cskip_op_.resize( play_.num_op_rec() );
@@ -319,6 +479,7 @@ void ADFun<Base>::optimize(const std::string& options)
 		// check results
 		Base eps99 = Base(99) * CppAD::numeric_limits<Base>::epsilon();
 		for(i = 0; i < m; i++)
+		if( ! CppAD::isnan( y[i] ) )
 		if( ! abs_geq( eps99 * max_taylor , check[i] - y[i] ) )
 		{	std::string msg = "Error during check of f.optimize().";
 			msg += "\neps99 * max_taylor = " + to_string(eps99 * max_taylor);
@@ -343,5 +504,33 @@ void ADFun<Base>::optimize(const std::string& options)
 # endif
 }
 
+/*!
+Number of operators changed by an algebraic simplification.
+
+\param rewrite
+is the name of the simplification; see local::optimize::simplify_name.
+
+\return
+is the number of operators changed by this simplification during the
+previous call to optimize (zero if this function has not been optimized).
+*/
+template <class Base>
+size_t ADFun<Base>::simplify_count(const std::string& rewrite) const
+{	using local::optimize::enum_simplify;
+	using local::optimize::simplify_name;
+	using local::optimize::number_simplify;
+	//
+	size_t k = 1;
+	while( k < size_t(number_simplify) &&
+		rewrite != simplify_name( enum_simplify(k) ) ) ++k;
+	CPPAD_ASSERT_KNOWN(
+		k < size_t(number_simplify),
+		"f.simplify_count(rewrite): rewrite is not a valid simplification"
+	);
+	if( simplify_count_.size() == 0 )
+		return 0;
+	return simplify_count_[k];
+}
+
 } // END_CPPAD_NAMESPACE
 # endif
@@ -0,0 +1,206 @@
+# ifndef CPPAD_CORE_PARALLEL_SWEEP_HPP
+# define CPPAD_CORE_PARALLEL_SWEEP_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin parallel_sweep$$
+$spell
+	const
+	cplusplus
+	CppAD
+	dw
+	dx
+	VecAD
+	thread_alloc
+	Jacobians
+	Hessians
+$$
+$section Use Multiple Threads During an ADFun Sweep$$
+
+$head Syntax$$
+$icode%f%.parallel_sweep(%num_threads%)
+%$$
+$icode%num_threads% = %f%.parallel_sweep()
+%$$
+
+$head Purpose$$
+The operations in a function's operation sequence can be grouped into
+levels where the operations in a level only depend on
+the independent variables and the results of lower levels.
+The operations in a level can be evaluated at the same time.
+This setting enables splitting the operations in each level
+between a team of threads during the following calculations:
+$codei%
+	%y% = %f%.Forward(0, %x%)
+	%dy% = %f%.Forward(1, %dx%)
+	%dw% = %f%.Reverse(%q%, %w%)
+%$$
+(For forward mode, only the case where
+$cref/one order/forward_order/One Order/$$ is computed is included.)
+
+$subhead Reverse Mode$$
+Operations in the same level may have the same argument,
+so each thread accumulates partial derivatives in its own copy
+of the partial derivative matrix.
+The partials for a variable are summed over the threads
+just before the operation that computes the variable is processed.
+Hence reverse mode uses $icode%num_threads%-1%$$ extra partial derivative
+matrices, each with $icode q$$ columns and one row for every variable
+in the operation sequence; see
+$cref/size_var/seq_property/size_var/$$.
+
+$subhead Sparse Jacobians and Hessians$$
+This setting also enables splitting the sweeps for different colors
+between a team of threads when computing
+$cref/sparse Jacobians/sparse_jac/Parallel/$$,
+$cref/sparse Hessians/sparse_hes/Parallel/$$, and
+$cref/sparse Hessians/sparse_hessian/Parallel/$$
+using the older interface.
+It also enables splitting the columns of sparsity patterns between a team;
+see $cref/for_jac_sparsity/for_jac_sparsity/Parallel/$$,
+$cref/rev_jac_sparsity/rev_jac_sparsity/Parallel/$$, and
+$cref/rev_hes_sparsity/rev_hes_sparsity/Parallel/$$.
+It is also the number of threads used by the
+$cref/cppad.parallel/sparse_jac/coloring/cppad.parallel/$$ coloring method
+and by $cref/optimize/optimize/Parallel/$$.
+
+$head f$$
+For the syntax where $icode num_threads$$ is an argument,
+$icode f$$ has prototype
+$codei%
+	ADFun<%Base%> %f%
+%$$
+For the syntax where $icode num_threads$$ is the result,
+$icode f$$ has prototype
+$codei%
+	const ADFun<%Base%> %f%
+%$$
+
+$head num_threads$$
+This argument or result has prototype
+$codei%
+	size_t %num_threads%
+%$$
+It is the number of threads in the team (including the current thread).
+If it is less than two, the sweeps are done by the current thread.
+It should not be greater than the number of processors available
+because the threads wait for each other by spinning.
+The other threads in the team are created at the beginning of a sweep
+and joined at the end of the sweep.
+The sweeps done by the team do not use $cref thread_alloc$$,
+so it is not necessary to call
+$cref/parallel_setup/ta_parallel_setup/$$ before using this setting.
+The operations on $icode Base$$ values must also be thread safe
+without $code parallel_setup$$; see
+$cref/restrictions/parallel_sweep/Restrictions/$$.
+
+$head Default$$
+The value for this setting after construction of $icode f$$ is one.
+The value of this setting is not affected by calling
+$cref Dependent$$ for this function object.
+
+$head Cost Model$$
+The threads in the team wait for each other at the end of every level
+that is split between them.
+A level is only split if it has many operations for each thread,
+and the team is only used if the number of operations in the levels that are
+split is large.
+Otherwise, the usual sweep is done by the current thread.
+The levels are computed the first time they are needed for an
+operation sequence; see $cref/optimize/optimize/$$ and
+$cref Dependent$$.
+
+$head Restrictions$$
+It is an error to set $icode num_threads$$ greater than one
+when $icode Base$$ is an $codei%AD<%Other%>%$$ type
+because all the threads in the team would record operations
+on the same tape.
+The team is not used unless $code __cplusplus >= 201100$$.
+It is also not used when the operation sequence contains
+$cref VecAD$$ operations, $cref Discrete$$ functions or
+$cref atomic$$ functions.
+
+$head Comparisons$$
+The comparison operations are evaluated in order by the
+current thread after the levels are evaluated.
+Hence $cref compare_change$$ has the same result as for the usual sweep.
+
+$head Conditional Skipping$$
+The team uses conditional skipping during reverse mode.
+If the team is used during zero order forward mode, the
+$cref/conditional skipping/optimize/options/no_conditional_skip/$$
+is not used during that sweep, nor during the higher order
+forward mode sweeps that follow it.
+The results are the same, but $cref number_skip$$ returns zero.
+
+$head Example$$
+$children%
+	example/general/parallel_sweep.cpp
+%$$
+The file
+$cref parallel_sweep.cpp$$
+contains an example and test of this operation.
+It returns true if it succeeds and false otherwise.
+
+$end
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file parallel_sweep.hpp
+Set and get the number of threads used by the parallel sweeps.
+*/
+
+namespace local {
+	/// is Type an AD type; i.e., do its operations record on a tape
+	template <class Type> struct parallel_sweep_is_ad
+	{	static bool value(void) { return false; } };
+	/// specialization for AD types
+	template <class Type> struct parallel_sweep_is_ad< AD<Type> >
+	{	static bool value(void) { return true; } };
+}
+
+/*!
+Set parallel_sweep
+
+\param num_threads
+is the number of threads in the team used by the parallel sweeps.
+It must be less than two if Base is an AD type.
+If it is less than two, the memory used by the sparsity calculations
+that are split between a team is freed.
+*/
+template <class Base>
+void ADFun<Base>::parallel_sweep(size_t num_threads)
+{	CPPAD_ASSERT_KNOWN(
+		num_threads < 2 || ! local::parallel_sweep_is_ad<Base>::value(),
+		"parallel_sweep: num_threads > 1 and Base is an AD type"
+	);
+	parallel_sweep_ = num_threads;
+	if( num_threads < 2 )
+	{	sparse_team_block_.clear();
+		sparse_team_rev_jac_.clear();
+	}
+}
+
+/*!
+Get parallel_sweep
+
+\return
+current value of parallel_sweep_.
+*/
+template <class Base>
+size_t ADFun<Base>::parallel_sweep(void) const
+{	return parallel_sweep_; }
+
+} // END_CPPAD_NAMESPACE
+
+# endif
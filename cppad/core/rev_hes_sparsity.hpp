@@ -14,6 +14,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 /*
 $begin rev_hes_sparsity$$
 $spell
+	cplusplus
 	Jacobian
 	Hessian
 	jac
@@ -94,6 +95,9 @@ If this is true, calculations are done with sets represented by a vector
 of boolean values. Otherwise, a vector of sets of integers is used.
 This must be the same as in the previous call to
 $icode%f%.for_jac_sparsity%$$.
+This argument is ignored when
+$cref/internal_sparsity/internal_sparsity/name/hybrid/$$ is $code "hybrid"$$
+or $cref/auto/internal_sparsity/name/auto/$$.
 
 $head pattern_out$$
 This argument has prototype
@@ -110,6 +114,30 @@ Suppose that $latex R$$ is the $latex n \times n$$ identity matrix.
 In this case, $icode pattern_out$$ is a sparsity pattern for
 $latex (s^\R{T} F) F^{(2)} ( x )$$.
 
+$head Parallel$$
+If $icode%f%.parallel_sweep()%$$ is greater than one
+and $icode internal_bool$$ is true,
+the columns of the $cref for_jac_sparsity$$ calculation
+(which are also the columns of $icode pattern_out$$)
+are split into blocks
+and the blocks are split between a team of
+$cref/parallel_sweep/parallel_sweep/$$ threads.
+Each thread does a complete sweep for its block using its own
+copy of the forward Jacobian sparsity for its block
+and its own vector of boolean values for the result.
+The memory for these vectors is kept in $icode f$$
+and reused by the next sparsity calculation that uses a team.
+It is freed when the operation sequence in $icode f$$ changes
+(e.g., by $cref optimize$$)
+and when $icode%f%.parallel_sweep(%num_threads%)%$$ is called
+with $icode num_threads$$ less than two.
+The team is not used when there is only one block,
+when $icode f$$ contains $cref atomic$$ function or $cref VecAD$$ operations,
+or when $code __cplusplus < 201100$$.
+This also applies to the older interface $cref RevSparseHes$$
+when its sparsity patterns are vectors of boolean values.
+See $cref sparsity_team.cpp$$ for an example.
+
 $head Example$$
 $children%
 	example/sparse/rev_hes_sparsity.cpp
@@ -124,6 +152,7 @@ $end
 */
 # include <cppad/core/ad_fun.hpp>
 # include <cppad/local/sparse_internal.hpp>
+# include <cppad/local/sweep/sparse_team.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 
@@ -150,6 +179,7 @@ Is the returned sparsity pattern transposed.
 \param internal_bool
 If this is true, calculations are done with sets represented by a vector
 of boolean values. Otherwise, a vector of standard sets is used.
+This is ignored when internal_sparsity_ is "hybrid".
 
 \param pattern_out
 The value of transpose is false (true),
@@ -185,8 +215,40 @@ void ADFun<Base>::rev_hes_sparsity(
 	for(size_t i = 0; i < m; i++)
 		rev_jac_pattern[ dep_taddr_[i] ] = select_range[i];
 	//
+	// use the representation chosen by the previous for_jac_sparsity
+	if( internal_sparsity_ == "auto" )
+		internal_bool = for_jac_sparse_pack_.n_set() > 0;
 	//
-	if( internal_bool )
+	if( internal_sparsity_ == "hybrid" )
+	{	CPPAD_ASSERT_KNOWN(
+			for_jac_sparse_hybrid_.n_set() > 0,
+			"rev_hes_sparsity: previous call to for_jac_sparsity did not "
+			"use hybrid for interanl sparsity patterns."
+		);
+		// column dimension of internal sparstiy pattern
+		size_t ell = for_jac_sparse_hybrid_.end();
+		//
+		// allocate memory for hybrid sparsity calculation
+		// (sparsity pattern is emtpy after a resize)
+		local::sparse_hybrid internal_hes;
+		internal_hes.resize(num_var_tape_, ell);
+		//
+		// compute the Hessian sparsity pattern
+		local::sweep::rev_hes<addr_t>(
+			&play_,
+			n,
+			num_var_tape_,
+			for_jac_sparse_hybrid_,
+			rev_jac_pattern.data(),
+			internal_hes
+
+		);
+		// get sparstiy pattern for independent variables
+		local::get_internal_sparsity(
+			transpose, ind_taddr_, internal_hes, pattern_out
+		);
+	}
+	else if( internal_bool )
 	{	CPPAD_ASSERT_KNOWN(
 			for_jac_sparse_pack_.n_set() > 0,
 			"rev_hes_sparsity: previous call to for_jac_sparsity did not "
@@ -201,14 +263,26 @@ void ADFun<Base>::rev_hes_sparsity(
 		internal_hes.resize(num_var_tape_, ell);
 		//
 		// compute the Hessian sparsity pattern
-		local::sweep::rev_hes<addr_t>(
+		bool done = false;
+		if( parallel_sweep_ > 1 ) done = local::sweep::rev_hes_team<addr_t>(
+			&play_,
+			n,
+			num_var_tape_,
+			ind_taddr_,
+			for_jac_sparse_pack_,
+			rev_jac_pattern.data(),
+			parallel_sweep_,
+			sparse_team_block_,
+			sparse_team_rev_jac_,
+			internal_hes
+		);
+		if( ! done ) local::sweep::rev_hes<addr_t>(
 			&play_,
 			n,
 			num_var_tape_,
 			for_jac_sparse_pack_,
 			rev_jac_pattern.data(),
 			internal_hes
-
 		);
 		// get sparstiy pattern for independent variables
 		local::get_internal_sparsity(
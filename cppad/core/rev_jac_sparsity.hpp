@@ -14,6 +14,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 /*
 $begin rev_jac_sparsity$$
 $spell
+	cplusplus
 	Jacobian
 	jac
 	bool
@@ -85,6 +86,10 @@ see $cref/pattern_out/rev_jac_sparsity/pattern_out/$$ below.
 $head internal_bool$$
 If this is true, calculations are done with sets represented by a vector
 of boolean values. Otherwise, a vector of sets of integers is used.
+This argument is ignored when
+$cref/internal_sparsity/internal_sparsity/name/hybrid/$$ is $code "hybrid"$$
+and it is chosen automatically when it is
+$cref/auto/internal_sparsity/name/auto/$$.
 
 $head pattern_out$$
 This argument has prototype
@@ -106,6 +111,27 @@ In this case, $icode pattern_out$$ is a sparsity pattern for
 $latex F^{(1)} ( x )$$  ( $latex F^{(1)} (x)^\R{T}$$ )
 if $icode transpose$$ is false (true).
 
+$head Parallel$$
+If $icode%f%.parallel_sweep()%$$ is greater than one
+and $icode internal_bool$$ is true,
+the $latex q$$ rows of $latex R$$ are split into blocks
+and the blocks are split between a team of
+$cref/parallel_sweep/parallel_sweep/$$ threads.
+Each thread does a complete sweep for its block using its own
+vector of boolean values.
+The memory for these vectors is kept in $icode f$$
+and reused by the next sparsity calculation that uses a team.
+It is freed when the operation sequence in $icode f$$ changes
+(e.g., by $cref optimize$$)
+and when $icode%f%.parallel_sweep(%num_threads%)%$$ is called
+with $icode num_threads$$ less than two.
+The team is not used when there is only one block,
+when $icode f$$ contains $cref atomic$$ function or $cref VecAD$$ operations,
+or when $code __cplusplus < 201100$$.
+This also applies to the older interface $cref RevSparseJac$$
+when its sparsity patterns are vectors of boolean values.
+See $cref sparsity_team.cpp$$ for an example.
+
 $head Example$$
 $children%
 	example/sparse/rev_jac_sparsity.cpp
@@ -120,6 +146,7 @@ $end
 */
 # include <cppad/core/ad_fun.hpp>
 # include <cppad/local/sparse_internal.hpp>
+# include <cppad/local/sweep/sparse_team.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 
@@ -150,6 +177,7 @@ This is used by the optimizer to obtain the correct dependency relations.
 \param internal_bool
 If this is true, calculations are done with sets represented by a vector
 of boolean values. Otherwise, a vector of standard sets is used.
+This is ignored when internal_sparsity_ is "hybrid".
 
 \param pattern_out
 The value of transpose is false (true),
@@ -185,9 +213,43 @@ void ADFun<Base>::rev_jac_sparsity(
 	// number of independent variables
 	size_t n = Domain();
 	//
+	if( internal_sparsity_ == "auto" )
+	{	internal_bool = internal_sparsity_auto(
+			"rev_jac_sparsity", false, dependency, ! transpose, pattern_in
+		);
+	}
 	bool zero_empty  = true;
 	bool input_empty = true;
-	if( internal_bool )
+	if( internal_sparsity_ == "hybrid" )
+	{	// allocate memory for hybrid sparsity calculation
+		// (sparsity pattern is emtpy after a resize)
+		local::sparse_hybrid internal_jac;
+		internal_jac.resize(num_var_tape_, ell);
+		//
+		// set sparsity patttern for dependent variables
+		local::set_internal_sparsity(
+			zero_empty            ,
+			input_empty           ,
+			! transpose           ,
+			dep_taddr_            ,
+			internal_jac          ,
+			pattern_in
+		);
+
+		// compute sparsity for other variables
+		local::sweep::rev_jac<addr_t>(
+			&play_,
+			dependency,
+			n,
+			num_var_tape_,
+			internal_jac
+		);
+		// get sparstiy pattern for independent variables
+		local::get_internal_sparsity(
+			! transpose, ind_taddr_, internal_jac, pattern_out
+		);
+	}
+	else if( internal_bool )
 	{	// allocate memory for bool sparsity calculation
 		// (sparsity pattern is emtpy after a resize)
 		local::sparse_pack internal_jac;
@@ -204,7 +266,19 @@ void ADFun<Base>::rev_jac_sparsity(
 		);
 
 		// compute sparsity for other variables
-		local::sweep::rev_jac<addr_t>(
+		bool done = false;
+		if( parallel_sweep_ > 1 ) done = local::sweep::rev_jac_team<addr_t>(
+			&play_,
+			dependency,
+			n,
+			num_var_tape_,
+			ind_taddr_,
+			dep_taddr_,
+			parallel_sweep_,
+			sparse_team_block_,
+			internal_jac
+		);
+		if( ! done ) local::sweep::rev_jac<addr_t>(
 			&play_,
 			dependency,
 			n,
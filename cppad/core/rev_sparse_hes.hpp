@@ -192,6 +192,7 @@ $end
 # include <algorithm>
 # include <cppad/local/pod_vector.hpp>
 # include <cppad/local/std_set.hpp>
+# include <cppad/local/sweep/sparse_team.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -275,7 +276,20 @@ void ADFun<Base>::RevSparseHesCase(
 	rev_hes_pattern.resize(num_var_tape_, q);
 
 	// compute the Hessian sparsity patterns
-	local::sweep::rev_hes<addr_t>(
+	bool done = false;
+	if( parallel_sweep_ > 1 ) done = local::sweep::rev_hes_team<addr_t>(
+		&play_,
+		n,
+		num_var_tape_,
+		ind_taddr_,
+		for_jac_sparse_pack_,
+		RevJac.data(),
+		parallel_sweep_,
+		sparse_team_block_,
+		sparse_team_rev_jac_,
+		rev_hes_pattern
+	);
+	if( ! done ) local::sweep::rev_hes<addr_t>(
 		&play_,
 		n,
 		num_var_tape_,
@@ -171,6 +171,7 @@ $end
 */
 
 # include <cppad/local/std_set.hpp>
+# include <cppad/local/sweep/sparse_team.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -257,7 +258,19 @@ void ADFun<Base>::RevSparseJacCase(
 		var_sparsity.process_post( dep_taddr_[i] );
 
 	// evaluate the sparsity patterns
-	local::sweep::rev_jac<addr_t>(
+	bool done = false;
+	if( parallel_sweep_ > 1 ) done = local::sweep::rev_jac_team<addr_t>(
+		&play_,
+		dependency,
+		n,
+		num_var_tape_,
+		ind_taddr_,
+		dep_taddr_,
+		parallel_sweep_,
+		sparse_team_block_,
+		var_sparsity
+	);
+	if( ! done ) local::sweep::rev_jac<addr_t>(
 		&play_,
 		dependency,
 		n,
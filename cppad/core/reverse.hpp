@@ -155,20 +155,39 @@ VectorBase ADFun<Base>::Reverse(size_t q, const VectorBase &w)
 	// evaluate the derivatives
 	CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_.num_op_rec() );
 	CPPAD_ASSERT_UNKNOWN( load_op_.size()  == play_.num_load_op_rec() );
-	local::play::const_sequential_iterator play_itr = play_.end();
-	local::sweep::reverse(
-		q - 1,
-		n,
-		num_var_tape_,
-		&play_,
-		cap_order_taylor_,
-		taylor_.data(),
-		q,
-		Partial.data(),
-		cskip_op_.data(),
-		load_op_,
-		play_itr
-	);
+	bool done = false;
+	if( parallel_sweep_ > 1 )
+	{	// level schedule (only computed once for each recording)
+		local::sweep::level_schedule_setup(&play_);
+		done = local::sweep::reverse_level(
+			q - 1,
+			n,
+			num_var_tape_,
+			&play_,
+			cap_order_taylor_,
+			taylor_.data(),
+			q,
+			Partial.data(),
+			cskip_op_.data(),
+			parallel_sweep_
+		);
+	}
+	if( ! done )
+	{	local::play::const_sequential_iterator play_itr = play_.end();
+		local::sweep::reverse(
+			q - 1,
+			n,
+			num_var_tape_,
+			&play_,
+			cap_order_taylor_,
+			taylor_.data(),
+			q,
+			Partial.data(),
+			cskip_op_.data(),
+			load_op_,
+			play_itr
+		);
+	}
 
 	// return the derivative values
 	VectorBase value(n * q);
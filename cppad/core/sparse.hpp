@@ -13,6 +13,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 -------------------------------------------------------------------------- */
 
 //
+# include <cppad/core/internal_sparsity.hpp>
 # include <cppad/core/for_jac_sparsity.hpp>
 # include <cppad/core/rev_jac_sparsity.hpp>
 //
@@ -27,6 +28,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 //
 # include <cppad/core/sparse_jac.hpp>
 # include <cppad/core/sparse_hes.hpp>
+# include <cppad/core/sparse_cache.hpp>
 //
 # include <cppad/core/sparse_jacobian.hpp>
 # include <cppad/core/sparse_hessian.hpp>
@@ -0,0 +1,491 @@
+# ifndef CPPAD_CORE_SPARSE_CACHE_HPP
+# define CPPAD_CORE_SPARSE_CACHE_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin sparse_cache$$
+$spell
+	const
+	std
+	bool
+	jac
+	hes
+	rc
+	Jacobian
+$$
+
+$section Saving Sparsity Patterns and Coloring for Later Use$$
+
+$head Syntax$$
+$icode%f%.sparse_cache_store(%name%, %value%)
+%$$
+$icode%found% = %f%.sparse_cache_find(%name%, %value%)
+%$$
+$icode%f%.sparse_cache_to_file(%file_name%)
+%$$
+$icode%found% = %f%.sparse_cache_from_file(%file_name%)
+%$$
+$icode%f%.sparse_cache_clear()
+%$$
+
+$head Purpose$$
+Computing a sparsity pattern, and the coloring that
+$cref sparse_jac$$ and $cref sparse_hes$$ store in their $icode work$$
+argument, can take longer than computing the sparse derivative.
+These routines save the patterns and $icode work$$ structures
+with the function object $icode f$$
+and save them in a file so that a later program,
+using the same operation sequence, can skip these calculations.
+Nothing is saved unless $code sparse_cache_store$$ is used.
+
+$head f$$
+For $code sparse_cache_find$$ and $code sparse_cache_to_file$$
+the object $icode f$$ has prototype
+$codei%
+	const ADFun<%Base%> %f%
+%$$
+For the other syntaxes it has prototype
+$codei%
+	ADFun<%Base%> %f%
+%$$
+The information stored in $icode f$$ is removed when
+its operation sequence changes; e.g., by
+$cref Dependent$$, $cref from_file$$, or $cref optimize$$.
+It is not removed by $cref new_dynamic$$ because sparsity patterns
+do not depend on the value of the dynamic parameters.
+The information is copied by the $cref/assignment/FunConstruct/$$
+operator.
+
+$head name$$
+This argument has prototype
+$codei%
+	const std::string& %name%
+%$$
+It identifies the information; e.g., $code "jacobian"$$.
+If $code sparse_cache_store$$ is used twice with the same $icode name$$,
+the second value replaces the first.
+
+$head value$$
+The argument $icode value$$ has one of the following prototypes
+$codei%
+	sparse_rc<%SizeVector%>& %value%
+	sparse_jac_work&       %value%
+	sparse_hes_work&       %value%
+%$$
+where $icode SizeVector$$ is a $cref SimpleVector$$ class with
+elements of type $code size_t$$.
+For $code sparse_cache_store$$ it is $code const$$
+and its value is stored in $icode f$$ with the specified $icode name$$.
+For $code sparse_cache_find$$, if $icode found$$ is true,
+$icode value$$ is set to the value that was stored with this name.
+Otherwise it is not changed.
+
+$head found$$
+The return value $icode found$$ has prototype
+$codei%
+	bool %found%
+%$$
+For $code sparse_cache_find$$ it is true if a value with the same
+$icode name$$ and type as $icode value$$ is stored in $icode f$$.
+For $code sparse_cache_from_file$$ it is true if the file was read.
+
+$head file_name$$
+This argument has prototype
+$codei%
+	const std::string& %file_name%
+%$$
+
+$subhead sparse_cache_to_file$$
+All of the information stored in $icode f$$ is written to this file,
+together with a hash code for the structure of the operation sequence in
+$icode f$$; i.e., the operators, their arguments, and the independent
+and dependent variables (but not the value of the parameters).
+The information is first written to a temporary file,
+in the same directory, that is then renamed to $icode file_name$$.
+Thus another program, that is reading $icode file_name$$ at the same time,
+sees either the previous file or the new one.
+If the file cannot be written, an $cref/error/ErrorHandler/$$ is generated.
+
+$subhead sparse_cache_from_file$$
+The information stored in $icode f$$ is replaced by the information in this
+file.
+If the file does not exist, or it was written for a function with a
+different hash code, or by a different version of CppAD,
+or it is not in the expected format (e.g., it is truncated),
+$icode found$$ is false and the information in $icode f$$ is not changed.
+This computes the hash code and so it requires
+a pass through the operation sequence.
+
+$children%
+	example/sparse/sparse_cache.cpp
+%$$
+$head Example$$
+The file $cref sparse_cache.cpp$$
+contains an example and test of this operation.
+It returns true if it succeeds and false otherwise.
+
+$end
+*/
+# include <cstdio>
+# include <cstring>
+# include <fstream>
+# include <sstream>
+# include <cppad/configure.hpp>
+# include <cppad/core/sparse_jac.hpp>
+# include <cppad/core/sparse_hes.hpp>
+
+# if CPPAD_HAS_MKSTEMP
+# include <stdlib.h>
+# include <unistd.h>
+# endif
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file core/sparse_cache.hpp
+Save sparsity patterns and coloring information for later use.
+*/
+
+/// version number for the file format used by ADFun::sparse_cache_to_file
+# define CPPAD_SPARSE_CACHE_VERSION 2
+
+/*!
+Hash code for the structure of the operation sequence.
+
+\return
+is a hash code for the player structure (see player::structure_hash),
+the independent variable addresses, and the dependent variable addresses.
+It does not depend on the value of the parameters.
+*/
+template <class Base>
+size_t ADFun<Base>::structure_hash(void) const
+{	size_t code = play_.structure_hash();
+	code = local::play::binary_hash(
+		code, ind_taddr_.size(), ind_taddr_.data()
+	);
+	code = local::play::binary_hash(
+		code, dep_taddr_.size(), dep_taddr_.data()
+	);
+	size_t m = dep_parameter_.size();
+	local::pod_vector<bool> dep_parameter(m);
+	for(size_t i = 0; i < m; ++i)
+		dep_parameter[i] = dep_parameter_[i];
+	code = local::play::binary_hash(code, m, dep_parameter.data() );
+	return code;
+}
+// ----------------------------------------------------------------------------
+/*!
+Store a sparsity pattern.
+
+\param name
+is the name for this pattern.
+
+\param pattern
+is the sparsity pattern.
+*/
+template <class Base>
+template <class SizeVector>
+void ADFun<Base>::sparse_cache_store(
+	const std::string&           name    ,
+	const sparse_rc<SizeVector>& pattern )
+{	size_t nnz = pattern.nnz();
+	CppAD::vector<size_t> vec[3];
+	vec[0].resize(2);
+	vec[0][0] = pattern.nr();
+	vec[0][1] = pattern.nc();
+	vec[1].resize(nnz);
+	vec[2].resize(nnz);
+	for(size_t k = 0; k < nnz; ++k)
+	{	vec[1][k] = pattern.row()[k];
+		vec[2][k] = pattern.col()[k];
+	}
+	sparse_cache_.store(name, local::sparse_cache::pattern_kind, 3, vec);
+}
+/*!
+Store a sparse Jacobian work structure.
+
+\param name
+is the name for this work structure.
+
+\param work
+is the work structure.
+*/
+template <class Base>
+void ADFun<Base>::sparse_cache_store(
+	const std::string&      name  ,
+	const sparse_jac_work&  work  )
+{	CppAD::vector<size_t> vec[2];
+	vec[0] = work.order;
+	vec[1] = work.color;
+	sparse_cache_.store(name, local::sparse_cache::jac_work_kind, 2, vec);
+}
+/*!
+Store a sparse Hessian work structure.
+
+\param name
+is the name for this work structure.
+
+\param work
+is the work structure.
+*/
+template <class Base>
+void ADFun<Base>::sparse_cache_store(
+	const std::string&      name  ,
+	const sparse_hes_work&  work  )
+{	CppAD::vector<size_t> vec[7];
+	vec[0] = work.row;
+	vec[1] = work.col;
+	vec[2] = work.order;
+	vec[3] = work.color;
+	vec[4] = work.subset_entry;
+	vec[5] = work.substitute_ptr;
+	vec[6] = work.substitute;
+	sparse_cache_.store(name, local::sparse_cache::hes_work_kind, 7, vec);
+}
+// ----------------------------------------------------------------------------
+/*!
+Find a sparsity pattern.
+
+\param name
+is the name for this pattern.
+
+\param pattern [out]
+If the return value is true, this is set to the pattern that was stored
+with this name. Otherwise, it is not changed.
+
+\return
+is true if a sparsity pattern is stored with this name.
+*/
+template <class Base>
+template <class SizeVector>
+bool ADFun<Base>::sparse_cache_find(
+	const std::string&      name    ,
+	sparse_rc<SizeVector>&  pattern ) const
+{	CppAD::vector<size_t> vec[3];
+	if( ! sparse_cache_.find(
+		name, local::sparse_cache::pattern_kind, 3, vec
+	) ) return false;
+	if( vec[0].size() != 2 || vec[1].size() != vec[2].size() )
+		return false;
+	size_t nr  = vec[0][0];
+	size_t nc  = vec[0][1];
+	size_t nnz = vec[1].size();
+	for(size_t k = 0; k < nnz; ++k)
+	{	if( vec[1][k] >= nr || vec[2][k] >= nc )
+			return false;
+	}
+	pattern.resize(nr, nc, nnz);
+	for(size_t k = 0; k < nnz; ++k)
+		pattern.set(k, vec[1][k], vec[2][k]);
+	return true;
+}
+/*!
+Find a sparse Jacobian work structure.
+
+\param name
+is the name for this work structure.
+
+\param work [out]
+If the return value is true, this is set to the work structure that was
+stored with this name. Otherwise, it is not changed.
+
+\return
+is true if a sparse Jacobian work structure is stored with this name.
+*/
+template <class Base>
+bool ADFun<Base>::sparse_cache_find(
+	const std::string&  name  ,
+	sparse_jac_work&    work  ) const
+{	CppAD::vector<size_t> vec[2];
+	if( ! sparse_cache_.find(
+		name, local::sparse_cache::jac_work_kind, 2, vec
+	) ) return false;
+	work.clear();
+	work.order = vec[0];
+	work.color = vec[1];
+	return true;
+}
+/*!
+Find a sparse Hessian work structure.
+
+\param name
+is the name for this work structure.
+
+\param work [out]
+If the return value is true, this is set to the work structure that was
+stored with this name. Otherwise, it is not changed.
+
+\return
+is true if a sparse Hessian work structure is stored with this name.
+*/
+template <class Base>
+bool ADFun<Base>::sparse_cache_find(
+	const std::string&  name  ,
+	sparse_hes_work&    work  ) const
+{	CppAD::vector<size_t> vec[7];
+	if( ! sparse_cache_.find(
+		name, local::sparse_cache::hes_work_kind, 7, vec
+	) ) return false;
+	work.clear();
+	work.row            = vec[0];
+	work.col            = vec[1];
+	work.order          = vec[2];
+	work.color          = vec[3];
+	work.subset_entry   = vec[4];
+	work.substitute_ptr = vec[5];
+	work.substitute     = vec[6];
+	return true;
+}
+// ----------------------------------------------------------------------------
+/*!
+Write the sparse cache for this ADFun object to a binary file.
+
+\param file_name
+is the name of the file we are writing.
+
+\par Format
+The file is a sequence of sections (see local::play::binary_write).
+The first section is the characters "CppAD sparse cache".
+The next section is the file version, sizeof(size_t), and structure_hash().
+This is followed by the sections for local::sparse_cache::to_binary.
+
+\par Temporary File
+The sections are written to a temporary file in the same directory
+which is then renamed to file_name. Thus a reader never sees a partially
+written file.
+*/
+template <class Base>
+void ADFun<Base>::sparse_cache_to_file(const std::string& file_name) const
+{	//
+	// tmp_name: unique name for the temporary file
+	std::string tmp_name = file_name + ".XXXXXX";
+# if CPPAD_HAS_MKSTEMP
+	CppAD::vector<char> pattern( tmp_name.size() + 1 );
+	std::strcpy( pattern.data(), tmp_name.c_str() );
+	int fd = mkstemp( pattern.data() );
+	if( fd >= 0 )
+	{	close(fd);
+		tmp_name = pattern.data();
+	}
+# else
+	std::ostringstream unique;
+	unique << file_name << "." << this << ".tmp";
+	tmp_name = unique.str();
+# endif
+	std::ofstream os(tmp_name.c_str(), std::ios::out | std::ios::binary);
+	if( ! os )
+	{	std::string msg = "f.sparse_cache_to_file: cannot open " + tmp_name;
+		ErrorHandler::Call(true, __LINE__, __FILE__, "os", msg.c_str() );
+		return;
+	}
+	//
+	// magic
+	const char* magic = "CppAD sparse cache";
+	local::play::binary_write(os, std::strlen(magic), magic);
+	//
+	// info
+	size_t info[3];
+	info[0] = CPPAD_SPARSE_CACHE_VERSION;
+	info[1] = sizeof(size_t);
+	info[2] = structure_hash();
+	local::play::binary_write(os, 3, info);
+	//
+	// sparse_cache_
+	sparse_cache_.to_binary(os);
+	//
+	os.close();
+	if( ! os )
+	{	std::remove( tmp_name.c_str() );
+		std::string msg = "f.sparse_cache_to_file: error writing " + tmp_name;
+		ErrorHandler::Call(true, __LINE__, __FILE__, "os", msg.c_str() );
+		return;
+	}
+	//
+	// move the file into place
+	// (on some systems rename does not replace an existing file)
+	bool ok = std::rename( tmp_name.c_str(), file_name.c_str() ) == 0;
+	if( ! ok )
+	{	std::remove( file_name.c_str() );
+		ok = std::rename( tmp_name.c_str(), file_name.c_str() ) == 0;
+	}
+	if( ! ok )
+	{	std::remove( tmp_name.c_str() );
+		std::string msg = "f.sparse_cache_to_file: cannot create " + file_name;
+		ErrorHandler::Call(true, __LINE__, __FILE__, "ok", msg.c_str() );
+	}
+	return;
+}
+/*!
+Replace the sparse cache for this ADFun object by one in a binary file.
+
+\param file_name
+is the name of the file we are reading.
+It must have been written by ADFun::sparse_cache_to_file.
+
+\return
+is false, and the sparse cache is not changed, if the file does not exist,
+or it was written for a different version or structure_hash(),
+or it is not in the format written by sparse_cache_to_file.
+*/
+template <class Base>
+bool ADFun<Base>::sparse_cache_from_file(const std::string& file_name)
+{	//
+	// buffer
+	std::ifstream is(
+		file_name.c_str(), std::ios::in | std::ios::binary | std::ios::ate
+	);
+	if( ! is )
+		return false;
+	local::pod_vector<char> buffer;
+	size_t size = size_t( is.tellg() );
+	buffer.resize(size);
+	is.seekg(0, std::ios::beg);
+	if( size > 0 )
+		is.read(buffer.data(), std::streamsize(size) );
+	if( ! is || size == 0 )
+		return false;
+	const char* ptr = buffer.data();
+	const char* end = ptr + size;
+	//
+	// magic
+	local::pod_vector<char> magic;
+	bool ok_file = local::play::binary_read(ptr, end, true, magic);
+	ok_file     &= magic.size() == std::strlen("CppAD sparse cache");
+	if( ok_file ) ok_file = std::strncmp(
+		magic.data(), "CppAD sparse cache", magic.size()
+	) == 0;
+	//
+	// info
+	local::pod_vector<size_t> info;
+	if( ok_file )
+	{	ok_file  = local::play::binary_read(ptr, end, true, info);
+		ok_file &= info.size() == 3;
+	}
+	if( ! ok_file )
+		return false;
+	// a file for a different version or operation sequence
+	if( info[0] != CPPAD_SPARSE_CACHE_VERSION || info[1] != sizeof(size_t) )
+		return false;
+	if( info[2] != structure_hash() )
+		return false;
+	//
+	// sparse_cache_
+	local::sparse_cache cache;
+	if( ! cache.from_binary(ptr, end) )
+		return false;
+	sparse_cache_ = cache;
+	return true;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# undef CPPAD_SPARSE_CACHE_VERSION
+# endif
@@ -26,6 +26,9 @@ $spell
 	colpack
 	cmake
 	Jacobian
+	cplusplus
+	acyclic
+	tri
 $$
 
 $section Computing Sparse Hessians$$
@@ -151,6 +154,44 @@ $subhead cppad.general$$
 This is the same as the sparse Jacobian
 $cref/cppad/sparse_jac/coloring/cppad/$$ method
 which does not take advantage of symmetry.
+The names $code cppad.general.smallest_last$$,
+$code cppad.general.incidence_degree$$,
+$code cppad.general.saturation_degree$$, and
+$code cppad.general.parallel$$ correspond to the
+$cref/cppad.smallest_last/sparse_jac/coloring/cppad.smallest_last/$$,
+$cref/cppad.incidence_degree/sparse_jac/coloring/cppad.incidence_degree/$$,
+$cref/cppad.saturation_degree/sparse_jac/coloring/cppad.saturation_degree/$$, and
+$cref/cppad.parallel/sparse_jac/coloring/cppad.parallel/$$
+sparse Jacobian methods.
+
+$subhead cppad.star$$
+This is a star coloring; i.e.,
+every path of four rows (columns) in the graph for the Hessian
+uses at least three colors.
+Each element of the Hessian is the value for one row
+in the sum of the columns with one color
+(as is the case for $code cppad.symmetric$$).
+This method does not require $cref colpack_prefix$$.
+
+$subhead cppad.acyclic$$
+This is an acyclic coloring; i.e.,
+every cycle in the graph for the Hessian uses at least three colors.
+This often uses fewer colors than a star coloring;
+e.g., a tri-diagonal Hessian requires two colors.
+All of the elements in $icode pattern$$ are computed
+by subtracting values that are already known from sums of columns
+(starting at the leaves of the trees corresponding to each pair of colors).
+The elements in $icode subset$$ are then copied from these values.
+This requires more memory and is subject to more round off error
+than the direct methods above.
+This method does not require $cref colpack_prefix$$.
+
+$subhead Star and Acyclic Pattern$$
+If $icode coloring$$ is $code cppad.star$$ or $code cppad.acyclic$$,
+every possibly non-zero element of the Hessian must be in
+$icode pattern$$, or its transpose; i.e.,
+the $cref/subset/sparse_hes/pattern/subset/$$ discussion
+under $icode pattern$$ does not apply.
 
 $subhead colpack.symmetric$$
 If $cref colpack_prefix$$ was specified on the
@@ -204,6 +245,22 @@ This is proportional to the total computational work,
 not counting the zero order forward sweep,
 or combining multiple columns and rows into a single sweep.
 
+$head Parallel$$
+If $icode%f%.parallel_sweep()%$$ is greater than one,
+the forward and reverse sweeps for different colors are split between
+a team of $cref/parallel_sweep/parallel_sweep/$$ threads.
+Each thread does complete sweeps using its own
+Taylor coefficient and partial derivative workspace,
+and the results are stored in $icode subset$$ after the team is done
+(so the results do not depend on the number of threads).
+Each thread uses memory proportional to four times the number of
+variables in $icode f$$; see
+$cref/size_var/seq_property/size_var/$$.
+The team is not used when there is only one color,
+when $icode f$$ contains $cref atomic$$ function operations,
+or when $code __cplusplus < 201100$$.
+In these cases, the sweeps are done by the current thread.
+
 $head Uses Forward$$
 After each call to $cref Forward$$,
 the object $icode f$$ contains the corresponding
@@ -217,11 +274,14 @@ All the other forward mode coefficients are unspecified.
 
 $head Example$$
 $children%
-	example/sparse/sparse_hes.cpp
+	example/sparse/sparse_hes.cpp%
+	example/sparse/sparse_hes_team.cpp
 %$$
 The files $cref sparse_hes.cpp$$
 is an example and test of $code sparse_hes$$.
-It returns $code true$$, if it succeeds, and $code false$$ otherwise.
+The file $cref sparse_hes_team.cpp$$ is an example and test that
+uses a team of threads for the sweeps.
+They return $code true$$, if they succeed, and $code false$$ otherwise.
 
 $head Subset Hessian$$
 The routine
@@ -235,6 +295,8 @@ $end
 # include <cppad/local/sparse_internal.hpp>
 # include <cppad/local/color_general.hpp>
 # include <cppad/local/color_symmetric.hpp>
+# include <cppad/local/color_star.hpp>
+# include <cppad/local/sweep/color_team.hpp>
 
 /*!
 \file sparse_hes.hpp
@@ -256,6 +318,15 @@ class sparse_hes_work {
 		CppAD::vector<size_t> order;
 		/// results of the coloring algorithm
 		CppAD::vector<size_t> color;
+		/// index in row, col for each subset element
+		/// (only used by substitution coloring algorithms)
+		CppAD::vector<size_t> subset_entry;
+		/// start of the values subtracted from each row, col entry
+		/// (only used by substitution coloring algorithms)
+		CppAD::vector<size_t> substitute_ptr;
+		/// row, col entries that are subtracted
+		/// (only used by substitution coloring algorithms)
+		CppAD::vector<size_t> substitute;
 
 		/// constructor
 		sparse_hes_work(void)
@@ -267,6 +338,9 @@ class sparse_hes_work {
 			col.clear();
 			order.clear();
 			color.clear();
+			subset_entry.clear();
+			substitute_ptr.clear();
+			substitute.clear();
 		}
 };
 // ----------------------------------------------------------------------------
@@ -303,8 +377,8 @@ where m is number of dependent variables in f.
 
 \param coloring
 determines which coloring algorithm is used.
-This must be cppad.symmetric, cppad.general, colpack.symmetic,
-or colpack.star.
+This must be cppad.symmetric, cppad.general, cppad.star, cppad.acyclic,
+colpack.symmetic, or colpack.star.
 
 \param work
 this structure must be empty, or contain the information stored
@@ -349,6 +423,9 @@ size_t ADFun<Base>::sparse_hes(
 	vector<size_t>& col(work.col);
 	vector<size_t>& color(work.color);
 	vector<size_t>& order(work.order);
+	vector<size_t>& subset_entry(work.subset_entry);
+	vector<size_t>& substitute_ptr(work.substitute_ptr);
+	vector<size_t>& substitute(work.substitute);
 	//
 	// subset information
 	const SizeVector& subset_row( subset.row() );
@@ -366,7 +443,17 @@ size_t ADFun<Base>::sparse_hes(
 		return 0;
 	//
 # ifndef NDEBUG
-	if( color.size() != 0 )
+	if( color.size() != 0 && subset_entry.size() != 0 )
+	{	CPPAD_ASSERT_KNOWN(
+			color.size() == n,
+			"sparse_hes: work is non-empty and conditions have changed"
+		);
+		CPPAD_ASSERT_KNOWN(
+			subset_entry.size() == K,
+			"sparse_hes: work is non-empty and conditions have changed"
+		);
+	}
+	else if( color.size() != 0 )
 	{	CPPAD_ASSERT_KNOWN(
 			color.size() == n,
 			"sparse_hes: work is non-empty and conditions have changed"
@@ -429,10 +516,22 @@ size_t ADFun<Base>::sparse_hes(
 		// execute coloring algorithm
 		// (we are using transpose becasue coloring groups rows, not columns)
 		color.resize(n);
-		if( coloring == "cppad.general" )
-			local::color_general_cppad(internal_pattern, col, row, color);
+		local::color_general_order color_order;
+		if( local::color_general_name(coloring, "cppad.general", color_order) )
+		{	local::color_general_cppad(
+				internal_pattern, col, row, color, color_order,
+				std::max(parallel_sweep_, size_t(1))
+			);
+		}
 		else if( coloring == "cppad.symmetric" )
 			local::color_symmetric_cppad(internal_pattern, col, row, color);
+		else if( coloring == "cppad.star" )
+			local::color_star_cppad(internal_pattern, col, row, color);
+		else if( coloring == "cppad.acyclic" )
+		{	local::color_acyclic_cppad(internal_pattern, col, row, color,
+				subset_entry, substitute_ptr, substitute
+			);
+		}
 		else if( coloring == "colpack.general" )
 		{
 # if CPPAD_HAS_COLPACK
@@ -466,12 +565,15 @@ size_t ADFun<Base>::sparse_hes(
 		);
 		//
 		// put sorting indices in color order
-		SizeVector key(K);
-		order.resize(K);
-		for(size_t k = 0; k < K; k++)
+		SizeVector key( row.size() );
+		order.resize( row.size() );
+		for(size_t k = 0; k < row.size(); k++)
 			key[k] = color[ col[k] ];
 		index_sort(key, order);
 	}
+	// number of row, col entries that are computed
+	// (not equal to K when using substitution)
+	size_t n_entry = row.size();
 	// Base versions of zero and one
 	Base one(1.0);
 	Base zero(0.0);
@@ -484,57 +586,106 @@ size_t ADFun<Base>::sparse_hes(
 	for(size_t k = 0; k < K; k++)
 		subset.set(k, zero);
 	//
-	// direction vector for calls to first order forward
-	BaseVector dx(n);
+	// value of the row, col entries in color order
+	local::pod_vector_maybe<Base> value;
 	//
-	// return values for calls to second order reverse
-	BaseVector ddw(2 * n);
-	//
-	// loop over colors
-	size_t k = 0;
-	for(size_t ell = 0; ell < n_color; ell++)
-	if( k  == K )
-	{	// kludge because colpack returns colors that are not used
-		// (it does not know about the subset corresponding to row, col)
-		CPPAD_ASSERT_UNKNOWN(
-			coloring == "colpack.general" ||
-			coloring == "colpack.symmetric" ||
-			coloring == "colpack.star"
-		);
-	}
-	else if( color[ col[ order[k] ] ] != ell )
-	{	// kludge because colpack returns colors that are not used
-		// (it does not know about the subset corresponding to row, col)
-		CPPAD_ASSERT_UNKNOWN(
-			coloring == "colpack.general" ||
-			coloring == "colpack.symmetic" ||
-			coloring == "colpack.star"
+	// check for using a team of threads for the colors
+	bool done = false;
+	if( parallel_sweep_ > 1 )
+	{	done = local::sweep::hes_team(
+			&play_,
+			n,
+			Range(),
+			num_var_tape_,
+			cap_order_taylor_,
+			taylor_.data(),
+			cskip_op_.data(),
+			load_op_,
+			ind_taddr_,
+			dep_taddr_,
+			w,
+			color,
+			n_color,
+			col,
+			row,
+			order,
+			parallel_sweep_,
+			value
 		);
 	}
-	else
-	{	CPPAD_ASSERT_UNKNOWN( color[ col[ order[k] ] ] == ell );
+	if( ! done )
+	{	value.resize(n_entry);
 		//
-		// combine all columns with this color
-		for(size_t j = 0; j < n; j++)
-		{	dx[j] = zero;
-			if( color[j] == ell )
-				dx[j] = one;
-		}
-		// call forward mode for all these rows at once
-		Forward(1, dx);
+		// direction vector for calls to first order forward
+		BaseVector dx(n);
 		//
-		// evaluate derivative of w^T * F'(x) * dx
-		ddw = Reverse(2, w);
+		// return values for calls to second order reverse
+		BaseVector ddw(2 * n);
 		//
-		// set the corresponding components of the result
-		while( k < K && color[ col[order[k]] ] == ell )
-		{	size_t index = row[ order[k] ] * 2 + 1;
-			subset.set(order[k], ddw[index] );
-			k++;
+		// loop over colors
+		size_t k = 0;
+		for(size_t ell = 0; ell < n_color; ell++)
+		if( k  == n_entry )
+		{	// kludge because colpack returns colors that are not used
+			// (it does not know about the subset corresponding to row, col)
+			CPPAD_ASSERT_UNKNOWN(
+				coloring == "colpack.general" ||
+				coloring == "colpack.symmetric" ||
+				coloring == "colpack.star"
+			);
 		}
+		else if( color[ col[ order[k] ] ] != ell )
+		{	// kludge because colpack returns colors that are not used
+			// (it does not know about the subset corresponding to row, col)
+			CPPAD_ASSERT_UNKNOWN(
+				coloring == "colpack.general" ||
+				coloring == "colpack.symmetic" ||
+				coloring == "colpack.star"
+			);
+		}
+		else
+		{	CPPAD_ASSERT_UNKNOWN( color[ col[ order[k] ] ] == ell );
+			//
+			// combine all columns with this color
+			for(size_t j = 0; j < n; j++)
+			{	dx[j] = zero;
+				if( color[j] == ell )
+					dx[j] = one;
+			}
+			// call forward mode for all these rows at once
+			Forward(1, dx);
+			//
+			// evaluate derivative of w^T * F'(x) * dx
+			ddw = Reverse(2, w);
+			//
+			// set the corresponding components of the result
+			while( k < n_entry && color[ col[order[k]] ] == ell )
+			{	size_t index = row[ order[k] ] * 2 + 1;
+				value[k] = ddw[index];
+				k++;
+			}
+		}
+		// check that all the required entries have been set
+		CPPAD_ASSERT_UNKNOWN( k == n_entry );
+	}
+	//
+	// case where each subset element is a row, col entry
+	if( subset_entry.size() == 0 )
+	{	for(size_t k = 0; k < K; k++)
+			subset.set( order[k], value[k] );
+		return n_color;
 	}
-	// check that all the required entries have been set
-	CPPAD_ASSERT_UNKNOWN( k == K );
+	//
+	// substitution: value of entries in row, col order
+	local::pod_vector_maybe<Base> entry(n_entry);
+	for(size_t k = 0; k < n_entry; k++)
+		entry[ order[k] ] = value[k];
+	for(size_t e = 0; e < n_entry; e++)
+	{	for(size_t ell = substitute_ptr[e]; ell < substitute_ptr[e+1]; ell++)
+			entry[e] -= entry[ substitute[ell] ];
+	}
+	for(size_t k = 0; k < K; k++)
+		subset.set( k, entry[ subset_entry[k] ] );
 	return n_color;
 }
 
@@ -27,6 +27,7 @@ $spell
 	cppad
 	cmake
 	colpack
+	cplusplus
 $$
 
 $section Sparse Hessian$$
@@ -286,6 +287,13 @@ $code size_t$$.
 The routine $cref CheckSimpleVector$$ will generate an error message
 if this is not the case.
 
+$head Parallel$$
+If $icode%f%.parallel_sweep()%$$ is greater than one,
+the sweeps for different colors are split between a team of threads
+in the same way as for $cref/sparse_hes/sparse_hes/Parallel/$$.
+The team is not used when $icode f$$ contains $cref atomic$$
+function operations or when $code __cplusplus < 201100$$.
+
 $head Uses Forward$$
 After each call to $cref Forward$$,
 the object $icode f$$ contains the corresponding
@@ -320,6 +328,7 @@ $end
 # include <cppad/local/std_set.hpp>
 # include <cppad/local/color_general.hpp>
 # include <cppad/local/color_symmetric.hpp>
+# include <cppad/local/sweep/color_team.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -537,6 +546,36 @@ size_t ADFun<Base>::SparseHessianCompute(
 	for(k = 0; k < K; k++)
 		hes[k] = zero;
 
+	// check for using a team of threads for the colors
+	if( parallel_sweep_ > 1 )
+	{	local::pod_vector_maybe<Base> value;
+		bool done = local::sweep::hes_team(
+			&play_,
+			n,
+			Range(),
+			num_var_tape_,
+			cap_order_taylor_,
+			taylor_.data(),
+			cskip_op_.data(),
+			load_op_,
+			ind_taddr_,
+			dep_taddr_,
+			w,
+			color,
+			n_color,
+			row,
+			col,
+			order,
+			parallel_sweep_,
+			value
+		);
+		if( done )
+		{	for(k = 0; k < K; k++)
+				hes[ order[k] ] = value[k];
+			return n_color;
+		}
+	}
+
 	// loop over colors
 # ifndef NDEBUG
 	const std::string& coloring = work.color_method;
@@ -27,6 +27,7 @@ $spell
 	Cppad
 	Colpack
 	cmake
+	cplusplus
 $$
 
 $section Computing Sparse Jacobians$$
@@ -145,6 +146,42 @@ after the $icode work$$ constructor or $icode%work%.clear()%$$.
 
 $subhead cppad$$
 This uses a general purpose coloring algorithm written for Cppad.
+It colors the columns (forward) or rows (reverse) in index order,
+giving each one the smallest color that is not used by a column (row)
+that it conflicts with.
+
+$subhead cppad.smallest_last$$
+This is the same as $code cppad$$ except that the columns (rows)
+are colored in smallest last order; i.e., the reverse of the order
+in which a column (row) with the fewest conflicts,
+among the columns (rows) that remain, is removed.
+
+$subhead cppad.incidence_degree$$
+This is the same as $code cppad$$ except that the next column (row)
+to color is one with the most conflicts with the columns (rows)
+that have already been colored.
+
+$subhead cppad.saturation_degree$$
+This is the same as $code cppad$$ except that the next column (row)
+to color is one whose conflicting columns (rows)
+use the most different colors.
+
+$subhead cppad.parallel$$
+This is the same as $code cppad$$ except that the columns (rows)
+are split between a team of
+$cref/parallel_sweep/parallel_sweep/$$ threads.
+Each thread colors its columns (rows) at the same time,
+without using the colors chosen by the other threads.
+The columns (rows) that conflict with a smaller column (row),
+colored by a different thread, are then colored again
+(until there are no conflicts).
+The result depends on $icode%f%.parallel_sweep()%$$,
+but not on the timing of the threads.
+If $icode%f%.parallel_sweep()%$$ is less than two,
+the result is the same as for $code cppad$$.
+This may use more colors than $code cppad$$.
+Each thread uses memory proportional to the number of colors
+plus the number of columns (rows) it colors.
 
 $subhead colpack$$
 If $cref colpack_prefix$$ is specified on the
@@ -184,6 +221,22 @@ This is proportional to the total computational work,
 not counting the zero order forward sweep,
 or combining multiple columns (rows) into a single sweep.
 
+$head Parallel$$
+If $icode%f%.parallel_sweep()%$$ is greater than one,
+the sweeps for different groups of colors (forward)
+or different colors (reverse) are split between a team of
+$cref/parallel_sweep/parallel_sweep/$$ threads.
+Each thread does complete sweeps using its own
+Taylor coefficient (forward) or partial derivative (reverse) workspace
+and the results are stored in $icode subset$$ after the team is done.
+Each thread uses memory proportional to $icode group_max$$ (forward)
+or one (reverse) times the number of variables in $icode f$$; see
+$cref/size_var/seq_property/size_var/$$.
+The team is not used when there is only one sweep,
+when $icode f$$ contains $cref atomic$$ function operations,
+or when $code __cplusplus < 201100$$.
+In these cases, the sweeps are done by the current thread.
+
 $head Uses Forward$$
 After each call to $cref Forward$$,
 the object $icode f$$ contains the corresponding
@@ -198,10 +251,13 @@ All the other forward mode coefficients are unspecified.
 $head Example$$
 $children%
 	example/sparse/sparse_jac_for.cpp%
-	example/sparse/sparse_jac_rev.cpp
+	example/sparse/sparse_jac_rev.cpp%
+	example/sparse/sparse_jac_team.cpp
 %$$
 The files $cref sparse_jac_for.cpp$$ and $cref sparse_jac_rev.cpp$$
 are examples and tests of $code sparse_jac_for$$ and $code sparse_jac_rev$$.
+The file $cref sparse_jac_team.cpp$$ is an example and test that
+uses a team of threads for the sweeps.
 They return $code true$$, if they succeed, and $code false$$ otherwise.
 
 $end
@@ -209,6 +265,7 @@ $end
 # include <cppad/core/cppad_assert.hpp>
 # include <cppad/local/sparse_internal.hpp>
 # include <cppad/local/color_general.hpp>
+# include <cppad/local/sweep/color_team.hpp>
 # include <cppad/utility/vector.hpp>
 
 /*!
@@ -271,7 +328,8 @@ where m is number of dependent variables in f.
 
 \param coloring
 determines which coloring algorithm is used.
-This must be cppad or colpack.
+This must be cppad, cppad.smallest_last, cppad.incidence_degree,
+cppad.saturation_degree, or colpack.
 
 \param work
 this structure must be empty, or contain the information stored
@@ -354,8 +412,13 @@ size_t ADFun<Base>::sparse_jac_for(
 		// execute coloring algorithm
 		// (we are using transpose because coloring groups rows, not columns).
 		color.resize(n);
-		if(	coloring == "cppad" )
-			local::color_general_cppad(pattern_transpose, col, row, color);
+		local::color_general_order color_order;
+		if(	local::color_general_name(coloring, "cppad", color_order) )
+		{	local::color_general_cppad(
+				pattern_transpose, col, row, color, color_order,
+				std::max(parallel_sweep_, size_t(1))
+			);
+		}
 		else if( coloring == "colpack" )
 		{
 # if CPPAD_HAS_COLPACK
@@ -392,6 +455,35 @@ size_t ADFun<Base>::sparse_jac_for(
 	for(size_t k = 0; k < K; k++)
 		subset.set(k, zero);
 	//
+	// check for using a team of threads for the groups of colors
+	if( parallel_sweep_ > 1 )
+	{	local::pod_vector_maybe<Base> value;
+		bool done = local::sweep::jac_for_team(
+			&play_,
+			n,
+			num_var_tape_,
+			cap_order_taylor_,
+			taylor_.data(),
+			cskip_op_.data(),
+			load_op_,
+			ind_taddr_,
+			dep_taddr_,
+			color,
+			n_color,
+			group_max,
+			row,
+			col,
+			order,
+			parallel_sweep_,
+			value
+		);
+		if( done )
+		{	for(size_t k = 0; k < K; k++)
+				subset.set( order[k], value[k] );
+			return n_color;
+		}
+	}
+	//
 	// index in subset
 	size_t k = 0;
 	// number of colors computed so far
@@ -465,7 +557,8 @@ where m is number of dependent variables in f.
 
 \param coloring
 determines which coloring algorithm is used.
-This must be cppad or colpack.
+This must be cppad, cppad.smallest_last, cppad.incidence_degree,
+cppad.saturation_degree, or colpack.
 
 \param work
 this structure must be empty, or contain the information stored
@@ -546,8 +639,13 @@ size_t ADFun<Base>::sparse_jac_rev(
 		//
 		// execute coloring algorithm
 		color.resize(m);
-		if(	coloring == "cppad" )
-			local::color_general_cppad(internal_pattern, row, col, color);
+		local::color_general_order color_order;
+		if(	local::color_general_name(coloring, "cppad", color_order) )
+		{	local::color_general_cppad(
+				internal_pattern, row, col, color, color_order,
+				std::max(parallel_sweep_, size_t(1))
+			);
+		}
 		else if( coloring == "colpack" )
 		{
 # if CPPAD_HAS_COLPACK
@@ -584,6 +682,35 @@ size_t ADFun<Base>::sparse_jac_rev(
 	for(size_t k = 0; k < K; k++)
 		subset.set(k, zero);
 	//
+	// check for using a team of threads for the colors
+	if( parallel_sweep_ > 1 )
+	{	local::pod_vector_maybe<Base> value;
+		bool done = local::sweep::jac_rev_team(
+			&play_,
+			n,
+			m,
+			num_var_tape_,
+			cap_order_taylor_,
+			taylor_.data(),
+			cskip_op_.data(),
+			load_op_,
+			ind_taddr_,
+			dep_taddr_,
+			color,
+			n_color,
+			row,
+			col,
+			order,
+			parallel_sweep_,
+			value
+		);
+		if( done )
+		{	for(size_t k = 0; k < K; k++)
+				subset.set( order[k], value[k] );
+			return n_color;
+		}
+	}
+	//
 	// weighting vector and return values for calls to Reverse
 	BaseVector w(m), dw(n);
 	//
@@ -22,6 +22,7 @@ Preprecessor definitions that presist after cppad/cppad.hpp is included:
 # undef CPPAD_HASH_TABLE_SIZE                used by test_more/optimize.cpp
 # undef EIGEN_MATRIXBASE_PLUGIN              example use of Eigen with CppAD
 # undef CPPAD_HAS_COLPACK                    used by speed/cppad/sparse_*.cpp
+# undef CPPAD_HAS_DLOPEN                     used by example/general/fun_jit.cpp
 
 # undef CPPAD_BOOL_BINARY         in user api
 # undef CPPAD_BOOL_UNARY          in user api
@@ -74,6 +75,7 @@ Preprecessor definitions that presist after cppad/cppad.hpp is included:
 # undef CPPAD_FOR_JAC_SWEEP_TRACE
 # undef CPPAD_HAS_GETTIMEOFDAY
 # undef CPPAD_HAS_MKSTEMP
+# undef CPPAD_HAS_MMAP
 # undef CPPAD_HAS_TMPNAM_S
 # undef CPPAD_INLINE_FRIEND_TEMPLATE_FUNCTION
 # undef CPPAD_LIB_EXPORT
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_COLOR_GENERAL_HPP
 
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-17 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the
@@ -12,8 +12,13 @@ A copy of this license is included in the COPYING file of this distribution.
 Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 -------------------------------------------------------------------------- */
 
+# include <algorithm>
+# include <string>
 # include <cppad/configure.hpp>
 # include <cppad/local/cppad_colpack.hpp>
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/local/sparse_list.hpp>
+# include <cppad/local/team_run.hpp>
 
 namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
 /*!
@@ -21,6 +26,467 @@ namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
 Coloring algorithm for a general sparse matrix.
 */
 // --------------------------------------------------------------------------
+/// order in which color_general_cppad colors the rows
+enum color_general_order {
+	/// row index order
+	natural_order,
+	/// reverse of the order in which rows with the smallest degree,
+	/// in the graph of the remaining rows, are removed
+	smallest_last_order,
+	/// next row is one with the most neighbors that are already ordered
+	incidence_degree_order,
+	/// next row is one with the most different colors in its neighbors
+	/// (rows are colored as they are ordered; i.e., DSATUR)
+	saturation_degree_order,
+	/// rows are split between a team of threads and colored speculatively
+	/// in row index order, then the rows with conflicts are recolored
+	parallel_order
+};
+/*!
+Determine the color_general_order corresponding to a coloring name.
+
+\param coloring
+is the coloring argument for a sparse Jacobian or Hessian routine.
+
+\param prefix
+is the name that corresponds to natural_order; e.g., "cppad".
+
+\param order [out]
+if the return value is true, this is set to the order for coloring.
+The names prefix.smallest_last, prefix.incidence_degree,
+prefix.saturation_degree, and prefix.parallel correspond to the other orders.
+
+\return
+is true if coloring is one of the names above.
+*/
+inline bool color_general_name(
+	const std::string&    coloring ,
+	const std::string&    prefix   ,
+	color_general_order&  order    )
+{	if( coloring == prefix )
+		order = natural_order;
+	else if( coloring == prefix + ".smallest_last" )
+		order = smallest_last_order;
+	else if( coloring == prefix + ".incidence_degree" )
+		order = incidence_degree_order;
+	else if( coloring == prefix + ".saturation_degree" )
+		order = saturation_degree_order;
+	else if( coloring == prefix + ".parallel" )
+		order = parallel_order;
+	else
+		return false;
+	return true;
+}
+// --------------------------------------------------------------------------
+/*!
+Compressed adjacency for the rows of a general sparse matrix
+that need to be colored.
+
+Two rows i and r are neighbors (cannot have the same color)
+if there is a column j such that (i, j) and (r, j) are in the sparsity pattern
+and at least one of them needs to be computed.
+*/
+class color_general_graph {
+private:
+	/// number of rows in the matrix
+	size_t m_;
+	/// start of each row in pat_col_ and pat_appear_ (size m_+1)
+	CppAD::vector<size_t> pat_ptr_;
+	/// column indices for the pattern entries in rows that appear
+	CppAD::vector<size_t> pat_col_;
+	/// does the corresponding pattern entry need to be computed
+	CppAD::vector<bool>   pat_appear_;
+	/// start of each column in all_row_ (size n+1)
+	CppAD::vector<size_t> all_ptr_;
+	/// rows that appear and have a pattern entry in each column
+	CppAD::vector<size_t> all_row_;
+	/// start of each column in app_row_ (size n+1)
+	CppAD::vector<size_t> app_ptr_;
+	/// rows with an entry that needs to be computed in each column
+	CppAD::vector<size_t> app_row_;
+	/// used to avoid listing the same neighbor twice
+	CppAD::vector<size_t> mark_;
+	/// current value used to mark neighbors
+	size_t mark_value_;
+public:
+	/// does each row have an entry that needs to be computed
+	CppAD::vector<bool> row_appear;
+	/*!
+	Constructor
+
+	\param pattern
+	is the sparsity pattern for the matrix (see color_general_cppad).
+
+	\param row
+	the row indices that need to be computed.
+
+	\param col
+	the column indices that need to be computed.
+	*/
+	template <class VectorSet, class VectorSize>
+	color_general_graph(
+		const VectorSet&   pattern ,
+		const VectorSize&  row     ,
+		const VectorSize&  col     )
+	{	size_t K = row.size();
+		size_t m = pattern.n_set();
+		size_t n = pattern.end();
+		m_       = m;
+		CPPAD_ASSERT_UNKNOWN( size_t( col.size() ) == K );
+		//
+		// row_appear, appearing entries sorted by row (app_col)
+		row_appear.resize(m);
+		for(size_t i = 0; i < m; ++i)
+			row_appear[i] = false;
+		CppAD::vector<size_t> app_col_ptr(m + 1), app_col(K);
+		for(size_t i = 0; i <= m; ++i)
+			app_col_ptr[i] = 0;
+		for(size_t k = 0; k < K; ++k)
+		{	CPPAD_ASSERT_UNKNOWN( pattern.is_element(row[k], col[k]) );
+			row_appear[ row[k] ] = true;
+			++app_col_ptr[ row[k] + 1 ];
+		}
+		for(size_t i = 0; i < m; ++i)
+			app_col_ptr[i + 1] += app_col_ptr[i];
+		for(size_t k = 0; k < K; ++k)
+			app_col[ app_col_ptr[ row[k] ]++ ] = col[k];
+		for(size_t i = m; i > 0; --i)
+			app_col_ptr[i] = app_col_ptr[i - 1];
+		app_col_ptr[0] = 0;
+		//
+		// pat_ptr_, pat_col_, pat_appear_ (only for rows that appear)
+		CppAD::vector<size_t> col_mark(n);
+		for(size_t j = 0; j < n; ++j)
+			col_mark[j] = m;
+		pat_ptr_.resize(m + 1);
+		pat_ptr_[0] = 0;
+		size_t n_pat = 0;
+		for(size_t i = 0; i < m; ++i)
+		{	if( row_appear[i] )
+			{	typename VectorSet::const_iterator itr(pattern, i);
+				for(size_t j = *itr; j != pattern.end(); j = *(++itr) )
+					++n_pat;
+			}
+			pat_ptr_[i + 1] = n_pat;
+		}
+		pat_col_.resize(n_pat);
+		pat_appear_.resize(n_pat);
+		all_ptr_.resize(n + 1);
+		app_ptr_.resize(n + 1);
+		for(size_t j = 0; j <= n; ++j)
+		{	all_ptr_[j] = 0;
+			app_ptr_[j] = 0;
+		}
+		size_t ell = 0;
+		for(size_t i = 0; i < m; ++i) if( row_appear[i] )
+		{	for(size_t k = app_col_ptr[i]; k < app_col_ptr[i+1]; ++k)
+				col_mark[ app_col[k] ] = i;
+			typename VectorSet::const_iterator itr(pattern, i);
+			for(size_t j = *itr; j != pattern.end(); j = *(++itr) )
+			{	pat_col_[ell]    = j;
+				pat_appear_[ell] = col_mark[j] == i;
+				++all_ptr_[j + 1];
+				if( pat_appear_[ell] )
+					++app_ptr_[j + 1];
+				++ell;
+			}
+		}
+		CPPAD_ASSERT_UNKNOWN( ell == n_pat );
+		//
+		// all_row_, app_row_ (transpose of the pattern entries)
+		for(size_t j = 0; j < n; ++j)
+		{	all_ptr_[j + 1] += all_ptr_[j];
+			app_ptr_[j + 1] += app_ptr_[j];
+		}
+		all_row_.resize( all_ptr_[n] );
+		app_row_.resize( app_ptr_[n] );
+		CppAD::vector<size_t> all_next(n), app_next(n);
+		for(size_t j = 0; j < n; ++j)
+		{	all_next[j] = all_ptr_[j];
+			app_next[j] = app_ptr_[j];
+		}
+		for(size_t i = 0; i < m; ++i)
+		{	for(ell = pat_ptr_[i]; ell < pat_ptr_[i+1]; ++ell)
+			{	size_t j = pat_col_[ell];
+				all_row_[ all_next[j]++ ] = i;
+				if( pat_appear_[ell] )
+					app_row_[ app_next[j]++ ] = i;
+			}
+		}
+		//
+		// mark_
+		mark_.resize(m);
+		for(size_t i = 0; i < m; ++i)
+			mark_[i] = 0;
+		mark_value_ = 0;
+	}
+	/*!
+	Determine the neighbors of a row.
+
+	\param i
+	is the row index (must appear).
+
+	\param neighbor [out]
+	is set to the neighbors of row i (in no particular order).
+	It is a vector with capacity m so that it is not reallocated.
+	*/
+	void neighbors(size_t i, pod_vector<size_t>& neighbor)
+	{	CPPAD_ASSERT_UNKNOWN( row_appear[i] );
+		neighbor.resize(0);
+		++mark_value_;
+		mark_[i] = mark_value_;
+		for(size_t ell = pat_ptr_[i]; ell < pat_ptr_[i+1]; ++ell)
+		{	const size_t* begin;
+			const size_t* end;
+			entry_rows(ell, begin, end);
+			for(const size_t* itr = begin; itr < end; ++itr)
+			{	size_t r = *itr;
+				if( mark_[r] != mark_value_ )
+				{	mark_[r] = mark_value_;
+					neighbor.push_back(r);
+				}
+			}
+		}
+	}
+	/// first pattern entry for row i
+	size_t entry_begin(size_t i) const
+	{	return pat_ptr_[i]; }
+	/// one past last pattern entry for row i
+	size_t entry_end(size_t i) const
+	{	return pat_ptr_[i + 1]; }
+	/*!
+	Rows that are neighbors because of one pattern entry.
+	The neighbors of row i are the union, for ell between entry_begin(i)
+	and entry_end(i), of these rows (not counting i itself).
+	A row may be in more than one of these lists
+	(so that different threads can use these lists at the same time
+	without a mark vector).
+
+	\param ell
+	is the index of a pattern entry (i, j).
+
+	\param begin [out]
+	is set to the beginning of the list of rows; i.e.,
+	all rows with an entry in column j, if (i, j) appears,
+	and the rows r where (r, j) appears otherwise.
+
+	\param end [out]
+	is set to the end of the list of rows.
+	*/
+	void entry_rows(
+		size_t          ell   ,
+		const size_t*&  begin ,
+		const size_t*&  end   ) const
+	{	size_t j = pat_col_[ell];
+		if( pat_appear_[ell] )
+		{	begin = all_row_.data() + all_ptr_[j];
+			end   = all_row_.data() + all_ptr_[j + 1];
+		}
+		else
+		{	begin = app_row_.data() + app_ptr_[j];
+			end   = app_row_.data() + app_ptr_[j + 1];
+		}
+	}
+};
+// --------------------------------------------------------------------------
+/*!
+Doubly linked lists of items where each item is in the list for its key.
+Used by the color_general_cppad orderings.
+*/
+class color_general_bucket {
+private:
+	/// first item with each key (n_item_ if empty)
+	CppAD::vector<size_t> head_;
+	/// next item with the same key (n_item_ if none)
+	CppAD::vector<size_t> next_;
+	/// previous item with the same key (n_item_ if none)
+	CppAD::vector<size_t> prev_;
+	/// number of items
+	size_t n_item_;
+public:
+	/// current key for each item (not valid after it is removed)
+	CppAD::vector<size_t> key;
+	/// constructor (all lists are empty)
+	color_general_bucket(size_t n_key, size_t n_item)
+	: head_(n_key), next_(n_item), prev_(n_item), n_item_(n_item), key(n_item)
+	{	for(size_t d = 0; d < n_key; ++d)
+			head_[d] = n_item;
+	}
+	/// first item with key d (n_item if there is none)
+	size_t head(size_t d) const
+	{	return head_[d]; }
+	/// add item to the front of the list for key d
+	void insert(size_t item, size_t d)
+	{	key[item]   = d;
+		prev_[item] = n_item_;
+		next_[item] = head_[d];
+		if( head_[d] != n_item_ )
+			prev_[ head_[d] ] = item;
+		head_[d] = item;
+	}
+	/// remove item from the list for its key
+	void remove(size_t item)
+	{	size_t d = key[item];
+		if( prev_[item] == n_item_ )
+			head_[d] = next_[item];
+		else
+			next_[ prev_[item] ] = next_[item];
+		if( next_[item] != n_item_ )
+			prev_[ next_[item] ] = prev_[item];
+	}
+};
+// --------------------------------------------------------------------------
+/*!
+Work done by each thread in a team during one phase of the
+parallel_order coloring.
+
+The rows in the current list are split into contiguous blocks,
+one for each thread.
+During the color phase, each thread colors the rows in its block,
+in order, ignoring the rows in the other blocks.
+During the conflict phase, each thread marks the rows in its block that
+have the same color as a smaller neighbor in another block.
+A thread only writes the color and conflict values for the rows in
+its block, and only reads colors that are not written during the phase,
+so the result does not depend on the timing of the threads.
+The neighbors are not combined into a set (so a thread does not need
+a mark vector of size m); i.e., a color may be forbidden, or a conflict
+checked, more than once for the same neighbor.
+All the memory used by the threads is allocated before the team is run.
+*/
+class color_general_team_work {
+private:
+	const color_general_graph& graph_;
+	const size_t               m_;
+	const size_t               num_threads_;
+	const size_t*              list_;
+	const size_t               n_list_;
+	const size_t*              owner_;
+	size_t*                    color_;
+	size_t*                    conflict_;
+	const size_t*              forbidden_ptr_;
+	size_t*                    forbidden_;
+	size_t*                    stamp_;
+public:
+	/// true for the color phase and false for the conflict phase
+	bool color_phase;
+	/*!
+	constructor
+
+	\param graph
+	is the graph for the rows that appear.
+
+	\param m
+	is the number of rows in the sparsity pattern.
+
+	\param num_threads
+	is the number of threads in the team.
+
+	\param list
+	is the rows that are colored by the team (in increasing order).
+
+	\param n_list
+	is the number of rows in list.
+
+	\param owner
+	is the thread that colors each row in list and greater than or equal
+	num_threads for the other rows.
+
+	\param color
+	is the color for each row. The rows in list must have color m
+	at the beginning of the color phase.
+
+	\param conflict [out]
+	is set to one (zero) for the rows in list that must (need not)
+	be colored again.
+
+	\param forbidden_ptr
+	has size num_threads + 1. The forbidden colors for a thread are
+	stored in forbidden[ forbidden_ptr[thread] ] through
+	forbidden[ forbidden_ptr[thread+1] - 1 ].
+	This must be more than the largest color that a row in the block
+	for the thread, or one of its neighbors, can have.
+
+	\param forbidden
+	has size forbidden_ptr[num_threads] and is initialized as zero.
+
+	\param stamp
+	has size num_threads and its elements are initialized as zero.
+	*/
+	color_general_team_work(
+		const color_general_graph& graph         ,
+		size_t                     m             ,
+		size_t                     num_threads   ,
+		const size_t*              list          ,
+		size_t                     n_list        ,
+		const size_t*              owner         ,
+		size_t*                    color         ,
+		size_t*                    conflict      ,
+		const size_t*              forbidden_ptr ,
+		size_t*                    forbidden     ,
+		size_t*                    stamp         )
+	: graph_(graph)
+	, m_(m)
+	, num_threads_(num_threads)
+	, list_(list)
+	, n_list_(n_list)
+	, owner_(owner)
+	, color_(color)
+	, conflict_(conflict)
+	, forbidden_ptr_(forbidden_ptr)
+	, forbidden_(forbidden)
+	, stamp_(stamp)
+	, color_phase(true)
+	{ }
+	/// do the current phase for the rows in the block for one thread
+	void operator()(size_t thread)
+	{	size_t  begin     = (thread * n_list_) / num_threads_;
+		size_t  end       = ((thread + 1) * n_list_) / num_threads_;
+		size_t* forbidden = forbidden_ + forbidden_ptr_[thread];
+# ifndef NDEBUG
+		size_t  n_forbid  =
+			forbidden_ptr_[thread + 1] - forbidden_ptr_[thread];
+# endif
+		for(size_t k = begin; k < end; ++k)
+		{	size_t i = list_[k];
+			size_t stamp = 0;
+			if( color_phase )
+				stamp = ++stamp_[thread];
+			else
+				conflict_[i] = 0;
+			size_t ell_end = graph_.entry_end(i);
+			for(size_t ell = graph_.entry_begin(i); ell < ell_end; ++ell)
+			{	const size_t* itr;
+				const size_t* itr_end;
+				graph_.entry_rows(ell, itr, itr_end);
+				for(; itr < itr_end; ++itr)
+				{	size_t r     = *itr;
+					size_t owner = owner_[r];
+					if( color_phase )
+					{	if( owner >= num_threads_ || owner == thread )
+						{	if( color_[r] < m_ )
+							{	CPPAD_ASSERT_UNKNOWN( color_[r] < n_forbid );
+								forbidden[ color_[r] ] = stamp;
+							}
+						}
+					}
+					else if( owner < num_threads_ && owner != thread )
+					{	if( r < i && color_[r] == color_[i] )
+							conflict_[i] = 1;
+					}
+				}
+			}
+			if( color_phase )
+			{	size_t c = 0;
+				while( forbidden[c] == stamp )
+					++c;
+				CPPAD_ASSERT_UNKNOWN( c < n_forbid );
+				color_[i] = c;
+			}
+		}
+	}
+};
+// --------------------------------------------------------------------------
 /*!
 Determine which rows of a general sparse matrix can be computed together;
 i.e., do not have non-zero entries with the same column index.
@@ -67,69 +533,29 @@ It follows that neither of these pairs appear in the set of
 This routine tries to minimize, with respect to the choice of colors,
 the maximum, with respct to k, of <code>color[ row[k] ]</code>
 (not counting the indices k for which row[k] == m).
+
+\param order
+is the order in which the rows are colored; see color_general_order.
+Each row is given the smallest color that is not used by its neighbors
+that have already been colored.
+
+\param num_threads
+is the number of threads in the team used by parallel_order
+(it is not used by the other orders).
+The result for parallel_order depends on num_threads,
+but not on the timing of the threads.
+If num_threads is one, it is the same as natural_order.
 */
 template <class VectorSet, class VectorSize>
 void color_general_cppad(
 	const VectorSet&        pattern ,
 	const VectorSize&       row     ,
 	const VectorSize&       col     ,
-	CppAD::vector<size_t>&  color   )
-{
-	size_t K = row.size();
-	size_t m = pattern.n_set();
-	size_t n = pattern.end();
-
-	CPPAD_ASSERT_UNKNOWN( size_t( col.size() )   == K );
+	CppAD::vector<size_t>&  color   ,
+	color_general_order     order = natural_order ,
+	size_t                  num_threads = 1       )
+{	size_t m = pattern.n_set();
 	CPPAD_ASSERT_UNKNOWN( size_t( color.size() ) == m );
-
-	// We define the set of rows, columns, and pairs that appear
-	// by the set ( row[k], col[k] ) for k = 0, ... , K-1.
-
-	// initialize rows that appear
-	CppAD::vector<bool> row_appear(m);
-	for(size_t i = 0; i < m; i++)
-			row_appear[i] = false;
-
-	// rows and columns that appear
-	VectorSet c2r_appear, r2c_appear;
-	c2r_appear.resize(n, m);
-	r2c_appear.resize(m, n);
-	for(size_t k = 0;  k < K; k++)
-	{	CPPAD_ASSERT_UNKNOWN( pattern.is_element(row[k], col[k]) );
-		row_appear[ row[k] ] = true;
-		c2r_appear.post_element(col[k], row[k]);
-		r2c_appear.post_element(row[k], col[k]);
-	}
-	// process posts
-	for(size_t j = 0; j < n; ++j)
-		c2r_appear.process_post(j);
-	for(size_t i = 0; i < m; ++i)
-		r2c_appear.process_post(i);
-
-	// for each column, which rows are non-zero and do not appear
-	VectorSet not_appear;
-	not_appear.resize(n, m);
-	for(size_t i = 0; i < m; i++)
-	{	typename VectorSet::const_iterator pattern_itr(pattern, i);
-		size_t j = *pattern_itr;
-		while( j != pattern.end() )
-		{	if( ! c2r_appear.is_element(j , i) )
-				not_appear.post_element(j, i);
-			j = *(++pattern_itr);
-		}
-	}
-	// process posts
-	for(size_t j = 0; j < n; ++j)
-		not_appear.process_post(j);
-
-	// initial coloring
-	color.resize(m);
-	size_t ell = 0;
-	for(size_t i = 0; i < m; i++)
-	{	if( row_appear[i] )
-			color[i] = ell++;
-		else	color[i] = m;
-	}
 	/*
 	See GreedyPartialD2Coloring Algorithm Section 3.6.2 of
 	Graph Coloring in Optimization Revisited by
@@ -138,62 +564,238 @@ void color_general_cppad(
 	The algorithm above was modified (by Brad Bell) to take advantage of the
 	fact that only the entries (subset of the sparsity pattern) specified by
 	row and col need to be computed.
+	The orderings are described in Section 3.5 of the same paper.
 	*/
-	CppAD::vector<bool> forbidden(m);
-	for(size_t i = 1; i < m; i++) // for each row that appears
-	if( color[i] < m )
-	{
-		// initial all colors as ok for this row
-		// (value of forbidden for ell > initial color[i] does not matter)
-		for(ell = 0; ell <= color[i]; ell++)
-			forbidden[ell] = false;
-
-		// -----------------------------------------------------
-		// Forbid colors for which this row would destroy results:
-		//
-		// for each column that is non-zero for this row
-		typename VectorSet::const_iterator pattern_itr(pattern, i);
-		size_t j = *pattern_itr;
-		while( j != pattern.end() )
-		{	// for each row that appears with this column
-			typename VectorSet::const_iterator c2r_itr(c2r_appear, j);
-			size_t r = *c2r_itr;
-			while( r != c2r_appear.end() )
-			{	// if this is not the same row, forbid its color
-				if( (r < i) & (color[r] < m) )
-					forbidden[ color[r] ] = true;
-				r = *(++c2r_itr);
+	color_general_graph graph(pattern, row, col);
+	const CppAD::vector<bool>& row_appear( graph.row_appear );
+	//
+	// rows that appear
+	size_t n_appear = 0;
+	for(size_t i = 0; i < m; ++i)
+		if( row_appear[i] )
+			++n_appear;
+	//
+	// neighbor
+	pod_vector<size_t> neighbor;
+	neighbor.extend(m);
+	neighbor.resize(0);
+	//
+	// color, forbidden
+	color.resize(m);
+	for(size_t i = 0; i < m; ++i)
+		color[i] = m;
+	CppAD::vector<size_t> forbidden(m + 1);
+	for(size_t ell = 0; ell <= m; ++ell)
+		forbidden[ell] = m;
+	//
+	// ------------------------------------------------------------------------
+	if( order == parallel_order )
+	{	/*
+		See Algorithm 2 in
+		A Scalable Parallel Graph Coloring Algorithm for Distributed Memory
+		Computers, by Bozdag, Gebremedhin, Manne, Boman, Catalyurek.
+		Here the rows are colored by a team of threads in rounds;
+		the rows that conflict with a smaller row, colored by a different
+		thread during the same round, are colored again during the next round.
+		(The smallest row in each round does not conflict, so this terminates.)
+		*/
+		CPPAD_ASSERT_UNKNOWN( num_threads > 0 );
+		CppAD::vector<size_t> list(n_appear), owner(m), conflict(m);
+		size_t n_list = 0;
+		for(size_t i = 0; i < m; ++i)
+		{	owner[i] = num_threads;
+			if( row_appear[i] )
+				list[n_list++] = i;
+		}
+		// n_color is one more than the largest color for the rows that
+		// are not in list (zero if there are no such rows).
+		// The k-th row colored by a thread during a round has color less than
+		// or equal n_color + k, so its forbidden colors have size
+		// n_color + (size of its block) which is bounded by m.
+		size_t n_color = 0;
+		CppAD::vector<size_t> forbidden_ptr(num_threads + 1);
+		CppAD::vector<size_t> thread_forbidden, stamp(num_threads);
+		for(size_t thread = 0; thread < num_threads; ++thread)
+			stamp[thread] = 0;
+		while( n_list > 0 )
+		{	size_t n_team = std::min(num_threads, n_list);
+			forbidden_ptr[0] = 0;
+			for(size_t thread = 0; thread < n_team; ++thread)
+			{	size_t begin = (thread * n_list) / n_team;
+				size_t end   = ((thread + 1) * n_list) / n_team;
+				for(size_t k = begin; k < end; ++k)
+				{	owner[ list[k] ] = thread;
+					color[ list[k] ] = m;
+				}
+				size_t n_forbid = std::min(n_color + end - begin, m);
+				forbidden_ptr[thread + 1] = forbidden_ptr[thread] + n_forbid;
 			}
-			j = *(++pattern_itr);
+			thread_forbidden.resize( forbidden_ptr[n_team] );
+			for(size_t ell = 0; ell < forbidden_ptr[n_team]; ++ell)
+				thread_forbidden[ell] = 0;
+			color_general_team_work work(
+				graph,
+				m,
+				n_team,
+				list.data(),
+				n_list,
+				owner.data(),
+				color.data(),
+				conflict.data(),
+				forbidden_ptr.data(),
+				thread_forbidden.data(),
+				stamp.data()
+			);
+			team_run(n_team, work);
+			work.color_phase = false;
+			team_run(n_team, work);
+			//
+			// rows that must be colored again
+			size_t n_next = 0;
+			for(size_t k = 0; k < n_list; ++k)
+			{	size_t i = list[k];
+				owner[i] = num_threads;
+				if( conflict[i] )
+					list[n_next++] = i;
+				else
+					n_color = std::max(n_color, color[i] + 1);
+			}
+			CPPAD_ASSERT_UNKNOWN( n_next < n_list );
+			n_list = n_next;
 		}
-
-
-		// -----------------------------------------------------
-		// Forbid colors that destroy results needed for this row.
+		return;
+	}
+	// ------------------------------------------------------------------------
+	if( order == saturation_degree_order )
+	{	// colors used by the neighbors of each row
+		sparse_list neighbor_color;
+		neighbor_color.resize(m, m);
 		//
-		// for each column that appears with this row
-		typename VectorSet::const_iterator r2c_itr(r2c_appear, i);
-		j = *r2c_itr;
-		while( j != r2c_appear.end() )
-		{	// For each row that is non-zero for this column
-			// (the appear rows have already been checked above).
-			typename VectorSet::const_iterator not_itr(not_appear, j);
-			size_t r = *not_itr;
-			while( r != not_appear.end() )
-			{	// if this is not the same row, forbid its color
-				if( (r < i) & (color[r] < m) )
-					forbidden[ color[r] ] = true;
-				r = *(++not_itr);
+		// bucket.key[i] is number of different colors in the neighbors of i
+		color_general_bucket bucket(n_appear + 1, m);
+		for(size_t i = m; i > 0; --i)
+			if( row_appear[i-1] )
+				bucket.insert(i-1, 0);
+		size_t d_max = 0;
+		for(size_t count = 0; count < n_appear; ++count)
+		{	while( bucket.head(d_max) == m )
+				--d_max;
+			size_t i = bucket.head(d_max);
+			bucket.remove(i);
+			//
+			// color for row i
+			graph.neighbors(i, neighbor);
+			for(size_t k = 0; k < neighbor.size(); ++k)
+			{	size_t r = neighbor[k];
+				if( color[r] < m )
+					forbidden[ color[r] ] = i;
+			}
+			size_t ell = 0;
+			while( forbidden[ell] == i )
+				++ell;
+			color[i] = ell;
+			//
+			// update saturation for rows that are not yet colored
+			for(size_t k = 0; k < neighbor.size(); ++k)
+			{	size_t r = neighbor[k];
+				if( color[r] == m && ! neighbor_color.is_element(r, ell) )
+				{	neighbor_color.add_element(r, ell);
+					size_t d = bucket.key[r] + 1;
+					bucket.remove(r);
+					bucket.insert(r, d);
+					if( d > d_max )
+						d_max = d;
+				}
 			}
-			j = *(++r2c_itr);
 		}
-
-		// pick the color with smallest index
-		ell = 0;
-		while( forbidden[ell] )
-		{	ell++;
-			CPPAD_ASSERT_UNKNOWN( ell <= color[i] );
+		return;
+	}
+	// ------------------------------------------------------------------------
+	// sequence: order in which the rows are colored
+	CppAD::vector<size_t> sequence(n_appear);
+	if( order == natural_order )
+	{	size_t count = 0;
+		for(size_t i = 0; i < m; ++i)
+			if( row_appear[i] )
+				sequence[count++] = i;
+	}
+	else if( order == smallest_last_order )
+	{	// bucket.key[i] is degree of i in the graph of the remaining rows
+		color_general_bucket bucket(n_appear + 1, m);
+		for(size_t i = m; i > 0; --i) if( row_appear[i-1] )
+		{	graph.neighbors(i-1, neighbor);
+			bucket.insert(i-1, neighbor.size() );
+		}
+		CppAD::vector<bool> removed(m);
+		for(size_t i = 0; i < m; ++i)
+			removed[i] = false;
+		size_t d_min = 0;
+		for(size_t count = n_appear; count > 0; --count)
+		{	while( bucket.head(d_min) == m )
+				++d_min;
+			size_t i = bucket.head(d_min);
+			bucket.remove(i);
+			removed[i]          = true;
+			sequence[count - 1] = i;
+			//
+			graph.neighbors(i, neighbor);
+			for(size_t k = 0; k < neighbor.size(); ++k)
+			{	size_t r = neighbor[k];
+				if( ! removed[r] )
+				{	size_t d = bucket.key[r] - 1;
+					bucket.remove(r);
+					bucket.insert(r, d);
+					if( d < d_min )
+						d_min = d;
+				}
+			}
+		}
+	}
+	else
+	{	CPPAD_ASSERT_UNKNOWN( order == incidence_degree_order );
+		// bucket.key[i] is number of neighbors of i that are in sequence
+		color_general_bucket bucket(n_appear + 1, m);
+		for(size_t i = m; i > 0; --i)
+			if( row_appear[i-1] )
+				bucket.insert(i-1, 0);
+		CppAD::vector<bool> ordered(m);
+		for(size_t i = 0; i < m; ++i)
+			ordered[i] = false;
+		size_t d_max = 0;
+		for(size_t count = 0; count < n_appear; ++count)
+		{	while( bucket.head(d_max) == m )
+				--d_max;
+			size_t i = bucket.head(d_max);
+			bucket.remove(i);
+			ordered[i]      = true;
+			sequence[count] = i;
+			//
+			graph.neighbors(i, neighbor);
+			for(size_t k = 0; k < neighbor.size(); ++k)
+			{	size_t r = neighbor[k];
+				if( ! ordered[r] )
+				{	size_t d = bucket.key[r] + 1;
+					bucket.remove(r);
+					bucket.insert(r, d);
+					if( d > d_max )
+						d_max = d;
+				}
+			}
+		}
+	}
+	// ------------------------------------------------------------------------
+	// greedy coloring in the order specified by sequence
+	for(size_t count = 0; count < n_appear; ++count)
+	{	size_t i = sequence[count];
+		graph.neighbors(i, neighbor);
+		for(size_t k = 0; k < neighbor.size(); ++k)
+		{	size_t r = neighbor[k];
+			if( color[r] < m )
+				forbidden[ color[r] ] = i;
 		}
+		size_t ell = 0;
+		while( forbidden[ell] == i )
+			++ell;
 		color[i] = ell;
 	}
 	return;
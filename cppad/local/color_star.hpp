@@ -0,0 +1,662 @@
+# ifndef CPPAD_LOCAL_COLOR_STAR_HPP
+# define CPPAD_LOCAL_COLOR_STAR_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <algorithm>
+# include <cppad/utility/vector.hpp>
+# include <cppad/local/color_general.hpp>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file color_star.hpp
+Star and acyclic coloring algorithms for a symmetric sparse matrix.
+
+See Section 4 of
+What Color is Your Jacobian? Graph Coloring for Computing Derivatives, by
+Assefaw Gebremedhin, Fredrik Manne, Alex Pothen,
+and New Acyclic and Star Coloring Algorithms with Application to
+Computing Hessians, by the same authors and Arijit Tarafdar.
+*/
+// --------------------------------------------------------------------------
+/*!
+Adjacency graph for a symmetric sparse matrix.
+
+The vertices are the row (column) indices.
+Two vertices i != j are neighbors if (i, j) or (j, i)
+is in the sparsity pattern.
+*/
+class color_star_graph {
+public:
+	/// number of vertices
+	size_t n;
+	/// start of the slots for each vertex in adj and edge (size n+1)
+	CppAD::vector<size_t> ptr;
+	/// neighbors of each vertex in increasing order
+	CppAD::vector<size_t> adj;
+	/// undirected edge index corresponding to each slot
+	CppAD::vector<size_t> edge;
+	/// number of undirected edges
+	size_t n_edge;
+	/// is the diagonal entry for each vertex in the sparsity pattern
+	CppAD::vector<bool> diag;
+	/*!
+	Constructor
+
+	\param pattern
+	is a vector_of_sets representation of the sparsity pattern
+	(pattern.n_set() == pattern.end()).
+	*/
+	template <class VectorSet>
+	color_star_graph(const VectorSet& pattern)
+	{	n = pattern.n_set();
+		CPPAD_ASSERT_UNKNOWN( n == pattern.end() );
+		//
+		// diag, number of off diagonal entries in each row and column
+		diag.resize(n);
+		ptr.resize(n + 1);
+		for(size_t i = 0; i <= n; ++i)
+			ptr[i] = 0;
+		for(size_t i = 0; i < n; ++i)
+		{	diag[i] = false;
+			typename VectorSet::const_iterator itr(pattern, i);
+			for(size_t j = *itr; j != pattern.end(); j = *(++itr) )
+			{	if( i == j )
+					diag[i] = true;
+				else
+				{	++ptr[i + 1];
+					++ptr[j + 1];
+				}
+			}
+		}
+		for(size_t i = 0; i < n; ++i)
+			ptr[i + 1] += ptr[i];
+		//
+		// neighbors with possible duplicates
+		CppAD::vector<size_t> next(n);
+		for(size_t i = 0; i < n; ++i)
+			next[i] = ptr[i];
+		adj.resize( ptr[n] );
+		for(size_t i = 0; i < n; ++i)
+		{	typename VectorSet::const_iterator itr(pattern, i);
+			for(size_t j = *itr; j != pattern.end(); j = *(++itr) )
+			if( i != j )
+			{	adj[ next[i]++ ] = j;
+				adj[ next[j]++ ] = i;
+			}
+		}
+		//
+		// sort and remove duplicates
+		size_t n_slot = 0;
+		size_t begin  = 0;
+		for(size_t i = 0; i < n; ++i)
+		{	size_t end = ptr[i + 1];
+			std::sort(adj.data() + begin, adj.data() + end);
+			ptr[i] = n_slot;
+			for(size_t s = begin; s < end; ++s)
+			{	if( n_slot == ptr[i] || adj[n_slot - 1] != adj[s] )
+					adj[n_slot++] = adj[s];
+			}
+			begin = end;
+		}
+		ptr[n] = n_slot;
+		//
+		// edge
+		edge.resize(n_slot);
+		n_edge = 0;
+		for(size_t i = 0; i < n; ++i)
+		{	for(size_t s = ptr[i]; s < ptr[i + 1]; ++s)
+			{	size_t j = adj[s];
+				if( i < j )
+					edge[s] = n_edge++;
+				else
+					edge[s] = edge[ slot(j, i) ];
+			}
+		}
+	}
+	/// number of neighbors for vertex i
+	size_t degree(size_t i) const
+	{	return ptr[i + 1] - ptr[i]; }
+
+	/// slot for neighbor j of vertex i (ptr[n] if j is not a neighbor)
+	size_t slot(size_t i, size_t j) const
+	{	const size_t* begin = adj.data() + ptr[i];
+		const size_t* end   = adj.data() + ptr[i + 1];
+		const size_t* itr   = std::lower_bound(begin, end, j);
+		if( itr == end || *itr != j )
+			return ptr[n];
+		return ptr[i] + size_t(itr - begin);
+	}
+	/// is (i, j) in the sparsity pattern (or its transpose)
+	bool is_element(size_t i, size_t j) const
+	{	if( i == j )
+			return diag[i];
+		return slot(i, j) < ptr[n];
+	}
+	/*!
+	Order in which the vertices are colored; i.e., the reverse of the order
+	in which vertices with the smallest degree, in the graph of the
+	remaining vertices, are removed (see smallest_last_order).
+	*/
+	void color_sequence(CppAD::vector<size_t>& sequence) const
+	{	// bucket.key[i] is degree of i in the graph of the remaining vertices
+		color_general_bucket bucket(n + 1, n);
+		for(size_t i = n; i > 0; --i)
+			bucket.insert(i - 1, degree(i - 1) );
+		CppAD::vector<bool> removed(n);
+		for(size_t i = 0; i < n; ++i)
+			removed[i] = false;
+		sequence.resize(n);
+		size_t d_min = 0;
+		for(size_t count = n; count > 0; --count)
+		{	while( bucket.head(d_min) == n )
+				++d_min;
+			size_t i = bucket.head(d_min);
+			bucket.remove(i);
+			removed[i]          = true;
+			sequence[count - 1] = i;
+			for(size_t s = ptr[i]; s < ptr[i + 1]; ++s)
+			{	size_t r = adj[s];
+				if( ! removed[r] )
+				{	size_t d = bucket.key[r] - 1;
+					bucket.remove(r);
+					bucket.insert(r, d);
+					if( d < d_min )
+						d_min = d;
+				}
+			}
+		}
+	}
+};
+// --------------------------------------------------------------------------
+/*!
+Remove colors that are not used to compute any entry and then
+renumber the colors so the ones that remain are 0, 1, ...
+
+\param row [in]
+the color for row[k] is used to compute the k-th entry.
+
+\param color [in/out]
+is the coloring for the rows of the matrix.
+If the color for row i is not the color for any row[k],
+color[i] is set to n = color.size().
+*/
+inline void color_star_renumber(
+	const CppAD::vector<size_t>& row   ,
+	CppAD::vector<size_t>&       color )
+{	size_t n = color.size();
+	CppAD::vector<size_t> new_color(n + 1);
+	for(size_t c = 0; c <= n; ++c)
+		new_color[c] = n;
+	for(size_t k = 0; k < row.size(); ++k)
+		new_color[ color[ row[k] ] ] = 0;
+	new_color[n] = n;
+	size_t n_color = 0;
+	for(size_t c = 0; c < n; ++c)
+		if( new_color[c] == 0 )
+			new_color[c] = n_color++;
+	for(size_t i = 0; i < n; ++i)
+		color[i] = new_color[ color[i] ];
+}
+// --------------------------------------------------------------------------
+/*!
+CppAD star coloring for a symmetric sparse matrix.
+
+In a star coloring, adjacent rows have different colors and every path
+of four rows uses at least three colors; i.e., each pair of colors
+defines a set of stars. This allows each entry to be computed directly
+from the sum of the rows with one color.
+
+\tparam VectorSet
+is a vector_of_sets class.
+
+\param pattern [in]
+Is a representation of the sparsity pattern for the matrix.
+All the possibly non-zero entries in the matrix must be in the pattern,
+or its transpose, because the rows that do not appear in the entries
+below are also used to determine the coloring.
+
+\param row [in/out]
+is a vector specifying which row indices to compute.
+
+\param col [in/out]
+is a vector, with the same size as row,
+that specifies which column indices to compute.
+\n
+\n
+Input:
+For each  valid index \c k, the index pair
+<code>(row[k], col[k])</code> must be present in the sparsity pattern,
+or its transpose.
+\n
+\n
+Output:
+On output, some of row and column indices may have been swapped
+so that the color for row[k] can be used to compute entry
+(row[k], col[k]); i.e., row[k] is the only row with this color
+that has a possibly non-zero entry in column col[k].
+
+\param color [out]
+is a vector with size m.
+The input value of its elements does not matter.
+Upon return, it is a coloring for the rows of the sparse matrix.
+Note that if color[i] == m, then there is no index k for which
+row[k] == i (for the return value of row).
+*/
+template <class VectorSet>
+void color_star_cppad(
+	const VectorSet&        pattern   ,
+	CppAD::vector<size_t>&  row       ,
+	CppAD::vector<size_t>&  col       ,
+	CppAD::vector<size_t>&  color     )
+{	size_t K = row.size();
+	CPPAD_ASSERT_UNKNOWN( col.size() == K );
+	/*
+	See StarColoringAlg1 in Section 4.1 of
+	What Color is Your Jacobian? Graph Coloring for Computing Derivatives
+	*/
+	color_star_graph graph(pattern);
+	size_t m = graph.n;
+	CPPAD_ASSERT_UNKNOWN( color.size() == m );
+	for(size_t k = 0; k < K; ++k) CPPAD_ASSERT_KNOWN(
+		graph.is_element(row[k], col[k]),
+		"sparse_hes: subset has an element that is not in pattern"
+	);
+	//
+	// forbidden[c] == i + 1 if color c is forbidden for row i
+	CppAD::vector<size_t> forbidden(m);
+	for(size_t c = 0; c < m; ++c)
+		forbidden[c] = 0;
+	//
+	// rows that have a possibly non-zero entry get a color
+	CppAD::vector<size_t> sequence;
+	graph.color_sequence(sequence);
+	for(size_t i = 0; i < m; ++i)
+		color[i] = m;
+	for(size_t count = 0; count < m; ++count)
+	{	size_t v = sequence[count];
+		if( graph.degree(v) == 0 && ! graph.diag[v] )
+			continue;
+		// distance one
+		for(size_t s = graph.ptr[v]; s < graph.ptr[v+1]; ++s)
+		{	size_t w = graph.adj[s];
+			if( color[w] < m )
+				forbidden[ color[w] ] = v + 1;
+		}
+		// paths v, w, x that would not be in a star
+		for(size_t s = graph.ptr[v]; s < graph.ptr[v+1]; ++s)
+		{	size_t w = graph.adj[s];
+			for(size_t t = graph.ptr[w]; t < graph.ptr[w+1]; ++t)
+			{	size_t x = graph.adj[t];
+				if( x != v && color[x] < m )
+				{	if( color[w] == m )
+						forbidden[ color[x] ] = v + 1;
+					else
+					{	// path v, w, x, y with color[y] == color[w]
+						size_t u = graph.ptr[x];
+						while( u < graph.ptr[x+1] )
+						{	size_t y = graph.adj[u++];
+							if( y != w && color[y] == color[w] )
+							{	forbidden[ color[x] ] = v + 1;
+								u = graph.ptr[x+1];
+							}
+						}
+					}
+				}
+			}
+		}
+		size_t c = 0;
+		while( forbidden[c] == v + 1 )
+			++c;
+		color[v] = c;
+	}
+	//
+	// determine which entries need to be reflected
+	for(size_t k = 0; k < K; ++k)
+	{	size_t i = row[k];
+		size_t j = col[k];
+		bool reflect = false;
+		for(size_t s = graph.ptr[j]; s < graph.ptr[j+1]; ++s)
+		{	size_t r = graph.adj[s];
+			reflect |= r != i && color[r] == color[i];
+		}
+		if( reflect )
+		{	row[k] = j;
+			col[k] = i;
+# ifndef NDEBUG
+			for(size_t s = graph.ptr[i]; s < graph.ptr[i+1]; ++s)
+			{	size_t r = graph.adj[s];
+				CPPAD_ASSERT_UNKNOWN( r == j || color[r] != color[j] );
+			}
+# endif
+		}
+	}
+	//
+	// rows that are not used to compute any entry are not needed
+	CppAD::vector<bool> used(m);
+	for(size_t i = 0; i < m; ++i)
+		used[i] = false;
+	for(size_t k = 0; k < K; ++k)
+		used[ row[k] ] = true;
+	for(size_t i = 0; i < m; ++i)
+		if( ! used[i] )
+			color[i] = m;
+	color_star_renumber(row, color);
+}
+// --------------------------------------------------------------------------
+/// find the root of the tree that contains edge e (with path halving)
+inline size_t color_acyclic_find(CppAD::vector<size_t>& parent, size_t e)
+{	while( parent[e] != e )
+	{	parent[e] = parent[ parent[e] ];
+		e         = parent[e];
+	}
+	return e;
+}
+/// join the trees that contain edges e1 and e2
+inline void color_acyclic_union(
+	CppAD::vector<size_t>& parent, size_t e1, size_t e2)
+{	e1 = color_acyclic_find(parent, e1);
+	e2 = color_acyclic_find(parent, e2);
+	if( e1 < e2 )
+		parent[e2] = e1;
+	else
+		parent[e1] = e2;
+}
+/*!
+CppAD acyclic coloring for a symmetric sparse matrix and the corresponding
+substitution method for computing its entries.
+
+In an acyclic coloring, adjacent rows have different colors and every cycle
+uses at least three colors; i.e., the graph for each pair of colors
+is a forest. The entries corresponding to each tree are computed
+by starting at its leaves and subtracting the values already computed.
+
+\tparam VectorSet
+is a vector_of_sets class.
+
+\param pattern [in]
+Is a representation of the sparsity pattern for the matrix.
+All the possibly non-zero entries in the matrix must be in the pattern,
+or its transpose, because every entry is computed.
+
+\param row [in/out]
+On input, it is a vector specifying which row indices to compute.
+Upon return it is the row indices for the entries that are computed;
+i.e., one for each diagonal entry in the pattern and one for each
+pair of off diagonal entries (i, j), (j, i).
+
+\param col [in/out]
+On input, it is a vector, with the same size as row,
+that specifies which column indices to compute.
+For each  valid index \c k, the index pair
+<code>(row[k], col[k])</code> must be present in the sparsity pattern,
+or its transpose.
+Upon return it has the same size as row and is the column indices
+for the entries that are computed.
+
+\param color [out]
+is a vector with size m.
+The input value of its elements does not matter.
+Upon return, it is a coloring for the rows of the sparse matrix.
+If color[i] == m, there is no index k for which
+row[k] == i (for the return value of row).
+
+\param subset_entry [out]
+The input value of its elements does not matter.
+Upon return, its size is the input size of row and
+the input entry (row[k], col[k]), or its transpose,
+is the return entry with index subset_entry[k].
+
+\param substitute_ptr [out]
+The input value of its elements does not matter.
+Upon return, its size is one plus the return size of row.
+
+\param substitute [out]
+The input value of its elements does not matter.
+Let v[e] be the value, in column col[e],
+of the sum of the rows with color color[row[e]].
+The value of entry e, for e = 0, 1, ..., is v[e] minus
+the value of entry substitute[ell] for
+substitute_ptr[e] <= ell < substitute_ptr[e+1].
+Note that substitute[ell] < e; i.e., the entries are computed in order.
+*/
+template <class VectorSet>
+void color_acyclic_cppad(
+	const VectorSet&        pattern        ,
+	CppAD::vector<size_t>&  row            ,
+	CppAD::vector<size_t>&  col            ,
+	CppAD::vector<size_t>&  color          ,
+	CppAD::vector<size_t>&  subset_entry   ,
+	CppAD::vector<size_t>&  substitute_ptr ,
+	CppAD::vector<size_t>&  substitute     )
+{	size_t K = row.size();
+	CPPAD_ASSERT_UNKNOWN( col.size() == K );
+	/*
+	See AcyclicColoring, Algorithm 3.1, and the discussion of
+	substitution in Section 5, of
+	New Acyclic and Star Coloring Algorithms with Application to
+	Computing Hessians.
+	*/
+	color_star_graph graph(pattern);
+	size_t m      = graph.n;
+	size_t n_slot = graph.ptr[m];
+	size_t n_edge = graph.n_edge;
+	CPPAD_ASSERT_UNKNOWN( color.size() == m );
+	for(size_t k = 0; k < K; ++k) CPPAD_ASSERT_KNOWN(
+		graph.is_element(row[k], col[k]),
+		"sparse_hes: subset has an element that is not in pattern"
+	);
+	//
+	// parent: disjoint set forest for the edges in each two colored tree
+	CppAD::vector<size_t> parent(n_edge);
+	for(size_t e = 0; e < n_edge; ++e)
+		parent[e] = e;
+	//
+	// forbidden[c] == i + 1 if color c is forbidden for row i
+	CppAD::vector<size_t> forbidden(m);
+	// first_mark[c] == i + 1 if first_edge[c] is an edge from i to color c
+	CppAD::vector<size_t> first_mark(m), first_edge(m);
+	for(size_t c = 0; c < m; ++c)
+	{	forbidden[c]  = 0;
+		first_mark[c] = 0;
+	}
+	// tree_mark[e] == i + 1 if tree e is adjacent to a neighbor of i,
+	// in which case tree_vertex[e] is that neighbor
+	CppAD::vector<size_t> tree_mark(n_edge), tree_vertex(n_edge);
+	for(size_t e = 0; e < n_edge; ++e)
+		tree_mark[e] = 0;
+	//
+	// color
+	CppAD::vector<size_t> sequence;
+	graph.color_sequence(sequence);
+	for(size_t i = 0; i < m; ++i)
+		color[i] = m;
+	for(size_t count = 0; count < m; ++count)
+	{	size_t v = sequence[count];
+		if( graph.degree(v) == 0 && ! graph.diag[v] )
+			continue;
+		// distance one
+		for(size_t s = graph.ptr[v]; s < graph.ptr[v+1]; ++s)
+		{	size_t w = graph.adj[s];
+			if( color[w] < m )
+				forbidden[ color[w] ] = v + 1;
+		}
+		// a color that would connect two neighbors of v that are
+		// in the same two colored tree
+		for(size_t s = graph.ptr[v]; s < graph.ptr[v+1]; ++s)
+		{	size_t w = graph.adj[s];
+			if( color[w] < m )
+			{	for(size_t t = graph.ptr[w]; t < graph.ptr[w+1]; ++t)
+				{	size_t x = graph.adj[t];
+					if( color[x] < m )
+					{	size_t e = color_acyclic_find(parent, graph.edge[t]);
+						if( tree_mark[e] != v + 1 )
+						{	tree_mark[e]   = v + 1;
+							tree_vertex[e] = w;
+						}
+						else if( tree_vertex[e] != w )
+							forbidden[ color[x] ] = v + 1;
+					}
+				}
+			}
+		}
+		size_t c = 0;
+		while( forbidden[c] == v + 1 )
+			++c;
+		color[v] = c;
+		//
+		// add the edges from v to the two colored trees
+		for(size_t s = graph.ptr[v]; s < graph.ptr[v+1]; ++s)
+		{	size_t w = graph.adj[s];
+			size_t d = color[w];
+			if( d < m )
+			{	size_t e = graph.edge[s];
+				// an edge from w to color c
+				size_t t = graph.ptr[w];
+				while( t < graph.ptr[w+1] )
+				{	size_t x = graph.adj[t];
+					if( x != v && color[x] == c )
+					{	color_acyclic_union(parent, e, graph.edge[t]);
+						t = graph.ptr[w+1];
+					}
+					else
+						++t;
+				}
+				// an edge from v to color d
+				if( first_mark[d] != v + 1 )
+				{	first_mark[d] = v + 1;
+					first_edge[d] = e;
+				}
+				else
+					color_acyclic_union(parent, e, first_edge[d]);
+			}
+		}
+	}
+	// -----------------------------------------------------------------------
+	// group: slots for each vertex u and color d of the neighbors of u
+	// (group_mark[d] == u + 1 if group_index[d] is the group for u and d)
+	CppAD::vector<size_t> slot_group(n_slot), group_vertex(n_slot);
+	CppAD::vector<size_t> group_mark(m), group_index(m);
+	for(size_t d = 0; d < m; ++d)
+		group_mark[d] = 0;
+	size_t n_group = 0;
+	for(size_t u = 0; u < m; ++u)
+	{	for(size_t s = graph.ptr[u]; s < graph.ptr[u+1]; ++s)
+		{	size_t d = color[ graph.adj[s] ];
+			if( group_mark[d] != u + 1 )
+			{	group_mark[d]           = u + 1;
+				group_index[d]          = n_group;
+				group_vertex[n_group++] = u;
+			}
+			slot_group[s] = group_index[d];
+		}
+	}
+	CppAD::vector<size_t> group_ptr(n_group + 1), group_slot(n_slot);
+	for(size_t g = 0; g <= n_group; ++g)
+		group_ptr[g] = 0;
+	for(size_t s = 0; s < n_slot; ++s)
+		++group_ptr[ slot_group[s] + 1 ];
+	for(size_t g = 0; g < n_group; ++g)
+		group_ptr[g + 1] += group_ptr[g];
+	CppAD::vector<size_t> remaining(n_group);
+	for(size_t g = 0; g < n_group; ++g)
+		remaining[g] = group_ptr[g];
+	for(size_t s = 0; s < n_slot; ++s)
+		group_slot[ remaining[ slot_group[s] ]++ ] = s;
+	//
+	// entries for the diagonal
+	size_t n_entry = 0;
+	for(size_t i = 0; i < m; ++i)
+		if( graph.diag[i] )
+			++n_entry;
+	n_entry += n_edge;
+	CppAD::vector<size_t> entry_row(n_entry), entry_col(n_entry);
+	CppAD::vector<size_t> diag_entry(m);
+	substitute_ptr.resize(n_entry + 1);
+	substitute.resize(0);
+	size_t e_next = 0;
+	for(size_t i = 0; i < m; ++i)
+	{	diag_entry[i] = n_entry;
+		if( graph.diag[i] )
+		{	diag_entry[i]             = e_next;
+			entry_row[e_next]         = i;
+			entry_col[e_next]         = i;
+			substitute_ptr[e_next++]  = 0;
+		}
+	}
+	substitute_ptr[e_next] = 0;
+	//
+	// off diagonal entries: start with the groups that have one slot
+	CppAD::vector<size_t> edge_entry(n_edge), queue(n_group);
+	for(size_t e = 0; e < n_edge; ++e)
+		edge_entry[e] = n_entry;
+	size_t q_begin = 0;
+	size_t q_end   = 0;
+	for(size_t g = 0; g < n_group; ++g)
+	{	remaining[g] = group_ptr[g+1] - group_ptr[g];
+		if( remaining[g] == 1 )
+			queue[q_end++] = g;
+	}
+	while( q_begin < q_end )
+	{	size_t g = queue[q_begin++];
+		if( remaining[g] == 1 )
+		{	// the slot in this group whose value is not yet known
+			size_t s = n_slot;
+			for(size_t ell = group_ptr[g]; ell < group_ptr[g+1]; ++ell)
+			{	size_t t = group_slot[ell];
+				if( edge_entry[ graph.edge[t] ] == n_entry )
+					s = t;
+				else
+					substitute.push_back( edge_entry[ graph.edge[t] ] );
+			}
+			CPPAD_ASSERT_UNKNOWN( s < n_slot );
+			size_t u = group_vertex[g];
+			size_t w = graph.adj[s];
+			edge_entry[ graph.edge[s] ] = e_next;
+			entry_row[e_next]           = w;
+			entry_col[e_next]           = u;
+			substitute_ptr[++e_next]    = substitute.size();
+			remaining[g]                = 0;
+			//
+			// group for the same edge at vertex w
+			size_t h = slot_group[ graph.slot(w, u) ];
+			if( --remaining[h] == 1 )
+				queue[q_end++] = h;
+		}
+	}
+	CPPAD_ASSERT_UNKNOWN( e_next == n_entry );
+	//
+	// subset_entry
+	subset_entry.resize(K);
+	for(size_t k = 0; k < K; ++k)
+	{	size_t i = row[k];
+		size_t j = col[k];
+		if( i == j )
+			subset_entry[k] = diag_entry[i];
+		else
+			subset_entry[k] = edge_entry[ graph.edge[ graph.slot(i, j) ] ];
+		CPPAD_ASSERT_UNKNOWN( subset_entry[k] < n_entry );
+	}
+	//
+	// row, col, color
+	row.resize(n_entry);
+	col.resize(n_entry);
+	for(size_t e = 0; e < n_entry; ++e)
+	{	row[e] = entry_row[e];
+		col[e] = entry_col[e];
+	}
+	color_star_renumber(row, color);
+}
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+# endif
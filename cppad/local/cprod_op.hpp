@@ -0,0 +1,671 @@
+# ifndef CPPAD_LOCAL_CPROD_OP_HPP
+# define CPPAD_LOCAL_CPROD_OP_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file cprod_op.hpp
+Forward, reverse and sparsity calculations for cumulative product.
+*/
+
+/*!
+Value of the parameter factors in a cumulative product.
+
+\param arg
+-- arg[0]
+parameter[arg[0]] is the constant parameter factor s in this product.
+
+-- arg[1]
+end in arg of the variables in product.
+
+-- arg[2]
+end in arg of the dynamic parameters in product.
+arg[arg[1]] , ... , arg[arg[2]-1] correspond to d(0), ... , d(n-1).
+
+\param num_par
+is the number of parameters in parameter.
+
+\param parameter
+is the parameter vector for this operation sequence.
+
+\return
+is the product s * d(0) * ... * d(n-1).
+*/
+template <class Base>
+inline Base cprod_par_factor(
+	const addr_t* arg         ,
+	size_t        num_par     ,
+	const Base*   parameter   )
+{	CPPAD_ASSERT_UNKNOWN( size_t(arg[0]) < num_par );
+	Base c = parameter[ arg[0] ];
+	for(size_t i = size_t(arg[1]); i < size_t(arg[2]); ++i)
+	{	CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < num_par );
+		c *= parameter[ arg[i] ];
+	}
+	return c;
+}
+
+/*!
+Compute forward mode Taylor coefficients for result of op = CProdOp.
+
+This operation is
+\verbatim
+	z = s * x(0) * ... * x(m-1) * d(0) * ... * d(n-1).
+\endverbatim
+
+\tparam Base
+base type for the operator; i.e., this operation was recorded
+using AD< Base > and computations by this routine are done using type
+Base.
+
+\param p
+lowest order of the Taylor coefficient that we are computing.
+
+\param q
+highest order of the Taylor coefficient that we are computing.
+
+\param i_z
+variable index corresponding to the result for this operation;
+i.e. the row index in taylor corresponding to z.
+
+\param arg
+-- arg[0]
+parameter[arg[0]] is the constant parameter factor s in this product.
+
+-- arg[1]
+end in arg of the variables in product.
+arg[3] , ... , arg[arg[1]-1] correspond to x(0), ... , x(m-1)
+
+-- arg[2]
+end in arg of the dynamic parameters in product.
+arg[arg[1]] , ... , arg[arg[2]-1] correspond to d(0), ... , d(n-1)
+
+\param num_par
+is the number of parameters in parameter.
+
+\param parameter
+is the parameter vector for this operation sequence.
+
+\param cap_order
+number of colums in the matrix containing all the Taylor coefficients.
+
+\param taylor
+\b Input: taylor [ arg[3+i] * cap_order + k ]
+for i = 0, ..., m-1
+and k = 0 , ... , q
+is the k-th order Taylor coefficient corresponding to x(i)
+\n
+\b Input: taylor [ i_z * cap_order + k ]
+for k = 0 , ... , p-1,
+is the k-th order Taylor coefficient corresponding to z.
+\n
+\b Output: taylor [ i_z * cap_order + k ]
+for k = 0 , ... , q,
+is the k-th order Taylor coefficient corresponding to z.
+The partial products are not stored, so the coefficients of order
+less than p are recomputed (to the same values they had on input).
+*/
+template <class Base>
+inline void forward_cprod_op(
+	size_t        p           ,
+	size_t        q           ,
+	size_t        i_z         ,
+	const addr_t* arg         ,
+	size_t        num_par     ,
+	const Base*   parameter   ,
+	size_t        cap_order   ,
+	Base*         taylor      )
+{
+	// check assumptions
+	CPPAD_ASSERT_UNKNOWN( NumRes(CProdOp) == 1 );
+	CPPAD_ASSERT_UNKNOWN( q < cap_order );
+	CPPAD_ASSERT_UNKNOWN( p <= q );
+	CPPAD_ASSERT_UNKNOWN( 3 < arg[1] );
+	CPPAD_ASSERT_UNKNOWN(
+		arg[arg[2]] == arg[2]
+	);
+
+	// product of the parameter factors
+	Base c = cprod_par_factor(arg, num_par, parameter);
+
+	// Taylor coefficients corresponding to result
+	Base* z = taylor + i_z    * cap_order;
+	Base* x = taylor + arg[3] * cap_order;
+	CPPAD_ASSERT_UNKNOWN( size_t(arg[3]) < i_z );
+	for(size_t k = 0; k <= q; k++)
+		z[k] = c * x[k];
+	for(size_t i = 4; i < size_t(arg[1]); ++i)
+	{	CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < i_z );
+		x = taylor + arg[i] * cap_order;
+		// z = z * x(i) in place (z[j] for j < k is not yet changed)
+		size_t k = q + 1;
+		while(k--)
+		{	Base sum = z[0] * x[k];
+			for(size_t j = 1; j <= k; j++)
+				sum += z[j] * x[k-j];
+			z[k] = sum;
+		}
+	}
+}
+
+/*!
+Multiple direction forward mode Taylor coefficients for op = CProdOp.
+
+This operation is
+\verbatim
+	z = s * x(0) * ... * x(m-1) * d(0) * ... * d(n-1).
+\endverbatim
+
+\tparam Base
+base type for the operator; i.e., this operation was recorded
+using AD<Base> and computations by this routine are done using type
+Base.
+
+\param q
+order ot the Taylor coefficients that we are computing.
+
+\param r
+number of directions for Taylor coefficients that we are computing.
+
+\param i_z
+variable index corresponding to the result for this operation;
+i.e. the row index in taylor corresponding to z.
+
+\param arg
+-- arg[0]
+parameter[arg[0]] is the constant parameter factor s in this product.
+
+-- arg[1]
+end in arg of the variables in product.
+arg[3] , ... , arg[arg[1]-1] correspond to x(0), ... , x(m-1)
+
+-- arg[2]
+end in arg of the dynamic parameters in product.
+arg[arg[1]] , ... , arg[arg[2]-1] correspond to d(0), ... , d(n-1)
+
+\param num_par
+is the number of parameters in parameter.
+
+\param parameter
+is the parameter vector for this operation sequence.
+
+\param cap_order
+number of colums in the matrix containing all the Taylor coefficients.
+
+\param taylor
+\b Input: taylor [ arg[3+i]*((cap_order-1)*r + 1) + 0 ]
+for i = 0, ..., m-1
+is the 0-th order Taylor coefficient corresponding to x(i) and
+taylor [ arg[3+i]*((cap_order-1)*r + 1) + (k-1)*r + ell + 1 ]
+for i = 0, ..., m-1,
+k = 1 , ... , q,
+ell = 0 , ... , r-1
+is the k-th order Taylor coefficient corresponding to x(i)
+and direction ell.
+\n
+\b Input: taylor [ i_z*((cap_order-1)*r+1) + (k-1)*r + ell + 1 ]
+for k = 1 , ... , q-1,
+is the k-th order Taylor coefficient corresponding to z
+for direction ell = 0 , ... , r-1.
+\n
+\b Output: taylor [ i_z*((cap_order-1)*r+1) + (q-1)*r + ell + 1 ]
+is the q-th order Taylor coefficient corresponding to z
+for direction ell = 0 , ... , r-1.
+The lower order coefficients for z are recomputed
+(to the same values they had on input).
+*/
+template <class Base>
+inline void forward_cprod_op_dir(
+	size_t        q           ,
+	size_t        r           ,
+	size_t        i_z         ,
+	const addr_t* arg         ,
+	size_t        num_par     ,
+	const Base*   parameter   ,
+	size_t        cap_order   ,
+	Base*         taylor      )
+{
+	// check assumptions
+	CPPAD_ASSERT_UNKNOWN( NumRes(CProdOp) == 1 );
+	CPPAD_ASSERT_UNKNOWN( q < cap_order );
+	CPPAD_ASSERT_UNKNOWN( 0 < q );
+	CPPAD_ASSERT_UNKNOWN( 3 < arg[1] );
+	CPPAD_ASSERT_UNKNOWN(
+		arg[arg[2]] == arg[2]
+	);
+
+	// product of the parameter factors
+	Base c = cprod_par_factor(arg, num_par, parameter);
+
+	// Taylor coefficients corresponding to result
+	size_t num_taylor_per_var = (cap_order-1) * r + 1;
+	Base* z = taylor + i_z * num_taylor_per_var;
+	Base* x;
+	for(size_t ell = 0; ell < r; ell++)
+	{	// index in z and x of k-th order coefficient for this direction
+		// is 0 for k = 0 and (k-1)*r + ell + 1 for k > 0
+		x = taylor + arg[3] * num_taylor_per_var;
+		z[0] = c * x[0];
+		for(size_t k = 1; k <= q; k++)
+		{	size_t m = (k-1) * r + ell + 1;
+			z[m] = c * x[m];
+		}
+		for(size_t i = 4; i < size_t(arg[1]); ++i)
+		{	CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < i_z );
+			x = taylor + arg[i] * num_taylor_per_var;
+			// z = z * x(i) in place (z[j] for j < k is not yet changed)
+			size_t k = q + 1;
+			while(k--)
+			{	size_t m_k = 0;
+				if( k > 0 )
+					m_k = (k-1) * r + ell + 1;
+				Base sum = z[0] * x[m_k];
+				for(size_t j = 1; j <= k; j++)
+				{	size_t m_j  = (j-1) * r + ell + 1;
+					size_t m_kj = 0;
+					if( j < k )
+						m_kj = (k-j-1) * r + ell + 1;
+					sum += z[m_j] * x[m_kj];
+				}
+				z[m_k] = sum;
+			}
+		}
+	}
+}
+
+/*!
+Compute reverse mode Taylor coefficients for result of op = CProdOp.
+
+This operation is
+\verbatim
+	z = s * x(0) * ... * x(m-1) * d(0) * ... * d(n-1).
+	H(x, w, ...) = G[ z(x), x, w, ... ]
+\endverbatim
+
+\tparam Base
+base type for the operator; i.e., this operation was recorded
+using AD< Base > and computations by this routine are done using type
+Base.
+
+\param d
+order the highest order Taylor coefficient that we are computing
+the partial derivatives with respect to.
+
+\param i_z
+variable index corresponding to the result for this operation;
+i.e. the row index in taylor corresponding to z.
+
+\param arg
+-- arg[0]
+parameter[arg[0]] is the constant parameter factor s in this product.
+
+-- arg[1]
+end in arg of the variables in product.
+arg[3] , ... , arg[arg[1]-1] correspond to x(0), ... , x(m-1)
+
+-- arg[2]
+end in arg of the dynamic parameters in product.
+arg[arg[1]] , ... , arg[arg[2]-1] correspond to d(0), ... , d(n-1)
+
+\param num_par
+is the number of parameters in parameter.
+
+\param parameter
+is the parameter vector for this operation sequence.
+
+\param cap_order
+number of colums in the matrix containing all the Taylor coefficients.
+
+\param taylor
+\b Input: taylor [ arg[3+i] * cap_order + k ]
+for i = 0, ..., m-1
+and k = 0 , ... , d
+is the k-th order Taylor coefficient corresponding to x(i).
+
+\param nc_partial
+number of colums in the matrix containing all the partial derivatives.
+
+\param partial
+\b Input: partial [ arg[3+i] * nc_partial + k ]
+for i = 0, ..., m-1
+and k = 0 , ... , d
+is the partial derivative of G(z, x, w, ...) with respect to the
+k-th order Taylor coefficient corresponding to x(i)
+\n
+\b Input: partial [ i_z * nc_partial + k ]
+for k = 0 , ... , d
+is the partial derivative of G(z, x, w, ...) with respect to the
+k-th order Taylor coefficient corresponding to z.
+\n
+\b Output: partial [ arg[3+i] * nc_partial + k ]
+for i = 0, ..., m-1
+and k = 0 , ... , d
+is the partial derivative of H(x, w, ...) with respect to the
+k-th order Taylor coefficient corresponding to x(i)
+
+\param work
+is work space with at least (m + 1) * (d + 1) elements.
+Its input and output values do not matter.
+It is provided by the caller so that the sweeps do not allocate memory
+for each CProdOp operator (and so that the team threads used by
+reverse_level do not allocate memory).
+*/
+template <class Base>
+inline void reverse_cprod_op(
+	size_t        d           ,
+	size_t        i_z         ,
+	const addr_t* arg         ,
+	size_t        num_par     ,
+	const Base*   parameter   ,
+	size_t        cap_order   ,
+	const Base*   taylor      ,
+	size_t        nc_partial  ,
+	Base*         partial     ,
+	Base*         work        )
+{
+	// check assumptions
+	CPPAD_ASSERT_UNKNOWN( NumRes(CProdOp) == 1 );
+	CPPAD_ASSERT_UNKNOWN( d < cap_order );
+	CPPAD_ASSERT_UNKNOWN( d < nc_partial );
+	CPPAD_ASSERT_UNKNOWN( 3 < arg[1] );
+
+	// number of variables in the product
+	size_t m  = size_t(arg[1]) - 3;
+	size_t d1 = d + 1;
+
+	// prefix[j*d1 + k] is the k-th order Taylor coefficient for
+	// s * d(0) * ... * d(n-1) * x(0) * ... * x(j-1).
+	Base* prefix = work;
+	prefix[0] = cprod_par_factor(arg, num_par, parameter);
+	for(size_t k = 1; k < d1; k++)
+		prefix[k] = Base(0.0);
+	for(size_t j = 1; j < m; j++)
+	{	const Base* x  = taylor + arg[3 + j - 1] * cap_order;
+		const Base* pr = prefix + (j-1) * d1;
+		Base*       pj = prefix + j * d1;
+		for(size_t k = 0; k < d1; k++)
+		{	pj[k] = pr[0] * x[k];
+			for(size_t i = 1; i <= k; i++)
+				pj[k] += pr[i] * x[k-i];
+		}
+	}
+
+	// partial of G with respect to the product of the first j+1 factors
+	const Base* pz = partial + i_z * nc_partial;
+	Base*       r  = work + m * d1;
+	for(size_t k = 0; k < d1; k++)
+		r[k] = pz[k];
+	size_t j = m;
+	while(j--)
+	{	CPPAD_ASSERT_UNKNOWN( size_t(arg[3 + j]) < i_z );
+		const Base* x  = taylor  + arg[3 + j] * cap_order;
+		Base*       px = partial + arg[3 + j] * nc_partial;
+		const Base* pj = prefix + j * d1;
+		//
+		// partial with respect to x(j)
+		for(size_t i = 0; i < d1; i++)
+		{	for(size_t k = i; k < d1; k++)
+				px[i] += r[k] * pj[k-i];
+		}
+		//
+		// partial with respect to product of first j factors
+		// (r[k] for k > ell is not yet changed)
+		for(size_t ell = 0; ell < d1; ell++)
+		{	Base sum = r[ell] * x[0];
+			for(size_t k = ell + 1; k < d1; k++)
+				sum += r[k] * x[k-ell];
+			r[ell] = sum;
+		}
+	}
+}
+
+/*!
+Forward mode Jacobian sparsity pattern for CProdOp operator.
+
+This operation is
+\verbatim
+	z = s * x(0) * ... * x(m-1) * d(0) * ... * d(n-1).
+\endverbatim
+
+\tparam Vector_set
+is the type used for vectors of sets. It can be either
+sparse_pack or sparse_list.
+
+\param i_z
+variable index corresponding to the result for this operation;
+i.e. the index in sparsity corresponding to z.
+
+\param arg
+-- arg[1]
+end in arg of the variables in product.
+arg[3] , ... , arg[arg[1]-1] correspond to x(0), ... , x(m-1)
+
+\param sparsity
+\b Input:
+For i = 0, ..., m-1,
+the set with index arg[3+i] in sparsity
+is the sparsity bit pattern for x(i).
+This identifies which of the independent variables the variable
+x(i) depends on.
+\n
+\b Output:
+The set with index i_z in sparsity
+is the sparsity bit pattern for z.
+This identifies which of the independent variables the variable z
+depends on.
+*/
+template <class Vector_set>
+inline void forward_sparse_jacobian_cprod_op(
+	size_t           i_z         ,
+	const addr_t*    arg         ,
+	Vector_set&      sparsity    )
+{	sparsity.clear(i_z);
+
+	for(size_t i = 3; i < size_t(arg[1]); ++i)
+	{	CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < i_z );
+		sparsity.binary_union(
+			i_z        , // index in sparsity for result
+			i_z        , // index in sparsity for left operand
+			arg[i]     , // index for right operand
+			sparsity     // sparsity vector for right operand
+		);
+	}
+}
+
+/*!
+Reverse mode Jacobian sparsity pattern for CProdOp operator.
+
+This operation is
+\verbatim
+	z = s * x(0) * ... * x(m-1) * d(0) * ... * d(n-1).
+	H(x, w, ...) = G[ z(x), x, w, ... ]
+\endverbatim
+
+\tparam Vector_set
+is the type used for vectors of sets. It can be either
+sparse_pack or sparse_list.
+
+\param i_z
+variable index corresponding to the result for this operation;
+i.e. the index in sparsity corresponding to z.
+
+\param arg
+-- arg[1]
+end in arg of the variables in product.
+arg[3] , ... , arg[arg[1]-1] correspond to x(0), ... , x(m-1)
+
+\param sparsity
+For i = 0, ..., m-1,
+the set with index arg[3+i] in sparsity
+is the sparsity bit pattern for x(i).
+This identifies which of the dependent variables depend on x(i).
+On input, the sparsity patter corresponds to G,
+and on ouput it corresponds to H.
+\n
+\b Input:
+The set with index i_z in sparsity
+is the sparsity bit pattern for z.
+On input it corresponds to G and on output it is undefined.
+*/
+template <class Vector_set>
+inline void reverse_sparse_jacobian_cprod_op(
+	size_t           i_z         ,
+	const addr_t*    arg         ,
+	Vector_set&      sparsity    )
+{
+	for(size_t i = 3; i < size_t(arg[1]); ++i)
+	{
+		CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < i_z );
+		sparsity.binary_union(
+			arg[i]     , // index in sparsity for result
+			arg[i]     , // index in sparsity for left operand
+			i_z        , // index for right operand
+			sparsity     // sparsity vector for right operand
+		);
+	}
+}
+
+/*!
+Reverse mode Hessian sparsity pattern for CProdOp operator.
+
+This operation is
+\verbatim
+	z = s * x(0) * ... * x(m-1) * d(0) * ... * d(n-1).
+	H(x, w, ...) = G[ z(x), x, w, ... ]
+\endverbatim
+
+\tparam Vector_set
+is the type used for vectors of sets. It can be either
+sparse_pack or sparse_list.
+
+\param i_z
+variable index corresponding to the result for this operation;
+i.e. the index in sparsity corresponding to z.
+
+\param arg
+-- arg[1]
+end in arg of the variables in product.
+arg[3] , ... , arg[arg[1]-1] correspond to x(0), ... , x(m-1)
+
+\param rev_jacobian
+rev_jacobian[i_z]
+is all false (true) if the Jabobian of G with respect to z must be zero
+(may be non-zero).
+\n
+\n
+For i = 0, ..., m-1
+rev_jacobian[ arg[3+i] ]
+is all false (true) if the Jacobian with respect to x(i)
+is zero (may be non-zero).
+On input, it corresponds to the function G,
+and on output it corresponds to the function H.
+
+\param for_jac_sparsity
+The set with index arg[3+i] in for_jac_sparsity
+is the forward Jacobian sparsity pattern for x(i).
+
+\param rev_hes_sparsity
+The set with index i_z in in rev_hes_sparsity
+is the Hessian sparsity pattern for the fucntion G
+where one of the partials derivative is with respect to z.
+\n
+\n
+For i = 0, ..., m-1
+The set with index arg[3+i] in rev_hes_sparsity
+is the Hessian sparsity pattern
+where one of the partials derivative is with respect to x(i).
+On input, it corresponds to the function G,
+and on output it corresponds to the function H.
+
+\par Cost
+The cross terms are computed for each pair of factors, so the
+cost is proportional to the square of the number of variables m.
+*/
+template <class Vector_set>
+inline void reverse_sparse_hessian_cprod_op(
+	size_t               i_z                 ,
+	const addr_t*        arg                 ,
+	bool*                rev_jacobian        ,
+	const Vector_set&    for_jac_sparsity    ,
+	Vector_set&          rev_hes_sparsity    )
+{	size_t end = size_t(arg[1]);
+	for(size_t i = 3; i < end; ++i)
+	{	CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < i_z );
+		rev_hes_sparsity.binary_union(
+			arg[i], arg[i], i_z, rev_hes_sparsity
+		);
+		if( rev_jacobian[i_z] )
+		{	for(size_t j = 3; j < end; ++j) if( j != i )
+			{	rev_hes_sparsity.binary_union(
+					arg[i], arg[i], arg[j], for_jac_sparsity
+				);
+			}
+		}
+	}
+	for(size_t i = 3; i < end; ++i)
+		rev_jacobian[arg[i]] |= rev_jacobian[i_z];
+	return;
+}
+
+/*!
+Forward mode Hessian sparsity pattern for CProdOp operator.
+
+This operation is
+\verbatim
+	z = s * x(0) * ... * x(m-1) * d(0) * ... * d(n-1).
+\endverbatim
+
+\param arg
+-- arg[1]
+end in arg of the variables in product.
+arg[3] , ... , arg[arg[1]-1] correspond to x(0), ... , x(m-1)
+
+\param for_jac_sparsity
+for_jac_sparsity(arg[3+i]) constains the Jacobian sparsity for x(i).
+
+\param for_hes_sparsity
+On input, for_hes_sparsity includes the Hessian sparsity for x(i)
+for i = 0, ..., m-1; i.e., the sparsity can be a super set.
+Upon return it includes the Hessian sparsity for z.
+
+\par Cost
+The cross terms are computed for each pair of factors, so the
+cost is proportional to the square of the number of variables m.
+*/
+template <class Vector_set>
+inline void forward_sparse_hessian_cprod_op(
+	const addr_t*       arg               ,
+	const Vector_set&   for_jac_sparsity  ,
+	Vector_set&         for_hes_sparsity  )
+{	size_t end = size_t(arg[1]);
+	for(size_t i = 3; i < end; ++i)
+	{	// set of independent variables that x(i) depends on
+		typename Vector_set::const_iterator itr(for_jac_sparsity, arg[i]);
+		//
+		// loop over dependent variables with non-zero partial
+		size_t i_x = *itr;
+		while( i_x < for_jac_sparsity.end() )
+		{	// N(i_x) = N(i_x) union L(x(j)) for j != i
+			for(size_t j = 3; j < end; ++j) if( j != i )
+			{	for_hes_sparsity.binary_union(
+					i_x, i_x, arg[j], for_jac_sparsity
+				);
+			}
+			i_x = *(++itr);
+		}
+	}
+	return;
+}
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+# endif
@@ -45,6 +45,7 @@ namespace CppAD {
 	typedef CPPAD_TAPE_ID_TYPE   tape_id_t;
 
 	// classes
+	class fun_jit;
 	class sparse_hes_work;
 	class sparse_jac_work;
 	class sparse_jacobian_work;
@@ -53,6 +54,7 @@ namespace CppAD {
 	template <class Base> class ADFun;
 	template <class Base> class atomic_base;
 	template <class Base> class discrete;
+	template <class Base> class fun_work;
 	template <class Base> class VecAD;
 	template <class Base> class VecAD_reference;
 
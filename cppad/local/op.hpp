@@ -32,6 +32,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 # include <cppad/local/cosh_op.hpp>
 # include <cppad/local/cskip_op.hpp>
 # include <cppad/local/csum_op.hpp>
+# include <cppad/local/cprod_op.hpp>
 # include <cppad/local/discrete_op.hpp>
 # include <cppad/local/div_op.hpp>
 # include <cppad/local/erf_op.hpp>
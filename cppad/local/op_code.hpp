@@ -72,6 +72,13 @@ enum OpCode {
 	// arg[5]     = index correspoding to falseCase
 	CosOp,    // cos(variable)
 	CoshOp,   // cosh(variable)
+	CProdOp,  // Cumulative product
+	// arg[0] = index of constant parameter that initializes product
+	// arg[1] = end in arg of variables in product
+	// arg[2] = end in arg of dynamic parameters in product
+	// arg[3],      ... , arg[arg[1]-1]: indices for variables
+	// arg[arg[1]], ... , arg[arg[2]-1]: indices for dynamic parameters
+	// arg[arg[2]] = arg[2]
 	CSkipOp,  // Conditional skip
 	// arg[0]     = the Rel operator: Lt, Le, Eq, Ge, Gt, or Ne
 	// arg[1] & 1 = is left a variable
@@ -198,6 +205,7 @@ inline size_t NumArg( OpCode op)
 		6, // CExpOp
 		1, // CosOp
 		1, // CoshOp
+		0, // CProdOp  (actually has a variable number of arguments, not zero)
 		0, // CSkipOp  (actually has a variable number of arguments, not zero)
 		0, // CSumOp   (actually has a variable number of arguments, not zero)
 		2, // DisOp
@@ -314,6 +322,7 @@ inline size_t NumRes(OpCode op)
 		1, // CExpOp
 		2, // CosOp
 		2, // CoshOp
+		1, // CProdOp
 		0, // CSkipOp
 		1, // CSumOp
 		1, // DisOp
@@ -409,6 +418,7 @@ inline const char* OpName(OpCode op)
 		"CExp"  ,
 		"Cos"   ,
 		"Cosh"  ,
+		"CProd" ,
 		"CSkip" ,
 		"CSum"  ,
 		"Dis"   ,
@@ -667,6 +677,23 @@ void printOp(
 			 printOpField(os, " -d=", play->GetPar(ind[i]), ncol);
 		break;
 
+		case CProdOp:
+		/*
+		ind[0] = index of constant parameter that initializes product
+		ind[1] = end in ind of variables in product
+		ind[2] = end in ind of dynamic parameters in product
+		ind[3],      ... , ind[ind[1]-1]: indices for variables
+		ind[ind[1]], ... , ind[ind[2]-1]: indices for dynamic parameters
+		ind[ind[2]] = ind[2]
+		*/
+		CPPAD_ASSERT_UNKNOWN( ind[ind[2]] == ind[2] );
+		printOpField(os, " pr=", play->GetPar(ind[0]), ncol);
+		for(i = 3; i < size_t(ind[1]); i++)
+			 printOpField(os, " *v=", ind[i], ncol);
+		for(i = size_t(ind[1]); i < size_t(ind[2]); i++)
+			 printOpField(os, " *d=", play->GetPar(ind[i]), ncol);
+		break;
+
 		case LdpOp:
 		CPPAD_ASSERT_UNKNOWN( NumArg(op) == 3 );
 		printOpField(os, "off=", ind[0], ncol);
@@ -910,7 +937,7 @@ void printOpResult(
 Determines which arguments are variaibles for an operator.
 
 \param op
-is the operator. Note that CSkipOp and CSumOp are special cases
+is the operator. Note that CProdOp, CSkipOp and CSumOp are special cases
 because the true number of arguments is not equal to NumArg(op)
 and the true number of arguments num_arg can be large.
 It may be more efficient to handle these cases separately
@@ -923,12 +950,21 @@ is the argument vector for this operator.
 If the input value of the elements in this vector do not matter.
 Upon return, resize has been used to set its size to the true number
 of arguments to this operator.
-If op != CSkipOp and op != CSumOp, is_variable.size() = NumArg(op).
+If op is not CProdOp, CSkipOp, or CSumOp, is_variable.size() = NumArg(op).
 The j-th argument for this operator is a
 variable index if and only if is_variable[j] is true. Note that the variable
 index 0, for the BeginOp, does not correspond to a real variable and false
 is returned for this case.
 
+\par CProdOp
+In the case of CProdOp,
+\code
+		is_variable.size() = arg[2]
+		for(size_t j = 3; j < arg[1]; ++j)
+			is_variable[j] = true;
+\endcode
+and all the other is_variable values are false.
+
 \par CSkipOp
 In the case of CSkipOp,
 \code
@@ -1111,10 +1147,10 @@ inline void arg_is_variable(
 		CPPAD_ASSERT_UNKNOWN( NumArg(op) == 6 );
 		is_variable[0] = false;
 		is_variable[1] = false;
-		is_variable[2] = (arg[0] & 1) != 0;
-		is_variable[3] = (arg[0] & 2) != 0;
-		is_variable[4] = (arg[0] & 4) != 0;
-		is_variable[5] = (arg[0] & 8) != 0;
+		is_variable[2] = (arg[1] & 1) != 0;
+		is_variable[3] = (arg[1] & 2) != 0;
+		is_variable[4] = (arg[1] & 4) != 0;
+		is_variable[5] = (arg[1] & 8) != 0;
 		break;
 
 		// -------------------------------------------------------------------
@@ -1133,6 +1169,19 @@ inline void arg_is_variable(
 			is_variable[i] = false;
 		break;
 
+		// -------------------------------------------------------------------
+		// CProdOp:
+		case CProdOp:
+		CPPAD_ASSERT_UNKNOWN( NumArg(op) == 0 )
+		//
+		// true number of arguments
+		num_arg = arg[2];
+		//
+		is_variable.resize( num_arg );
+		for(size_t i = 0; i < num_arg; ++i)
+			is_variable[i] = (3 <= i) & (i < size_t(arg[1]));
+		break;
+
 		// -------------------------------------------------------------------
 		// CSumOp:
 		case CSumOp:
@@ -0,0 +1,39 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_CPROD_STACKS_HPP
+# define CPPAD_LOCAL_OPTIMIZE_CPROD_STACKS_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+# include <stack>
+
+/*!
+\file cprod_stacks.hpp
+Information about one cumulative product operation.
+*/
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize  {
+/*!
+Information about one cumulative product operation.
+*/
+struct struct_cprod_stacks {
+
+	/// old operator indices for this cumulative product
+	std::stack<addr_t>                          op;
+
+	/// old variable indices to be multiplied
+	std::stack<addr_t>                          var;
+
+	/// dynamic parameter indices to be multiplied
+	std::stack<addr_t>                          dyn;
+};
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
@@ -166,6 +166,7 @@ void get_cexp_info(
 	{	size_t j_op = i_op;
 		bool keep = op_usage[i_op] != usage_t(no_usage);
 		keep     &= op_usage[i_op] != usage_t(csum_usage);
+		keep     &= op_usage[i_op] != usage_t(cprod_usage);
 		keep     &= op_previous[i_op] == 0;
 		if( keep )
 		{	sparse_list_const_iterator itr(cexp_set, i_op);
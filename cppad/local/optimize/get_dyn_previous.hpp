@@ -0,0 +1,220 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_GET_DYN_PREVIOUS_HPP
+# define CPPAD_LOCAL_OPTIMIZE_GET_DYN_PREVIOUS_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*!
+\file get_dyn_previous.hpp
+Compute dynamic parameters that can be folded or replaced by previous ones.
+*/
+# include <algorithm>
+# include <cppad/local/optimize/hash_code.hpp>
+# include <cppad/local/optimize/op_hash_table.hpp>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize {
+
+/*!
+Constant folding and common subexpression detection
+for the dynamic parameter operators.
+
+\tparam Base
+base type for the operator; i.e., this operation sequence was recorded
+using AD<Base> and computations by this routine are done using type Base.
+
+\param play
+This is the old operation sequence.
+
+\param dyn_previous
+The input size of this vector must be zero.
+Upon return it has size equal to the number of parameters
+in the operation sequence; i.e., num_par = play->num_par_rec().
+For each parameter index i_par, dyn_previous[i_par] is one of the following:
+
+\li
+If i_par is a constant parameter, an independent dynamic parameter,
+or a dynamic parameter that must be recorded,
+dyn_previous[i_par] == i_par.
+
+\li
+If dyn_previous[i_par] == num_par, the value of this dynamic parameter
+does not depend on the independent dynamic parameters
+and it can be recorded as the constant play->GetPar(i_par).
+
+\li
+Otherwise, j_par = dyn_previous[i_par] is less than i_par
+and the parameter with index j_par is equal to this parameter
+for all values of the independent dynamic parameters.
+In this case dyn_previous[j_par] is j_par or num_par.
+
+\par Folding
+A dynamic parameter is folded to a constant if all of its arguments are
+constant (the comparison operator for cond_exp_dyn is not an argument).
+The following identities are also used, where c and d are constants:
+x + 0, 0 + x, x - 0, x * 1, 1 * x, x / 1, pow(x, 1), azmul(x, 1),
+and azmul(1, x) are replaced by x;
+cond_exp(cop, l, r, x, x) is replaced by x;
+and cond_exp(cop, c, d, x, y) is replaced by x or y.
+
+\par Previous
+If the operator and the arguments (after the replacements above)
+for a dynamic parameter are the same as for a previous dynamic parameter,
+it is replaced by the previous one.
+The add_dyn and mul_dyn operators are commutative in this comparison.
+*/
+template <class Base>
+void get_dyn_previous(
+	const player<Base>*        play         ,
+	pod_vector<addr_t>&        dyn_previous )
+{	CPPAD_ASSERT_UNKNOWN( dyn_previous.size() == 0 );
+	//
+	// number of parameters in the tape
+	const size_t num_par = play->num_par_rec();
+	//
+	// number of dynamic parameters
+	const size_t num_dynamic_par = play->num_dynamic_par();
+	//
+	// dynamic parameter information
+	const pod_vector<bool>&      dyn_par_is( play->dyn_par_is() );
+	const pod_vector<opcode_t>&  dyn_par_op( play->dyn_par_op() );
+	const pod_vector<addr_t>&    dyn_par_arg( play->dyn_par_arg() );
+	const pod_vector<addr_t>&    dyn_ind2par_ind( play->dyn_ind2par_ind() );
+	//
+	// initialize dyn_previous
+	dyn_previous.resize(num_par);
+	for(size_t i_par = 0; i_par < num_par; ++i_par)
+		dyn_previous[i_par] = addr_t( i_par );
+	//
+	// arguments after replacement for each dynamic parameter that
+	// is recorded, the arguments to add_dyn and mul_dyn are sorted
+	pod_vector<addr_t> new_arg( dyn_par_arg.size() );
+	//
+	// index in new_arg of first argument for each dynamic parameter
+	pod_vector<addr_t> arg_start( num_dynamic_par );
+	//
+	// hash table for dynamic parameter indices
+	op_hash_table hash_table_dyn;
+	hash_table_dyn.resize(num_dynamic_par);
+	//
+	size_t i_arg = 0; // index in dyn_par_arg
+	for(size_t i_dyn = 0; i_dyn < num_dynamic_par; ++i_dyn)
+	{	// parameter index for this dynamic parameter
+		size_t i_par = dyn_ind2par_ind[i_dyn];
+		CPPAD_ASSERT_UNKNOWN( dyn_par_is[i_par] );
+		//
+		// operator and number of arguments
+		op_code_dyn op = op_code_dyn( dyn_par_op[i_dyn] );
+		size_t n_arg   = num_arg_dyn(op);
+		CPPAD_ASSERT_UNKNOWN( n_arg <= 5 );
+		arg_start[i_dyn] = addr_t( i_arg );
+		//
+		// arguments after replacement and which ones are constant
+		addr_t* arg = new_arg.data() + i_arg;
+		bool    con[5];
+		bool    all_con = op != ind_dyn;
+		for(size_t k = 0; k < n_arg; ++k)
+		{	size_t j_par = dyn_par_arg[i_arg + k];
+			con[k]       = true;
+			if( op != cond_exp_dyn || k > 0 )
+			{	if( size_t( dyn_previous[j_par] ) != num_par )
+					j_par = dyn_previous[j_par];
+				con[k]   = ! dyn_par_is[j_par];
+				con[k]  |= size_t( dyn_previous[j_par] ) == num_par;
+				all_con &= con[k];
+			}
+			arg[k] = addr_t( j_par );
+		}
+		i_arg += n_arg;
+		//
+		// check for folding this dynamic parameter
+		size_t previous = i_par;
+		if( all_con )
+			previous = num_par;
+		else switch( op )
+		{
+			case add_dyn:
+			if( con[1] && IdenticalZero( play->GetPar( arg[1] ) ) )
+				previous = arg[0];
+			else if( con[0] && IdenticalZero( play->GetPar( arg[0] ) ) )
+				previous = arg[1];
+			break;
+
+			case sub_dyn:
+			if( con[1] && IdenticalZero( play->GetPar( arg[1] ) ) )
+				previous = arg[0];
+			break;
+
+			case mul_dyn:
+			case zmul_dyn:
+			if( con[1] && IdenticalOne( play->GetPar( arg[1] ) ) )
+				previous = arg[0];
+			else if( con[0] && IdenticalOne( play->GetPar( arg[0] ) ) )
+				previous = arg[1];
+			break;
+
+			case div_dyn:
+			case pow_dyn:
+			if( con[1] && IdenticalOne( play->GetPar( arg[1] ) ) )
+				previous = arg[0];
+			break;
+
+			case cond_exp_dyn:
+			if( arg[3] == arg[4] )
+				previous = arg[3];
+			else if( con[1] && con[2] )
+			{	Base flag = CondExpOp(
+					CompareOp( arg[0] )    ,
+					play->GetPar( arg[1] ) ,
+					play->GetPar( arg[2] ) ,
+					Base(1.0)              ,
+					Base(0.0)
+				);
+				if( IdenticalOne(flag) )
+					previous = arg[3];
+				else if( IdenticalZero(flag) )
+					previous = arg[4];
+			}
+			break;
+
+			default:
+			break;
+		}
+		//
+		// check for a match with a previous dynamic parameter
+		if( previous == i_par && op != ind_dyn )
+		{	if( (op == add_dyn || op == mul_dyn) && arg[1] < arg[0] )
+				std::swap(arg[0], arg[1]);
+			size_t code  = optimize_hash_code(op, n_arg, arg);
+			size_t slot  = hash_table_dyn.first(code);
+			size_t j_dyn = hash_table_dyn.next(code, slot);
+			while( previous == i_par && j_dyn != num_dynamic_par )
+			{	if( op_code_dyn( dyn_par_op[j_dyn] ) == op )
+				{	const addr_t* arg_j = new_arg.data() + arg_start[j_dyn];
+					bool match = true;
+					for(size_t k = 0; k < n_arg; ++k)
+						match &= arg[k] == arg_j[k];
+					if( match )
+						previous = dyn_ind2par_ind[j_dyn];
+				}
+				j_dyn = hash_table_dyn.next(code, slot);
+			}
+			if( previous == i_par )
+				hash_table_dyn.insert(code, i_dyn);
+		}
+		dyn_previous[i_par] = addr_t( previous );
+	}
+	CPPAD_ASSERT_UNKNOWN( i_arg == dyn_par_arg.size() );
+	//
+	return;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
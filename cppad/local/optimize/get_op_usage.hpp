@@ -18,6 +18,7 @@ Create operator information tables
 
 # include <cppad/local/optimize/cexp_info.hpp>
 # include <cppad/local/optimize/usage.hpp>
+# include <cppad/local/optimize/simplify.hpp>
 
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
 namespace CppAD { namespace local { namespace optimize {
@@ -44,6 +45,12 @@ inline bool op_add_or_sub(
 	return result;
 }
 
+/// Is this a multiplication operator that can be part of a cumulative product
+inline bool op_mul(
+	OpCode op ///< operator we are checking
+)
+{	return (op == MulpvOp) | (op == MulvvOp); }
+
 /*!
 Increarse argument usage and propagate cexp_set from result to argument.
 
@@ -54,6 +61,10 @@ is the player for the old operation sequence.
 is result an addition or subtraction operator (passed for speed so
 do not need to call op_add_or_sub for result).
 
+\param prod_result
+is result a multiplication operator that is not simplified
+(passed for speed so do not need to call op_mul for result).
+
 \param i_result
 is the operator index for the result operator.
 
@@ -65,6 +76,9 @@ structure that holds the information for each of the operators.
 The output value of op_usage[i_arg] is increased; to be specific,
 If sum_result is true and the input value of op_usage[i_arg]
 is usage_t(no_usage), its output value is usage_t(csum_usage).
+If prod_result is true, the input value of op_usage[i_arg]
+is usage_t(no_usage), and op_mul is true for the argument,
+its output value is usage_t(cprod_usage).
 Otherwise, the output value of op_usage[i_arg] is usage_t(yes_usage).
 
 \param cexp_set
@@ -90,6 +104,7 @@ template <class Base>
 inline void op_inc_arg_usage(
 	const player<Base>*         play           ,
 	bool                        sum_result     ,
+	bool                        prod_result    ,
 	size_t                      i_result       ,
 	size_t                      i_arg          ,
 	pod_vector<usage_t>&        op_usage       ,
@@ -107,6 +122,14 @@ inline void op_inc_arg_usage(
 			}
 		}
 	}
+	if( prod_result )
+	{	if( arg_usage == no_usage )
+		{	OpCode op_a = play->GetOp(i_arg);
+			if( op_mul( op_a ) )
+			{	op_usage[i_arg] = usage_t(cprod_usage);
+			}
+		}
+	}
 	//
 	// cexp_set
 	if( cexp_set.n_set() == 0 )
@@ -151,6 +174,15 @@ if this is true, arguments are considered used if they appear in
 print forward operators; i.e., PriOp.
 This is also a side effect; i.e. NumRes(PriOp) is zero.
 
+\param exact_only
+If this is true, the multiplications that are combined into a
+cumulative product must give the same value as the original operations.
+To be specific, each multiplication in a cumulative product has at most
+one argument that is also in the cumulative product
+(so the operations are done in the same order)
+and multiplications by a parameter are not included.
+Otherwise, the multiplications are combined in any order.
+
 \param play
 This is the operation sequence.
 
@@ -161,6 +193,11 @@ This is a random iterator for the operation sequence.
 is a vector of indices for the dependent variables
 (where the reverse activity analysis starts).
 
+\param op_simplify
+is the algebraic simplification for each operator; see get_simplify.
+If an operator is used and it is simplified,
+the only argument that it uses is the variable op_simplify[i_op].var.
+
 \param cexp2op
 The input size of this vector must be zero.
 Upon retun it has size equal to the number of conditional expressions,
@@ -197,9 +234,11 @@ void get_op_usage(
 	bool                                        conditional_skip    ,
 	bool                                        compare_op          ,
 	bool                                        print_for_op        ,
+	bool                                        exact_only          ,
 	const player<Base>*                         play                ,
 	const play::const_random_iterator<Addr>&    random_itr          ,
 	const vector<size_t>&                       dep_taddr           ,
+	const pod_vector<struct_simplify>&          op_simplify         ,
 	pod_vector<addr_t>&                         cexp2op             ,
 	sparse_list&                                cexp_set            ,
 	pod_vector<bool>&                           vecad_used          ,
@@ -327,8 +366,17 @@ void get_op_usage(
 		// (This only makes sense when NumRes(op) > 0.)
 		usage_t use_result = op_usage[i_op];
 		//
-		bool sum_op = false;
-		switch( op )
+		bool sum_op  = false;
+		bool prod_op = false;
+		if( use_result == usage_t(yes_usage) &&
+			op_simplify[i_op].kind != simplify_t(no_simplify) )
+		{	// a simplified operator only uses the variable x
+			size_t j_op = random_itr.var2op( op_simplify[i_op].var );
+			op_inc_arg_usage(
+				play, sum_op, prod_op, i_op, j_op, op_usage, cexp_set
+			);
+		}
+		else switch( op )
 		{
 			// =============================================================
 			// normal operators
@@ -365,7 +413,7 @@ void get_op_usage(
 			if( use_result != usage_t(no_usage) )
 			{	size_t j_op = random_itr.var2op(arg[0]);
 				op_inc_arg_usage(
-					play, sum_op, i_op, j_op, op_usage, cexp_set
+					play, sum_op, prod_op, i_op, j_op, op_usage, cexp_set
 				);
 			}
 			break; // --------------------------------------------
@@ -375,16 +423,19 @@ void get_op_usage(
 			case SubpvOp:
 			sum_op = true;
 			//
+			case MulpvOp:
+			// (exact_only: parameter factors would change the order)
+			prod_op = (op == MulpvOp) & (! exact_only);
+			//
 			case DisOp:
 			case DivpvOp:
-			case MulpvOp:
 			case PowpvOp:
 			case ZmulpvOp:
 			CPPAD_ASSERT_UNKNOWN( NumRes(op) > 0 );
 			if( use_result != usage_t(no_usage) )
 			{	size_t j_op = random_itr.var2op(arg[1]);
 				op_inc_arg_usage(
-					play, sum_op, i_op, j_op, op_usage, cexp_set
+					play, sum_op, prod_op, i_op, j_op, op_usage, cexp_set
 				);
 			}
 			break; // --------------------------------------------
@@ -394,8 +445,10 @@ void get_op_usage(
 			case SubvvOp:
 			sum_op = true;
 			//
-			case DivvvOp:
 			case MulvvOp:
+			prod_op = op == MulvvOp;
+			//
+			case DivvvOp:
 			case PowvvOp:
 			case ZmulvvOp:
 			CPPAD_ASSERT_UNKNOWN( NumRes(op) > 0 );
@@ -403,8 +456,11 @@ void get_op_usage(
 			{	for(size_t i = 0; i < 2; i++)
 				{	size_t j_op = random_itr.var2op(arg[i]);
 					op_inc_arg_usage(
-						play, sum_op, i_op, j_op, op_usage, cexp_set
+						play, sum_op, prod_op, i_op, j_op, op_usage, cexp_set
 					);
+					// exact_only: at most one argument in the product
+					if( exact_only & (op_usage[j_op] == usage_t(cprod_usage)) )
+						prod_op = false;
 				}
 			}
 			break; // --------------------------------------------
@@ -423,14 +479,14 @@ void get_op_usage(
 				if( arg[1] & 1 )
 				{	size_t j_op = random_itr.var2op(arg[2]);
 					op_inc_arg_usage(
-						play, sum_op, i_op, j_op, op_usage, cexp_set
+						play, sum_op, prod_op, i_op, j_op, op_usage, cexp_set
 					);
 				}
 				// propgate from result to right argument
 				if( arg[1] & 2 )
 				{	size_t j_op = random_itr.var2op(arg[3]);
 					op_inc_arg_usage(
-							play, sum_op, i_op, j_op, op_usage, cexp_set
+						play, sum_op, prod_op, i_op, j_op, op_usage, cexp_set
 					);
 				}
 				// are if_true and if_false cases the same variable
@@ -443,7 +499,7 @@ void get_op_usage(
 					bool can_skip = conditional_skip & (! same_variable);
 					can_skip     &= op_usage[j_op] == usage_t(no_usage);
 					op_inc_arg_usage(
-						play, sum_op, i_op, j_op, op_usage, cexp_set
+						play, sum_op, prod_op, i_op, j_op, op_usage, cexp_set
 					);
 					if( can_skip )
 					{	// j_op corresponds to the value used when the
@@ -462,7 +518,7 @@ void get_op_usage(
 					bool can_skip = conditional_skip & (! same_variable);
 					can_skip     &= op_usage[j_op] == usage_t(no_usage);
 					op_inc_arg_usage(
-						play, sum_op, i_op, j_op, op_usage, cexp_set
+						play, sum_op, prod_op, i_op, j_op, op_usage, cexp_set
 					);
 					if( can_skip )
 					{	// j_op corresponds to the value used when the
@@ -499,14 +555,14 @@ void get_op_usage(
 				{	// arg[1] is a variable
 					size_t j_op = random_itr.var2op(arg[1]);
 					op_inc_arg_usage(
-						play, sum_op, i_op, j_op, op_usage, cexp_set
+						play, sum_op, prod_op, i_op, j_op, op_usage, cexp_set
 					);
 				}
 				if( arg[0] & 2 )
 				{	// arg[3] is a variable
 					size_t j_op = random_itr.var2op(arg[3]);
 					op_inc_arg_usage(
-						play, sum_op, i_op, j_op, op_usage, cexp_set
+						play, sum_op, prod_op, i_op, j_op, op_usage, cexp_set
 					);
 				}
 			}
@@ -527,7 +583,7 @@ void get_op_usage(
 				//
 				size_t j_op = random_itr.var2op(arg[1]);
 				op_inc_arg_usage(
-					play, sum_op, i_op, j_op, op_usage, cexp_set
+					play, sum_op, prod_op, i_op, j_op, op_usage, cexp_set
 				);
 			}
 			break; // ----------------------------------------------
@@ -541,7 +597,7 @@ void get_op_usage(
 				//
 				size_t j_op = random_itr.var2op(arg[0]);
 				op_inc_arg_usage(
-					play, sum_op, i_op, j_op, op_usage, cexp_set
+					play, sum_op, prod_op, i_op, j_op, op_usage, cexp_set
 				);
 			}
 			break; // ----------------------------------------------
@@ -558,7 +614,7 @@ void get_op_usage(
 				for(size_t i = 0; i < 2; i++)
 				{	size_t j_op = random_itr.var2op(arg[i]);
 					op_inc_arg_usage(
-						play, sum_op, i_op, j_op, op_usage, cexp_set
+						play, sum_op, prod_op, i_op, j_op, op_usage, cexp_set
 					);
 				}
 			}
@@ -613,6 +669,20 @@ void get_op_usage(
 			}
 			break; // -----------------------------------------------------
 
+			// =============================================================
+			// cumulative product operator
+			// ============================================================
+			case CProdOp:
+			CPPAD_ASSERT_UNKNOWN( NumRes(op) == 1 );
+			{
+				for(size_t i = 3; i < size_t(arg[1]); i++)
+				{	size_t j_op = random_itr.var2op( arg[i] );
+					op_inc_arg_usage(
+						play, sum_op, prod_op, i_op, j_op, op_usage, cexp_set
+					);
+				}
+			}
+			break;
 			// =============================================================
 			// cumulative summation operator
 			// ============================================================
@@ -622,7 +692,7 @@ void get_op_usage(
 				for(size_t i = 5; i < size_t(arg[2]); i++)
 				{	size_t j_op = random_itr.var2op( arg[i] );
 					op_inc_arg_usage(
-						play, sum_op, i_op, j_op, op_usage, cexp_set
+						play, sum_op, prod_op, i_op, j_op, op_usage, cexp_set
 					);
 				}
 			}
@@ -763,8 +833,8 @@ void get_op_usage(
 					}
 					if( use_arg_j )
 					{	size_t j_op = random_itr.var2op(user_ix[j]);
-						op_inc_arg_usage(play,
-							sum_op, last_user_i_op, j_op, op_usage, cexp_set
+						op_inc_arg_usage(play, sum_op, prod_op,
+							last_user_i_op, j_op, op_usage, cexp_set
 						);
 					}
 				}
@@ -832,8 +902,8 @@ void get_op_usage(
 				if( user_pack )
 					user_r_pack[user_i] = true;
 				//
-				op_inc_arg_usage(
-					play, sum_op, i_op, last_user_i_op, op_usage, cexp_set
+				op_inc_arg_usage(play, sum_op, prod_op,
+					i_op, last_user_i_op, op_usage, cexp_set
 				);
 			}
 			break; // --------------------------------------------------------
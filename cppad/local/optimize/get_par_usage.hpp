@@ -16,10 +16,279 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 Create operator information tables
 */
 # include <cppad/local/optimize/get_op_usage.hpp>
+# include <cppad/local/team_run.hpp>
 
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
 namespace CppAD { namespace local { namespace optimize {
 
+/*!
+Mark the parameters that are used by one operator.
+
+\tparam Addr
+Type used by random iterator for the player.
+
+\param random_itr
+This is a random iterator for the operation sequence.
+
+\param op_usage
+is the usage for each operator in the operation sequence.
+
+\param dyn_par_is
+is the vector that identifies dynamic parameters.
+
+\param i_op
+is the index of the operator.
+
+\param mark
+If the operator is used, mark[i_par] is set to true
+for each parameter index i_par that is used by the operator.
+Other elements of mark are not modified.
+*/
+template <class Addr>
+void get_par_usage_op(
+	const play::const_random_iterator<Addr>&    random_itr          ,
+	const pod_vector<usage_t>&                  op_usage            ,
+	const pod_vector<bool>&                     dyn_par_is          ,
+	size_t                                      i_op                ,
+	bool*                                       mark                )
+{	// information about current operator
+	OpCode        op;     // operator
+	const addr_t* arg;    // arguments
+	size_t        i_var;  // variable index of first result
+	random_itr.op_info(i_op, op, arg, i_var);
+	//
+	if( op_usage[i_op] != no_usage ) switch( op )
+	{
+		// add or subtrace with left a parameter and right a variable
+		case AddpvOp:
+		case SubpvOp:
+		if( dyn_par_is[ arg[0] ] )
+			mark[ arg[0] ] = true;
+		else
+		{	// determine if this parameter will be absorbed by csum
+			 if( ! (op_usage[i_op] == csum_usage) )
+			{	// determine operator corresponding to variable
+				size_t j_op = random_itr.var2op( arg[1] );
+				CPPAD_ASSERT_UNKNOWN( op_usage[j_op] != no_usage );
+				if( op_usage[j_op] != csum_usage )
+					mark[ arg[0] ] = true;
+			}
+		}
+		break;
+
+		// subtract with left a variable and right a parameter
+		case SubvpOp:
+		if( dyn_par_is[ arg[1] ] )
+			mark[ arg[1] ] = true;
+		else
+		{	// determine if this parameter will be absorbed by csum
+			 if( ! (op_usage[i_op] == csum_usage) )
+			{	// determine operator corresponding to variable
+				size_t j_op = random_itr.var2op( arg[0] );
+				CPPAD_ASSERT_UNKNOWN( op_usage[j_op] != no_usage );
+				if( op_usage[j_op] != csum_usage )
+					mark[ arg[1] ] = true;
+			}
+		}
+		break;
+
+		// multiply with left a parameter and right a variable
+		case MulpvOp:
+		if( dyn_par_is[ arg[0] ] )
+			mark[ arg[0] ] = true;
+		else
+		{	// determine if this parameter will be absorbed by cprod
+			 if( ! (op_usage[i_op] == cprod_usage) )
+			{	// determine operator corresponding to variable
+				// (it is not used when this operator is simplified)
+				size_t j_op = random_itr.var2op( arg[1] );
+				if( op_usage[j_op] != cprod_usage )
+					mark[ arg[0] ] = true;
+			}
+		}
+		break;
+
+		// cumulative product
+		case CProdOp:
+		mark[ arg[0] ] = true;
+		for(size_t i = size_t(arg[1]); i < size_t(arg[2]); ++i)
+			mark[ arg[i] ] = true;
+		break;
+
+
+		// cases with no parameter arguments
+		case AbsOp:
+		case AcosOp:
+		case AcoshOp:
+		case AddvvOp:
+		case AsinOp:
+		case AsinhOp:
+		case AtanOp:
+		case AtanhOp:
+		case BeginOp:
+		case CosOp:
+		case CoshOp:
+		case CSkipOp:
+		case DisOp:
+		case DivvvOp:
+		case EndOp:
+		case EqvvOp:
+		case ExpOp:
+		case Expm1Op:
+		case InvOp:
+		case LdpOp:
+		case LdvOp:
+		case LevvOp:
+		case LogOp:
+		case Log1pOp:
+		case LtvvOp:
+		case MulvvOp:
+		case NevvOp:
+		case PowvvOp:
+		case SignOp:
+		case SinOp:
+		case SinhOp:
+		case SqrtOp:
+		case StpvOp:
+		case StvvOp:
+		case SubvvOp:
+		case TanOp:
+		case TanhOp:
+		case UserOp:
+		case UsravOp:
+		case UsrrvOp:
+		case ZmulvvOp:
+		break;
+
+		// cases where first and second arguments are parameters
+		case EqppOp:
+		case LeppOp:
+		case LtppOp:
+		case NeppOp:
+		CPPAD_ASSERT_UNKNOWN( 2 <= NumArg(op) )
+		mark[arg[0]] = true;
+		mark[arg[1]] = true;
+		break;
+
+
+		// cases where only first argument is a parameter
+		case CSumOp:
+		case EqpvOp:
+		case DivpvOp:
+		case LepvOp:
+		case LtpvOp:
+		case NepvOp:
+		case ParOp:
+		case PowpvOp:
+		case UsrapOp:
+		case UsrrpOp:
+		case ZmulpvOp:
+		CPPAD_ASSERT_UNKNOWN( 1 <= NumArg(op) )
+		mark[arg[0]] = true;
+		break;
+
+		// cases where only second argument is a parameter
+		case DivvpOp:
+		case LevpOp:
+		case LtvpOp:
+		case PowvpOp:
+		case ZmulvpOp:
+		CPPAD_ASSERT_UNKNOWN( 2 <= NumArg(op) )
+		mark[arg[1]] = true;
+		break;
+
+		// cases where only third argument is a parameter
+		case StppOp:
+		case StvpOp:
+		mark[arg[2]] = true;
+		break;
+
+		// conditional expression operator
+		case CExpOp:
+		CPPAD_ASSERT_UNKNOWN( 6 == NumArg(op) )
+		if( (arg[1] & 1) == 0 )
+			mark[arg[2]] = true;
+		if( (arg[1] & 2) == 0 )
+			mark[arg[3]] = true;
+		if( (arg[1] & 4) == 0 )
+			mark[arg[4]] = true;
+		if( (arg[1] & 8) == 0 )
+			mark[arg[5]] = true;
+		break;
+
+		// erf function is special
+		case ErfOp:
+		CPPAD_ASSERT_UNKNOWN( 3 == NumArg(op) )
+		mark[arg[1]] = true;
+		mark[arg[2]] = true;
+		break;
+
+		// print function
+		case PriOp:
+		if( (arg[0] & 1) == 0 )
+			mark[arg[1]] = true;
+		if( (arg[0] & 2) == 0 )
+			mark[arg[2]] = true;
+		CPPAD_ASSERT_UNKNOWN( 5 == NumArg(op) )
+		break;
+
+		default:
+		CPPAD_ASSERT_UNKNOWN(false);
+	}
+	return;
+}
+
+/*!
+Work done by each thread in a team that marks the parameters
+used by a segment of the operation sequence.
+
+\tparam Addr
+Type used by random iterator for the player.
+*/
+template <class Addr>
+class get_par_usage_team_work {
+private:
+	const play::const_random_iterator<Addr>& random_itr_;
+	const pod_vector<usage_t>&               op_usage_;
+	const pod_vector<bool>&                  dyn_par_is_;
+	const size_t                             num_threads_;
+	const size_t                             num_par_;
+	/// marks for thread zero
+	bool* const                              par_usage_;
+	/// marks for thread k > 0 start at copy_[(k-1) * num_par_]
+	bool* const                              copy_;
+public:
+	/// constructor
+	get_par_usage_team_work(
+		const play::const_random_iterator<Addr>& random_itr  ,
+		const pod_vector<usage_t>&               op_usage    ,
+		const pod_vector<bool>&                  dyn_par_is  ,
+		size_t                                   num_threads ,
+		size_t                                   num_par     ,
+		bool*                                    par_usage   ,
+		bool*                                    copy        )
+	: random_itr_(random_itr)
+	, op_usage_(op_usage)
+	, dyn_par_is_(dyn_par_is)
+	, num_threads_(num_threads)
+	, num_par_(num_par)
+	, par_usage_(par_usage)
+	, copy_(copy)
+	{ }
+	/// mark the parameters used by operators in the segment for this thread
+	void operator()(size_t thread)
+	{	bool* mark = par_usage_;
+		if( thread > 0 )
+			mark = copy_ + (thread - 1) * num_par_;
+		//
+		size_t num_op   = op_usage_.size();
+		size_t op_begin = (thread * num_op) / num_threads_;
+		size_t op_end   = ((thread + 1) * num_op) / num_threads_;
+		for(size_t i_op = op_begin; i_op < op_end; ++i_op)
+			get_par_usage_op(random_itr_, op_usage_, dyn_par_is_, i_op, mark);
+	}
+};
+
 /*!
 Use reverse activity analysis to get usage for each parameters.
 
@@ -48,12 +317,28 @@ in the operations sequences; i.e., play->num_vecad_vec_rec().
 The VecAD vectors are indexed in the order that thier indices apprear
 in the one large play->GetVecInd that holds all the VecAD vectors.
 
+\param dyn_previous
+is the mapping from parameters to previous parameters computed
+by get_dyn_previous.
+If a dynamic parameter is replaced by a previous parameter,
+the previous parameter is used in its place.
+If a dynamic parameter is folded to a constant,
+its arguments are not used by it.
+
 \param par_usage
 Upon return it has size equal to the number of parameters
 in the operation sequence; i.e., play->num_par_rec();
 The value par_usage[i] is true if an only if
 the i-th parameter is used.
 (Independent dynamic parameters are always used.)
+
+\param num_threads
+is the number of threads in the team that is used to mark the
+parameters used by the operators.
+Each thread marks a contiguous segment of the operation sequence
+in a separate copy of par_usage; i.e., this uses
+(num_threads - 1) * num_par extra bytes of memory.
+If num_threads is one, no extra threads or memory are used.
 */
 
 template <class Addr, class Base>
@@ -62,10 +347,13 @@ void get_par_usage(
 	const play::const_random_iterator<Addr>&    random_itr          ,
 	const pod_vector<usage_t>&                  op_usage            ,
 	pod_vector<bool>&                           vecad_used          ,
-	pod_vector<bool>&                           par_usage           )
+	const pod_vector<addr_t>&                   dyn_previous        ,
+	pod_vector<bool>&                           par_usage           ,
+	size_t                                      num_threads = 1     )
 {
 	CPPAD_ASSERT_UNKNOWN( op_usage.size()   == play->num_op_rec() );
 	CPPAD_ASSERT_UNKNOWN( par_usage.size()  == 0 );
+	CPPAD_ASSERT_UNKNOWN( dyn_previous.size() == play->num_par_rec() );
 	//
 	// number of operators in the tape
 	const size_t num_op = play->num_op_rec();
@@ -92,7 +380,7 @@ void get_par_usage(
 	par_usage.resize(num_par);
 	for(size_t i_par = 0; i_par < num_dynamic_ind; ++i_par)
 		par_usage[i_par] = true;  // true for independent dynamic parameters
-	for(size_t i_par = num_dynamic_par; i_par < num_par; ++i_par)
+	for(size_t i_par = num_dynamic_ind; i_par < num_par; ++i_par)
 		par_usage[i_par] = false; // initialize as false for other parameters
 	//
 	// -----------------------------------------------------------------------
@@ -119,171 +407,27 @@ void get_par_usage(
 	//
 	// -----------------------------------------------------------------------
 	// forward pass to mark which parameters are used by necessary operators
-	for(size_t i_op = 0; i_op < num_op; ++i_op)
-	{
-		// information about current operator
-		OpCode        op;     // operator
-		const addr_t* arg;    // arguments
-		size_t        i_var;  // variable index of first result
-		random_itr.op_info(i_op, op, arg, i_var);
+	if( num_threads <= 1 || num_op < 2 * num_threads )
+	{	for(size_t i_op = 0; i_op < num_op; ++i_op)
+			get_par_usage_op(
+				random_itr, op_usage, dyn_par_is, i_op, par_usage.data()
+			);
+	}
+	else
+	{	// each thread marks a segment of the operation sequence,
+		// thread zero uses par_usage and the others use their own marks
+		pod_vector<bool> copy( (num_threads - 1) * num_par );
+		for(size_t k = 0; k < copy.size(); ++k)
+			copy[k] = false;
+		get_par_usage_team_work<Addr> work(
+			random_itr, op_usage, dyn_par_is,
+			num_threads, num_par, par_usage.data(), copy.data()
+		);
+		team_run(num_threads, work);
 		//
-		if( op_usage[i_op] != no_usage ) switch( op )
-		{
-			// add or subtrace with left a parameter and right a variable
-			case AddpvOp:
-			case SubpvOp:
-			if( dyn_par_is[ arg[0] ] )
-				par_usage[ arg[0] ] = true;
-			else
-			{	// determine if this parameter will be absorbed by csum
-				 if( ! (op_usage[i_op] == csum_usage) )
-				{	// determine operator corresponding to variable
-					size_t j_op = random_itr.var2op( arg[1] );
-					CPPAD_ASSERT_UNKNOWN( op_usage[j_op] != no_usage );
-					if( op_usage[j_op] != csum_usage )
-						par_usage[ arg[0] ] = true;
-				}
-			}
-			break;
-
-			// subtract with left a variable and right a parameter
-			case SubvpOp:
-			if( dyn_par_is[ arg[1] ] )
-				par_usage[ arg[1] ] = true;
-			else
-			{	// determine if this parameter will be absorbed by csum
-				 if( ! (op_usage[i_op] == csum_usage) )
-				{	// determine operator corresponding to variable
-					size_t j_op = random_itr.var2op( arg[0] );
-					CPPAD_ASSERT_UNKNOWN( op_usage[j_op] != no_usage );
-					if( op_usage[j_op] != csum_usage )
-						par_usage[ arg[1] ] = true;
-				}
-			}
-			break;
-
-
-
-			// cases with no parameter arguments
-			case AbsOp:
-			case AcosOp:
-			case AcoshOp:
-			case AddvvOp:
-			case AsinOp:
-			case AsinhOp:
-			case AtanOp:
-			case AtanhOp:
-			case BeginOp:
-			case CosOp:
-			case CoshOp:
-			case CSkipOp:
-			case DisOp:
-			case DivvvOp:
-			case EndOp:
-			case EqvvOp:
-			case ExpOp:
-			case Expm1Op:
-			case InvOp:
-			case LdpOp:
-			case LdvOp:
-			case LevvOp:
-			case LogOp:
-			case Log1pOp:
-			case LtvvOp:
-			case MulvvOp:
-			case NevvOp:
-			case PowvvOp:
-			case SignOp:
-			case SinOp:
-			case SinhOp:
-			case SqrtOp:
-			case StpvOp:
-			case StvvOp:
-			case SubvvOp:
-			case TanOp:
-			case TanhOp:
-			case UserOp:
-			case UsravOp:
-			case UsrrvOp:
-			case ZmulvvOp:
-			break;
-
-			// cases where first and second arguments are parameters
-			case EqppOp:
-			case LeppOp:
-			case LtppOp:
-			case NeppOp:
-			CPPAD_ASSERT_UNKNOWN( 2 <= NumArg(op) )
-			par_usage[arg[0]] = true;
-			par_usage[arg[1]] = true;
-			break;
-
-
-			// cases where only first argument is a parameter
-			case CSumOp:
-			case EqpvOp:
-			case DivpvOp:
-			case LepvOp:
-			case LtpvOp:
-			case MulpvOp:
-			case NepvOp:
-			case ParOp:
-			case PowpvOp:
-			case UsrapOp:
-			case UsrrpOp:
-			case ZmulpvOp:
-			CPPAD_ASSERT_UNKNOWN( 1 <= NumArg(op) )
-			par_usage[arg[0]] = true;
-			break;
-
-			// cases where only second argument is a parameter
-			case DivvpOp:
-			case LevpOp:
-			case LtvpOp:
-			case PowvpOp:
-			case ZmulvpOp:
-			CPPAD_ASSERT_UNKNOWN( 2 <= NumArg(op) )
-			par_usage[arg[1]] = true;
-			break;
-
-			// cases where only third argument is a parameter
-			case StppOp:
-			case StvpOp:
-			par_usage[arg[2]] = true;
-			break;
-
-			// conditional expression operator
-			case CExpOp:
-			CPPAD_ASSERT_UNKNOWN( 6 == NumArg(op) )
-			if( (arg[1] & 1) == 0 )
-				par_usage[arg[2]] = true;
-			if( (arg[1] & 2) == 0 )
-				par_usage[arg[3]] = true;
-			if( (arg[1] & 4) == 0 )
-				par_usage[arg[4]] = true;
-			if( (arg[1] & 8) == 0 )
-				par_usage[arg[5]] = true;
-			break;
-
-			// erf function is special
-			case ErfOp:
-			CPPAD_ASSERT_UNKNOWN( 3 == NumArg(op) )
-			par_usage[arg[1]] = true;
-			par_usage[arg[2]] = true;
-			break;
-
-			// print function
-			case PriOp:
-			if( (arg[0] & 1) == 0 )
-				par_usage[arg[1]] = true;
-			if( (arg[0] & 2) == 0 )
-				par_usage[arg[2]] = true;
-			CPPAD_ASSERT_UNKNOWN( 5 == NumArg(op) )
-			break;
-
-			default:
-			CPPAD_ASSERT_UNKNOWN(false);
-		}
+		// combine the marks for the segments
+		for(size_t k = 0; k < copy.size(); ++k)
+			par_usage[k % num_par] |= copy[k];
 	}
 	// -----------------------------------------------------------------------
 	// reverse pass to determine which dynamic parameters are necessary
@@ -306,8 +450,16 @@ void get_par_usage(
 		// index of first argument for this operator
 		i_arg -= n_arg;
 		//
+		// previous parameter that replaces this one
+		size_t j_par = dyn_previous[i_par];
+		//
 		// if this dynamic parameter is needed
-		if( par_usage[i_par] )
+		if( par_usage[i_par] && j_par != i_par )
+		{	// a folded constant does not need its arguments
+			if( j_par != num_par )
+				par_usage[j_par] = true;
+		}
+		else if( par_usage[i_par] )
 		{	// neeed dynamic parameters that are used to generate this one
 			if( op == cond_exp_dyn )
 			{	// special case
@@ -18,6 +18,7 @@ Create operator information tables
 
 # include <cppad/local/optimize/match_op.hpp>
 # include <cppad/local/optimize/usage.hpp>
+# include <cppad/local/optimize/simplify.hpp>
 
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
 namespace CppAD { namespace local { namespace optimize {
@@ -61,6 +62,12 @@ i-th operator has NumArg(op) <= 3, 0 < NumRes(op), is not one of the following:
 	- it is not a user atomic fucntion op
 	UserOp, UsrapOp, UsravOp, UsrrpOp, UsrrvOp.
 
+\param op_simplify
+is the algebraic simplification for each operator; see get_simplify.
+If an operator is used and the result of its simplification is the
+variable x (see simplify_alias), op_previous for the operator is set to the
+operator that creates x.
+
 \param op_usage
 The size of this vector is the number of operators in the
 operation sequence.i.e., play->nun_var_rec().
@@ -74,6 +81,7 @@ template <class Addr, class Base>
 void get_previous(
 	const player<Base>*                         play                ,
 	const play::const_random_iterator<Addr>&    random_itr          ,
+	const pod_vector<struct_simplify>&          op_simplify         ,
 	sparse_list&                                cexp_set            ,
 	pod_vector<addr_t>&                         op_previous         ,
 	pod_vector<usage_t>&                        op_usage            )
@@ -95,21 +103,47 @@ void get_previous(
 	// ----------------------------------------------------------------------
 	// compute op_previous
 	// ----------------------------------------------------------------------
-	sparse_list  hash_table_op;
-	hash_table_op.resize(CPPAD_HASH_TABLE_SIZE, num_op);
+	op_hash_table hash_table_op;
+	hash_table_op.resize(num_op);
 	//
 	pod_vector<bool> work_bool;
 	pod_vector<addr_t> work_addr_t;
 	for(size_t i_op = 0; i_op < num_op; ++i_op)
 	{	op_previous[i_op] = 0;
-
-		if( op_usage[i_op] == usage_t(yes_usage) )
+		//
+		enum_simplify kind = enum_simplify( op_simplify[i_op].kind );
+		if( op_usage[i_op] == usage_t(yes_usage) && simplify_alias(kind) )
+		{	// the result of this operator is the variable x
+			// (get_op_usage has already marked x as used)
+			size_t x          = op_simplify[i_op].var;
+			op_previous[i_op] = addr_t( random_itr.var2op(x) );
+			CPPAD_ASSERT_UNKNOWN(
+				op_usage[ op_previous[i_op] ] == usage_t(yes_usage)
+			);
+			//
+			// use previous of x when matching operators that use this one
+			// (same initialization of work_addr_t as in match_op)
+			if( work_addr_t.size() == 0 )
+			{	size_t num_var = random_itr.num_var();
+				work_addr_t.resize(num_var);
+				for(size_t i = 0; i < num_var; ++i)
+					work_addr_t[i] = addr_t(i);
+			}
+			OpCode        op;
+			const addr_t* arg;
+			size_t        i_var;
+			random_itr.op_info(i_op, op, arg, i_var);
+			CPPAD_ASSERT_UNKNOWN( NumRes(op) == 1 );
+			work_addr_t[i_var] = work_addr_t[x];
+		}
+		else if( op_usage[i_op] == usage_t(yes_usage) )
 		switch( random_itr.get_op(i_op) )
 		{
 			// ----------------------------------------------------------------
 			// these operators never match pevious operators
 			case BeginOp:
 			case CExpOp:
+			case CProdOp:
 			case CSkipOp:
 			case CSumOp:
 			case EndOp:
@@ -189,10 +223,11 @@ void get_previous(
 			if( op_previous[i_op] != 0 )
 			{	// like a unary operator that assigns i_op equal to previous.
 				size_t previous = op_previous[i_op];
-				bool sum_op = false;
+				bool sum_op  = false;
+				bool prod_op = false;
 				CPPAD_ASSERT_UNKNOWN( previous < i_op );
 				op_inc_arg_usage(
-					play, sum_op, i_op, previous, op_usage, cexp_set
+					play, sum_op, prod_op, i_op, previous, op_usage, cexp_set
 				);
 			}
 			break;
@@ -0,0 +1,255 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_GET_SIMPLIFY_HPP
+# define CPPAD_LOCAL_OPTIMIZE_GET_SIMPLIFY_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*!
+\file get_simplify.hpp
+Determine the algebraic simplification for each operator.
+*/
+# include <cppad/local/optimize/simplify.hpp>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize {
+
+/*!
+Is a parameter a constant in the optimized recording.
+
+\param dyn_par_is
+is the vector that identifies dynamic parameters.
+
+\param dyn_previous
+is the mapping from parameters to previous parameters computed
+by get_dyn_previous.
+
+\param i_par
+is the index of the parameter in the old recording.
+
+\return
+is true if the parameter is a constant, or a dynamic parameter that
+the optimizer converts to a constant.
+*/
+inline bool simplify_con_par(
+	const pod_vector<bool>&      dyn_par_is   ,
+	const pod_vector<addr_t>&    dyn_previous ,
+	size_t                       i_par        )
+{	if( ! dyn_par_is[i_par] )
+		return true;
+	size_t j_par = dyn_previous[i_par];
+	if( j_par == dyn_previous.size() )
+		return true;
+	return ! dyn_par_is[j_par];
+}
+
+/*!
+Forward pass that determines the algebraic simplification for each operator.
+
+\tparam Addr
+Type used by random iterator for the player.
+
+\tparam Base
+base type for the operator; i.e., this operation sequence was recorded
+using AD<Base> and computations by this routine are done using type Base.
+
+\param play
+This is the old operation sequence.
+
+\param random_itr
+This is a random iterator for the old operation sequence.
+
+\param dyn_previous
+is the mapping from parameters to previous parameters computed
+by get_dyn_previous.
+
+\param exact_only
+If true, only the mul_one_simplify and add_zero_simplify cases are used.
+These do not change the function or derivative values.
+
+\param op_simplify
+The input size of this vector must be zero.
+Upon return it has size equal to the number of operators
+in the operation sequence and op_simplify[i_op] is the
+simplification for the i_op-th operator; see enum_simplify.
+The simplification does not depend on whether the operator is used,
+so it is the same for operators that are common subexpressions.
+
+\param simplify_factor
+The input size of this vector must be zero.
+Upon return, it contains the factors that multiply x for the
+div_con_simplify and mul_chain_simplify cases.
+
+\par Derivatives
+The mul_one_simplify and add_zero_simplify cases have the same value and
+derivatives as the original operators.
+The div_con_simplify and mul_chain_simplify cases may differ by rounding.
+The exp_log_simplify case is x when x is not positive
+(where the original value is nan).
+The pow_two_simplify case has finite derivatives when x is not positive
+(where the original derivatives are nan).
+*/
+template <class Addr, class Base>
+void get_simplify(
+	const player<Base>*                         play            ,
+	const play::const_random_iterator<Addr>&    random_itr      ,
+	const pod_vector<addr_t>&                   dyn_previous    ,
+	bool                                        exact_only      ,
+	pod_vector<struct_simplify>&                op_simplify     ,
+	vector<Base>&                               simplify_factor )
+{	CPPAD_ASSERT_UNKNOWN( op_simplify.size() == 0 );
+	CPPAD_ASSERT_UNKNOWN( simplify_factor.size() == 0 );
+	CPPAD_ASSERT_UNKNOWN( dyn_previous.size() == play->num_par_rec() );
+	//
+	// number of operators in the tape
+	const size_t num_op = random_itr.num_op();
+	//
+	// which parameters are dynamic
+	const pod_vector<bool>& dyn_par_is( play->dyn_par_is() );
+	//
+	op_simplify.resize(num_op);
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+	{	// information for this operator
+		OpCode        op;
+		const addr_t* arg;
+		size_t        i_var;
+		random_itr.op_info(i_op, op, arg, i_var);
+		//
+		// information for operator that created a variable argument
+		size_t        j_op;
+		OpCode        op_j;
+		const addr_t* arg_j;
+		size_t        j_var;
+		//
+		enum_simplify kind   = no_simplify;
+		size_t        x      = 0;
+		size_t        factor = 0;
+		switch( op )
+		{
+			// x * 1, 1 * x, azmul(1, x), c * (d * x)
+			case MulpvOp:
+			case ZmulpvOp:
+			if( ! simplify_con_par(dyn_par_is, dyn_previous, arg[0]) )
+				break;
+			if( IdenticalOne( play->GetPar( arg[0] ) ) )
+			{	kind = mul_one_simplify;
+				x    = arg[1];
+				break;
+			}
+			if( op == ZmulpvOp || exact_only )
+				break;
+			j_op = random_itr.var2op( arg[1] );
+			random_itr.op_info(j_op, op_j, arg_j, j_var);
+			if( op_j != MulpvOp )
+				break;
+			if( op_simplify[j_op].kind == mul_chain_simplify )
+			{	kind   = mul_chain_simplify;
+				x      = op_simplify[j_op].var;
+				factor = simplify_factor.size();
+				simplify_factor.push_back(
+					play->GetPar( arg[0] )
+					* simplify_factor[ op_simplify[j_op].factor ]
+				);
+			}
+			else if( op_simplify[j_op].kind == no_simplify )
+			{	if( simplify_con_par(dyn_par_is, dyn_previous, arg_j[0]) )
+				{	kind   = mul_chain_simplify;
+					x      = arg_j[1];
+					factor = simplify_factor.size();
+					simplify_factor.push_back(
+						play->GetPar( arg[0] ) * play->GetPar( arg_j[0] )
+					);
+				}
+			}
+			break;
+
+			// azmul(x, 1)
+			case ZmulvpOp:
+			if( simplify_con_par(dyn_par_is, dyn_previous, arg[1]) )
+			{	if( IdenticalOne( play->GetPar( arg[1] ) ) )
+				{	kind = mul_one_simplify;
+					x    = arg[0];
+				}
+			}
+			break;
+
+			// x / 1, x / c
+			case DivvpOp:
+			if( simplify_con_par(dyn_par_is, dyn_previous, arg[1]) )
+			{	Base c = play->GetPar( arg[1] );
+				if( IdenticalOne(c) )
+				{	kind = mul_one_simplify;
+					x    = arg[0];
+				}
+				else if( ! ( exact_only || IdenticalZero(c) ) )
+				{	kind   = div_con_simplify;
+					x      = arg[0];
+					factor = simplify_factor.size();
+					simplify_factor.push_back( Base(1.0) / c );
+				}
+			}
+			break;
+
+			// 0 + x
+			case AddpvOp:
+			if( simplify_con_par(dyn_par_is, dyn_previous, arg[0]) )
+			{	if( IdenticalZero( play->GetPar( arg[0] ) ) )
+				{	kind = add_zero_simplify;
+					x    = arg[1];
+				}
+			}
+			break;
+
+			// x - 0
+			case SubvpOp:
+			if( simplify_con_par(dyn_par_is, dyn_previous, arg[1]) )
+			{	if( IdenticalZero( play->GetPar( arg[1] ) ) )
+				{	kind = add_zero_simplify;
+					x    = arg[0];
+				}
+			}
+			break;
+
+			// pow(x, 2)
+			case PowvpOp:
+			if( exact_only )
+				break;
+			if( simplify_con_par(dyn_par_is, dyn_previous, arg[1]) )
+			{	if( IdenticalEqualCon( play->GetPar( arg[1] ), Base(2.0) ) )
+				{	kind = pow_two_simplify;
+					x    = arg[0];
+				}
+			}
+			break;
+
+			// exp( log(x) )
+			case ExpOp:
+			if( exact_only )
+				break;
+			j_op = random_itr.var2op( arg[0] );
+			random_itr.op_info(j_op, op_j, arg_j, j_var);
+			if( op_j == LogOp )
+			{	kind = exp_log_simplify;
+				x    = arg_j[0];
+			}
+			break;
+
+			default:
+			break;
+		}
+		CPPAD_ASSERT_UNKNOWN( kind == no_simplify || x < i_var );
+		op_simplify[i_op].kind   = simplify_t( kind );
+		op_simplify[i_op].var    = addr_t( x );
+		op_simplify[i_op].factor = addr_t( factor );
+	}
+	return;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
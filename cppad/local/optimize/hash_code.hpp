@@ -20,6 +20,24 @@ CppAD hashing utility.
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
 namespace CppAD { namespace local { namespace optimize {
 /*!
+Mix the bits in a hash code so that the low order bits
+depend on all the bits in the code.
+
+\param code
+is the value before mixing.
+
+\return
+is the mixed value.
+*/
+inline size_t optimize_hash_mix(size_t code)
+{	code ^= code >> 16;
+	code *= size_t(0x45d9f3b);
+	code ^= code >> 16;
+	code *= size_t(0x45d9f3b);
+	code ^= code >> 16;
+	return code;
+}
+/*!
 Specialized hash code for a CppAD operator and its arguments
 (used during optimization).
 
@@ -35,7 +53,8 @@ is a vector of length num_arg
 containing the corresponding argument indices for this operator.
 
 \return
-is a hash code that is between zero and CPPAD_HASH_TABLE_SIZE - 1.
+is a hash code that uses all the bits in a size_t value
+(see op_hash_table for how it is mapped to a slot in the table).
 */
 
 inline size_t optimize_hash_code(
@@ -46,11 +65,41 @@ inline size_t optimize_hash_code(
 	// there is only one case where num_arg == 3
 	CPPAD_ASSERT_UNKNOWN( op == ErfOp || num_arg <= 2 );
 	CPPAD_ASSERT_UNKNOWN( num_arg <= 3 );
-	size_t sum = size_t(op);
+	size_t code = size_t(op);
+	for(size_t i = 0; i < num_arg; i++)
+		code = code * 31 + size_t(arg[i]);
+	//
+	return optimize_hash_mix(code);
+}
+/*!
+Specialized hash code for a dynamic parameter operator and its arguments
+(used during optimization).
+
+\param op
+is the dynamic parameter operator that we are computing a hash code for.
+
+\param num_arg
+number of elements of arg to include in the hash code
+(num_arg <= 5).
+
+\param arg
+is a vector of length num_arg
+containing the corresponding argument indices for this operator.
+In the cond_exp_dyn case, arg[0] is the comparison operator.
+
+\return
+is a hash code that uses all the bits in a size_t value.
+*/
+inline size_t optimize_hash_code(
+	op_code_dyn   op      ,
+	size_t        num_arg ,
+	const addr_t* arg     )
+{	CPPAD_ASSERT_UNKNOWN( num_arg <= 5 );
+	size_t code = size_t(number_dyn) + size_t(op);
 	for(size_t i = 0; i < num_arg; i++)
-		sum += size_t(arg[i]);
+		code = code * 31 + size_t(arg[i]);
 	//
-	return sum % CPPAD_HASH_TABLE_SIZE;
+	return optimize_hash_mix(code);
 }
 
 } } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
@@ -11,6 +11,7 @@ A copy of this license is included in the COPYING file of this distribution.
 Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 -------------------------------------------------------------------------- */
 # include <cppad/local/optimize/hash_code.hpp>
+# include <cppad/local/optimize/op_hash_table.hpp>
 /*!
 \file match_op.hpp
 Check if current operator matches a previous operator.
@@ -42,8 +43,8 @@ or binary operator with NumRes(op) > 0.
 Note that NumArg(ErfOp) == 3 but it is effectivey
 a unary operator and is allowed otherwise
 NumArg( random_itr.get_op[current]) < 3.
-It is assumed that hash_table_op is initialized as a vector of emtpy
-sets. After this initialization, the value of current inceases with
+It is assumed that hash_table_op is initialized as an empty table.
+After this initialization, the value of current inceases with
 each call to match_op.
 
 \li
@@ -58,13 +59,12 @@ LtpvOp, LtvpOp, LtvvOp, StppOp, StpvOp, StvpOp, StvvOp.
 It also must not be an independent variable operator InvOp.
 
 \param hash_table_op
-is a vector of sets,
-hash_table_op.n_set() == CPPAD_HASH_TABLE_SIZE and
-hash_table_op.end() == op_previous.size().
-If i_op is an element of set[j],
-then the operation op_previous[i_op] has hash code j,
-and op_previous[i_op] does not match any other element of set[j].
-An entry to set[j] is added each time match_op is called
+is a hash table for operators in the operation sequence
+that was initialized by hash_table_op.resize( op_previous.size() ).
+If i_op is in the table with hash code j,
+then op_previous[i_op] is zero
+and i_op does not match any other operator in the table with code j.
+The current operator is added to the table each time match_op is called
 and a match for the current operator is not found.
 
 \param work_bool
@@ -83,7 +83,7 @@ void match_op(
 	const play::const_random_iterator<Addr>&    random_itr     ,
 	pod_vector<addr_t>&                         op_previous    ,
 	size_t                                      current        ,
-	sparse_list&                                hash_table_op  ,
+	op_hash_table&                              hash_table_op  ,
 	pod_vector<bool>&                           work_bool      ,
 	pod_vector<addr_t>&                         work_addr_t    )
 {	//
@@ -107,10 +107,6 @@ void match_op(
 	CPPAD_ASSERT_UNKNOWN( var2previous_var.size() == num_var );
 	CPPAD_ASSERT_UNKNOWN( num_op == op_previous.size() );
 	CPPAD_ASSERT_UNKNOWN( op_previous[current] == 0 );
-	CPPAD_ASSERT_UNKNOWN(
-		hash_table_op.n_set() == CPPAD_HASH_TABLE_SIZE
-	);
-	CPPAD_ASSERT_UNKNOWN( hash_table_op.end() == num_op );
 	CPPAD_ASSERT_UNKNOWN( current < num_op );
 	//
 	// op, arg, i_var
@@ -139,16 +135,13 @@ void match_op(
 	//
 	size_t code = optimize_hash_code(op, num_arg, arg_match);
 	//
-	// iterator for the set with this hash code
-	sparse_list_const_iterator itr(hash_table_op, code);
+	// first slot in the table for this hash code
+	size_t slot      = hash_table_op.first(code);
+	size_t candidate = hash_table_op.next(code, slot);
 	//
 	// check for a match
-	size_t count = 0;
-	while( *itr != num_op )
-	{	++count;
-		//
-		// candidate previous for current operator
-		size_t  candidate  = *itr;
+	while( candidate != num_op )
+	{	// candidate previous for current operator
 		CPPAD_ASSERT_UNKNOWN( candidate < current );
 		CPPAD_ASSERT_UNKNOWN( op_previous[candidate] == 0 );
 		//
@@ -175,7 +168,7 @@ void match_op(
 			}
 			return;
 		}
-		++itr;
+		candidate = hash_table_op.next(code, slot);
 	}
 
 	// special case where operator is commutative
@@ -183,12 +176,11 @@ void match_op(
 	{	CPPAD_ASSERT_UNKNOWN( NumArg(op) == 2 );
 		std::swap( arg_match[0], arg_match[1] );
 		//
-		code      = optimize_hash_code(op, num_arg, arg_match);
-		sparse_list_const_iterator itr_swap(hash_table_op, code);
-		while( *itr_swap != num_op )
-		{
-			size_t candidate  = *itr_swap;
-			CPPAD_ASSERT_UNKNOWN( candidate < current );
+		size_t code_swap = optimize_hash_code(op, num_arg, arg_match);
+		slot             = hash_table_op.first(code_swap);
+		candidate        = hash_table_op.next(code_swap, slot);
+		while( candidate != num_op )
+		{	CPPAD_ASSERT_UNKNOWN( candidate < current );
 			CPPAD_ASSERT_UNKNOWN( op_previous[candidate] == 0 );
 			//
 			OpCode        op_c;
@@ -211,16 +203,11 @@ void match_op(
 				}
 				return;
 			}
-			++itr_swap;
+			candidate = hash_table_op.next(code_swap, slot);
 		}
 	}
-	CPPAD_ASSERT_UNKNOWN( count < 11 );
-	if( count == 10 )
-	{	// restart the list
-		hash_table_op.clear(code);
-	}
-	// no match was found, add this operator the the set for this hash code
-	hash_table_op.add_element(code, current);
+	// no match was found, add this operator to the table
+	hash_table_op.insert(code, current);
 }
 
 } } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
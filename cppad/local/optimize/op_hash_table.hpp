@@ -0,0 +1,177 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_OP_HASH_TABLE_HPP
+# define CPPAD_LOCAL_OPTIMIZE_OP_HASH_TABLE_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+# include <cppad/local/pod_vector.hpp>
+/*!
+\file op_hash_table.hpp
+Hash table of operators used to detect common subexpressions.
+*/
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize  {
+/*!
+Open addressing (linear probing) hash table of operator indices.
+
+\par Size
+The number of slots is a power of two and is doubled whenever
+more than half of the slots would be in use; i.e.,
+the load factor is at most one half.
+The initial number of slots is determined by the number of operators
+in the operation sequence, so small tapes use a small table
+and large tapes do not have long probe sequences.
+Each operator is added at most once, so the number of slots is never more
+than max_slot, the smallest power of two that is greater than or equal
+the maximum of 64 and twice the number of operators.
+
+\par Codes
+The low order 32 bits of the hash code (see optimize_hash_code)
+are stored with each operator.
+They determine the first slot for the operator
+(so the table does not need the full code when it grows)
+and are used to skip operators with a different code during a search.
+Each slot uses sizeof(addr_t) + 4 bytes.
+*/
+class op_hash_table {
+private:
+	/// number of operators in the operation sequence (empty slot value)
+	size_t                   num_op_;
+	/// number of slots in use
+	size_t                   n_used_;
+	/// number of slots minus one
+	size_t                   mask_;
+	/// maximum number of slots
+	size_t                   max_slot_;
+	/// operator index for each slot
+	pod_vector<addr_t>       op_;
+	/// low order 32 bits of the hash code for the operator in each slot
+	pod_vector<unsigned int> code_;
+	// -----------------------------------------------------------------------
+	/// low order 32 bits of a hash code
+	static unsigned int short_code(size_t code)
+	{	return static_cast<unsigned int>( code & size_t(0xffffffff) ); }
+	/// set the number of slots to n_slot (a power of two) and empty them
+	void empty(size_t n_slot)
+	{	CPPAD_ASSERT_UNKNOWN( (n_slot & (n_slot - 1)) == 0 );
+		CPPAD_ASSERT_UNKNOWN( n_slot <= max_slot_ );
+		op_.resize(n_slot);
+		code_.resize(n_slot);
+		for(size_t i = 0; i < n_slot; ++i)
+			op_[i] = addr_t( num_op_ );
+		mask_   = n_slot - 1;
+		n_used_ = 0;
+	}
+	/// double the number of slots and rehash the operators
+	void grow(void)
+	{	pod_vector<addr_t>       old_op;
+		pod_vector<unsigned int> old_code;
+		old_op.swap(op_);
+		old_code.swap(code_);
+		size_t n_old = old_op.size();
+		empty(2 * n_old);
+		for(size_t i = 0; i < n_old; ++i)
+		{	if( size_t( old_op[i] ) != num_op_ )
+			{	size_t slot = old_code[i] & mask_;
+				while( size_t( op_[slot] ) != num_op_ )
+					slot = (slot + 1) & mask_;
+				op_[slot]   = old_op[i];
+				code_[slot] = old_code[i];
+				++n_used_;
+			}
+		}
+	}
+public:
+	/// default constructor
+	op_hash_table(void)
+	: num_op_(0), n_used_(0), mask_(0), max_slot_(0)
+	{ }
+	/*!
+	Set the number of operators and make the table empty.
+
+	\param num_op
+	is the number of operators in the operation sequence.
+	*/
+	void resize(size_t num_op)
+	{	num_op_   = num_op;
+		max_slot_ = 64;
+		while( max_slot_ < 2 * num_op )
+			max_slot_ *= 2;
+		size_t n_slot = 64;
+		while( n_slot < num_op / 4 )
+			n_slot *= 2;
+		empty(n_slot);
+	}
+	/// number of operators in the table
+	size_t size(void) const
+	{	return n_used_; }
+
+	/// number of slots in the table
+	size_t n_slot(void) const
+	{	return op_.size(); }
+
+	/// first slot to search for operators with a hash code
+	size_t first(size_t code) const
+	{	return short_code(code) & mask_; }
+
+	/*!
+	Next operator in the table with a specified hash code.
+
+	\param code
+	is the hash code we are searching for.
+
+	\param slot [in,out]
+	On input, it is the slot where the search starts
+	(the first call for a search should use first(code)).
+	Upon return, it is the slot after the operator that was found.
+
+	\return
+	is the index of an operator with the specified hash code
+	(only the low order 32 bits of the codes are compared).
+	If there are no more such operators, the return value is num_op.
+	*/
+	size_t next(size_t code, size_t& slot) const
+	{	unsigned int short_c = short_code(code);
+		while( size_t( op_[slot] ) != num_op_ )
+		{	size_t i = slot;
+			slot     = (slot + 1) & mask_;
+			if( code_[i] == short_c )
+				return size_t( op_[i] );
+		}
+		return num_op_;
+	}
+	/*!
+	Add an operator to the table.
+
+	\param code
+	is the hash code for this operator.
+
+	\param i_op
+	is the index of the operator (must be less than num_op).
+	Each operator index can be added at most once.
+	*/
+	void insert(size_t code, size_t i_op)
+	{	CPPAD_ASSERT_UNKNOWN( i_op < num_op_ );
+		CPPAD_ASSERT_UNKNOWN( n_used_ < num_op_ );
+		if( 2 * (n_used_ + 1) > op_.size() )
+			grow();
+		CPPAD_ASSERT_UNKNOWN( 2 * n_used_ < op_.size() );
+		unsigned int short_c = short_code(code);
+		size_t slot = short_c & mask_;
+		while( size_t( op_[slot] ) != num_op_ )
+			slot = (slot + 1) & mask_;
+		op_[slot]   = addr_t( i_op );
+		code_[slot] = short_c;
+		++n_used_;
+	}
+};
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
@@ -16,15 +16,20 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 # include <iterator>
 # include <cppad/local/optimize/get_op_usage.hpp>
 # include <cppad/local/optimize/get_par_usage.hpp>
+# include <cppad/local/optimize/get_dyn_previous.hpp>
+# include <cppad/local/optimize/get_simplify.hpp>
 # include <cppad/local/optimize/get_previous.hpp>
 # include <cppad/local/optimize/get_cexp_info.hpp>
 # include <cppad/local/optimize/size_pair.hpp>
 # include <cppad/local/optimize/csum_stacks.hpp>
+# include <cppad/local/optimize/cprod_stacks.hpp>
 # include <cppad/local/optimize/cexp_info.hpp>
 # include <cppad/local/optimize/record_pv.hpp>
 # include <cppad/local/optimize/record_vp.hpp>
 # include <cppad/local/optimize/record_vv.hpp>
 # include <cppad/local/optimize/record_csum.hpp>
+# include <cppad/local/optimize/record_cprod.hpp>
+# include <cppad/local/optimize/record_simplify.hpp>
 
 /*!
 \file optimize_run.hpp
@@ -64,6 +69,15 @@ If the sub-string "no_print_for" appears,
 then print forward (PriOp) operators will be removed from the optimized tape.
 These operators are useful for reporting problems evaluating derivatives
 at independent variable values different from those used to record a function.
+\li
+If the sub-string "no_simplify" appears,
+the algebraic simplifications (see get_simplify) are not done.
+\li
+If the sub-string "simplify" appears (and "no_simplify" does not),
+the simplifications that may change function or derivative values
+are also done; see exact_only in get_simplify.
+This also allows multiplications to be combined into cumulative products
+in any order; see exact_only in get_op_usage.
 
 \param n
 is the number of independent variables on the tape.
@@ -83,15 +97,34 @@ The input contents of this recording must be empty; i.e.,
 it corresponds to directly after the default constructor.
 Upon return, it contains an optimized verison of the
 operation sequence corresponding to \a play.
+
+\param simplify_count
+The input size of this vector does not matter.
+Upon return it has size number_simplify and simplify_count[k]
+is the number of operators, in the optimized recording,
+that were changed by the k-th simplification; see enum_simplify.
+
+\param num_threads
+is the number of threads in the team used to determine which parameters
+are used (see get_par_usage).
+
+\par Memory
+The work vectors are freed as soon as they are no longer needed
+and memory for the optimized operators and arguments is reserved,
+before the new recording is created, using the number of operators
+that are used. This keeps the peak memory close to the
+old operation sequence plus the new one.
 */
 
 template <class Addr, class Base>
 void optimize_run(
-	const std::string&                         options    ,
-	size_t                                     n          ,
-	vector<size_t>&                            dep_taddr  ,
-	player<Base>*                              play       ,
-	recorder<Base>*                            rec        )
+	const std::string&                         options        ,
+	size_t                                     n              ,
+	vector<size_t>&                            dep_taddr      ,
+	player<Base>*                              play           ,
+	recorder<Base>*                            rec            ,
+	vector<size_t>&                            simplify_count ,
+	size_t                                     num_threads = 1 )
 {	// check that recorder is empty
 	CPPAD_ASSERT_UNKNOWN( rec->num_op_rec() == 0 );
 	//
@@ -103,6 +136,8 @@ void optimize_run(
 	bool conditional_skip = true;
 	bool compare_op       = true;
 	bool print_for_op     = true;
+	bool simplify         = true;
+	bool exact_only       = true;
 	size_t index = 0;
 	while( index < options.size() )
 	{	while( index < options.size() && options[index] == ' ' )
@@ -117,6 +152,10 @@ void optimize_run(
 				compare_op = false;
 			else if( option == "no_print_for_op" )
 				print_for_op = false;
+			else if( option == "no_simplify" )
+				simplify = false;
+			else if( option == "simplify" )
+				exact_only = false;
 			else
 			{	option += " is not a valid optimize option";
 				CPPAD_ASSERT_KNOWN( false , option.c_str() );
@@ -147,6 +186,35 @@ void optimize_run(
 	// number of dynamic parameters
 	CPPAD_ASSERT_UNKNOWN( num_dynamic_ind <= play->num_dynamic_par () );
 
+	// -----------------------------------------------------------------------
+	// dynamic parameters that are folded or replaced by previous parameters
+	pod_vector<addr_t> dyn_previous;
+	get_dyn_previous(
+		play,
+		dyn_previous
+	);
+	// -----------------------------------------------------------------------
+	// algebraic simplification for each operator
+	pod_vector<struct_simplify> op_simplify;
+	vector<Base>                simplify_factor;
+	if( simplify )
+	{	get_simplify(
+			play,
+			random_itr,
+			dyn_previous,
+			exact_only,
+			op_simplify,
+			simplify_factor
+		);
+	}
+	else
+	{	op_simplify.resize(num_op);
+		for(size_t i_op = 0; i_op < num_op; ++i_op)
+			op_simplify[i_op].kind = simplify_t(no_simplify);
+	}
+	simplify_count.resize( size_t(number_simplify) );
+	for(size_t k = 0; k < size_t(number_simplify); ++k)
+		simplify_count[k] = 0;
 	// -----------------------------------------------------------------------
 	// operator information
 	pod_vector<addr_t>        cexp2op;
@@ -157,9 +225,11 @@ void optimize_run(
 		conditional_skip,
 		compare_op,
 		print_for_op,
+		exact_only,
 		play,
 		random_itr,
 		dep_taddr,
+		op_simplify,
 		cexp2op,
 		cexp_set,
 		vecad_used,
@@ -169,6 +239,7 @@ void optimize_run(
 	get_previous(
 		play,
 		random_itr,
+		op_simplify,
 		cexp_set,
 		op_previous,
 		op_usage
@@ -202,7 +273,9 @@ void optimize_run(
 		random_itr,
 		op_usage,
 		vecad_used,
-		par_usage
+		dyn_previous,
+		par_usage,
+		num_threads
 	);
 	// -----------------------------------------------------------------------
 
@@ -244,6 +317,20 @@ void optimize_run(
 	// =======================================================================
 	// check that recording is still empty
 	CPPAD_ASSERT_UNKNOWN( rec->num_op_rec() == 0 );
+	//
+	// reserve memory for the operators that are used
+	// (one conditional skip for each conditional expression)
+	{	size_t n_op_reserve  = num_cexp;
+		size_t n_arg_reserve = 0;
+		for(size_t j_op = 0; j_op < num_op; ++j_op)
+		{	bool used = op_usage[j_op] == usage_t(yes_usage);
+			if( used && op_previous[j_op] == 0 )
+			{	++n_op_reserve;
+				n_arg_reserve += NumArg( random_itr.get_op(j_op) );
+			}
+		}
+		rec->reserve(n_op_reserve, n_arg_reserve);
+	}
 
 	// -----------------------------------------------------------------------
 	// set mapping from old parameter indices to new parameter indices
@@ -281,7 +368,22 @@ void optimize_run(
 		// number of arguments for this dynamic parameter
 		size_t n_arg   = num_arg_dyn(op);
 		//
-		if( par_usage[i_par] )
+		// previous parameter that replaces this one
+		size_t j_par = dyn_previous[i_par];
+		//
+		if( par_usage[i_par] && j_par == num_par )
+		{	// this dynamic parameter has been folded to a constant
+			CPPAD_ASSERT_UNKNOWN( num_dynamic_ind <= i_par );
+			Base par       = play->GetPar(i_par);
+			new_par[i_par] = rec->put_con_par(par);
+		}
+		else if( par_usage[i_par] && j_par != i_par )
+		{	// use the previous parameter that has the same value
+			CPPAD_ASSERT_UNKNOWN( num_dynamic_ind <= i_par );
+			CPPAD_ASSERT_UNKNOWN( j_par < i_par && par_usage[j_par] );
+			new_par[i_par] = new_par[j_par];
+		}
+		else if( par_usage[i_par] )
 		{	// value of this parameter
 			Base par       = play->GetPar(i_par);
 			//
@@ -324,6 +426,9 @@ void optimize_run(
 		++i_dyn;
 		i_arg += n_arg;
 	}
+	// We no longer need par_usage or dyn_previous, so free their memory
+	par_usage.clear();
+	dyn_previous.clear();
 	// ------------------------------------------------------------------------
 	// initialize mapping from old VecAD index to new VecAD index
 	CPPAD_ASSERT_UNKNOWN(
@@ -359,6 +464,9 @@ void optimize_run(
 	// (decalared here to avoid realloaction of memory)
 	struct_csum_stacks csum_work;
 
+	// temporary work space used by record_cprod
+	struct_cprod_stacks cprod_work;
+
 	// tempory used to hold a size_pair
 	struct_size_pair size_pair;
 	//
@@ -451,10 +559,28 @@ void optimize_run(
 			size_t( std::numeric_limits<addr_t>::max() ) >= rec->num_op_rec()
 		);
 		//
+		// algebraic simplification for this operator
+		enum_simplify kind = enum_simplify( op_simplify[i_op].kind );
+		//
 		if( op_usage[i_op] != usage_t(yes_usage) )
 		{	if( op == CExpOp )
 				++cexp_next;
 		}
+		else if( simplify_alias(kind) )
+		{	// result of this operator is the variable x (see get_previous)
+			CPPAD_ASSERT_UNKNOWN(
+				previous == random_itr.var2op( op_simplify[i_op].var )
+			);
+			++simplify_count[kind];
+		}
+		else if( kind != no_simplify && previous == 0 )
+		{	size_pair = record_simplify(
+				random_itr, op_simplify, simplify_factor, new_var, i_op, rec
+			);
+			new_op[i_op]  = addr_t( size_pair.i_op );
+			new_var[i_op] = addr_t( size_pair.i_var );
+			++simplify_count[kind];
+		}
 		else switch( op )
 		{	// op_usage[i_op] == usage_t(yes_usage)
 
@@ -600,8 +726,33 @@ void optimize_run(
 				// abort rest of this case
 				break;
 			}
-			case DivpvOp:
 			case MulpvOp:
+			// check if this is the top of a cprod connection
+			// (AddpvOp and SubpvOp fall through to this case, and a
+			// simplified operator that is replaced by a previous
+			// operator may have a cprod_usage argument)
+			if( op == MulpvOp && previous == 0 &&
+				op_usage[ random_itr.var2op(arg[1]) ] == usage_t(cprod_usage)
+			)
+			{	CPPAD_ASSERT_UNKNOWN( kind == no_simplify );
+				//
+				// convert to a sequence of multiplication operators
+				size_pair = record_cprod(
+					play                ,
+					random_itr          ,
+					op_usage            ,
+					new_par             ,
+					new_var             ,
+					i_var               ,
+					rec                 ,
+					cprod_work
+				);
+				new_op[i_op]  = addr_t( size_pair.i_op );
+				new_var[i_op] = addr_t( size_pair.i_var );
+				// abort rest of this case
+				break;
+			}
+			case DivpvOp:
 			case PowpvOp:
 			case ZmulpvOp:
 			if( previous == 0 )
@@ -646,8 +797,33 @@ void optimize_run(
 				// abort rest of this case
 				break;
 			}
-			case DivvvOp:
 			case MulvvOp:
+			// check if this is the top of a cprod connection
+			// (AddvvOp and SubvvOp fall through to this case)
+			if( op == MulvvOp && previous == 0 && (
+				op_usage[ random_itr.var2op(arg[0]) ] == usage_t(cprod_usage)
+				||
+				op_usage[ random_itr.var2op(arg[1]) ] == usage_t(cprod_usage)
+			) )
+			{	CPPAD_ASSERT_UNKNOWN( kind == no_simplify );
+				//
+				// convert to a sequence of multiplication operators
+				size_pair = record_cprod(
+					play                ,
+					random_itr          ,
+					op_usage            ,
+					new_par             ,
+					new_var             ,
+					i_var               ,
+					rec                 ,
+					cprod_work
+				);
+				new_op[i_op]  = addr_t( size_pair.i_op );
+				new_var[i_op] = addr_t( size_pair.i_var );
+				// abort rest of this case
+				break;
+			}
+			case DivvvOp:
 			case PowvvOp:
 			case ZmulvvOp:
 			if( previous == 0 )
@@ -997,11 +1173,17 @@ void optimize_run(
 
 		}
 	}
+	// We no longer need op_usage and vecad_used, so free their memory
+	op_usage.clear();
+	vecad_used.clear();
+	//
 	// modify the dependent variable vector to new indices
 	for(size_t i = 0; i < dep_taddr.size(); i++ )
 	{	dep_taddr[i] = new_var[ random_itr.var2op(dep_taddr[i]) ];
 		CPPAD_ASSERT_UNKNOWN( size_t(dep_taddr[i]) < num_var );
 	}
+	// We no longer need new_var, so free its memory
+	new_var.clear();
 
 # ifndef NDEBUG
 	for(i_op = 0; i_op < num_op; i_op++)
@@ -0,0 +1,206 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_RECORD_CPROD_HPP
+# define CPPAD_LOCAL_OPTIMIZE_RECORD_CPROD_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*!
+\file record_cprod.hpp
+Recording a cumulative product.
+*/
+# include <cppad/local/optimize/cprod_stacks.hpp>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize  {
+/*!
+Recording a cumulative product.
+
+\param play
+player object corresponding to the old recroding.
+
+\param random_itr
+is a random iterator corresponding to the old operation sequence.
+
+\param op_usage
+mapping from old index to how it is used.
+
+\param new_par
+mapping from old parameter index to parameter index in new recording.
+
+\param new_var
+mapping from old operator index to variable index in new recording.
+
+\param current
+is the index in the old operation sequence for
+the variable corresponding to the result for the current operator.
+We use the notation i_op = random_itr.var2op(current).
+It follows that  NumRes( random_itr.get_op[i_op] ) > 0.
+If 0 < j_op < i_op, either op_usage[j_op] == usage_t(cprod_usage),
+op_usage[j_op] = usage_t(no_usage), or new_var[j_op] != 0.
+
+\param rec
+is the object that will record the new operations.
+
+\return
+is the operator and variable indices in the new operation sequence.
+
+\param stack
+Is temporary work space. On input and output,
+stack.op, stack.var, and stack.dyn, are all empty.
+These stacks are passed in so that they are created once
+and then be reused with calls to record_cprod.
+
+\par Assumptions
+random_itr.get_op[i_op] must be MulpvOp or MulvvOp,
+op_usage[i_op] == usage_t(yes_usage),
+and i_op is not simplified; see get_simplify.
+Furthermore op_usage[j_op] == usage_t(cprod_usage) is true from some
+j_op that corresponds to a variable that is an argument to
+random_itr.get_op[i_op].
+*/
+
+template <class Addr, class Base>
+struct_size_pair record_cprod(
+	const player<Base>*                                play           ,
+	const play::const_random_iterator<Addr>&           random_itr     ,
+	const pod_vector<usage_t>&                         op_usage       ,
+	const pod_vector<addr_t>&                          new_par        ,
+	const pod_vector<addr_t>&                          new_var        ,
+	size_t                                             current        ,
+	recorder<Base>*                                    rec            ,
+	// local information passed so stacks need not be allocated for every call
+	struct_cprod_stacks&                               stack          )
+{
+# ifndef NDEBUG
+	// number of parameters corresponding to the old operation sequence.
+	size_t npar = play->num_par_rec();
+# endif
+
+	// vector of length npar containing the parameters the old operation
+	// sequence; i.e., given a parameter index i < npar, the corresponding
+	// parameter value is par[i].
+	const Base* par = play->GetPar();
+
+	// which parameters are dynamic
+	const pod_vector<bool>& dyn_par_is( play->dyn_par_is() );
+
+	// check assumption about work space
+	CPPAD_ASSERT_UNKNOWN( stack.op.empty() );
+	CPPAD_ASSERT_UNKNOWN( stack.var.empty() );
+	CPPAD_ASSERT_UNKNOWN( stack.dyn.empty() );
+	//
+	size_t i_op = random_itr.var2op(current);
+	CPPAD_ASSERT_UNKNOWN( op_usage[i_op] == usage_t(yes_usage) );
+	//
+	// initialize stack as containing this one operator
+	stack.op.push( addr_t(i_op) );
+	//
+	// initialize product of constant parameter values as one
+	Base prod_par(1);
+	//
+	// while there are operators left on the stack
+	OpCode        op;
+	const addr_t* arg;
+	size_t        not_used;
+	while( ! stack.op.empty() )
+	{	// get this multiplication operator
+		random_itr.op_info( size_t( stack.op.top() ), op, arg, not_used);
+		stack.op.pop();
+		CPPAD_ASSERT_UNKNOWN( op == MulpvOp || op == MulvvOp );
+		// -------------------------------------------------------------------
+		// process first argument to this operator
+		// -------------------------------------------------------------------
+		if( op == MulpvOp )
+		{	CPPAD_ASSERT_UNKNOWN( size_t(arg[0]) < npar );
+			if( dyn_par_is[ arg[0] ] )
+			{	// first argument is a dynamic parameter
+				// (can't yet be a result, so no nodes below)
+				stack.dyn.push(arg[0]);
+			}
+			else
+			{	// first argument is not a dynamic parameter
+				prod_par *= par[arg[0]];
+			}
+		}
+		else
+		{	size_t j_op = random_itr.var2op(arg[0]);
+			if( op_usage[j_op] == usage_t(cprod_usage) )
+			{	CPPAD_ASSERT_UNKNOWN( size_t( new_var[j_op] ) == 0 );
+				// push the operator corresponding to the first argument
+				stack.op.push( addr_t(j_op) );
+			}
+			else
+			{	// there are no nodes below this one
+				CPPAD_ASSERT_UNKNOWN( size_t(arg[0]) < current );
+				stack.var.push(arg[0]);
+			}
+		}
+		// -------------------------------------------------------------------
+		// process second argument to this operator (always a variable)
+		// -------------------------------------------------------------------
+		size_t j_op = random_itr.var2op(arg[1]);
+		if( op_usage[j_op] == usage_t(cprod_usage) )
+		{	CPPAD_ASSERT_UNKNOWN( size_t( new_var[j_op] ) == 0 );
+			// push the operator corresponding to the second argument
+			stack.op.push( addr_t(j_op) );
+		}
+		else
+		{	// there are no nodes below this one
+			CPPAD_ASSERT_UNKNOWN( size_t(arg[1]) < current );
+			stack.var.push(arg[1]);
+		}
+	}
+	// number of variables in this cumulative product operator
+	size_t n_var = stack.var.size();
+	CPPAD_ASSERT_UNKNOWN( 0 < n_var );
+
+	// number of dynamic parameters in this cumulative product operator
+	size_t n_dyn = stack.dyn.size();
+
+	// first three arguements to cumulative product operator
+	addr_t new_arg = rec->put_con_par(prod_par);
+	rec->PutArg(new_arg);            // arg[0]: initial product
+	size_t end   = n_var + 3;
+	rec->PutArg( addr_t(end) );      // arg[1]: end for variables
+	end           += n_dyn;
+	rec->PutArg( addr_t(end) );      // arg[2]: end for dynamics
+
+	// variable arguments
+	for(size_t i = 0; i < n_var; i++)
+	{	CPPAD_ASSERT_UNKNOWN( ! stack.var.empty() );
+		addr_t old_arg = stack.var.top();
+		new_arg        = new_var[ random_itr.var2op(old_arg) ];
+		CPPAD_ASSERT_UNKNOWN( 0 < new_arg && size_t(new_arg) < current );
+		rec->PutArg(new_arg);         // arg[3+i]
+		stack.var.pop();
+	}
+
+	// dynamic parameter arguments
+	for(size_t i = 0; i < n_dyn; ++i)
+	{	addr_t old_arg = stack.dyn.top();
+		new_arg        = new_par[ old_arg ];
+		rec->PutArg(new_arg);      // arg[arg[1] + i]
+		stack.dyn.pop();
+	}
+
+	// number of variables plus number of dynamic parameters
+	rec->PutArg( addr_t(end) );    // arg[arg[2]] = arg[2]
+	//
+	// return value
+	struct_size_pair ret;
+	ret.i_op  = rec->num_op_rec();
+	ret.i_var = rec->PutOp(CProdOp);
+	//
+	return ret;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+
+# endif
@@ -0,0 +1,99 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_RECORD_SIMPLIFY_HPP
+# define CPPAD_LOCAL_OPTIMIZE_RECORD_SIMPLIFY_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*!
+\file record_simplify.hpp
+Record the simplified version of an operator.
+*/
+# include <cppad/local/optimize/simplify.hpp>
+# include <cppad/local/optimize/size_pair.hpp>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize  {
+
+/*!
+Record the simplified version of an operator.
+
+\param random_itr
+random iterator corresponding to old recording.
+
+\param op_simplify
+is the algebraic simplification for each operator; see get_simplify.
+
+\param simplify_factor
+is the vector of factors for the div_con_simplify and
+mul_chain_simplify cases.
+
+\param new_var
+mapping from old operator index to variable index in new recording.
+
+\param i_op
+is the index in the old operation sequence for this operator.
+The simplification for this operator must be
+pow_two_simplify, div_con_simplify, or mul_chain_simplify.
+
+\param rec
+is the object that will record the new operations.
+
+\return
+is the operator and variable indices in the new operation sequence.
+*/
+template <class Addr, class Base>
+struct_size_pair record_simplify(
+	const play::const_random_iterator<Addr>&           random_itr      ,
+	const pod_vector<struct_simplify>&                 op_simplify     ,
+	const vector<Base>&                                simplify_factor ,
+	const pod_vector<addr_t>&                          new_var         ,
+	size_t                                             i_op            ,
+	recorder<Base>*                                    rec             )
+{	enum_simplify kind = enum_simplify( op_simplify[i_op].kind );
+	//
+	// new variable index for x
+	size_t  x     = op_simplify[i_op].var;
+	addr_t  new_x = new_var[ random_itr.var2op(x) ];
+	CPPAD_ASSERT_UNKNOWN( 0 < new_x );
+	//
+	struct_size_pair ret;
+	switch( kind )
+	{
+		// x * x
+		case pow_two_simplify:
+		CPPAD_ASSERT_NARG_NRES(MulvvOp, 2, 1);
+		rec->PutArg(new_x, new_x);
+		ret.i_op  = rec->num_op_rec();
+		ret.i_var = rec->PutOp(MulvvOp);
+		break;
+
+		// factor * x
+		case div_con_simplify:
+		case mul_chain_simplify:
+		CPPAD_ASSERT_NARG_NRES(MulpvOp, 2, 1);
+		rec->PutArg(
+			rec->put_con_par( simplify_factor[ op_simplify[i_op].factor ] ),
+			new_x
+		);
+		ret.i_op  = rec->num_op_rec();
+		ret.i_var = rec->PutOp(MulpvOp);
+		break;
+
+		default:
+		CPPAD_ASSERT_UNKNOWN(false);
+		ret.i_op  = 0;
+		ret.i_var = 0;
+	}
+	CPPAD_ASSERT_UNKNOWN( size_t(new_x) < ret.i_var );
+	return ret;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
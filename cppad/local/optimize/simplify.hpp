@@ -0,0 +1,100 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_SIMPLIFY_HPP
+# define CPPAD_LOCAL_OPTIMIZE_SIMPLIFY_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+# include <cppad/local/define.hpp>
+/*!
+\file simplify.hpp
+Algebraic simplifications done by the optimizer.
+*/
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize {
+
+typedef CPPAD_VEC_ENUM_TYPE simplify_t;
+
+/*!
+Algebraic simplification for one operator.
+In the cases below x is a variable and c, d are constant parameters
+(or dynamic parameters that the optimizer converts to constants).
+*/
+enum enum_simplify {
+	/// This operator is not simplified.
+	no_simplify,
+
+	/// x * 1, 1 * x, x / 1, azmul(x, 1), azmul(1, x) are replaced by x.
+	mul_one_simplify,
+
+	/// x + 0, 0 + x, x - 0 are replaced by x.
+	add_zero_simplify,
+
+	/// exp( log(x) ) is replaced by x.
+	exp_log_simplify,
+
+	/// pow(x, 2) is recorded as x * x.
+	pow_two_simplify,
+
+	/// x / c is recorded as (1 / c) * x.
+	div_con_simplify,
+
+	/// c * (d * x) is recorded as (c * d) * x (for any length chain).
+	mul_chain_simplify,
+
+	/// number of simplifications (not a simplification)
+	number_simplify
+};
+
+/// Is the result of this simplification equal to the variable x
+inline bool simplify_alias(enum_simplify kind)
+{	return (kind == mul_one_simplify)
+	|      (kind == add_zero_simplify)
+	|      (kind == exp_log_simplify);
+}
+
+/// name used by ADFun<Base>::simplify_count for each simplification
+inline const char* simplify_name(enum_simplify kind)
+{	static const char* name_table[] = {
+		"",           // no_simplify
+		"mul_one",    // mul_one_simplify
+		"add_zero",   // add_zero_simplify
+		"exp_log",    // exp_log_simplify
+		"pow_two",    // pow_two_simplify
+		"div_con",    // div_con_simplify
+		"mul_chain"   // mul_chain_simplify
+	};
+	CPPAD_ASSERT_UNKNOWN(
+		size_t(number_simplify) == sizeof(name_table)/sizeof(name_table[0])
+	);
+	return name_table[kind];
+}
+
+/// Simplification information for one operator in the old recording
+struct struct_simplify {
+	/// The type of simplification; i.e., an enum_simplify value.
+	simplify_t kind;
+
+	/// If kind is not no_simplify, the variable index for x
+	/// in the old recording.
+	addr_t     var;
+
+	/// If kind is div_con_simplify or mul_chain_simplify,
+	/// the index in the vector of factors that multiplies x.
+	addr_t     factor;
+};
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+namespace CppAD { namespace local {
+	template <> inline bool is_pod<optimize::struct_simplify>(void)
+	{ return true; }
+} }
+
+# endif
@@ -30,7 +30,15 @@ enum enum_usage {
 	a dependent variable. Hence case it can be removed as part of a
 	cumulative summation starting at its parent or above.
 	*/
-	csum_usage
+	csum_usage,
+
+	/*!
+	This operator is only used once, it is a multiplication operator,
+	and its parrent is a multiplication operator. Furthermore, its result is
+	not a dependent variable. Hence case it can be removed as part of a
+	cumulative product starting at its parent or above.
+	*/
+	cprod_usage
 };
 
 
@@ -0,0 +1,216 @@
+# ifndef CPPAD_LOCAL_PLAY_BINARY_FILE_HPP
+# define CPPAD_LOCAL_PLAY_BINARY_FILE_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <ostream>
+# include <cstring>
+
+// BEGIN_CPPAD_LOCAL_PLAY_NAMESPACE
+namespace CppAD { namespace local { namespace play {
+
+/*!
+\file binary_file.hpp
+Sections of the binary file format used by ADFun::to_file.
+
+Each section begins with a header that contains the number of elements
+in the section. The header, and the data that follows it, begin on
+boundaries that are multiples of binary_align bytes from the beginning of
+the file. Hence, if the file is mapped into memory, the section data can
+be used in place.
+*/
+
+/// alignment, in bytes, of section headers and section data
+static const size_t binary_align = 16;
+
+/// number of bytes in a section with data of length n_byte
+inline size_t binary_section_size(size_t n_byte)
+{	size_t size = binary_align + n_byte;
+	return ( (size + binary_align - 1) / binary_align ) * binary_align;
+}
+
+/*!
+Write a section of the binary file.
+
+\param os
+is the stream we are writing to. Its current position must be a
+multiple of binary_align from the beginning of the file.
+
+\param n
+is the number of elements in the section.
+
+\param data
+is the first element in the section (not used if n is zero).
+*/
+template <class Type>
+void binary_write(std::ostream& os, size_t n, const Type* data)
+{	CPPAD_ASSERT_UNKNOWN( sizeof(size_t) <= binary_align );
+	char zero[binary_align];
+	std::memset(zero, 0, binary_align);
+	//
+	size_t n_byte = n * sizeof(Type);
+	os.write( reinterpret_cast<const char*>(&n), sizeof(size_t) );
+	os.write(zero, std::streamsize( binary_align - sizeof(size_t) ) );
+	if( n_byte > 0 ) os.write(
+		reinterpret_cast<const char*>(data), std::streamsize(n_byte)
+	);
+	//
+	size_t n_pad = binary_section_size(n_byte) - binary_align - n_byte;
+	os.write(zero, std::streamsize(n_pad) );
+}
+
+/// initial value for binary_hash
+static const size_t binary_hash_init = size_t( 2166136261u );
+
+/*!
+Continue a hash code with the bytes in an array
+(uses the FNV-1a algorithm with its 32 bit prime).
+
+\param code
+is the hash code for the previous arrays (binary_hash_init for none).
+
+\param n
+is the number of elements in the array.
+
+\param data
+is the first element in the array (not used if n is zero).
+
+\return
+is the hash code for the previous arrays followed by this one.
+*/
+template <class Type>
+size_t binary_hash(size_t code, size_t n, const Type* data)
+{	const unsigned char* byte = reinterpret_cast<const unsigned char*>(data);
+	size_t n_byte = n * sizeof(Type);
+	code = (code ^ n) * size_t( 16777619u );
+	for(size_t i = 0; i < n_byte; ++i)
+		code = (code ^ size_t( byte[i] ) ) * size_t( 16777619u );
+	return code;
+}
+
+/*!
+Locate a section of the binary file.
+
+\param ptr [in,out]
+On input, is the beginning of the section in memory.
+Upon return, it is the beginning of the next section.
+
+\param end
+is the end of the memory that contains the file.
+
+\param size_of
+is the number of bytes in each element of the section.
+
+\param n [out]
+is the number of elements in the section.
+
+\param data [out]
+is the beginning of the section data.
+
+\return
+is false if the section does not fit in the memory that contains the file.
+*/
+inline bool binary_section(
+	const char*&  ptr     ,
+	const char*   end     ,
+	size_t        size_of ,
+	size_t&       n       ,
+	const char*&  data    )
+{	if( size_t(end - ptr) < binary_align )
+		return false;
+	std::memcpy(&n, ptr, sizeof(size_t) );
+	//
+	size_t n_byte = n * size_of;
+	if( n_byte / size_of != n )
+		return false;
+	size_t size   = binary_section_size(n_byte);
+	if( size < n_byte || size_t(end - ptr) < size )
+		return false;
+	//
+	data = ptr + binary_align;
+	ptr += size;
+	return true;
+}
+
+/*!
+Read a section of the binary file into a pod_vector.
+
+\param ptr [in,out]
+On input, is the beginning of the section in memory.
+Upon return, it is the beginning of the next section.
+
+\param end
+is the end of the memory that contains the file.
+
+\param copy
+If true, the section data is copied to the vector.
+Otherwise, the vector refers to the section data in place
+(see pod_vector::set_external). In this case, ptr must be aligned
+for the type of the elements in vec and the memory must be writable
+if any of the elements of vec are changed.
+
+\param vec [out]
+is set to the section data.
+
+\return
+is false if the section does not fit in the memory that contains the file.
+*/
+template <class Type>
+bool binary_read(
+	const char*&       ptr  ,
+	const char*        end  ,
+	bool               copy ,
+	pod_vector<Type>&  vec  )
+{	size_t      n;
+	const char* data;
+	if( ! binary_section(ptr, end, sizeof(Type), n, data) )
+		return false;
+	if( copy )
+	{	vec.resize(n);
+		if( n > 0 )
+			std::memcpy(vec.data(), data, n * sizeof(Type) );
+	}
+	else
+	{	// data is aligned because memory maps begin on a page boundary
+		Type* type_data = reinterpret_cast<Type*>( const_cast<char*>(data) );
+		vec.set_external(type_data, n);
+	}
+	return true;
+}
+/// pod_vector_maybe version of binary_read (is_pod<Type> must be true)
+template <class Type>
+bool binary_read(
+	const char*&             ptr  ,
+	const char*              end  ,
+	bool                     copy ,
+	pod_vector_maybe<Type>&  vec  )
+{	CPPAD_ASSERT_UNKNOWN( is_pod<Type>() );
+	size_t      n;
+	const char* data;
+	if( ! binary_section(ptr, end, sizeof(Type), n, data) )
+		return false;
+	if( copy )
+	{	vec.resize(n);
+		if( n > 0 )
+			std::memcpy(vec.data(), data, n * sizeof(Type) );
+	}
+	else
+	{	// data is aligned because memory maps begin on a page boundary
+		Type* type_data = reinterpret_cast<Type*>( const_cast<char*>(data) );
+		vec.set_external(type_data, n);
+	}
+	return true;
+}
+
+} } } // END_CPPAD_LOCAL_PLAY_NAMESPACE
+
+# endif
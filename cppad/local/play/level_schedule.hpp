@@ -0,0 +1,80 @@
+# ifndef CPPAD_LOCAL_PLAY_LEVEL_SCHEDULE_HPP
+# define CPPAD_LOCAL_PLAY_LEVEL_SCHEDULE_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/local/pod_vector.hpp>
+
+// BEGIN_CPPAD_LOCAL_PLAY_NAMESPACE
+namespace CppAD { namespace local { namespace play {
+
+/*!
+\file level_schedule.hpp
+Level (wavefront) schedule for the operators in an operation sequence.
+*/
+
+/// One operator in a level schedule.
+struct level_op {
+	/// operator code
+	OpCode        op;
+	/// index of this operator in the operation sequence
+	size_t        op_index;
+	/// primary (last) result for this operator
+	size_t        i_var;
+	/// arguments for this operator
+	const addr_t* arg;
+};
+
+/*!
+The level schedule for an operation sequence.
+
+The operators with results (other than InvOp) are divided into windows
+of consecutive operators. Within a window, the level of an operator is one
+plus the maximum level for its variable arguments that are results of
+operators in the same window (one if there are no such arguments).
+The levels for each window come after the levels for the previous window.
+Operators with the same level do not depend on each other and hence can be
+evaluated in any order.
+*/
+struct level_schedule {
+	/// has this schedule been setup for the current operation sequence
+	bool setup;
+	/// does the schedule support this operation sequence
+	/// (VecAD, discrete and atomic function operators are not supported)
+	bool supported;
+	/// operators with results (not including InvOp) sorted by level
+	pod_vector_maybe<level_op> op_vec;
+	/// op_vec[ level_begin[ell] ] is the first operator in the ell-th level;
+	/// level_begin.size() is the number of levels plus one and
+	/// its last element is op_vec.size().
+	pod_vector<size_t> level_begin;
+	/// comparison and print operators in operation sequence order
+	pod_vector_maybe<level_op> serial_vec;
+	/// maximum number of variables in a CProdOp operator (zero if none)
+	size_t max_cprod;
+	/// constructor
+	level_schedule(void) : setup(false), supported(false), max_cprod(0)
+	{ }
+	/// free the memory for this schedule and mark it as not setup
+	void clear(void)
+	{	setup     = false;
+		supported = false;
+		op_vec.clear();
+		level_begin.clear();
+		serial_vec.clear();
+		max_cprod = 0;
+	}
+};
+
+} } } // END_CPPAD_LOCAL_PLAY_NAMESPACE
+
+# endif
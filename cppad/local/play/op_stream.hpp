@@ -0,0 +1,110 @@
+# ifndef CPPAD_LOCAL_PLAY_OP_STREAM_HPP
+# define CPPAD_LOCAL_PLAY_OP_STREAM_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <ostream>
+# include <cppad/local/pod_vector.hpp>
+
+// BEGIN_CPPAD_LOCAL_PLAY_NAMESPACE
+namespace CppAD { namespace local { namespace play {
+
+/*!
+\file op_stream.hpp
+Types used by the pre-decoded operator stream for zero order forward mode.
+*/
+
+/*!
+Information that is the same for every operator during one
+zero order forward sweep that uses the operator stream.
+
+\tparam Base
+type used for the zero order forward mode calculations.
+*/
+template <class Base>
+struct op_stream_info {
+	/// number of parameters
+	size_t        num_par;
+	/// pointer to the beginning of the parameter vector
+	const Base*   parameter;
+	/// number of characters in the text vector
+	size_t        num_text;
+	/// pointer to the beginning of the text vector
+	const char*   text;
+	/// number of columns in the Taylor coefficient matrix
+	size_t        J;
+	/// Taylor coefficient matrix
+	Base*         taylor;
+	/// which operators are conditionally skipped
+	bool*         cskip_op;
+	/// stream where the print operator output is written
+	std::ostream* s_out;
+	/// should the print operators generate output
+	bool          print;
+	/// count value for compare_change_op_index
+	size_t        compare_change_count;
+	/// number of comparison operators that changed
+	size_t        compare_change_number;
+	/// operator index for the count-th comparison that changed
+	size_t        compare_change_op_index;
+};
+
+/*!
+One operator in the pre-decoded operator stream.
+
+\tparam Base
+type used for the zero order forward mode calculations.
+*/
+template <class Base>
+struct op_stream_op {
+	/// function that computes the zero order result for this operator
+	void (*handler)(const op_stream_op& op, op_stream_info<Base>& info);
+	/// index of this operator in the operation sequence
+	size_t        op_index;
+	/// primary (last) result for this operator
+	size_t        i_var;
+	/// arguments for this operator
+	const addr_t* arg;
+};
+
+/*!
+The pre-decoded operator stream for an operation sequence.
+
+\tparam Base
+type used for the zero order forward mode calculations.
+*/
+template <class Base>
+struct op_stream {
+	/// has this stream been setup for the current operation sequence
+	bool setup;
+	/// does the stream support this operation sequence
+	/// (VecAD and atomic function operators are not supported)
+	bool supported;
+	/// does the operation sequence contain a CSkipOp operator
+	bool has_cskip;
+	/// the operators that have a handler (in order)
+	pod_vector_maybe< op_stream_op<Base> > op_vec;
+	/// constructor
+	op_stream(void) : setup(false), supported(false), has_cskip(false)
+	{ }
+	/// free the memory for this stream and mark it as not setup
+	void clear(void)
+	{	setup     = false;
+		supported = false;
+		has_cskip = false;
+		op_vec.clear();
+	}
+};
+
+} } } // END_CPPAD_LOCAL_PLAY_NAMESPACE
+
+# endif
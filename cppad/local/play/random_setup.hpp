@@ -123,6 +123,18 @@ void random_setup(
 			// Correct index of first argument for next operator
 			arg_index += op_arg[4] + 1;
 		}
+		// CProdOp
+		if( op == CProdOp )
+		{	CPPAD_ASSERT_UNKNOWN( NumArg(CProdOp) == 0 );
+			//
+			// pointer to first argument for this operator
+			const addr_t* op_arg = arg_vec.data() + arg_index;
+			//
+			// The actual number of arugments for this operator is
+			// op_arg[2] + 1
+			// Correct index of first argument for next operator
+			arg_index += op_arg[2] + 1;
+		}
 		//
 		// CSkip
 		if( op == CSkipOp )
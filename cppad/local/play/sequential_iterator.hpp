@@ -165,7 +165,7 @@ public:
 	}
 	/*!
 	Correction applied before ++ operation when current operator
-	is CSumOp or CSkipOp.
+	is CSumOp, CProdOp, or CSkipOp.
 	*/
 	void correct_before_increment(void)
 	{	// number of arguments for this operator depends on argument data
@@ -178,6 +178,12 @@ public:
 			arg_ += arg[4] + 1;
 		}
 		//
+		// CProdOp
+		else if( op_ == CProdOp )
+		{	// add actual number of arguments to arg_
+			arg_ += arg[2] + 1;
+		}
+		//
 		// CSkip
 		else
 		{	CPPAD_ASSERT_UNKNOWN( op_ == CSkipOp );
@@ -210,7 +216,7 @@ public:
 	}
 	/*!
 	Correction applied after -- operation when current operator
-	is CSumOp or CSkipOp.
+	is CSumOp, CProdOp, or CSkipOp.
 
 	\param arg [out]
 	corrected point to arguments for this operation.
@@ -233,6 +239,17 @@ public:
 			CPPAD_ASSERT_UNKNOWN( arg[arg[4] ] == arg[4] );
 		}
 		//
+		// CProdOp
+		else if( op_ == CProdOp )
+		{	// index of arg[2]
+			addr_t arg_2 = *(arg_ - 1);
+			//
+			// corrected index of first argument to this operator
+			arg = arg_ -= arg_2 + 1;
+			//
+			CPPAD_ASSERT_UNKNOWN( arg[arg[2] ] == arg[2] );
+		}
+		//
 		// CSkip
 		else
 		{	CPPAD_ASSERT_UNKNOWN( op_ == CSkipOp );
@@ -16,9 +16,16 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 # include <cppad/local/play/sequential_iterator.hpp>
 # include <cppad/local/play/subgraph_iterator.hpp>
 # include <cppad/local/play/random_setup.hpp>
+# include <cppad/local/play/binary_file.hpp>
+# include <cppad/local/play/op_stream.hpp>
+# include <cppad/local/play/level_schedule.hpp>
 # include <cppad/local/user_state.hpp>
 # include <cppad/local/is_pod.hpp>
 
+# if CPPAD_HAS_MMAP
+# include <sys/mman.h>
+# endif
+
 namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
 /*!
 \file player.hpp
@@ -104,18 +111,53 @@ private:
 	/// This value is valid (invalid) for primary (auxillary) variables.
 	pod_vector<unsigned char> var2op_vec_;
 
+	// ----------------------------------------------------------------------
+	/// Pre-decoded operators used by zero order forward mode
+	/// (see sweep::forward0_stream_setup).
+	play::op_stream<Base> op_stream_;
+
+	/// Level schedule used by the parallel sweeps
+	/// (see sweep::level_schedule_setup).
+	play::level_schedule level_schedule_;
+
+	// ----------------------------------------------------------------------
+	// Information about a file that is mapped into memory (see from_binary)
+
+	/// beginning of the memory map (null if there is no memory map)
+	void* map_ptr_;
+
+	/// number of bytes in the memory map
+	size_t map_size_;
+
+	/// Free the memory map (if there is one). The vectors that
+	/// refer to the map must be cleared, or have their own copy, before
+	/// this is called.
+	void free_map(void)
+	{	if( map_ptr_ == CPPAD_NULL )
+			return;
+# if CPPAD_HAS_MMAP
+		munmap(map_ptr_, map_size_);
+# else
+		CPPAD_ASSERT_UNKNOWN(false);
+# endif
+		map_ptr_  = CPPAD_NULL;
+		map_size_ = 0;
+	}
+
 public:
 	// =================================================================
 	/// constructor
 	player(void) :
 	num_var_rec_(0)      ,
-	num_load_op_rec_(0)
+	num_load_op_rec_(0)  ,
+	map_ptr_(CPPAD_NULL) ,
+	map_size_(0)
 	{ }
 
 	// =================================================================
 	/// destructor
 	~player(void)
-	{ }
+	{	free_map(); }
 	// ======================================================================
 	/// type used for addressing iterators for this player
 	play::addr_enum address_type(void) const
@@ -165,6 +207,10 @@ public:
 # ifndef NDEBUG
 		size_t addr_t_max = size_t( std::numeric_limits<addr_t>::max() );
 # endif
+		// do not swap vectors that refer to a memory map into rec
+		if( map_ptr_ != CPPAD_NULL )
+			Erase();
+
 		// just set size_t values
 		num_dynamic_ind_    = rec.num_dynamic_ind_;
 		num_var_rec_        = rec.num_var_rec_;
@@ -222,6 +268,10 @@ public:
 		// random access information
 		clear_random();
 
+		// pre-decoded operator stream and level schedule
+		op_stream_.clear();
+		level_schedule_.clear();
+
 		// some checks
 		check_inv_op(n_ind);
 		check_variable_dag();
@@ -376,6 +426,15 @@ public:
 				itr.correct_before_increment();
 				break;
 
+				// CProdOp
+				case CProdOp:
+				{	CPPAD_ASSERT_UNKNOWN( 3 < op_arg[1] );
+					for(addr_t j = 3; j < op_arg[1]; j++)
+						CPPAD_ASSERT_UNKNOWN(op_arg[j] <= arg_var_bound);
+				}
+				itr.correct_before_increment();
+				break;
+
 				// CExpOp
 				case CExpOp:
 				if( op_arg[1] & 1 )
@@ -493,6 +552,14 @@ public:
 		op2arg_vec_         = play.op2arg_vec_;
 		op2var_vec_         = play.op2var_vec_;
 		var2op_vec_         = play.var2op_vec_;
+		//
+		// the operator stream and level schedule refer to the arguments in play
+		op_stream_.clear();
+		level_schedule_.clear();
+		//
+		// the vectors above are copies (not in the memory map)
+		if( map_ptr_ != play.map_ptr_ )
+			free_map();
 	}
 	// ===============================================================
 	/// Erase the recording stored in the player
@@ -515,6 +582,122 @@ public:
 		op2arg_vec_.resize(0);
 		op2var_vec_.resize(0);
 		var2op_vec_.resize(0);
+		op_stream_.clear();
+		level_schedule_.clear();
+		//
+		// vectors that may refer to a memory map
+		op_vec_.clear();
+		vecad_ind_vec_.clear();
+		arg_vec_.clear();
+		dyn_par_is_.clear();
+		dyn_ind2par_ind_.clear();
+		dyn_par_op_.clear();
+		dyn_par_arg_.clear();
+		text_vec_.clear();
+		free_map();
+	}
+	// ===============================================================
+	/*!
+	Write the recording to a binary file.
+
+	\param os
+	is the stream we are writing to.
+	Its position must be a multiple of play::binary_align
+	from the beginning of the file.
+	*/
+	void to_binary(std::ostream& os) const
+	{	CPPAD_ASSERT_UNKNOWN( is_pod<Base>() );
+		size_t info[5];
+		info[0] = num_dynamic_ind_;
+		info[1] = num_var_rec_;
+		info[2] = num_load_op_rec_;
+		info[3] = num_vecad_vec_rec_;
+		info[4] = 0; // reserved
+		play::binary_write(os, 5, info);
+		//
+		play::binary_write(os, op_vec_.size(),          op_vec_.data() );
+		play::binary_write(os, arg_vec_.size(),         arg_vec_.data() );
+		play::binary_write(os, text_vec_.size(),        text_vec_.data() );
+		play::binary_write(os, vecad_ind_vec_.size(), vecad_ind_vec_.data() );
+		play::binary_write(os, all_par_vec_.size(),     all_par_vec_.data() );
+		play::binary_write(os, dyn_par_is_.size(),      dyn_par_is_.data() );
+		play::binary_write(os,
+			dyn_ind2par_ind_.size(), dyn_ind2par_ind_.data()
+		);
+		play::binary_write(os, dyn_par_op_.size(),      dyn_par_op_.data() );
+		play::binary_write(os, dyn_par_arg_.size(),     dyn_par_arg_.data() );
+	}
+	/*!
+	Set the recording from a binary file that is in memory.
+
+	\param ptr [in,out]
+	On input, is the beginning of the recording as written by to_binary.
+	Upon return, it is the end of the recording.
+
+	\param end
+	is the end of the memory that contains the file.
+
+	\param map_ptr
+	If this is null, the recording is copied from the memory.
+	Otherwise, [map_ptr, map_ptr + map_size) is a memory map that contains
+	[ptr, end). In this case, the recording vectors refer to the memory map
+	(except for the parameter vector which is always copied because it is
+	changed by new_dynamic) and this player frees the memory map when it no
+	longer uses it.
+
+	\param map_size
+	is the number of bytes in the memory map.
+
+	\return
+	is false (and this player is empty) if the memory does not contain
+	a valid recording.
+	*/
+	bool from_binary(
+		const char*& ptr      ,
+		const char*  end      ,
+		void*        map_ptr  ,
+		size_t       map_size )
+	{	CPPAD_ASSERT_UNKNOWN( is_pod<Base>() );
+		Erase();
+		//
+		bool copy = map_ptr == CPPAD_NULL;
+		pod_vector<size_t> info;
+		bool ok = play::binary_read(ptr, end, true, info);
+		ok     &= info.size() == 5;
+		if( ! ok )
+			return false;
+		//
+		ok &= play::binary_read(ptr, end, copy, op_vec_);
+		ok &= play::binary_read(ptr, end, copy, arg_vec_);
+		ok &= play::binary_read(ptr, end, copy, text_vec_);
+		ok &= play::binary_read(ptr, end, copy, vecad_ind_vec_);
+		ok &= play::binary_read(ptr, end, true, all_par_vec_);
+		ok &= play::binary_read(ptr, end, copy, dyn_par_is_);
+		ok &= play::binary_read(ptr, end, copy, dyn_ind2par_ind_);
+		ok &= play::binary_read(ptr, end, copy, dyn_par_op_);
+		ok &= play::binary_read(ptr, end, copy, dyn_par_arg_);
+		//
+		// check the sizes and the last operator
+		ok &= all_par_vec_.size()     == dyn_par_is_.size();
+		ok &= dyn_ind2par_ind_.size() == dyn_par_op_.size();
+		ok &= info[0] <= dyn_par_op_.size();
+		ok &= 1 < op_vec_.size();
+		if( ok )
+			ok &= OpCode( op_vec_[ op_vec_.size() - 1 ] ) == EndOp;
+		if( ! ok )
+		{	Erase();
+			return false;
+		}
+		num_dynamic_ind_   = info[0];
+		num_var_rec_       = info[1];
+		num_load_op_rec_   = info[2];
+		num_vecad_vec_rec_ = info[3];
+		map_ptr_           = map_ptr;
+		map_size_          = map_size;
+		//
+		check_variable_dag();
+		check_dynamic_dag();
+		return true;
 	}
 	// =================================================================
 	/// Enable use of const_subgraph_iterator and member functions that begin
@@ -541,6 +724,18 @@ public:
 		CPPAD_ASSERT_UNKNOWN( op2var_vec_.size() == 0  );
 		CPPAD_ASSERT_UNKNOWN( var2op_vec_.size() == 0  );
 	}
+	/// get the pre-decoded operator stream
+	const play::op_stream<Base>& op_stream(void) const
+	{	return op_stream_; }
+	/// get non-const version of op_stream
+	play::op_stream<Base>& op_stream(void)
+	{	return op_stream_; }
+	/// get the level schedule
+	const play::level_schedule& level_schedule(void) const
+	{	return level_schedule_; }
+	/// get non-const version of level_schedule
+	play::level_schedule& level_schedule(void)
+	{	return level_schedule_; }
 	/// get non-const version of all_par_vec
 	pod_vector_maybe<Base>& all_par_vec(void)
 	{	return all_par_vec_; }
@@ -689,6 +884,19 @@ public:
 		     + vecad_ind_vec_.size() * sizeof(addr_t)
 		;
 	}
+	/// Hash code for the structure of the operation sequence; i.e.,
+	/// the operators, their arguments, and the VecAD indices
+	/// (it does not depend on the parameter values).
+	size_t structure_hash(void) const
+	{	size_t code = play::binary_hash_init;
+		code = play::binary_hash(code, 1, &num_var_rec_);
+		code = play::binary_hash(code, op_vec_.size(), op_vec_.data() );
+		code = play::binary_hash(code, arg_vec_.size(), arg_vec_.data() );
+		code = play::binary_hash(
+			code, vecad_ind_vec_.size(), vecad_ind_vec_.data()
+		);
+		return code;
+	}
 	/// A measure of amount of memory used for random access routine
 	/// In user api as f.size_random(); see the file seq_property.omh.
 	size_t size_random(void) const
@@ -0,0 +1,158 @@
+# ifndef CPPAD_LOCAL_POD_ARENA_HPP
+# define CPPAD_LOCAL_POD_ARENA_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+# include <vector>
+# include <cstring>
+# include <cppad/utility/thread_alloc.hpp>
+# include <cppad/core/cppad_assert.hpp>
+# include <cppad/local/is_pod.hpp>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file pod_arena.hpp
+File used to define the pod_arena class
+*/
+// ---------------------------------------------------------------------------
+/*!
+An indexed arena of plain old data stored in fixed size chunks
+(is_pod<Type> must be true).
+
+The arena has the same indexing interface as pod_vector, but extending it
+never moves the elements that are already in the arena.
+Hence the address of an element does not change until the arena is
+cleared or destroyed, and growing the arena does not copy elements.
+Reducing its length, using resize, is a bulk reset that keeps
+the chunks for reuse.
+*/
+template <class Type>
+class pod_arena {
+private:
+	/// log base two of the number of elements in each chunk
+	/// and the corresponding mask for the index within a chunk
+	enum { log_chunk_ = 10, n_chunk_ = 1 << log_chunk_, mask_ = n_chunk_ - 1 };
+
+	/// number of elements currently in the arena
+	size_t length_;
+
+	/// memory for each chunk; i.e., chunk_[k] has n_chunk_ elements
+	std::vector<Type*> chunk_;
+
+	/// do not use the copy constructor
+	explicit pod_arena(const pod_arena& )
+	{	CPPAD_ASSERT_UNKNOWN(false); }
+
+	/// allocate another chunk
+	void new_chunk(void)
+	{	size_t min_bytes = n_chunk_ * sizeof(Type);
+		size_t cap_bytes;
+		void* v_ptr = thread_alloc::get_memory(min_bytes, cap_bytes);
+		chunk_.push_back( reinterpret_cast<Type*>(v_ptr) );
+	}
+public:
+	/// default constructor (no memory allocated)
+	pod_arena(void) : length_(0)
+	{	CPPAD_ASSERT_UNKNOWN( is_pod<Type>() ); }
+
+	/// sizing constructor (elements are not initialized)
+	pod_arena(size_t n) : length_(0)
+	{	CPPAD_ASSERT_UNKNOWN( is_pod<Type>() );
+		extend(n);
+	}
+
+	/// destructor: returns all the chunks to thread_alloc
+	~pod_arena(void)
+	{	clear(); }
+
+	/// current number of elements in the arena
+	size_t size(void) const
+	{	return length_; }
+
+	/// number of elements that the arena can hold without allocating
+	size_t capacity(void) const
+	{	return chunk_.size() * size_t(n_chunk_); }
+
+	/// non-constant element access; i.e., we can change this element value
+	Type& operator[](size_t i)
+	{	CPPAD_ASSERT_UNKNOWN( i < length_ );
+		return chunk_[i >> log_chunk_][i & mask_];
+	}
+
+	/// constant element access; i.e., we cannot change this element value
+	const Type& operator[](size_t i) const
+	{	CPPAD_ASSERT_UNKNOWN( i < length_ );
+		return chunk_[i >> log_chunk_][i & mask_];
+	}
+
+	/*!
+	Increase the number of elements at the end of this arena.
+
+	\param n
+	is the number of elements to add to the arena
+	(new elements are not initialized).
+
+	\return
+	is the number of elements in the arena before it was extended.
+	This is the index of the first new element added to the arena.
+	*/
+	size_t extend(size_t n)
+	{	size_t old_length = length_;
+		length_          += n;
+		while( capacity() < length_ )
+			new_chunk();
+		return old_length;
+	}
+
+	/*!
+	Change the number of elements in this arena.
+
+	\param n
+	is the new number of elements in the arena.
+	If n is less than the current size, the chunks are kept for reuse;
+	i.e., this is a bulk reset that does not free or copy memory.
+	*/
+	void resize(size_t n)
+	{	length_ = 0;
+		extend(n);
+	}
+
+	/// remove all the elements from this arena and free its memory
+	void clear(void)
+	{	for(size_t k = 0; k < chunk_.size(); ++k)
+		{	void* v_ptr = reinterpret_cast<void*>( chunk_[k] );
+			thread_alloc::return_memory(v_ptr);
+		}
+		chunk_.clear();
+		length_ = 0;
+	}
+
+	/// arena assignment operator (copies only the elements in use)
+	void operator=(const pod_arena& x)
+	{	resize( x.length_ );
+		size_t n_full = length_ >> log_chunk_;
+		for(size_t k = 0; k < n_full; ++k)
+			std::memcpy(chunk_[k], x.chunk_[k], n_chunk_ * sizeof(Type));
+		size_t n_rest = length_ & mask_;
+		if( n_rest > 0 ) std::memcpy(
+			chunk_[n_full], x.chunk_[n_full], n_rest * sizeof(Type)
+		);
+	}
+
+	/// swap all properties of this arena with another
+	void swap(pod_arena& other)
+	{	std::swap(length_, other.length_);
+		chunk_.swap(other.chunk_);
+	}
+};
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+# endif
@@ -107,6 +107,30 @@ public:
 	Type* data(void)
 	{	return data_; }
 
+	/*!
+	Use memory that was not allocated by this vector; e.g. a memory map.
+
+	\param data
+	is the first element of the memory (the elements are not copied).
+
+	\param n
+	is the number of elements in the memory.
+
+	\par
+	The capacity of this vector is zero after this operation
+	and the destructor does not free the memory.
+	Hence extend will make a copy of the elements in new memory.
+	On the other hand, resize to a non-zero length allocates new memory
+	without copying the elements; i.e., their values are lost.
+	The memory must remain valid until this vector is destroyed, cleared,
+	or its length is changed.
+	*/
+	void set_external(Type* data, size_t n)
+	{	clear();
+		byte_length_ = n * sizeof(Type);
+		data_        = data;
+	}
+
 	/// const version of data pointer (see non-const documentation)
 	const Type* data(void) const
 	{	return data_; }
@@ -260,7 +284,7 @@ public:
 		/// right hand size of the assingment operation
 		const pod_vector& x
 	)
-	{	resize( x.byte_length_ );
+	{	resize( x.size() );
 		if( byte_length_ > 0 )
 		{
 			void* v_ptr   = reinterpret_cast<void*>( data_ );
@@ -334,6 +358,15 @@ public:
 	Type* data(void)
 	{	return data_; }
 
+	/// Use memory that was not allocated by this vector
+	/// (is_pod<Type> must be true; see pod_vector::set_external).
+	void set_external(Type* data, size_t n)
+	{	CPPAD_ASSERT_UNKNOWN( is_pod<Type>() );
+		clear();
+		length_ = n;
+		data_   = data;
+	}
+
 	/// const version of data pointer (see non-const documentation)
 	const Type* data(void) const
 	{	return data_; }
@@ -196,7 +196,33 @@ public:
 		     + all_par_vec_.capacity()   * sizeof(Base)
 		     + text_vec_.capacity()      * sizeof(char);
 	}
-
+	/*!
+	Reserve memory for the operators and arguments in this recording.
+
+	\param n_op
+	is the number of operators that the recording is expected to have.
+
+	\param n_arg
+	is the number of arguments that the recording is expected to have.
+
+	\par
+	The values are only a hint; the recording grows as necessary
+	if they are exceeded.
+	Reserving the final size avoids copying the recording each time
+	it grows, and the extra memory that growing leaves at the end.
+	*/
+	void reserve(size_t n_op, size_t n_arg)
+	{	size_t size = op_vec_.size();
+		if( size < n_op && op_vec_.capacity() < n_op )
+		{	op_vec_.extend(n_op - size);
+			op_vec_.resize(size);
+		}
+		size = arg_vec_.size();
+		if( size < n_arg && arg_vec_.capacity() < n_arg )
+		{	arg_vec_.extend(n_arg - size);
+			arg_vec_.resize(size);
+		}
+	}
 };
 
 /*!
@@ -0,0 +1,227 @@
+# ifndef CPPAD_LOCAL_SPARSE_CACHE_HPP
+# define CPPAD_LOCAL_SPARSE_CACHE_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <map>
+# include <string>
+# include <cppad/utility/vector.hpp>
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/local/play/binary_file.hpp>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file sparse_cache.hpp
+Storage for the sparsity patterns and coloring information that an ADFun
+object saves for later calls (see ADFun::sparse_cache_store).
+*/
+
+/*!
+A set of named entries, each entry is a list of vectors of size_t values.
+
+\par Entry
+The vector for an entry has the following layout:
+kind, n_vec, len[0], ... , len[n_vec-1],
+followed by the elements of each of the n_vec vectors.
+The kind identifies the type of value that was stored in the entry.
+*/
+class sparse_cache {
+private:
+	/// map from entry name to entry vector
+	std::map<std::string, CppAD::vector<size_t> > entry_;
+public:
+	/// kind of value stored in an entry
+	enum kind_enum {
+		pattern_kind  , // sparse_rc
+		jac_work_kind , // sparse_jac_work
+		hes_work_kind , // sparse_hes_work
+		number_kind
+	};
+	/// assignment operator
+	/// (CppAD::vector assignment requires equal sizes so do not reuse nodes)
+	void operator=(const sparse_cache& other)
+	{	entry_.clear();
+		entry_ = other.entry_;
+	}
+	/// remove all the entries
+	void clear(void)
+	{	entry_.clear(); }
+
+	/// number of entries
+	size_t size(void) const
+	{	return entry_.size(); }
+
+	/// amount of memory used by the entries (not counting map overhead)
+	size_t memory(void) const
+	{	size_t total = 0;
+		std::map<std::string, CppAD::vector<size_t> >::const_iterator itr;
+		for(itr = entry_.begin(); itr != entry_.end(); ++itr)
+		{	total += itr->first.size();
+			total += itr->second.size() * sizeof(size_t);
+		}
+		return total;
+	}
+	/*!
+	Store an entry (replaces any previous entry with the same name).
+
+	\param name
+	is the name for this entry.
+
+	\param kind
+	is the kind of value stored in this entry.
+
+	\param n_vec
+	is the number of vectors in this entry.
+
+	\param vec
+	is the vectors for this entry; vec[i] for i < n_vec.
+	*/
+	void store(
+		const std::string&           name  ,
+		kind_enum                    kind  ,
+		size_t                       n_vec ,
+		const CppAD::vector<size_t>* vec   )
+	{	size_t size = 2 + n_vec;
+		for(size_t i = 0; i < n_vec; ++i)
+			size += vec[i].size();
+		//
+		CppAD::vector<size_t>& entry( entry_[name] );
+		entry.resize(size);
+		entry[0] = size_t( kind );
+		entry[1] = n_vec;
+		size_t k = 2 + n_vec;
+		for(size_t i = 0; i < n_vec; ++i)
+		{	entry[2 + i] = vec[i].size();
+			for(size_t j = 0; j < vec[i].size(); ++j)
+				entry[k++] = vec[i][j];
+		}
+		CPPAD_ASSERT_UNKNOWN( k == size );
+	}
+	/*!
+	Find an entry.
+
+	\param name
+	is the name for this entry.
+
+	\param kind
+	is the kind of value that must be stored in this entry.
+
+	\param n_vec
+	is the number of vectors that must be in this entry.
+
+	\param vec [out]
+	If the return value is true, vec[i] is set to the i-th vector
+	in the entry for i < n_vec. Otherwise, it is not changed.
+
+	\return
+	is true if there is an entry with this name, kind, and number of vectors.
+	*/
+	bool find(
+		const std::string&           name  ,
+		kind_enum                    kind  ,
+		size_t                       n_vec ,
+		CppAD::vector<size_t>*       vec   ) const
+	{	std::map<std::string, CppAD::vector<size_t> >::const_iterator itr;
+		itr = entry_.find(name);
+		if( itr == entry_.end() )
+			return false;
+		const CppAD::vector<size_t>& entry( itr->second );
+		if( entry[0] != size_t(kind) || entry[1] != n_vec )
+			return false;
+		size_t k = 2 + n_vec;
+		for(size_t i = 0; i < n_vec; ++i)
+		{	vec[i].resize( entry[2 + i] );
+			for(size_t j = 0; j < vec[i].size(); ++j)
+				vec[i][j] = entry[k++];
+		}
+		CPPAD_ASSERT_UNKNOWN( k == entry.size() );
+		return true;
+	}
+	/*!
+	Write the entries as sections of a binary file
+	(see play::binary_write).
+
+	\param os
+	is the stream we are writing to.
+
+	\par Format
+	The first section is the number of entries.
+	This is followed by two sections for each entry,
+	the characters in its name and its entry vector.
+	*/
+	void to_binary(std::ostream& os) const
+	{	size_t n_entry = entry_.size();
+		play::binary_write(os, 1, &n_entry);
+		std::map<std::string, CppAD::vector<size_t> >::const_iterator itr;
+		for(itr = entry_.begin(); itr != entry_.end(); ++itr)
+		{	const std::string&           name( itr->first );
+			const CppAD::vector<size_t>& entry( itr->second );
+			play::binary_write(os, name.size(), name.data() );
+			play::binary_write(os, entry.size(), entry.data() );
+		}
+	}
+	/*!
+	Replace the entries by the sections in a binary file
+	(see to_binary).
+
+	\param ptr [in,out]
+	On input, is the beginning of the sections in memory.
+	Upon return, it is the end of the sections.
+
+	\param end
+	is the end of the memory that contains the file.
+
+	\return
+	is false if the sections are not in the format written by to_binary.
+	In this case, there are no entries upon return.
+	*/
+	bool from_binary(const char*& ptr, const char* end)
+	{	entry_.clear();
+		pod_vector<size_t> n_entry;
+		bool ok = play::binary_read(ptr, end, true, n_entry);
+		ok     &= n_entry.size() == 1;
+		pod_vector<char>   name;
+		pod_vector<size_t> entry;
+		for(size_t ell = 0; ok && ell < n_entry[0]; ++ell)
+		{	ok &= play::binary_read(ptr, end, true, name);
+			ok &= play::binary_read(ptr, end, true, entry);
+			ok &= 2 <= entry.size();
+			if( ok )
+				ok &= entry[0] < size_t(number_kind);
+			if( ok )
+				ok &= entry[1] <= entry.size() - 2;
+			size_t size = 0;
+			if( ok )
+			{	size = 2 + entry[1];
+				for(size_t i = 0; i < entry[1]; ++i)
+				{	ok   &= entry[2 + i] <= entry.size();
+					size += entry[2 + i];
+				}
+			}
+			ok &= size == entry.size();
+			if( ok )
+			{	std::string key( name.data(), name.size() );
+				CppAD::vector<size_t>& vec( entry_[key] );
+				vec.resize( entry.size() );
+				for(size_t k = 0; k < entry.size(); ++k)
+					vec[k] = entry[k];
+			}
+		}
+		if( ! ok )
+			entry_.clear();
+		return ok;
+	}
+};
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+# endif
@@ -0,0 +1,1356 @@
+# ifndef CPPAD_LOCAL_SPARSE_HYBRID_HPP
+# define CPPAD_LOCAL_SPARSE_HYBRID_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+# include <cppad/local/define.hpp>
+# include <cppad/local/is_pod.hpp>
+# include <algorithm>
+# include <limits>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file sparse_hybrid.hpp
+Vector of sets of positive integers stored as a sequence of
+compressed containers that are either sorted arrays or bitmaps.
+*/
+class sparse_hybrid_const_iterator;
+
+// =========================================================================
+/*!
+Vector of sets of positive integers, each set stored as a sequence
+of containers.
+
+\par Containers
+The elements of a set with the same value of <code>element / 2^16</code>
+(called the key) are stored in one container.
+If there are at most array_max_ elements in a container,
+it is a sorted array of the values <code>element % 2^16</code>,
+each of which uses 16 bits.
+Otherwise it is a bitmap with 2^16 bits.
+Hence a sparse set uses about 16 bits per element,
+a dense set uses about one bit per possible element,
+and the elements of a set are contiguous in memory.
+
+\par Container Header
+Each container starts with a header word equal to
+<code>(key << 16) | (card - 1)</code>
+where card is the number of elements in the container.
+The header is followed by n_word(card) words that contain the
+array or bitmap.
+
+All the public members for this class are also in the
+sparse_pack, sparse_list and sparse_sizevec classes.
+This defines the CppAD vector_of_sets concept.
+*/
+class sparse_hybrid {
+	friend class sparse_hybrid_const_iterator;
+private:
+	/// type used to store the containers
+	typedef size_t Word;
+
+	/// constants that define the container format
+	enum {
+		/// number of bits in a Word
+		n_bit_      = std::numeric_limits<Word>::digits,
+		/// number of 16 bit array values in a Word
+		n_short_    = n_bit_ / 16,
+		/// number of Words in a bitmap container
+		n_bitmap_   = 65536 / n_bit_,
+		/// maximum number of elements in an array container
+		array_max_  = 4096
+	};
+
+	/// Possible elements in each set are 0, 1, ..., end_ - 1;
+	size_t end_;
+
+	/// number of elements in data_ that have been allocated
+	/// and are no longer being used.
+	size_t data_not_used_;
+
+	/// The containers for all the sets (data_[0] is not used).
+	pod_vector<Word> data_;
+
+	/*!
+	Starting point for i-th set is start_[i].
+
+	\li
+	If the i-th set has no elements, start_[i] is zero.
+	Othersize the conditions below hold.
+
+	\li
+	data_[ start_[i] ] is the capacity; i.e., the number of words
+	following data_[ start_[i] + 1 ] that are reserved for this set.
+
+	\li
+	data_[ start_[i] + 1 ] is the length; i.e., the number of words
+	used by the containers for this set.
+
+	\li
+	The first container header is data_[ start_[i] + 2 ].
+	*/
+	pod_vector<size_t> start_;
+
+	/*!
+	Elements that have not yet been added to corresponding sets.
+
+	\li
+	If all the post_element calls for the i-th set have been added,
+	post_[i] is zero.
+
+	\li
+	Otherwise, post_element_[ post_[i] ] is the last element posted
+	for set i and post_next_[ post_[i] ] is the index in post_element_
+	of the previous element posted for set i (zero if there is none).
+	*/
+	pod_vector<size_t> post_;
+
+	/// values that have been posted (post_element_[0] is not used)
+	pod_vector<size_t> post_element_;
+
+	/// links between the values that have been posted
+	pod_vector<size_t> post_next_;
+
+	/// number of sets that have elements posted and not yet added
+	size_t n_post_;
+
+	/// temporary used to hold the result of a set operation
+	pod_vector<Word> temp_;
+
+	/// temporary used to hold the containers for a vector of elements
+	pod_vector<Word> temp_vec_;
+
+	/// temporary used to hold one bitmap container
+	pod_vector<Word> temp_bitmap_;
+
+	/// temporary used to hold elements of a set
+	pod_vector<size_t> temp_element_;
+	// -----------------------------------------------------------------
+	/// key for container with header h
+	static size_t key(Word h)
+	{	return size_t(h >> 16); }
+
+	/// number of elements in container with header h
+	static size_t card(Word h)
+	{	return size_t(h & 0xFFFF) + 1; }
+
+	/// header for a container with the specified key and number of elements
+	static Word header(size_t key, size_t card)
+	{	CPPAD_ASSERT_UNKNOWN( 0 < card && card <= 65536 );
+		return (Word(key) << 16) | Word(card - 1);
+	}
+
+	/// number of words, after the header, in container with card elements
+	static size_t n_word(size_t card)
+	{	if( card <= size_t(array_max_) )
+			return (card + n_short_ - 1) / n_short_;
+		return n_bitmap_;
+	}
+
+	/// k-th value in an array container that starts at w
+	static size_t get_short(const Word* w, size_t k)
+	{	return size_t( (w[k / n_short_] >> (16 * (k % n_short_))) & 0xFFFF ); }
+
+	/// set k-th value in array container that starts at w (must be zero)
+	static void put_short(Word* w, size_t k, size_t value)
+	{	w[k / n_short_] |= Word(value) << (16 * (k % n_short_)); }
+
+	/// number of bits that are one in the word w
+	static size_t bit_count(Word w)
+	{	const Word all  = ~ Word(0);
+		w = w - ( (w >> 1) & (all / 3) );
+		w = ( w & (all / 15 * 3) ) + ( (w >> 2) & (all / 15 * 3) );
+		w = ( w + (w >> 4) ) & (all / 255 * 15);
+		return size_t( (w * (all / 255)) >> (n_bit_ - 8) );
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Check that the data structure is valid; i.e. does not check elements.
+	*/
+# ifdef NDEBUG
+	void check_data_structure(void) const
+	{	return; }
+# else
+	void check_data_structure(void) const
+	{	CPPAD_ASSERT_UNKNOWN( post_.size() == start_.size() );
+		size_t n_set = start_.size();
+		if( n_set == 0 )
+		{	CPPAD_ASSERT_UNKNOWN( end_ == 0 );
+			CPPAD_ASSERT_UNKNOWN( data_not_used_ == 0 );
+			CPPAD_ASSERT_UNKNOWN( data_.size() == 0 );
+			CPPAD_ASSERT_UNKNOWN( n_post_ == 0 );
+			return;
+		}
+		size_t data_used = 1;
+		for(size_t i = 0; i < n_set; i++)
+		{	size_t start = start_[i];
+			if( start > 0 )
+			{	size_t capacity = data_[start];
+				size_t length   = data_[start + 1];
+				CPPAD_ASSERT_UNKNOWN( 0 < length && length <= capacity );
+				data_used += capacity + 2;
+				//
+				size_t pos = 0;
+				while( pos < length )
+					pos += 1 + n_word( card( data_[start + 2 + pos] ) );
+				CPPAD_ASSERT_UNKNOWN( pos == length );
+			}
+		}
+		CPPAD_ASSERT_UNKNOWN( data_used + data_not_used_ == data_.size() );
+	}
+# endif
+	// -----------------------------------------------------------------
+	/*!
+	Remove the space that is no longer being used by any set
+	(if it is more than half of the data_ vector).
+	*/
+	void collect_garbage(void)
+	{	if( data_not_used_ < data_.size() / 2 + 100 )
+			return;
+		check_data_structure();
+		//
+		pod_vector<Word> data_tmp(1); // data_tmp[0] will not be used
+		size_t n_set = start_.size();
+		for(size_t i = 0; i < n_set; i++)
+		{	size_t start = start_[i];
+			if( start > 0 )
+			{	size_t length    = data_[start + 1];
+				size_t tmp_start = data_tmp.extend(length + 2);
+				data_tmp[tmp_start]     = length; // capacity
+				data_tmp[tmp_start + 1] = length;
+				for(size_t k = 0; k < length; ++k)
+					data_tmp[tmp_start + 2 + k] = data_[start + 2 + k];
+				start_[i] = tmp_start;
+			}
+		}
+		data_.swap(data_tmp);
+		data_not_used_ = 0;
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Replace the containers for a set.
+
+	\param target
+	is the index of the set that is replaced.
+
+	\param src
+	is the first word of the new containers. It must not point into data_.
+
+	\param length
+	is the number of words in the new containers.
+	*/
+	void store(size_t target, const Word* src, size_t length)
+	{	CPPAD_ASSERT_UNKNOWN( target < start_.size() );
+		size_t start = start_[target];
+		if( length == 0 )
+		{	if( start > 0 )
+			{	data_not_used_ += data_[start] + 2;
+				start_[target]  = 0;
+				collect_garbage();
+			}
+			return;
+		}
+		if( start > 0 && length <= data_[start] )
+		{	// the new containers fit in the current space for this set
+			data_[start + 1] = length;
+			Word* dst        = data_.data() + start + 2;
+			for(size_t k = 0; k < length; ++k)
+				dst[k] = src[k];
+			return;
+		}
+		// the capacity for a set that grows leaves room to grow again
+		size_t capacity = length;
+		if( start > 0 )
+		{	data_not_used_ += data_[start] + 2;
+			start_[target]  = 0;
+			capacity        = length + length / 2;
+			collect_garbage();
+		}
+		start = data_.extend(capacity + 2);
+		data_[start]     = capacity;
+		data_[start + 1] = length;
+		Word* dst        = data_.data() + start + 2;
+		for(size_t k = 0; k < length; ++k)
+			dst[k] = src[k];
+		start_[target] = start;
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Write the bitmap in temp_bitmap_ as a container.
+
+	\param key
+	is the key for the container.
+
+	\param card
+	is the number of bits that are one in temp_bitmap_.
+
+	\param dst
+	is the location where the header for the container is placed
+	(there must be room for the header and n_bitmap_ words after it).
+
+	\return
+	is the number of words used by the container (including the header).
+	*/
+	size_t put_bitmap(size_t key, size_t card, Word* dst)
+	{	CPPAD_ASSERT_UNKNOWN( card > 0 );
+		const Word* bitmap = temp_bitmap_.data();
+		dst[0]  = header(key, card);
+		Word* w = dst + 1;
+		if( card > size_t(array_max_) )
+		{	for(size_t k = 0; k < size_t(n_bitmap_); ++k)
+				w[k] = bitmap[k];
+			return 1 + n_bitmap_;
+		}
+		// convert to an array container
+		size_t n = n_word(card);
+		for(size_t k = 0; k < n; ++k)
+			w[k] = 0;
+		size_t k = 0;
+		for(size_t j = 0; j < size_t(n_bitmap_); ++j)
+		{	Word bits = bitmap[j];
+			size_t low = j * n_bit_;
+			while( bits != 0 )
+			{	if( bits & 1 )
+					put_short(w, k++, low);
+				bits >>= 1;
+				++low;
+			}
+		}
+		CPPAD_ASSERT_UNKNOWN( k == card );
+		return 1 + n;
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Or a container into temp_bitmap_.
+
+	\param card
+	is the number of elements in the container.
+
+	\param w
+	is the first word, after the header, for the container.
+	*/
+	void or_bitmap(size_t card, const Word* w)
+	{	Word* bitmap = temp_bitmap_.data();
+		if( card > size_t(array_max_) )
+		{	for(size_t k = 0; k < size_t(n_bitmap_); ++k)
+				bitmap[k] |= w[k];
+			return;
+		}
+		for(size_t k = 0; k < card; ++k)
+		{	size_t low = get_short(w, k);
+			bitmap[low / n_bit_] |= Word(1) << (low % n_bit_);
+		}
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Union of two sequences of containers.
+
+	\param left
+	is the first word for the left operand containers.
+
+	\param n_left
+	is the number of words in the left operand containers.
+
+	\param right
+	is the first word for the right operand containers.
+
+	\param n_right
+	is the number of words in the right operand containers.
+
+	\param result
+	the input value does not matter.
+	Upon return it contains the containers for the union.
+	It must not be the same as temp_bitmap_ and must not
+	contain the left or right operands.
+	*/
+	void container_union(
+		const Word*        left    ,
+		size_t             n_left  ,
+		const Word*        right   ,
+		size_t             n_right ,
+		pod_vector<Word>&  result  )
+	{	// space for one bitmap container
+		temp_bitmap_.resize(n_bitmap_);
+		//
+		// a union container is never larger than the sum of the operands
+		result.resize(n_left + n_right);
+		Word* out    = result.data();
+		size_t n_out = 0;
+		//
+		size_t i_left  = 0;
+		size_t i_right = 0;
+		size_t no_key  = std::numeric_limits<size_t>::max();
+		while( i_left < n_left || i_right < n_right )
+		{	size_t key_left  = no_key;
+			size_t key_right = no_key;
+			if( i_left < n_left )
+				key_left = key( left[i_left] );
+			if( i_right < n_right )
+				key_right = key( right[i_right] );
+			//
+			// case where only one operand has this key
+			const Word* src = CPPAD_NULL;
+			if( key_left < key_right )
+			{	src     = left + i_left;
+				i_left += 1 + n_word( card(*src) );
+			}
+			else if( key_right < key_left )
+			{	src      = right + i_right;
+				i_right += 1 + n_word( card(*src) );
+			}
+			if( src != CPPAD_NULL )
+			{	size_t n = 1 + n_word( card(*src) );
+				for(size_t k = 0; k < n; ++k)
+					out[n_out + k] = src[k];
+				n_out += n;
+				continue;
+			}
+			// case where both operands have this key
+			size_t card_left    = card( left[i_left] );
+			size_t card_right   = card( right[i_right] );
+			const Word* w_left  = left + i_left + 1;
+			const Word* w_right = right + i_right + 1;
+			i_left  += 1 + n_word(card_left);
+			i_right += 1 + n_word(card_right);
+			//
+			if( card_left <= size_t(array_max_) &&
+				card_right <= size_t(array_max_) )
+			{	// merge two arrays
+				temp_element_.resize(card_left + card_right);
+				size_t* merge = temp_element_.data();
+				size_t  n     = 0;
+				size_t  k_l   = 0;
+				size_t  k_r   = 0;
+				while( k_l < card_left && k_r < card_right )
+				{	size_t v_l = get_short(w_left, k_l);
+					size_t v_r = get_short(w_right, k_r);
+					if( v_l <= v_r )
+					{	merge[n++] = v_l;
+						++k_l;
+						if( v_l == v_r )
+							++k_r;
+					}
+					else
+					{	merge[n++] = v_r;
+						++k_r;
+					}
+				}
+				while( k_l < card_left )
+					merge[n++] = get_short(w_left, k_l++);
+				while( k_r < card_right )
+					merge[n++] = get_short(w_right, k_r++);
+				//
+				if( n <= size_t(array_max_) )
+				{	out[n_out] = header(key_left, n);
+					Word* w    = out + n_out + 1;
+					size_t nw  = n_word(n);
+					for(size_t k = 0; k < nw; ++k)
+						w[k] = 0;
+					for(size_t k = 0; k < n; ++k)
+						put_short(w, k, merge[k]);
+					n_out += 1 + nw;
+					continue;
+				}
+				// n values are more than fit in an array container
+				Word* bitmap = temp_bitmap_.data();
+				for(size_t k = 0; k < size_t(n_bitmap_); ++k)
+					bitmap[k] = 0;
+				for(size_t k = 0; k < n; ++k)
+					bitmap[merge[k] / n_bit_] |= Word(1) << (merge[k] % n_bit_);
+				n_out += put_bitmap(key_left, n, out + n_out);
+				continue;
+			}
+			// at least one of the operands is a bitmap
+			Word* bitmap = temp_bitmap_.data();
+			for(size_t k = 0; k < size_t(n_bitmap_); ++k)
+				bitmap[k] = 0;
+			or_bitmap(card_left, w_left);
+			or_bitmap(card_right, w_right);
+			size_t n = 0;
+			for(size_t k = 0; k < size_t(n_bitmap_); ++k)
+				n += bit_count( bitmap[k] );
+			n_out += put_bitmap(key_left, n, out + n_out);
+		}
+		CPPAD_ASSERT_UNKNOWN( n_out <= n_left + n_right );
+		result.resize(n_out);
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Intersection of two sequences of containers.
+
+	\param left
+	is the first word for the left operand containers.
+
+	\param n_left
+	is the number of words in the left operand containers.
+
+	\param right
+	is the first word for the right operand containers.
+
+	\param n_right
+	is the number of words in the right operand containers.
+
+	\param result
+	the input value does not matter.
+	Upon return it contains the containers for the intersection.
+	It must not be the same as temp_bitmap_ and must not
+	contain the left or right operands.
+	*/
+	void container_intersection(
+		const Word*        left    ,
+		size_t             n_left  ,
+		const Word*        right   ,
+		size_t             n_right ,
+		pod_vector<Word>&  result  )
+	{	// space for one bitmap container
+		temp_bitmap_.resize(n_bitmap_);
+		//
+		// an intersection is never larger than the left operand
+		result.resize(n_left);
+		Word* out    = result.data();
+		size_t n_out = 0;
+		//
+		size_t i_left  = 0;
+		size_t i_right = 0;
+		while( i_left < n_left && i_right < n_right )
+		{	size_t key_left     = key( left[i_left] );
+			size_t key_right    = key( right[i_right] );
+			size_t card_left    = card( left[i_left] );
+			size_t card_right   = card( right[i_right] );
+			const Word* w_left  = left + i_left + 1;
+			const Word* w_right = right + i_right + 1;
+			if( key_left < key_right )
+			{	i_left += 1 + n_word(card_left);
+				continue;
+			}
+			if( key_right < key_left )
+			{	i_right += 1 + n_word(card_right);
+				continue;
+			}
+			i_left  += 1 + n_word(card_left);
+			i_right += 1 + n_word(card_right);
+			//
+			bool array_left  = card_left <= size_t(array_max_);
+			bool array_right = card_right <= size_t(array_max_);
+			if( ! (array_left || array_right) )
+			{	// both operands are bitmaps
+				Word* bitmap = temp_bitmap_.data();
+				size_t n     = 0;
+				for(size_t k = 0; k < size_t(n_bitmap_); ++k)
+				{	bitmap[k] = w_left[k] & w_right[k];
+					n        += bit_count( bitmap[k] );
+				}
+				if( n > 0 )
+					n_out += put_bitmap(key_left, n, out + n_out);
+				continue;
+			}
+			// the result is an array container
+			Word* w = out + n_out + 1;
+			size_t nw = n_word( std::min(card_left, card_right) );
+			for(size_t k = 0; k < nw; ++k)
+				w[k] = 0;
+			size_t n = 0;
+			if( array_left && array_right )
+			{	size_t k_l = 0;
+				size_t k_r = 0;
+				while( k_l < card_left && k_r < card_right )
+				{	size_t v_l = get_short(w_left, k_l);
+					size_t v_r = get_short(w_right, k_r);
+					if( v_l == v_r )
+					{	put_short(w, n++, v_l);
+						++k_l;
+						++k_r;
+					}
+					else if( v_l < v_r )
+						++k_l;
+					else
+						++k_r;
+				}
+			}
+			else
+			{	// one array and one bitmap
+				size_t      card_a = card_left;
+				const Word* w_a    = w_left;
+				const Word* w_b    = w_right;
+				if( ! array_left )
+				{	card_a = card_right;
+					w_a    = w_right;
+					w_b    = w_left;
+				}
+				for(size_t k = 0; k < card_a; ++k)
+				{	size_t low = get_short(w_a, k);
+					if( w_b[low / n_bit_] & ( Word(1) << (low % n_bit_) ) )
+						put_short(w, n++, low);
+				}
+			}
+			if( n > 0 )
+			{	out[n_out] = header(key_left, n);
+				n_out     += 1 + n_word(n);
+			}
+		}
+		CPPAD_ASSERT_UNKNOWN( n_out <= n_left );
+		result.resize(n_out);
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Containers for a sorted vector of elements.
+
+	\param n
+	is the number of elements.
+
+	\param element
+	is a sorted vector of elements, the same element may appear
+	more than once.
+
+	\param result
+	the input value does not matter.
+	Upon return it contains the containers for the elements.
+	*/
+	void container_vector(
+		size_t             n       ,
+		const size_t*      element ,
+		pod_vector<Word>&  result  )
+	{	// each container uses less than two words per element
+		result.resize(2 * n);
+		Word* out    = result.data();
+		size_t n_out = 0;
+		//
+		size_t i = 0;
+		while( i < n )
+		{	CPPAD_ASSERT_UNKNOWN( element[i] < end_ );
+			size_t key_i = element[i] >> 16;
+			size_t last  = i;
+			size_t count = 1;
+			while( last + 1 < n && (element[last + 1] >> 16) == key_i )
+			{	CPPAD_ASSERT_UNKNOWN( element[last] <= element[last + 1] );
+				if( element[last] != element[last + 1] )
+					++count;
+				++last;
+			}
+			Word* w   = out + n_out + 1;
+			size_t nw = n_word(count);
+			for(size_t k = 0; k < nw; ++k)
+				w[k] = 0;
+			if( count <= size_t(array_max_) )
+			{	size_t k = 0;
+				for(size_t j = i; j <= last; ++j)
+				{	if( j == i || element[j] != element[j-1] )
+						put_short(w, k++, element[j] & 0xFFFF);
+				}
+				CPPAD_ASSERT_UNKNOWN( k == count );
+			}
+			else
+			{	for(size_t j = i; j <= last; ++j)
+				{	size_t low = element[j] & 0xFFFF;
+					w[low / n_bit_] |= Word(1) << (low % n_bit_);
+				}
+			}
+			out[n_out] = header(key_i, count);
+			n_out     += 1 + nw;
+			i          = last + 1;
+		}
+		CPPAD_ASSERT_UNKNOWN( n_out <= 2 * n );
+		result.resize(n_out);
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Assign a set equal to the union of a set and a vector;
+
+	\param target
+	is the index in this sparse_hybrid object of the set being assinged.
+
+	\param left
+	is the index in this sparse_hybrid object of the
+	left operand for the union operation.
+	It is OK for target and left to be the same value.
+
+	\param n
+	is the number of elements in the right operand.
+
+	\param right
+	is a sorted vector of elements that is the right operand for the union.
+	*/
+	void binary_union(
+		size_t                    target  ,
+		size_t                    left    ,
+		size_t                    n       ,
+		const size_t*             right   )
+	{	container_vector(n, right, temp_vec_);
+		//
+		size_t start       = start_[left];
+		const Word* w_left = CPPAD_NULL;
+		size_t      n_left = 0;
+		if( start > 0 )
+		{	w_left = data_.data() + start + 2;
+			n_left = data_[start + 1];
+		}
+		container_union(
+			w_left, n_left, temp_vec_.data(), temp_vec_.size(), temp_
+		);
+		store(target, temp_.data(), temp_.size());
+	}
+// ===========================================================================
+public:
+	/// declare a const iterator
+	typedef sparse_hybrid_const_iterator const_iterator;
+	// -----------------------------------------------------------------
+	/*!
+	Default constructor (no sets)
+	*/
+	sparse_hybrid(void) :
+	end_(0)                  ,
+	data_not_used_(0)        ,
+	data_(0)                 ,
+	start_(0)                ,
+	post_(0)                 ,
+	post_element_(0)         ,
+	post_next_(0)            ,
+	n_post_(0)
+	{ }
+	// -----------------------------------------------------------------
+	/// Destructor
+	~sparse_hybrid(void)
+	{	check_data_structure();
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Using copy constructor is a programing (not user) error
+
+	\param v
+	vector of sets that we are attempting to make a copy of.
+	*/
+	sparse_hybrid(const sparse_hybrid& v)
+	{	// Error: Probably a sparse_hybrid argument has been passed by value
+		CPPAD_ASSERT_UNKNOWN(false);
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Assignement operator.
+
+	\param other
+	this sparse_hybrid with be set to a deep copy of other.
+	*/
+	void operator=(const sparse_hybrid& other)
+	{	end_           = other.end_;
+		data_not_used_ = other.data_not_used_;
+		data_          = other.data_;
+		start_         = other.start_;
+		post_          = other.post_;
+		post_element_  = other.post_element_;
+		post_next_     = other.post_next_;
+		n_post_        = other.n_post_;
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Start a new vector of sets.
+
+	\param n_set
+	is the number of sets in this vector of sets.
+	\li
+	If n_set is zero, any memory currently allocated for this object
+	is freed.
+	\li
+	If n_set is non-zero, a vector of n_set sets is created and all
+	the sets are initilaized as empty.
+
+	\param end
+	is the maximum element plus one (the minimum element is 0).
+	If n_set is zero, end must also be zero.
+	*/
+	void resize(size_t n_set, size_t end)
+	{	check_data_structure();
+
+		if( n_set == 0 )
+		{	CPPAD_ASSERT_UNKNOWN(end == 0 );
+			//
+			// restore object to start after constructor
+			// (no memory allocated for this object)
+			data_.clear();
+			start_.clear();
+			post_.clear();
+			post_element_.clear();
+			post_next_.clear();
+			temp_.clear();
+			temp_vec_.clear();
+			temp_bitmap_.clear();
+			temp_element_.clear();
+			data_not_used_  = 0;
+			n_post_         = 0;
+			end_            = 0;
+			//
+			return;
+		}
+		end_                   = end;
+		//
+		start_.resize(n_set);
+		post_.resize(n_set);
+		for(size_t i = 0; i < n_set; i++)
+		{	start_[i] = 0;
+			post_[i]  = 0;
+		}
+		//
+		data_.resize(1);         // first element is not used
+		post_element_.resize(1); // first element is not used
+		post_next_.resize(1);
+		data_not_used_  = 0;
+		n_post_         = 0;
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Return number of elements in a set.
+
+	\param i
+	is the index of the set we are checking number of the elements of.
+	*/
+	size_t number_elements(size_t i) const
+	{	CPPAD_ASSERT_UNKNOWN( post_[i] == 0 );
+		//
+		size_t start = start_[i];
+		if( start == 0 )
+			return 0;
+		size_t length = data_[start + 1];
+		const Word* w = data_.data() + start + 2;
+		size_t count  = 0;
+		size_t pos    = 0;
+		while( pos < length )
+		{	size_t c = card( w[pos] );
+			count   += c;
+			pos     += 1 + n_word(c);
+		}
+		return count;
+	}
+	// ------------------------------------------------------------------
+	/*!
+	Post an element for delayed addition to a set.
+
+	\param i
+	is the index for this set in the vector of sets.
+
+	\param element
+	is the value of the element that we are posting.
+	The same element may be posted multiple times.
+
+	\par
+	It is faster to post multiple elements to set i and then call
+	process_post(i) then to add each element individually.
+	It is an error to call any member function,
+	that depends on the value of set i,
+	before processing the posts to set i.
+	*/
+	void post_element(size_t i, size_t element)
+	{	CPPAD_ASSERT_UNKNOWN( i < start_.size() );
+		CPPAD_ASSERT_UNKNOWN( element < end_ );
+		//
+		size_t post = post_element_.extend(1);
+		post_next_.extend(1);
+		post_element_[post] = element;
+		post_next_[post]    = post_[i];
+		if( post_[i] == 0 )
+			++n_post_;
+		post_[i] = post;
+	}
+	// -----------------------------------------------------------------
+	/*!
+	process post entries for a specific set.
+
+	\param i
+	index of the set for which we are processing the post entries.
+
+	\par post_
+	Upon call, post_[i] is location in post_element_ of the last element
+	that gets added to the i-th set.  Upon return, post_[i] is zero.
+	*/
+	void process_post(size_t i)
+	{	size_t post = post_[i];
+		if( post == 0 )
+			return;
+		//
+		// sort the elements that need to be processed
+		temp_element_.resize(0);
+		while( post != 0 )
+		{	temp_element_.push_back( post_element_[post] );
+			post = post_next_[post];
+		}
+		size_t  n     = temp_element_.size();
+		size_t* first = temp_element_.data();
+		std::sort(first, first + n);
+		//
+		post_[i] = 0;
+		--n_post_;
+		if( n_post_ == 0 )
+		{	// all of the posted elements have been processed
+			post_element_.resize(1);
+			post_next_.resize(1);
+		}
+		// (binary_union is done with first before temp_element_ changes)
+		binary_union(i, i, n, first);
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Add one element to a set.
+
+	\param i
+	is the index for this set in the vector of sets.
+
+	\param element
+	is the element we are adding to the set.
+	*/
+	void add_element(size_t i, size_t element)
+	{	CPPAD_ASSERT_UNKNOWN( i < start_.size() );
+		CPPAD_ASSERT_UNKNOWN( element < end_ );
+		if( is_element(i, element) )
+			return;
+		binary_union(i, i, 1, &element);
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Is an element of a set.
+
+	\param i
+	is the index for this set in the vector of sets.
+
+	\param element
+	is the element we are checking to see if it is in the set.
+	*/
+	bool is_element(size_t i, size_t element) const
+	{	CPPAD_ASSERT_UNKNOWN( post_[i] == 0 );
+		CPPAD_ASSERT_UNKNOWN( element < end_ );
+		//
+		size_t start = start_[i];
+		if( start == 0 )
+			return false;
+		size_t length = data_[start + 1];
+		const Word* w = data_.data() + start + 2;
+		size_t key_e  = element >> 16;
+		size_t low    = element & 0xFFFF;
+		size_t pos    = 0;
+		while( pos < length )
+		{	size_t key_pos  = key( w[pos] );
+			size_t card_pos = card( w[pos] );
+			if( key_e < key_pos )
+				return false;
+			if( key_e == key_pos )
+			{	const Word* c = w + pos + 1;
+				if( card_pos > size_t(array_max_) )
+					return ( c[low / n_bit_] >> (low % n_bit_) ) & 1;
+				// binary search of the array
+				size_t lower = 0;
+				size_t upper = card_pos;
+				while( lower < upper )
+				{	size_t middle = (lower + upper) / 2;
+					size_t value  = get_short(c, middle);
+					if( value == low )
+						return true;
+					if( value < low )
+						lower = middle + 1;
+					else
+						upper = middle;
+				}
+				return false;
+			}
+			pos += 1 + n_word(card_pos);
+		}
+		return false;
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Assign the empty set to one of the sets.
+
+	\param target
+	is the index of the set we are setting to the empty set.
+
+	\par data_not_used_
+	increments this value by number of words lost.
+	*/
+	void clear(size_t target)
+	{	CPPAD_ASSERT_UNKNOWN( target < start_.size() );
+		store(target, CPPAD_NULL, 0);
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Assign one set equal to another set.
+
+	\param this_target
+	is the index in this sparse_hybrid object of the set being assinged.
+
+	\param other_source
+	is the index in the other sparse_hybrid object of the
+	set that we are using as the value to assign to the target set.
+
+	\param other
+	is the other sparse_hybrid object (which may be the same as this
+	sparse_hybrid object). This must have the same value for end_.
+	*/
+	void assignment(
+		size_t               this_target  ,
+		size_t               other_source ,
+		const sparse_hybrid& other        )
+	{	CPPAD_ASSERT_UNKNOWN( other.post_[ other_source ] == 0 );
+		//
+		CPPAD_ASSERT_UNKNOWN( this_target  <   start_.size()        );
+		CPPAD_ASSERT_UNKNOWN( other_source <   other.start_.size()  );
+		CPPAD_ASSERT_UNKNOWN( end_        == other.end_   );
+
+		// check if we are assigning a set to itself
+		if( (this == &other) & (this_target == other_source) )
+			return;
+
+		size_t start = other.start_[other_source];
+		if( start == 0 )
+		{	store(this_target, CPPAD_NULL, 0);
+			return;
+		}
+		size_t      length = other.data_[start + 1];
+		const Word* src    = other.data_.data() + start + 2;
+		if( this == &other )
+		{	// store may reallocate data_
+			temp_.resize(length);
+			for(size_t k = 0; k < length; ++k)
+				temp_[k] = src[k];
+			src = temp_.data();
+		}
+		store(this_target, src, length);
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Assign a set equal to the union of two other sets.
+
+	\param this_target
+	is the index in this sparse_hybrid object of the set being assinged.
+
+	\param this_left
+	is the index in this sparse_hybrid object of the
+	left operand for the union operation.
+	It is OK for this_target and this_left to be the same value.
+
+	\param other_right
+	is the index in the other sparse_hybrid object of the
+	right operand for the union operation.
+	It is OK for this_target and other_right to be the same value.
+
+	\param other
+	is the other sparse_hybrid object (which may be the same as this
+	sparse_hybrid object).
+	*/
+	void binary_union(
+		size_t                this_target  ,
+		size_t                this_left    ,
+		size_t                other_right  ,
+		const sparse_hybrid&  other        )
+	{	CPPAD_ASSERT_UNKNOWN( post_[this_left] == 0 );
+		CPPAD_ASSERT_UNKNOWN( other.post_[ other_right ] == 0 );
+		//
+		CPPAD_ASSERT_UNKNOWN( this_target < start_.size()         );
+		CPPAD_ASSERT_UNKNOWN( this_left   < start_.size()         );
+		CPPAD_ASSERT_UNKNOWN( other_right < other.start_.size()   );
+		CPPAD_ASSERT_UNKNOWN( end_        == other.end_           );
+		//
+		size_t start_left  = start_[this_left];
+		size_t start_right = other.start_[other_right];
+		//
+		// cases where one of the operands is empty
+		if( start_right == 0 )
+		{	assignment(this_target, this_left, *this);
+			return;
+		}
+		if( start_left == 0 )
+		{	assignment(this_target, other_right, other);
+			return;
+		}
+		container_union(
+			data_.data() + start_left + 2        ,
+			data_[start_left + 1]                ,
+			other.data_.data() + start_right + 2 ,
+			other.data_[start_right + 1]         ,
+			temp_
+		);
+		store(this_target, temp_.data(), temp_.size());
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Assign a set equal to the intersection of two other sets.
+
+	\param this_target
+	is the index in this sparse_hybrid object of the set being assinged.
+
+	\param this_left
+	is the index in this sparse_hybrid object of the
+	left operand for the intersection operation.
+	It is OK for this_target and this_left to be the same value.
+
+	\param other_right
+	is the index in the other sparse_hybrid object of the
+	right operand for the intersection operation.
+	It is OK for this_target and other_right to be the same value.
+
+	\param other
+	is the other sparse_hybrid object (which may be the same as this
+	sparse_hybrid object).
+	*/
+	void binary_intersection(
+		size_t                this_target  ,
+		size_t                this_left    ,
+		size_t                other_right  ,
+		const sparse_hybrid&  other        )
+	{	CPPAD_ASSERT_UNKNOWN( post_[this_left] == 0 );
+		CPPAD_ASSERT_UNKNOWN( other.post_[ other_right ] == 0 );
+		//
+		CPPAD_ASSERT_UNKNOWN( this_target < start_.size()         );
+		CPPAD_ASSERT_UNKNOWN( this_left   < start_.size()         );
+		CPPAD_ASSERT_UNKNOWN( other_right < other.start_.size()   );
+		CPPAD_ASSERT_UNKNOWN( end_        == other.end_           );
+		//
+		size_t start_left  = start_[this_left];
+		size_t start_right = other.start_[other_right];
+		//
+		// case where one of the operands is empty
+		if( start_left == 0 || start_right == 0 )
+		{	store(this_target, CPPAD_NULL, 0);
+			return;
+		}
+		container_intersection(
+			data_.data() + start_left + 2        ,
+			data_[start_left + 1]                ,
+			other.data_.data() + start_right + 2 ,
+			other.data_[start_right + 1]         ,
+			temp_
+		);
+		store(this_target, temp_.data(), temp_.size());
+	}
+	// -----------------------------------------------------------------
+	/*! Fetch n_set for vector of sets object.
+
+	\return
+	Number of from sets for this vector of sets object
+	*/
+	size_t n_set(void) const
+	{	return start_.size(); }
+	// -----------------------------------------------------------------
+	/*! Fetch end for this vector of sets object.
+
+	\return
+	is the maximum element value plus one (the minimum element value is 0).
+	*/
+	size_t end(void) const
+	{	return end_; }
+	// -----------------------------------------------------------------
+	/*! Amount of memory used by this vector of sets
+
+	\return
+	The amount of memory in units of type unsigned char memory.
+	*/
+	size_t memory(void) const
+	{	size_t words = data_.capacity() + temp_.capacity()
+			+ temp_vec_.capacity() + temp_bitmap_.capacity();
+		return words * sizeof(Word);
+	}
+	/*!
+	Print the vector of sets (used for debugging)
+	*/
+	void print(void) const;
+};
+// =========================================================================
+/*!
+cons_iterator for one set of positive integers in a sparse_hybrid object.
+
+All the public member functions for this class are also in the
+sparse_pack_const_iterator, sparse_list_const_iterator and
+sparse_sizevec_const_iterator classes.
+This defines the CppAD vector_of_sets iterator concept.
+*/
+class sparse_hybrid_const_iterator {
+private:
+	/// type used to store the containers
+	typedef sparse_hybrid::Word Word;
+
+	/// data for the entire vector of sets
+	const pod_vector<Word>&        data_;
+
+	/// Possible elements in a list are 0, 1, ..., end_ - 1;
+	const size_t                   end_;
+
+	/// data index of the header for the current container
+	size_t                         header_;
+
+	/// data index of the header after the last container for this set
+	size_t                         last_;
+
+	/// index in array, or bit in bitmap, of current element in container
+	size_t                         index_;
+
+	/// value of the current element (end_ for no more elements)
+	size_t                         value_;
+
+	/// set value_ to the first element at or after index_ in container
+	/// header_, or at the start of a following container.
+	void find(void)
+	{	while( header_ < last_ )
+		{	Word h        = data_[header_];
+			size_t card   = sparse_hybrid::card(h);
+			size_t base   = sparse_hybrid::key(h) << 16;
+			const Word* w = data_.data() + header_ + 1;
+			if( card <= size_t(sparse_hybrid::array_max_) )
+			{	if( index_ < card )
+				{	value_ = base + sparse_hybrid::get_short(w, index_);
+					return;
+				}
+			}
+			else
+			{	size_t n_bit = sparse_hybrid::n_bit_;
+				while( index_ < 65536 )
+				{	Word bits = w[index_ / n_bit] >> (index_ % n_bit);
+					if( bits == 0 )
+						index_ = (index_ / n_bit + 1) * n_bit;
+					else
+					{	while( (bits & 1) == 0 )
+						{	bits >>= 1;
+							++index_;
+						}
+						value_ = base + index_;
+						return;
+					}
+				}
+			}
+			header_ += 1 + sparse_hybrid::n_word(card);
+			index_   = 0;
+		}
+		value_ = end_;
+	}
+public:
+	/// construct a const_iterator for a set in a sparse_hybrid object
+	sparse_hybrid_const_iterator (const sparse_hybrid& vec_set, size_t i)
+	:
+	data_( vec_set.data_ ) ,
+	end_ ( vec_set.end_ )
+	{	CPPAD_ASSERT_UNKNOWN( vec_set.post_[i] == 0 );
+		//
+		size_t start = vec_set.start_[i];
+		header_      = 0;
+		last_        = 0;
+		index_       = 0;
+		if( start > 0 )
+		{	header_ = start + 2;
+			last_   = header_ + data_[start + 1];
+		}
+		find();
+	}
+
+	/// advance to next element in this list
+	sparse_hybrid_const_iterator& operator++(void)
+	{	if( value_ != end_ )
+		{	++index_;
+			find();
+		}
+		return *this;
+	}
+
+	/// obtain value of this element of the set of positive integers
+	/// (end_ for no such element)
+	size_t operator*(void)
+	{	return value_; }
+};
+// =========================================================================
+/*!
+Print the vector of sets (used for debugging)
+*/
+inline void sparse_hybrid::print(void) const
+{	std::cout << "sparse_hybrid:\n";
+	for(size_t i = 0; i < n_set(); i++)
+	{	std::cout << "set[" << i << "] = {";
+		const_iterator itr(*this, i);
+		while( *itr != end() )
+		{	std::cout << *itr;
+			if( *(++itr) != end() )
+				std::cout << ",";
+		}
+		std::cout << "}\n";
+	}
+	return;
+}
+
+/*!
+Copy a user vector of sets sparsity pattern to an internal sparse_hybrid object.
+
+\tparam VectorSet
+is a simple vector with elements of type std::set<size_t>.
+
+\param internal
+The input value of sparisty does not matter.
+Upon return it contains the same sparsity pattern as \c user
+(or the transposed sparsity pattern).
+
+\param user
+sparsity pattern that we are placing internal.
+
+\param n_set
+number of sets (rows) in the internal sparsity pattern.
+
+\param end
+end of set value (number of columns) in the interanl sparsity pattern.
+
+\param transpose
+if true, the user sparsity patter is the transposed.
+
+\param error_msg
+is the error message to display if some values in the user sparstiy
+pattern are not valid.
+*/
+template<class VectorSet>
+void sparsity_user2internal(
+	sparse_hybrid&          internal  ,
+	const VectorSet&        user      ,
+	size_t                  n_set     ,
+	size_t                  end       ,
+	bool                    transpose ,
+	const char*             error_msg )
+{
+# ifndef NDEBUG
+	if( transpose )
+		CPPAD_ASSERT_KNOWN( end == size_t( user.size() ), error_msg);
+	if( ! transpose )
+		CPPAD_ASSERT_KNOWN( n_set == size_t( user.size() ), error_msg);
+# endif
+
+	// iterator for user set
+	std::set<size_t>::const_iterator itr;
+
+	// size of internal sparsity pattern
+	internal.resize(n_set, end);
+
+	if( transpose )
+	{	// transposed pattern case
+		for(size_t j = 0; j < end; j++)
+		{	itr = user[j].begin();
+			while(itr != user[j].end())
+			{	size_t i = *itr++;
+				CPPAD_ASSERT_KNOWN(i < n_set, error_msg);
+				internal.post_element(i, j);
+			}
+		}
+		for(size_t i = 0; i < n_set; i++)
+			internal.process_post(i);
+	}
+	else
+	{	for(size_t i = 0; i < n_set; i++)
+		{	itr = user[i].begin();
+			while(itr != user[i].end())
+			{	size_t j = *itr++;
+				CPPAD_ASSERT_KNOWN( j < end, error_msg);
+				internal.post_element(i, j);
+			}
+			internal.process_post(i);
+		}
+	}
+	return;
+}
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+# endif
@@ -17,6 +17,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 # include <cppad/local/sparse_pack.hpp>
 # include <cppad/local/sparse_list.hpp>
 # include <cppad/local/sparse_sizevec.hpp>
+# include <cppad/local/sparse_hybrid.hpp>
 
 namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
 /*!
@@ -446,7 +447,113 @@ void get_internal_sparsity(
 	return;
 }
 
+// ----------------------------------------------------------------------------
+/*!
+Set a sample of the columns of a sparsity pattern in an internal
+sparsity pattern.
+
+\tparam SizeVector
+The type used for index sparsity patterns. This is a simple vector
+with elements of type size_t.
+
+\param stride
+Only the columns (rows if transpose is true) of pattern_in that are
+multiples of stride are included in the sample.
+Column j of pattern_in corresponds to element j / stride in sample_pattern.
+
+\param transpose
+If this is true, pattern_in is transposed.
+
+\param internal_index
+If traspose is false (true),
+this is the mapping from row (column) index in pattern_in to the corresponding
+row index in the sample_pattern.
+
+\param sample_pattern
+On input, the number of sets sample_pattern.n_set(),
+and possible elements sample_pattern.end(), have been set and
+all the sets are empty. Set zero is left empty.
+On output, the sampled entries in pattern_in are in sample_pattern.
+
+\param pattern_in
+This is the sparsity pattern for variables,
+or its transpose, depending on the value of transpose.
+*/
+template <class SizeVector>
+void set_sample_sparsity(
+	size_t                        stride           ,
+	bool                          transpose        ,
+	const vector<size_t>&         internal_index   ,
+	sparse_pack&                  sample_pattern   ,
+	const sparse_rc<SizeVector>&  pattern_in       )
+{	CPPAD_ASSERT_UNKNOWN( stride > 0 );
+	const SizeVector& row( pattern_in.row() );
+	const SizeVector& col( pattern_in.col() );
+	size_t nnz = row.size();
+	for(size_t k = 0; k < nnz; k++)
+	{	size_t r = row[k];
+		size_t c = col[k];
+		if( transpose )
+			std::swap(r, c);
+		//
+		size_t i_var = internal_index[r];
+		if( i_var != 0 && c % stride == 0 )
+		{	CPPAD_ASSERT_UNKNOWN( c / stride < sample_pattern.end() );
+			sample_pattern.post_element(i_var, c / stride);
+		}
+	}
+	// process posts
+	size_t nr = internal_index.size();
+	for(size_t i = 0; i < nr; ++i)
+		sample_pattern.process_post( internal_index[i] );
+}
+// ----------------------------------------------------------------------------
+/*!
+Fraction of the possible elements that are in an internal sparsity pattern.
+
+\param internal_pattern
+is the internal sparsity pattern.
+
+\return
+is the number of elements in all the sets divided by
+internal_pattern.n_set() * internal_pattern.end().
+*/
+template <class InternalSparsity>
+double sparsity_fill(const InternalSparsity& internal_pattern)
+{	size_t n_set = internal_pattern.n_set();
+	size_t end   = internal_pattern.end();
+	if( n_set == 0 || end == 0 )
+		return 0.0;
+	size_t count = 0;
+	for(size_t i = 0; i < n_set; ++i)
+		count += internal_pattern.number_elements(i);
+	return double(count) / ( double(n_set) * double(end) );
+}
+// ----------------------------------------------------------------------------
+/*!
+Choose between sparse_pack and sparse_list for an internal sparsity pattern.
+
+\param fill
+is the expected fraction of the possible elements that are in each set.
 
+\param end
+is the number of possible elements in each set.
+
+\return
+is true if sparse_pack is expected to use less memory than sparse_list;
+i.e., if the number of words sparse_pack uses for a set is less than or
+equal two times the expected number of elements in the set
+(sparse_list uses a pair of size_t values for each element).
+The time for a set operation is roughly proportional to this memory
+for both representations.
+*/
+inline bool sparsity_choose_bool(double fill, size_t end)
+{	// number of bits in each sparse_pack word
+	size_t n_bit     = std::numeric_limits<size_t>::digits;
+	double n_pack    = double( (end + n_bit - 1) / n_bit );
+	double n_element = fill * double(end);
+	return n_pack <= 2.0 * n_element;
+}
 
 } } // END_CPPAD_LOCAL_NAMESPACE
 
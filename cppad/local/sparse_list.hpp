@@ -13,6 +13,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 -------------------------------------------------------------------------- */
 # include <cppad/local/define.hpp>
 # include <cppad/local/is_pod.hpp>
+# include <cppad/local/pod_arena.hpp>
 # include <list>
 
 namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
@@ -58,8 +59,9 @@ private:
 	/// list of elements of data_ that are not being used.
 	size_t data_not_used_;
 
-	/// The data for all the singly linked lists.
-	pod_vector<pair_size_t> data_;
+	/// The data for all the singly linked lists
+	/// (stored in chunks so growing it does not copy the lists).
+	pod_arena<pair_size_t> data_;
 
 	/*!
 	Starting point for i-th set is start_[i].
@@ -679,6 +681,7 @@ public:
 		}
 		//
 		// last element, marks the end for all lists
+		// (resize keeps the memory in data_ for reuse)
 		data_.resize(1);
 		data_[0].value    = end_;
 		data_[0].next     = 0;
@@ -1296,6 +1299,38 @@ public:
 	size_t memory(void) const
 	{	return data_.capacity() * sizeof(pair_size_t);
 	}
+	// -----------------------------------------------------------------
+	/*!
+	Number of data_ entries that are in use.
+
+	\return
+	is the number of entries used by the sets (including one reference
+	count entry for each distinct list) and by the posted elements.
+
+	\par vector_of_sets
+	This public member function is not part of
+	the vector_of_sets concept.
+	*/
+	size_t number_live(void) const
+	{	if( data_.size() == 0 )
+			return 0;
+		return data_.size() - 1 - number_not_used_;
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Number of data_ entries that are garbage.
+
+	\return
+	is the number of entries that have been dropped and are waiting to be
+	reused. Together with number_live, this is the number of data_ entries
+	(not counting the entry that marks the end of all the lists).
+
+	\par vector_of_sets
+	This public member function is not part of
+	the vector_of_sets concept.
+	*/
+	size_t number_garbage(void) const
+	{	return number_not_used_; }
 	/*!
 	Print the vector of sets (used for debugging)
 	*/
@@ -1315,7 +1350,7 @@ private:
 	typedef sparse_list::pair_size_t pair_size_t;
 
 	/// data for the entire vector of sets
-	const pod_vector<pair_size_t>& data_;
+	const pod_arena<pair_size_t>&  data_;
 
 	/// Possible elements in a list are 0, 1, ..., end_ - 1;
 	const size_t                   end_;
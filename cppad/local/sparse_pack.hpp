@@ -49,6 +49,105 @@ private:
 	size_t n_pack_;
 	/// Data for all the sets.
 	pod_vector<Pack>  data_;
+// ============================================================================
+	/*
+	The block routines below process four Pack values at a time
+	(256 bits when Pack has 64 bits). All the loads in a block come before
+	the stores, so the compiler can use wide vector instructions without
+	having to check if the target overlaps the operands
+	(it can be the same as an operand).
+	*/
+	/*!
+	Copy packed bits.
+
+	\param n
+	is the number of Pack values.
+
+	\param target
+	is the first Pack value that is assigned.
+
+	\param value
+	is the first Pack value that is copied.
+	*/
+	static void block_copy(size_t n, Pack* target, const Pack* value)
+	{	if( target == value )
+			return;
+		size_t k = 0;
+		for(; k + 4 <= n; k += 4)
+		{	Pack v0 = value[k];
+			Pack v1 = value[k + 1];
+			Pack v2 = value[k + 2];
+			Pack v3 = value[k + 3];
+			target[k]     = v0;
+			target[k + 1] = v1;
+			target[k + 2] = v2;
+			target[k + 3] = v3;
+		}
+		for(; k < n; ++k)
+			target[k] = value[k];
+	}
+	/*!
+	Union of packed bits.
+
+	\param n
+	is the number of Pack values.
+
+	\param target
+	is the first Pack value that is assigned.
+
+	\param left
+	is the first Pack value for the left operand.
+
+	\param right
+	is the first Pack value for the right operand.
+	*/
+	static void block_union(
+		size_t n, Pack* target, const Pack* left, const Pack* right)
+	{	size_t k = 0;
+		for(; k + 4 <= n; k += 4)
+		{	Pack v0 = left[k]     | right[k];
+			Pack v1 = left[k + 1] | right[k + 1];
+			Pack v2 = left[k + 2] | right[k + 2];
+			Pack v3 = left[k + 3] | right[k + 3];
+			target[k]     = v0;
+			target[k + 1] = v1;
+			target[k + 2] = v2;
+			target[k + 3] = v3;
+		}
+		for(; k < n; ++k)
+			target[k] = left[k] | right[k];
+	}
+	/*!
+	Intersection of packed bits.
+
+	\param n
+	is the number of Pack values.
+
+	\param target
+	is the first Pack value that is assigned.
+
+	\param left
+	is the first Pack value for the left operand.
+
+	\param right
+	is the first Pack value for the right operand.
+	*/
+	static void block_intersection(
+		size_t n, Pack* target, const Pack* left, const Pack* right)
+	{	size_t k = 0;
+		for(; k + 4 <= n; k += 4)
+		{	Pack v0 = left[k]     & right[k];
+			Pack v1 = left[k + 1] & right[k + 1];
+			Pack v2 = left[k + 2] & right[k + 2];
+			Pack v3 = left[k + 3] & right[k + 3];
+			target[k]     = v0;
+			target[k + 1] = v1;
+			target[k + 2] = v2;
+			target[k + 3] = v3;
+		}
+		for(; k < n; ++k)
+			target[k] = left[k] & right[k];
+	}
 // ============================================================================
 	/*!
 	Assign a set equal to the union of a set and a vector;
@@ -74,11 +173,8 @@ private:
 		const pod_vector<size_t>& right  )
 	{
 		// initialize target = left
-		size_t t = target * n_pack_;
-		size_t l = left   * n_pack_;
-		size_t j = n_pack_;
-		while(j--)
-			data_[t++] = data_[l++];
+		Pack* data = data_.data();
+		block_copy(n_pack_, data + target * n_pack_, data + left * n_pack_);
 
 		// add the elements in right
 		for(size_t i = 0; i < right.size(); ++i)
@@ -307,12 +403,95 @@ public:
 	{	CPPAD_ASSERT_UNKNOWN( this_target  <   n_set_        );
 		CPPAD_ASSERT_UNKNOWN( other_value  <   other.n_set_  );
 		CPPAD_ASSERT_UNKNOWN( n_pack_      ==  other.n_pack_ );
-		size_t t = this_target * n_pack_;
-		size_t v = other_value * n_pack_;
+		block_copy(
+			n_pack_,
+			data_.data()       + this_target * n_pack_,
+			other.data_.data() + other_value * n_pack_
+		);
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Assign one set equal to a block of the possible elements in another set.
 
-		size_t j = n_pack_;
-		while(j--)
-			data_[t++] = other.data_[v++];
+	\param this_target
+	is the index (in this \c sparse_pack object) of the set being assinged.
+
+	\param other_value
+	is the index (in the other \c sparse_pack object) of the set
+	that contains the block.
+
+	\param other_first
+	is the index of the first Pack value in the block; i.e.,
+	element e of this set is element e + other_first * n_bit_ of the other set.
+
+	\param other
+	is the other \c sparse_pack object.
+
+	\par Checked Assertions
+	\li this_target  < n_set_
+	\li other_value  < other.n_set_
+	\li other_first + n_pack_ <= other.n_pack_
+
+	\par vector_of_sets
+	This public member function is not part of
+	the vector_of_sets concept.
+	*/
+	void assignment_from_block(
+		size_t               this_target  ,
+		size_t               other_value  ,
+		size_t               other_first  ,
+		const sparse_pack&   other        )
+	{	CPPAD_ASSERT_UNKNOWN( this_target  <   n_set_        );
+		CPPAD_ASSERT_UNKNOWN( other_value  <   other.n_set_  );
+		CPPAD_ASSERT_UNKNOWN( other_first + n_pack_ <= other.n_pack_ );
+		block_copy(
+			n_pack_,
+			data_.data()       + this_target * n_pack_,
+			other.data_.data() + other_value * other.n_pack_ + other_first
+		);
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Assign a block of the possible elements in one set equal to another set.
+
+	\param this_target
+	is the index (in this \c sparse_pack object) of the set that
+	contains the block being assigned.
+
+	\param this_first
+	is the index of the first Pack value in the block; i.e.,
+	element e of the other set is element e + this_first * n_bit_
+	of this set.
+
+	\param other_value
+	is the index (in the other \c sparse_pack object) of the set
+	that we are using as the value to assign to the block.
+
+	\param other
+	is the other \c sparse_pack object.
+
+	\par Checked Assertions
+	\li this_target  < n_set_
+	\li other_value  < other.n_set_
+	\li this_first + other.n_pack_ <= n_pack_
+
+	\par vector_of_sets
+	This public member function is not part of
+	the vector_of_sets concept.
+	*/
+	void assignment_to_block(
+		size_t               this_target  ,
+		size_t               this_first   ,
+		size_t               other_value  ,
+		const sparse_pack&   other        )
+	{	CPPAD_ASSERT_UNKNOWN( this_target  <   n_set_        );
+		CPPAD_ASSERT_UNKNOWN( other_value  <   other.n_set_  );
+		CPPAD_ASSERT_UNKNOWN( this_first + other.n_pack_ <= n_pack_ );
+		block_copy(
+			other.n_pack_,
+			data_.data()       + this_target * n_pack_ + this_first,
+			other.data_.data() + other_value * other.n_pack_
+		);
 	}
 	// -----------------------------------------------------------------
 	/*!
@@ -351,13 +530,12 @@ public:
 		CPPAD_ASSERT_UNKNOWN( other_right < other.n_set_   );
 		CPPAD_ASSERT_UNKNOWN( n_pack_    ==  other.n_pack_ );
 
-		size_t t = this_target * n_pack_;
-		size_t l  = this_left  * n_pack_;
-		size_t r  = other_right * n_pack_;
-
-		size_t j = n_pack_;
-		while(j--)
-			data_[t++] = ( data_[l++] | other.data_[r++] );
+		block_union(
+			n_pack_,
+			data_.data()       + this_target * n_pack_,
+			data_.data()       + this_left   * n_pack_,
+			other.data_.data() + other_right * n_pack_
+		);
 	}
 	// -----------------------------------------------------------------
 	/*!
@@ -396,13 +574,12 @@ public:
 		CPPAD_ASSERT_UNKNOWN( other_right < other.n_set_   );
 		CPPAD_ASSERT_UNKNOWN( n_pack_    ==  other.n_pack_ );
 
-		size_t t = this_target * n_pack_;
-		size_t l  = this_left  * n_pack_;
-		size_t r  = other_right * n_pack_;
-
-		size_t j = n_pack_;
-		while(j--)
-			data_[t++] = ( data_[l++] & other.data_[r++] );
+		block_intersection(
+			n_pack_,
+			data_.data()       + this_target * n_pack_,
+			data_.data()       + this_left   * n_pack_,
+			other.data_.data() + other_right * n_pack_
+		);
 	}
 	// -----------------------------------------------------------------
 	/*!
@@ -0,0 +1,1042 @@
+# ifndef CPPAD_LOCAL_SWEEP_COLOR_TEAM_HPP
+# define CPPAD_LOCAL_SWEEP_COLOR_TEAM_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/local/team_run.hpp>
+
+// BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/color_team.hpp
+Sparse derivative sweeps for the colors (or groups of colors) used to compute
+sparse Jacobians and Hessians split between a team of threads.
+
+Each thread does complete sweeps (for the colors assigned to it) using its own
+Taylor coefficient or partial derivative workspace.
+All the memory used by the threads is allocated by the current thread
+before the team is started (the team threads do not use thread_alloc).
+*/
+
+/*!
+Can the color groups for this operation sequence be split between a team.
+
+\param play
+is the operation sequence.
+
+\return
+is false if the operation sequence contains atomic function operators
+(the sweeps allocate memory for the atomic function arguments and results)
+or if C++11 threads are not available.
+*/
+template <class Base>
+bool color_team_supported(const local::player<Base>* play)
+{
+# if ! CPPAD_USE_CPLUSPLUS_2011
+	return false;
+# else
+	size_t num_op = play->num_op_rec();
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+	{	if( play->GetOp(i_op) == UserOp )
+			return false;
+	}
+	return true;
+# endif
+}
+
+/*!
+Size of the CProdOp work space used by each thread for reverse sweeps.
+
+\param play
+is the operation sequence.
+
+\param d
+is the highest order Taylor coefficient for the reverse sweeps.
+
+\return
+is (m + 1) * (d + 1) where m is the maximum number of variables in a
+CProdOp operator (zero if there are no CProdOp operators); see the
+cprod_work argument to sweep::reverse.
+*/
+template <class Base>
+size_t color_team_num_cprod(const local::player<Base>* play, size_t d)
+{	size_t max_cprod = 0;
+	play::const_sequential_iterator itr = play->begin();
+	OpCode        op;
+	size_t        i_var;
+	const addr_t* arg;
+	itr.op_info(op, arg, i_var);
+	CPPAD_ASSERT_UNKNOWN( op == BeginOp );
+	while( op != EndOp )
+	{	(++itr).op_info(op, arg, i_var);
+		if( op == CSumOp || op == CProdOp )
+			itr.correct_before_increment();
+		if( op == CProdOp )
+			max_cprod = std::max(max_cprod, size_t(arg[1]) - 3);
+	}
+	if( max_cprod == 0 )
+		return 0;
+	return (max_cprod + 1) * (d + 1);
+}
+
+/*!
+Index in subset of the first entry for each color.
+
+\param n_color
+is the number of colors.
+
+\param color
+is the color for each row or column that is colored.
+
+\param index
+is the colored row or column index for each entry in subset.
+
+\param order
+sorts the entries in subset by color.
+
+\param color_begin [out]
+has size n_color + 1. The entries with color c are
+order[k] for k = color_begin[c], ... , color_begin[c+1] - 1.
+*/
+template <class SizeVector>
+void color_team_begin(
+	size_t                        n_color     ,
+	const CppAD::vector<size_t>&  color       ,
+	const SizeVector&             index       ,
+	const CppAD::vector<size_t>&  order       ,
+	pod_vector<size_t>&           color_begin )
+{	size_t K = order.size();
+	color_begin.resize(n_color + 1);
+	size_t k = 0;
+	for(size_t c = 0; c <= n_color; ++c)
+	{	color_begin[c] = k;
+		while( k < K && color[ index[ order[k] ] ] == c )
+			++k;
+	}
+	CPPAD_ASSERT_UNKNOWN( k == K );
+}
+
+/// work done by each thread during sparse Jacobian forward mode
+template <class Base>
+class jac_for_team_work {
+private:
+	const local::player<Base>*  play_;
+	const size_t                n_;
+	const size_t                numvar_;
+	const size_t                C_;
+	const Base*                 taylor_;
+	const bool*                 cskip_op_;
+	const pod_vector<addr_t>&   load_op_;
+	const size_t*               ind_taddr_;
+	const size_t*               dep_taddr_;
+	const size_t*               color_;
+	const size_t                n_color_;
+	const size_t                group_max_;
+	const size_t*               color_begin_;
+	const size_t*               entry_row_;
+	const size_t                num_threads_;
+	Base*                       thread_taylor_;
+	Base*                       value_;
+public:
+	/*!
+	constructor
+
+	\param play
+	is the operation sequence.
+
+	\param n
+	is the number of independent variables.
+
+	\param numvar
+	is the number of variables in the operation sequence.
+
+	\param C
+	is the number of columns in the zero order Taylor coefficient matrix
+	taylor (the zero order coefficient for variable i is taylor[i * C]).
+
+	\param taylor
+	contains the zero order Taylor coefficients for all the variables.
+
+	\param cskip_op
+	is the conditional skip flag for each operator.
+
+	\param load_op
+	is the variable index for each load operator.
+
+	\param ind_taddr
+	is the variable index for each independent variable.
+
+	\param dep_taddr
+	is the variable index for each dependent variable.
+
+	\param color
+	is the color for each independent variable (column of the Jacobian).
+
+	\param n_color
+	is the number of colors.
+
+	\param group_max
+	is the maximum number of colors in a group (one forward sweep).
+
+	\param color_begin
+	is the entry index where each color begins; see color_team_begin.
+
+	\param entry_row
+	is the row index for each entry in color order.
+
+	\param num_threads
+	is the number of threads in the team.
+
+	\param thread_taylor
+	is the Taylor coefficient workspace for the threads; it has size
+	num_threads * numvar * (group_max + 1).
+
+	\param value
+	is the Jacobian value for each entry in color order.
+	*/
+	jac_for_team_work(
+		const local::player<Base>*  play          ,
+		size_t                      n             ,
+		size_t                      numvar        ,
+		size_t                      C             ,
+		const Base*                 taylor        ,
+		const bool*                 cskip_op      ,
+		const pod_vector<addr_t>&   load_op       ,
+		const size_t*               ind_taddr     ,
+		const size_t*               dep_taddr     ,
+		const size_t*               color         ,
+		size_t                      n_color       ,
+		size_t                      group_max     ,
+		const size_t*               color_begin   ,
+		const size_t*               entry_row     ,
+		size_t                      num_threads   ,
+		Base*                       thread_taylor ,
+		Base*                       value         )
+	: play_(play)
+	, n_(n)
+	, numvar_(numvar)
+	, C_(C)
+	, taylor_(taylor)
+	, cskip_op_(cskip_op)
+	, load_op_(load_op)
+	, ind_taddr_(ind_taddr)
+	, dep_taddr_(dep_taddr)
+	, color_(color)
+	, n_color_(n_color)
+	, group_max_(group_max)
+	, color_begin_(color_begin)
+	, entry_row_(entry_row)
+	, num_threads_(num_threads)
+	, thread_taylor_(thread_taylor)
+	, value_(value)
+	{ }
+	/// the work for one thread in the team
+	void operator()(size_t thread)
+	{	Base zero(0.0);
+		Base one(1.0);
+		Base* taylor = thread_taylor_ + thread * numvar_ * (group_max_ + 1);
+		size_t n_group = (n_color_ + group_max_ - 1) / group_max_;
+		for(size_t g = thread; g < n_group; g += num_threads_)
+		{	// colors in this group
+			size_t c_begin = g * group_max_;
+			size_t r       = std::min(group_max_, n_color_ - c_begin);
+			size_t stride  = r + 1;
+			//
+			// zero order coefficients
+			for(size_t i = 0; i < numvar_; ++i)
+				taylor[i * stride] = taylor_[i * C_];
+			//
+			// first order coefficients for the independent variables
+			for(size_t j = 0; j < n_; ++j)
+			{	Base* dx = taylor + ind_taddr_[j] * stride + 1;
+				for(size_t ell = 0; ell < r; ++ell)
+					dx[ell] = zero;
+				size_t c = color_[j];
+				if( c_begin <= c && c < c_begin + r )
+					dx[c - c_begin] = one;
+			}
+			//
+			// forward sweep for all the colors in this group
+			forward2(
+				play_, 1, r, n_, numvar_, 2, taylor, cskip_op_, load_op_
+			);
+			//
+			// values for the entries with colors in this group
+			for(size_t ell = 0; ell < r; ++ell)
+			{	size_t c = c_begin + ell;
+				for(size_t k = color_begin_[c]; k < color_begin_[c+1]; ++k)
+				{	size_t i_var = dep_taddr_[ entry_row_[k] ];
+					value_[k]    = taylor[i_var * stride + 1 + ell];
+				}
+			}
+		}
+	}
+};
+
+/// work done by each thread during sparse Jacobian reverse mode
+template <class Base>
+class jac_rev_team_work {
+private:
+	const local::player<Base>*  play_;
+	const size_t                n_;
+	const size_t                m_;
+	const size_t                numvar_;
+	const size_t                C_;
+	const Base*                 taylor_;
+	bool*                       cskip_op_;
+	const pod_vector<addr_t>&   load_op_;
+	const size_t*               ind_taddr_;
+	const size_t*               dep_taddr_;
+	const size_t*               color_;
+	const size_t                n_color_;
+	const size_t*               color_begin_;
+	const size_t*               entry_col_;
+	const size_t                num_threads_;
+	Base*                       thread_partial_;
+	const size_t                num_cprod_;
+	Base*                       thread_cprod_;
+	Base*                       value_;
+public:
+	/*!
+	constructor
+
+	\param play
+	is the operation sequence.
+
+	\param n
+	is the number of independent variables.
+
+	\param m
+	is the number of dependent variables.
+
+	\param numvar
+	is the number of variables in the operation sequence.
+
+	\param C
+	is the number of columns in the Taylor coefficient matrix taylor.
+
+	\param taylor
+	contains the zero order Taylor coefficients for all the variables.
+
+	\param cskip_op
+	is the conditional skip flag for each operator.
+
+	\param load_op
+	is the variable index for each load operator.
+
+	\param ind_taddr
+	is the variable index for each independent variable.
+
+	\param dep_taddr
+	is the variable index for each dependent variable.
+
+	\param color
+	is the color for each dependent variable (row of the Jacobian).
+
+	\param n_color
+	is the number of colors.
+
+	\param color_begin
+	is the entry index where each color begins; see color_team_begin.
+
+	\param entry_col
+	is the column index for each entry in color order.
+
+	\param num_threads
+	is the number of threads in the team.
+
+	\param thread_partial
+	is the partial derivative workspace for the threads; it has size
+	num_threads * numvar.
+
+	\param num_cprod
+	is the size of the CProdOp workspace for each thread;
+	see color_team_num_cprod.
+
+	\param thread_cprod
+	is the CProdOp workspace for the threads; it has size
+	num_threads * num_cprod.
+
+	\param value
+	is the Jacobian value for each entry in color order.
+	*/
+	jac_rev_team_work(
+		const local::player<Base>*  play           ,
+		size_t                      n              ,
+		size_t                      m              ,
+		size_t                      numvar         ,
+		size_t                      C              ,
+		const Base*                 taylor         ,
+		bool*                       cskip_op       ,
+		const pod_vector<addr_t>&   load_op        ,
+		const size_t*               ind_taddr      ,
+		const size_t*               dep_taddr      ,
+		const size_t*               color          ,
+		size_t                      n_color        ,
+		const size_t*               color_begin    ,
+		const size_t*               entry_col      ,
+		size_t                      num_threads    ,
+		Base*                       thread_partial ,
+		size_t                      num_cprod      ,
+		Base*                       thread_cprod   ,
+		Base*                       value          )
+	: play_(play)
+	, n_(n)
+	, m_(m)
+	, numvar_(numvar)
+	, C_(C)
+	, taylor_(taylor)
+	, cskip_op_(cskip_op)
+	, load_op_(load_op)
+	, ind_taddr_(ind_taddr)
+	, dep_taddr_(dep_taddr)
+	, color_(color)
+	, n_color_(n_color)
+	, color_begin_(color_begin)
+	, entry_col_(entry_col)
+	, num_threads_(num_threads)
+	, thread_partial_(thread_partial)
+	, num_cprod_(num_cprod)
+	, thread_cprod_(thread_cprod)
+	, value_(value)
+	{ }
+	/// the work for one thread in the team
+	void operator()(size_t thread)
+	{	Base zero(0.0);
+		Base one(1.0);
+		Base* partial = thread_partial_ + thread * numvar_;
+		Base* cprod   = thread_cprod_   + thread * num_cprod_;
+		for(size_t c = thread; c < n_color_; c += num_threads_)
+		if( color_begin_[c] < color_begin_[c+1] )
+		{	// combine all the rows with this color
+			for(size_t i = 0; i < numvar_; ++i)
+				partial[i] = zero;
+			for(size_t i = 0; i < m_; ++i)
+			{	if( color_[i] == c )
+					partial[ dep_taddr_[i] ] += one;
+			}
+			//
+			// reverse sweep for this color
+			play::const_sequential_iterator itr = play_->end();
+			reverse(
+				0,
+				n_,
+				numvar_,
+				play_,
+				C_,
+				taylor_,
+				1,
+				partial,
+				cskip_op_,
+				load_op_,
+				itr,
+				cprod
+			);
+			//
+			// values for the entries with this color
+			for(size_t k = color_begin_[c]; k < color_begin_[c+1]; ++k)
+				value_[k] = partial[ ind_taddr_[ entry_col_[k] ] ];
+		}
+	}
+};
+
+/// work done by each thread during sparse Hessian calculations
+template <class Base>
+class hes_team_work {
+private:
+	const local::player<Base>*  play_;
+	const size_t                n_;
+	const size_t                m_;
+	const size_t                numvar_;
+	const size_t                C_;
+	const Base*                 taylor_;
+	bool*                       cskip_op_;
+	const pod_vector<addr_t>&   load_op_;
+	const size_t*               ind_taddr_;
+	const size_t*               dep_taddr_;
+	const Base*                 w_;
+	const size_t*               color_;
+	const size_t                n_color_;
+	const size_t*               color_begin_;
+	const size_t*               entry_index_;
+	const size_t                num_threads_;
+	Base*                       thread_taylor_;
+	Base*                       thread_partial_;
+	const size_t                num_cprod_;
+	Base*                       thread_cprod_;
+	Base*                       value_;
+public:
+	/*!
+	constructor
+
+	\param play
+	is the operation sequence.
+
+	\param n
+	is the number of independent variables.
+
+	\param m
+	is the number of dependent variables.
+
+	\param numvar
+	is the number of variables in the operation sequence.
+
+	\param C
+	is the number of columns in the Taylor coefficient matrix taylor.
+
+	\param taylor
+	contains the zero order Taylor coefficients for all the variables.
+
+	\param cskip_op
+	is the conditional skip flag for each operator.
+
+	\param load_op
+	is the variable index for each load operator.
+
+	\param ind_taddr
+	is the variable index for each independent variable.
+
+	\param dep_taddr
+	is the variable index for each dependent variable.
+
+	\param w
+	is the weight for each dependent variable.
+
+	\param color
+	is the color for each independent variable
+	(the forward mode direction index).
+
+	\param n_color
+	is the number of colors.
+
+	\param color_begin
+	is the entry index where each color begins; see color_team_begin.
+
+	\param entry_index
+	is the reverse mode (not colored) index for each entry in color order.
+
+	\param num_threads
+	is the number of threads in the team.
+
+	\param thread_taylor
+	is the Taylor coefficient workspace for the threads; it has size
+	num_threads * numvar * 2.
+
+	\param thread_partial
+	is the partial derivative workspace for the threads; it has size
+	num_threads * numvar * 2.
+
+	\param num_cprod
+	is the size of the CProdOp workspace for each thread;
+	see color_team_num_cprod.
+
+	\param thread_cprod
+	is the CProdOp workspace for the threads; it has size
+	num_threads * num_cprod.
+
+	\param value
+	is the Hessian value for each entry in color order.
+	*/
+	hes_team_work(
+		const local::player<Base>*  play           ,
+		size_t                      n              ,
+		size_t                      m              ,
+		size_t                      numvar         ,
+		size_t                      C              ,
+		const Base*                 taylor         ,
+		bool*                       cskip_op       ,
+		const pod_vector<addr_t>&   load_op        ,
+		const size_t*               ind_taddr      ,
+		const size_t*               dep_taddr      ,
+		const Base*                 w              ,
+		const size_t*               color          ,
+		size_t                      n_color        ,
+		const size_t*               color_begin    ,
+		const size_t*               entry_index    ,
+		size_t                      num_threads    ,
+		Base*                       thread_taylor  ,
+		Base*                       thread_partial ,
+		size_t                      num_cprod      ,
+		Base*                       thread_cprod   ,
+		Base*                       value          )
+	: play_(play)
+	, n_(n)
+	, m_(m)
+	, numvar_(numvar)
+	, C_(C)
+	, taylor_(taylor)
+	, cskip_op_(cskip_op)
+	, load_op_(load_op)
+	, ind_taddr_(ind_taddr)
+	, dep_taddr_(dep_taddr)
+	, w_(w)
+	, color_(color)
+	, n_color_(n_color)
+	, color_begin_(color_begin)
+	, entry_index_(entry_index)
+	, num_threads_(num_threads)
+	, thread_taylor_(thread_taylor)
+	, thread_partial_(thread_partial)
+	, num_cprod_(num_cprod)
+	, thread_cprod_(thread_cprod)
+	, value_(value)
+	{ }
+	/// the work for one thread in the team
+	void operator()(size_t thread)
+	{	Base zero(0.0);
+		Base one(1.0);
+		Base* taylor  = thread_taylor_  + thread * numvar_ * 2;
+		Base* partial = thread_partial_ + thread * numvar_ * 2;
+		Base* cprod   = thread_cprod_   + thread * num_cprod_;
+		for(size_t c = thread; c < n_color_; c += num_threads_)
+		if( color_begin_[c] < color_begin_[c+1] )
+		{	// zero order coefficients
+			for(size_t i = 0; i < numvar_; ++i)
+				taylor[i * 2] = taylor_[i * C_];
+			//
+			// combine all the independent variables with this color
+			for(size_t j = 0; j < n_; ++j)
+			{	Base* dx = taylor + ind_taddr_[j] * 2 + 1;
+				*dx = zero;
+				if( color_[j] == c )
+					*dx = one;
+			}
+			//
+			// first order forward sweep for this color
+			forward2(
+				play_, 1, 1, n_, numvar_, 2, taylor, cskip_op_, load_op_
+			);
+			//
+			// partial of w^T * F'(x) * dx
+			for(size_t i = 0; i < numvar_ * 2; ++i)
+				partial[i] = zero;
+			for(size_t i = 0; i < m_; ++i)
+				partial[ dep_taddr_[i] * 2 + 1 ] += w_[i];
+			//
+			// second order reverse sweep for this color
+			play::const_sequential_iterator itr = play_->end();
+			reverse(
+				1,
+				n_,
+				numvar_,
+				play_,
+				2,
+				taylor,
+				2,
+				partial,
+				cskip_op_,
+				load_op_,
+				itr,
+				cprod
+			);
+			//
+			// values for the entries with this color
+			for(size_t k = color_begin_[c]; k < color_begin_[c+1]; ++k)
+				value_[k] = partial[ ind_taddr_[ entry_index_[k] ] * 2 ];
+		}
+	}
+};
+
+/*!
+Compute the Jacobian entries in a subset using forward mode sweeps for
+groups of colors split between a team of threads.
+
+\param play
+is the operation sequence.
+
+\param n
+is the number of independent variables.
+
+\param numvar
+is the number of variables in the operation sequence.
+
+\param C
+is the number of columns in the Taylor coefficient matrix taylor.
+
+\param taylor
+contains the zero order Taylor coefficients for all the variables.
+
+\param cskip_op
+is the conditional skip flag for each operator.
+
+\param load_op
+is the variable index for each load operator.
+
+\param ind_taddr
+is the variable index for each independent variable.
+
+\param dep_taddr
+is the variable index for each dependent variable.
+
+\param color
+is the color for each column of the Jacobian.
+
+\param n_color
+is the number of colors.
+
+\param group_max
+is the maximum number of colors in one forward sweep.
+
+\param row
+is the row index for each entry in the subset.
+
+\param col
+is the column index for each entry in the subset.
+
+\param order
+sorts the entries in the subset by color.
+
+\param num_threads
+is the maximum number of threads in the team.
+
+\param value [out]
+if the return value is true, value[k] is the Jacobian value for
+the entry with index order[k] in the subset.
+
+\return
+is false (and nothing is computed) if there is only one group of colors
+or the team cannot be used for this operation sequence;
+see color_team_supported.
+*/
+template <class Base, class SizeVector>
+bool jac_for_team(
+	const local::player<Base>*    play        ,
+	size_t                        n           ,
+	size_t                        numvar      ,
+	size_t                        C           ,
+	const Base*                   taylor      ,
+	const bool*                   cskip_op    ,
+	const pod_vector<addr_t>&     load_op     ,
+	const CppAD::vector<size_t>&  ind_taddr   ,
+	const CppAD::vector<size_t>&  dep_taddr   ,
+	const CppAD::vector<size_t>&  color       ,
+	size_t                        n_color     ,
+	size_t                        group_max   ,
+	const SizeVector&             row         ,
+	const SizeVector&             col         ,
+	const CppAD::vector<size_t>&  order       ,
+	size_t                        num_threads ,
+	pod_vector_maybe<Base>&       value       )
+{	size_t n_group = (n_color + group_max - 1) / group_max;
+	num_threads    = std::min(num_threads, n_group);
+	if( num_threads < 2 )
+		return false;
+	if( ! color_team_supported(play) )
+		return false;
+	//
+	// entries in color order
+	pod_vector<size_t> color_begin;
+	color_team_begin(n_color, color, col, order, color_begin);
+	size_t K = order.size();
+	pod_vector<size_t> entry_row(K);
+	for(size_t k = 0; k < K; ++k)
+		entry_row[k] = row[ order[k] ];
+	value.resize(K);
+	//
+	// Taylor coefficient workspace for each thread
+	pod_vector_maybe<Base> thread_taylor(
+		num_threads * numvar * (group_max + 1)
+	);
+	//
+	jac_for_team_work<Base> work(
+		play,
+		n,
+		numvar,
+		C,
+		taylor,
+		cskip_op,
+		load_op,
+		ind_taddr.data(),
+		dep_taddr.data(),
+		color.data(),
+		n_color,
+		group_max,
+		color_begin.data(),
+		entry_row.data(),
+		num_threads,
+		thread_taylor.data(),
+		value.data()
+	);
+	team_run(num_threads, work);
+	return true;
+}
+
+/*!
+Compute the Jacobian entries in a subset using a reverse mode sweep for
+each color with the colors split between a team of threads.
+
+\param play
+is the operation sequence.
+
+\param n
+is the number of independent variables.
+
+\param m
+is the number of dependent variables.
+
+\param numvar
+is the number of variables in the operation sequence.
+
+\param C
+is the number of columns in the Taylor coefficient matrix taylor.
+
+\param taylor
+contains the zero order Taylor coefficients for all the variables.
+
+\param cskip_op
+is the conditional skip flag for each operator.
+
+\param load_op
+is the variable index for each load operator.
+
+\param ind_taddr
+is the variable index for each independent variable.
+
+\param dep_taddr
+is the variable index for each dependent variable.
+
+\param color
+is the color for each row of the Jacobian.
+
+\param n_color
+is the number of colors.
+
+\param row
+is the row index for each entry in the subset.
+
+\param col
+is the column index for each entry in the subset.
+
+\param order
+sorts the entries in the subset by color.
+
+\param num_threads
+is the maximum number of threads in the team.
+
+\param value [out]
+if the return value is true, value[k] is the Jacobian value for
+the entry with index order[k] in the subset.
+
+\return
+is false (and nothing is computed) if there is only one color
+or the team cannot be used for this operation sequence;
+see color_team_supported.
+*/
+template <class Base, class SizeVector>
+bool jac_rev_team(
+	const local::player<Base>*    play        ,
+	size_t                        n           ,
+	size_t                        m           ,
+	size_t                        numvar      ,
+	size_t                        C           ,
+	const Base*                   taylor      ,
+	bool*                         cskip_op    ,
+	const pod_vector<addr_t>&     load_op     ,
+	const CppAD::vector<size_t>&  ind_taddr   ,
+	const CppAD::vector<size_t>&  dep_taddr   ,
+	const CppAD::vector<size_t>&  color       ,
+	size_t                        n_color     ,
+	const SizeVector&             row         ,
+	const SizeVector&             col         ,
+	const CppAD::vector<size_t>&  order       ,
+	size_t                        num_threads ,
+	pod_vector_maybe<Base>&       value       )
+{	num_threads = std::min(num_threads, n_color);
+	if( num_threads < 2 )
+		return false;
+	if( ! color_team_supported(play) )
+		return false;
+	//
+	// entries in color order
+	pod_vector<size_t> color_begin;
+	color_team_begin(n_color, color, row, order, color_begin);
+	size_t K = order.size();
+	pod_vector<size_t> entry_col(K);
+	for(size_t k = 0; k < K; ++k)
+		entry_col[k] = col[ order[k] ];
+	value.resize(K);
+	//
+	// partial derivative workspace for each thread
+	pod_vector_maybe<Base> thread_partial(num_threads * numvar);
+	//
+	// CProdOp workspace for each thread (first order reverse)
+	size_t num_cprod = color_team_num_cprod(play, 0);
+	pod_vector_maybe<Base> thread_cprod(num_threads * num_cprod);
+	//
+	jac_rev_team_work<Base> work(
+		play,
+		n,
+		m,
+		numvar,
+		C,
+		taylor,
+		cskip_op,
+		load_op,
+		ind_taddr.data(),
+		dep_taddr.data(),
+		color.data(),
+		n_color,
+		color_begin.data(),
+		entry_col.data(),
+		num_threads,
+		thread_partial.data(),
+		num_cprod,
+		thread_cprod.data(),
+		value.data()
+	);
+	team_run(num_threads, work);
+	return true;
+}
+
+/*!
+Compute the Hessian entries in a subset using a first order forward sweep
+and a second order reverse sweep for each color with the colors split between
+a team of threads.
+
+\param play
+is the operation sequence.
+
+\param n
+is the number of independent variables.
+
+\param m
+is the number of dependent variables.
+
+\param numvar
+is the number of variables in the operation sequence.
+
+\param C
+is the number of columns in the Taylor coefficient matrix taylor.
+
+\param taylor
+contains the zero order Taylor coefficients for all the variables.
+
+\param cskip_op
+is the conditional skip flag for each operator.
+
+\param load_op
+is the variable index for each load operator.
+
+\param ind_taddr
+is the variable index for each independent variable.
+
+\param dep_taddr
+is the variable index for each dependent variable.
+
+\param w
+is the weight for each dependent variable.
+
+\param color
+is the color for each independent variable.
+
+\param n_color
+is the number of colors.
+
+\param color_index
+is the colored (forward mode) index for each entry in the subset.
+
+\param entry_index
+is the other (reverse mode) index for each entry in the subset.
+
+\param order
+sorts the entries in the subset by color.
+
+\param num_threads
+is the maximum number of threads in the team.
+
+\param value [out]
+if the return value is true, value[k] is the Hessian value for
+the entry with index order[k] in the subset.
+
+\return
+is false (and nothing is computed) if there is only one color
+or the team cannot be used for this operation sequence;
+see color_team_supported.
+*/
+template <class Base, class BaseVector>
+bool hes_team(
+	const local::player<Base>*    play        ,
+	size_t                        n           ,
+	size_t                        m           ,
+	size_t                        numvar      ,
+	size_t                        C           ,
+	const Base*                   taylor      ,
+	bool*                         cskip_op    ,
+	const pod_vector<addr_t>&     load_op     ,
+	const CppAD::vector<size_t>&  ind_taddr   ,
+	const CppAD::vector<size_t>&  dep_taddr   ,
+	const BaseVector&             w           ,
+	const CppAD::vector<size_t>&  color       ,
+	size_t                        n_color     ,
+	const CppAD::vector<size_t>&  color_index ,
+	const CppAD::vector<size_t>&  entry_index ,
+	const CppAD::vector<size_t>&  order       ,
+	size_t                        num_threads ,
+	pod_vector_maybe<Base>&       value       )
+{	num_threads = std::min(num_threads, n_color);
+	if( num_threads < 2 )
+		return false;
+	if( ! color_team_supported(play) )
+		return false;
+	//
+	// entries in color order
+	pod_vector<size_t> color_begin;
+	color_team_begin(n_color, color, color_index, order, color_begin);
+	size_t K = order.size();
+	pod_vector<size_t> index(K);
+	for(size_t k = 0; k < K; ++k)
+		index[k] = entry_index[ order[k] ];
+	value.resize(K);
+	//
+	// weights for the dependent variables
+	pod_vector_maybe<Base> weight(m);
+	for(size_t i = 0; i < m; ++i)
+		weight[i] = w[i];
+	//
+	// Taylor coefficient and partial derivative workspace for each thread
+	pod_vector_maybe<Base> thread_taylor(num_threads * numvar * 2);
+	pod_vector_maybe<Base> thread_partial(num_threads * numvar * 2);
+	//
+	// CProdOp workspace for each thread (second order reverse)
+	size_t num_cprod = color_team_num_cprod(play, 1);
+	pod_vector_maybe<Base> thread_cprod(num_threads * num_cprod);
+	//
+	hes_team_work<Base> work(
+		play,
+		n,
+		m,
+		numvar,
+		C,
+		taylor,
+		cskip_op,
+		load_op,
+		ind_taddr.data(),
+		dep_taddr.data(),
+		weight.data(),
+		color.data(),
+		n_color,
+		color_begin.data(),
+		index.data(),
+		num_threads,
+		thread_taylor.data(),
+		thread_partial.data(),
+		num_cprod,
+		thread_cprod.data(),
+		value.data()
+	);
+	team_run(num_threads, work);
+	return true;
+}
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
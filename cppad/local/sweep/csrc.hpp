@@ -0,0 +1,570 @@
+# ifndef CPPAD_LOCAL_SWEEP_CSRC_HPP
+# define CPPAD_LOCAL_SWEEP_CSRC_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <sstream>
+# include <string>
+
+// BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/csrc.hpp
+Create C source code for zero order forward and first order reverse mode.
+*/
+
+/// C source for the value of variable i
+inline std::string csrc_v(size_t i)
+{	std::ostringstream os;
+	os << "v[" << i << "]";
+	return os.str();
+}
+/// C source for the value of parameter i
+inline std::string csrc_p(size_t i)
+{	std::ostringstream os;
+	os << "p[" << i << "]";
+	return os.str();
+}
+/// C source for the partial with respect to variable i
+inline std::string csrc_pv(size_t i)
+{	std::ostringstream os;
+	os << "pv[" << i << "]";
+	return os.str();
+}
+
+/*!
+Create C source code that evaluates an operation sequence.
+
+The C source defines the following two functions:
+\verbatim
+void cppad_jit_forward(
+	const double* p, const double* x, double* y, double* v
+)
+void cppad_jit_reverse(
+	const double* p, const double* x, const double* w,
+	double* y, double* dw, double* v, double* pv
+)
+\endverbatim
+Here p is the parameter vector, x is the independent variable vector,
+and y is the dependent variable vector.
+The vectors v and pv have length equal to the number of variables
+and are used to hold the value of, and partial with respect to, each
+variable. The reverse function computes y, and the
+derivative of w^T y with respect to x in dw.
+
+Only the primary result of each operator is computed;
+i.e., the auxiliary results used by the Taylor coefficient recursions
+are not needed by the other operators.
+Conditional skip operators are not used, comparison operators are
+not counted, and print operators do not generate output.
+As in the reverse mode sweep, the reverse statements for an operator
+are skipped when the partial with respect to its result is zero,
+and the partials for the pow operators use cppad_azmul; i.e.,
+the derivative values are the same as for f.Reverse(1, w)
+(not nan when the unused result of a conditional expression is nan).
+
+\tparam Base
+is the base type for the operator; i.e., this operation sequence was
+recorded using AD<Base>. The C source uses double for its computations.
+
+\param os
+is the stream that the C source code is written to.
+
+\param play
+is the operation sequence.
+
+\param ind_taddr
+is the variable index for each independent variable.
+
+\param dep_taddr
+is the variable index for each dependent variable.
+
+\return
+is empty if the C source code was created.
+Otherwise, it is an error message that identifies an operator
+that is not supported; e.g., VecAD, discrete, and atomic function
+operators. In this case, the output written to os should not be used.
+*/
+template <class Base>
+std::string csrc(
+	std::ostream&                os        ,
+	const local::player<Base>*   play      ,
+	const CppAD::vector<size_t>& ind_taddr ,
+	const CppAD::vector<size_t>& dep_taddr )
+{	size_t n      = ind_taddr.size();
+	size_t m      = dep_taddr.size();
+	size_t numvar = play->num_var_rec();
+
+	// first order reverse statements for each operator
+	CppAD::vector<std::string> reverse_src;
+
+	// zero order forward statements
+	std::ostringstream fos;
+
+	// comparison operators used by conditional expressions
+	const char* compare[] = { "<", "<=", "==", ">=", ">", "!=" };
+
+	play::const_sequential_iterator itr = play->begin();
+	OpCode        op;
+	size_t        i_var;
+	const addr_t* arg;
+	itr.op_info(op, arg, i_var);
+	CPPAD_ASSERT_UNKNOWN( op == BeginOp );
+	bool more_operators = true;
+	while(more_operators)
+	{	(++itr).op_info(op, arg, i_var);
+
+		// names for the result and first two arguments
+		std::string z, pz, x, px, y, py;
+		if( NumRes(op) > 0 )
+		{	z  = csrc_v(i_var);
+			pz = csrc_pv(i_var);
+		}
+		// forward expression (if not empty) and
+		// derivative of result w.r.t. x (for unary operators)
+		std::string fexp, dx;
+		// reverse statements (if not using dx)
+		std::ostringstream ros;
+		//
+		switch( op )
+		{	// ------------------------------------------------------------
+			// operators that have no effect on the C source
+			case BeginOp:
+			case InvOp:
+			case EqppOp:
+			case EqpvOp:
+			case EqvvOp:
+			case LeppOp:
+			case LepvOp:
+			case LevpOp:
+			case LevvOp:
+			case LtppOp:
+			case LtpvOp:
+			case LtvpOp:
+			case LtvvOp:
+			case NeppOp:
+			case NepvOp:
+			case NevvOp:
+			case PriOp:
+			break;
+
+			case CSkipOp:
+			itr.correct_before_increment();
+			break;
+
+			case EndOp:
+			more_operators = false;
+			break;
+			// ------------------------------------------------------------
+			// unary operators
+			case AbsOp:
+			x    = csrc_v(arg[0]);
+			fexp = "fabs(" + x + ")";
+			dx   = "cppad_sign(" + x + ")";
+			break;
+
+			case AcosOp:
+			x    = csrc_v(arg[0]);
+			fexp = "acos(" + x + ")";
+			dx   = "- 1.0 / sqrt(1.0 - " + x + " * " + x + ")";
+			break;
+
+			case AsinOp:
+			x    = csrc_v(arg[0]);
+			fexp = "asin(" + x + ")";
+			dx   = "1.0 / sqrt(1.0 - " + x + " * " + x + ")";
+			break;
+
+			case AtanOp:
+			x    = csrc_v(arg[0]);
+			fexp = "atan(" + x + ")";
+			dx   = "1.0 / (1.0 + " + x + " * " + x + ")";
+			break;
+
+			case CosOp:
+			x    = csrc_v(arg[0]);
+			fexp = "cos(" + x + ")";
+			dx   = "- sin(" + x + ")";
+			break;
+
+			case CoshOp:
+			x    = csrc_v(arg[0]);
+			fexp = "cosh(" + x + ")";
+			dx   = "sinh(" + x + ")";
+			break;
+
+			case ExpOp:
+			x    = csrc_v(arg[0]);
+			fexp = "exp(" + x + ")";
+			dx   = z;
+			break;
+
+			case LogOp:
+			x    = csrc_v(arg[0]);
+			fexp = "log(" + x + ")";
+			dx   = "1.0 / " + x;
+			break;
+
+			case SignOp:
+			// the derivative is zero
+			x    = csrc_v(arg[0]);
+			fexp = "cppad_sign(" + x + ")";
+			break;
+
+			case SinOp:
+			x    = csrc_v(arg[0]);
+			fexp = "sin(" + x + ")";
+			dx   = "cos(" + x + ")";
+			break;
+
+			case SinhOp:
+			x    = csrc_v(arg[0]);
+			fexp = "sinh(" + x + ")";
+			dx   = "cosh(" + x + ")";
+			break;
+
+			case SqrtOp:
+			x    = csrc_v(arg[0]);
+			fexp = "sqrt(" + x + ")";
+			dx   = "0.5 / " + z;
+			break;
+
+			case TanOp:
+			x    = csrc_v(arg[0]);
+			fexp = "tan(" + x + ")";
+			dx   = "1.0 + " + z + " * " + z;
+			break;
+
+			case TanhOp:
+			x    = csrc_v(arg[0]);
+			fexp = "tanh(" + x + ")";
+			dx   = "1.0 - " + z + " * " + z;
+			break;
+
+# if CPPAD_USE_CPLUSPLUS_2011
+			case AcoshOp:
+			x    = csrc_v(arg[0]);
+			fexp = "acosh(" + x + ")";
+			dx   = "1.0 / sqrt(" + x + " * " + x + " - 1.0)";
+			break;
+
+			case AsinhOp:
+			x    = csrc_v(arg[0]);
+			fexp = "asinh(" + x + ")";
+			dx   = "1.0 / sqrt(" + x + " * " + x + " + 1.0)";
+			break;
+
+			case AtanhOp:
+			x    = csrc_v(arg[0]);
+			fexp = "atanh(" + x + ")";
+			dx   = "1.0 / (1.0 - " + x + " * " + x + ")";
+			break;
+
+			case ErfOp:
+			// arg[2] is the parameter 2 / sqrt(pi)
+			x    = csrc_v(arg[0]);
+			fexp = "erf(" + x + ")";
+			dx   = csrc_p(arg[2]) + " * exp(- " + x + " * " + x + ")";
+			break;
+
+			case Expm1Op:
+			x    = csrc_v(arg[0]);
+			fexp = "expm1(" + x + ")";
+			dx   = z + " + 1.0";
+			break;
+
+			case Log1pOp:
+			x    = csrc_v(arg[0]);
+			fexp = "log1p(" + x + ")";
+			dx   = "1.0 / (1.0 + " + x + ")";
+			break;
+# endif
+			// ------------------------------------------------------------
+			// binary operators
+			case AddvvOp:
+			x    = csrc_v(arg[0]);
+			y    = csrc_v(arg[1]);
+			fexp = x + " + " + y;
+			ros << csrc_pv(arg[0]) << " += " << pz << ";\n";
+			ros << csrc_pv(arg[1]) << " += " << pz << ";\n";
+			break;
+
+			case AddpvOp:
+			x    = csrc_p(arg[0]);
+			y    = csrc_v(arg[1]);
+			fexp = x + " + " + y;
+			ros << csrc_pv(arg[1]) << " += " << pz << ";\n";
+			break;
+
+			case SubvvOp:
+			x    = csrc_v(arg[0]);
+			y    = csrc_v(arg[1]);
+			fexp = x + " - " + y;
+			ros << csrc_pv(arg[0]) << " += " << pz << ";\n";
+			ros << csrc_pv(arg[1]) << " -= " << pz << ";\n";
+			break;
+
+			case SubpvOp:
+			x    = csrc_p(arg[0]);
+			y    = csrc_v(arg[1]);
+			fexp = x + " - " + y;
+			ros << csrc_pv(arg[1]) << " -= " << pz << ";\n";
+			break;
+
+			case SubvpOp:
+			x    = csrc_v(arg[0]);
+			y    = csrc_p(arg[1]);
+			fexp = x + " - " + y;
+			ros << csrc_pv(arg[0]) << " += " << pz << ";\n";
+			break;
+
+			case MulvvOp:
+			x    = csrc_v(arg[0]);
+			y    = csrc_v(arg[1]);
+			fexp = x + " * " + y;
+			ros << csrc_pv(arg[0]) << " += " << pz << " * " << y << ";\n";
+			ros << csrc_pv(arg[1]) << " += " << pz << " * " << x << ";\n";
+			break;
+
+			case MulpvOp:
+			x    = csrc_p(arg[0]);
+			y    = csrc_v(arg[1]);
+			fexp = x + " * " + y;
+			ros << csrc_pv(arg[1]) << " += " << pz << " * " << x << ";\n";
+			break;
+
+			case DivvvOp:
+			x    = csrc_v(arg[0]);
+			y    = csrc_v(arg[1]);
+			fexp = x + " / " + y;
+			ros << csrc_pv(arg[0]) << " += " << pz << " / " << y << ";\n";
+			ros << csrc_pv(arg[1]) << " -= "
+			    << pz << " * " << z << " / " << y << ";\n";
+			break;
+
+			case DivpvOp:
+			x    = csrc_p(arg[0]);
+			y    = csrc_v(arg[1]);
+			fexp = x + " / " + y;
+			ros << csrc_pv(arg[1]) << " -= "
+			    << pz << " * " << z << " / " << y << ";\n";
+			break;
+
+			case DivvpOp:
+			x    = csrc_v(arg[0]);
+			y    = csrc_p(arg[1]);
+			fexp = x + " / " + y;
+			ros << csrc_pv(arg[0]) << " += " << pz << " / " << y << ";\n";
+			break;
+
+			// z = exp( y * log(x) ) as in the reverse mode sweep
+			case PowvvOp:
+			x    = csrc_v(arg[0]);
+			y    = csrc_v(arg[1]);
+			fexp = "pow(" + x + ", " + y + ")";
+			ros << "{\tdouble cppad_pe = cppad_azmul("
+			    << pz << ", " << z << ");\n";
+			ros << "\t" << csrc_pv(arg[0]) << " += cppad_azmul("
+			    << "cppad_azmul(cppad_pe, " << y << "), 1.0 / " << x
+			    << ");\n";
+			ros << "\t" << csrc_pv(arg[1])
+			    << " += cppad_azmul(cppad_pe, log(" << x << "));\n";
+			ros << "}\n";
+			break;
+
+			case PowpvOp:
+			x    = csrc_p(arg[0]);
+			y    = csrc_v(arg[1]);
+			fexp = "pow(" + x + ", " + y + ")";
+			ros << csrc_pv(arg[1]) << " += cppad_azmul("
+			    << "cppad_azmul(" << pz << ", " << z << "), log(" << x
+			    << "));\n";
+			break;
+
+			case PowvpOp:
+			x    = csrc_v(arg[0]);
+			y    = csrc_p(arg[1]);
+			fexp = "pow(" + x + ", " + y + ")";
+			ros << csrc_pv(arg[0]) << " += cppad_azmul(cppad_azmul("
+			    << "cppad_azmul(" << pz << ", " << z << "), " << y
+			    << "), 1.0 / " << x << ");\n";
+			break;
+
+			case ZmulvvOp:
+			x    = csrc_v(arg[0]);
+			y    = csrc_v(arg[1]);
+			fexp = "cppad_azmul(" + x + ", " + y + ")";
+			ros << csrc_pv(arg[0])
+			    << " += cppad_azmul(" << pz << ", " << y << ");\n";
+			ros << csrc_pv(arg[1])
+			    << " += cppad_azmul(" << x << ", " << pz << ");\n";
+			break;
+
+			case ZmulpvOp:
+			x    = csrc_p(arg[0]);
+			y    = csrc_v(arg[1]);
+			fexp = "cppad_azmul(" + x + ", " + y + ")";
+			ros << csrc_pv(arg[1])
+			    << " += cppad_azmul(" << x << ", " << pz << ");\n";
+			break;
+
+			case ZmulvpOp:
+			x    = csrc_v(arg[0]);
+			y    = csrc_p(arg[1]);
+			fexp = "cppad_azmul(" + x + ", " + y + ")";
+			ros << csrc_pv(arg[0])
+			    << " += cppad_azmul(" << pz << ", " << y << ");\n";
+			break;
+			// ------------------------------------------------------------
+			// other operators
+			case ParOp:
+			fexp = csrc_p(arg[0]);
+			break;
+
+			case CExpOp:
+			{	std::string a[4];
+				for(size_t k = 0; k < 4; k++)
+				{	if( arg[1] & (1 << k) )
+						a[k] = csrc_v(arg[2 + k]);
+					else
+						a[k] = csrc_p(arg[2 + k]);
+				}
+				std::string cond = "(" + a[0] + " "
+					+ compare[ arg[0] ] + " " + a[1] + ")";
+				fexp = cond + " ? " + a[2] + " : " + a[3];
+				if( arg[1] & 4 )
+				{	ros << "if" << cond << " "
+					    << csrc_pv(arg[4]) << " += " << pz << ";\n";
+				}
+				if( arg[1] & 8 )
+				{	ros << "if( ! " << cond << " ) "
+					    << csrc_pv(arg[5]) << " += " << pz << ";\n";
+				}
+			}
+			break;
+
+			case CSumOp:
+			{	fos << z << " = " << csrc_p(arg[0]) << ";\n";
+				for(size_t i = 5; i < size_t(arg[1]); ++i)
+				{	fos << z << " += " << csrc_v(arg[i]) << ";\n";
+					ros << csrc_pv(arg[i]) << " += " << pz << ";\n";
+				}
+				for(size_t i = size_t(arg[1]); i < size_t(arg[2]); ++i)
+				{	fos << z << " -= " << csrc_v(arg[i]) << ";\n";
+					ros << csrc_pv(arg[i]) << " -= " << pz << ";\n";
+				}
+				for(size_t i = size_t(arg[2]); i < size_t(arg[3]); ++i)
+					fos << z << " += " << csrc_p(arg[i]) << ";\n";
+				for(size_t i = size_t(arg[3]); i < size_t(arg[4]); ++i)
+					fos << z << " -= " << csrc_p(arg[i]) << ";\n";
+				itr.correct_before_increment();
+			}
+			break;
+
+			case CProdOp:
+			{	size_t n_var = size_t(arg[1]) - 3;
+				fos << z << " = " << csrc_p(arg[0]) << ";\n";
+				for(size_t i = size_t(arg[1]); i < size_t(arg[2]); ++i)
+					fos << z << " *= " << csrc_p(arg[i]) << ";\n";
+				for(size_t i = 3; i < size_t(arg[1]); ++i)
+					fos << z << " *= " << csrc_v(arg[i]) << ";\n";
+				//
+				// cppad_lj = product of parameters and first j variables
+				ros << "{\tdouble cppad_l0 = " << csrc_p(arg[0]);
+				for(size_t i = size_t(arg[1]); i < size_t(arg[2]); ++i)
+					ros << " * " << csrc_p(arg[i]);
+				ros << ";\n";
+				for(size_t j = 1; j < n_var; ++j)
+				{	ros << "\tdouble cppad_l" << j << " = cppad_l" << j - 1
+					    << " * " << csrc_v(arg[3 + j - 1]) << ";\n";
+				}
+				// cppad_r = product of last n_var-j-1 variables times pz
+				ros << "\tdouble cppad_r = " << pz << ";\n";
+				size_t j = n_var;
+				while(j--)
+				{	ros << "\t" << csrc_pv(arg[3 + j])
+					    << " += cppad_r * cppad_l" << j << ";\n";
+					if( j > 0 )
+					{	ros << "\tcppad_r *= "
+						    << csrc_v(arg[3 + j]) << ";\n";
+					}
+				}
+				ros << "}\n";
+				itr.correct_before_increment();
+			}
+			break;
+			// ------------------------------------------------------------
+			default:
+			{	std::string msg = "csrc: the operator ";
+				msg += OpName(op);
+				msg += " is not supported";
+				return msg;
+			}
+		}
+		if( fexp != "" )
+			fos << z << " = " << fexp << ";\n";
+		if( dx != "" )
+			ros << csrc_pv(arg[0]) << " += " << pz << " * (" << dx << ");\n";
+		if( ros.str() != "" )
+		{	CPPAD_ASSERT_UNKNOWN( NumRes(op) > 0 );
+			reverse_src.push_back(
+				"if( " + pz + " != 0.0 )\n{\n" + ros.str() + "}\n"
+			);
+		}
+	}
+	//
+	// C source code
+	os << "/* C source code created by CppAD */\n";
+	os << "# include <math.h>\n";
+	os << "static double cppad_sign(double x)\n";
+	os << "{\tif( x > 0.0 ) return 1.0;\n";
+	os << "\tif( x < 0.0 ) return -1.0;\n";
+	os << "\treturn 0.0;\n";
+	os << "}\n";
+	os << "static double cppad_azmul(double x, double y)\n";
+	os << "{\tif( x == 0.0 ) return 0.0;\n";
+	os << "\treturn x * y;\n";
+	os << "}\n";
+	//
+	// cppad_jit_forward
+	os << "void cppad_jit_forward(\n";
+	os << "\tconst double* p, const double* x, double* y, double* v\n";
+	os << ")\n{\n";
+	for(size_t j = 0; j < n; j++)
+		os << csrc_v( ind_taddr[j] ) << " = x[" << j << "];\n";
+	os << fos.str();
+	for(size_t i = 0; i < m; i++)
+		os << "y[" << i << "] = " << csrc_v( dep_taddr[i] ) << ";\n";
+	os << "}\n";
+	//
+	// cppad_jit_reverse
+	os << "void cppad_jit_reverse(\n";
+	os << "\tconst double* p, const double* x, const double* w,\n";
+	os << "\tdouble* y, double* dw, double* v, double* pv\n";
+	os << ")\n{\tunsigned long i;\n";
+	os << "\tcppad_jit_forward(p, x, y, v);\n";
+	os << "\tfor(i = 0; i < " << numvar << "; i++)\n";
+	os << "\t\tpv[i] = 0.0;\n";
+	for(size_t i = 0; i < m; i++)
+		os << csrc_pv( dep_taddr[i] ) << " += w[" << i << "];\n";
+	size_t k = reverse_src.size();
+	while( k-- )
+		os << reverse_src[k];
+	for(size_t j = 0; j < n; j++)
+		os << "dw[" << j << "] = " << csrc_pv( ind_taddr[j] ) << ";\n";
+	os << "}\n";
+	//
+	return "";
+}
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
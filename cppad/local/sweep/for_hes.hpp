@@ -198,6 +198,7 @@ void for_hes(
 		include |= op == EndOp;
 		include |= op == CSkipOp;
 		include |= op == CSumOp;
+		include |= op == CProdOp;
 		include |= op == UserOp;
 		include |= op == UsrapOp;
 		include |= op == UsravOp;
@@ -272,6 +273,14 @@ void for_hes(
 			break;
 			// -------------------------------------------------
 
+			case CProdOp:
+			forward_sparse_hessian_cprod_op(
+				arg, for_jac_sparse, for_hes_sparse
+			);
+			itr.correct_before_increment();
+			break;
+			// -------------------------------------------------
+
 			case DivvvOp:
 			CPPAD_ASSERT_NARG_NRES(op, 2, 1)
 			forward_sparse_hessian_div_op(
@@ -270,6 +270,14 @@ void for_jac(
 			break;
 			// -------------------------------------------------
 
+			case CProdOp:
+			forward_sparse_jacobian_cprod_op(
+				i_var, arg, var_sparsity
+			);
+			itr.correct_before_increment();
+			break;
+			// -------------------------------------------------
+
 			case CExpOp:
 			forward_sparse_jacobian_cond_op(
 				dependency, i_var, arg, num_par, var_sparsity
@@ -225,6 +225,31 @@ void forward0(
 	<!-- end forward0sweep_code_define -->
 	*/
 
+# if ! CPPAD_FORWARD0_TRACE
+	// use the pre-decoded operator stream if it has been setup
+	// and this operation sequence is supported (see forward0_stream_setup)
+	const play::op_stream<Base>& op_stream( play->op_stream() );
+	if( op_stream.setup && op_stream.supported )
+	{	play::op_stream_info<Base> info;
+		info.num_par                 = num_par;
+		info.parameter               = parameter;
+		info.num_text                = num_text;
+		info.text                    = text;
+		info.J                       = J;
+		info.taylor                  = taylor;
+		info.cskip_op                = cskip_op;
+		info.s_out                   = &s_out;
+		info.print                   = print;
+		info.compare_change_count    = compare_change_count;
+		info.compare_change_number   = compare_change_number;
+		info.compare_change_op_index = compare_change_op_index;
+		forward0_stream(op_stream, info);
+		compare_change_number   = info.compare_change_number;
+		compare_change_op_index = info.compare_change_op_index;
+		return;
+	}
+# endif
+
 # if CPPAD_FORWARD0_TRACE
 	// flag as to when to trace user function values
 	bool user_trace            = false;
@@ -275,6 +300,7 @@ void forward0(
 
 				case CSkipOp:
 				case CSumOp:
+				case CProdOp:
 				itr.correct_before_increment();
 				break;
 
@@ -390,6 +416,14 @@ void forward0(
 			break;
 			// -------------------------------------------------
 
+			case CProdOp:
+			forward_cprod_op(
+				0, 0, i_var, arg, num_par, parameter, J, taylor
+			);
+			itr.correct_before_increment();
+			break;
+			// -------------------------------------------------
+
 			case DisOp:
 			forward_dis_op(p, q, r, i_var, arg, J, taylor);
 			break;
@@ -0,0 +1,518 @@
+# ifndef CPPAD_LOCAL_SWEEP_FORWARD0_STREAM_HPP
+# define CPPAD_LOCAL_SWEEP_FORWARD0_STREAM_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+// BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/forward0_stream.hpp
+Zero order forward mode using a pre-decoded operator stream.
+
+The operator stream is created once for each operation sequence.
+Each element contains a pointer to the function that computes its result,
+its operator index, its primary result, and its arguments.
+Hence a sweep does not need to decode the operators or switch on their
+type.
+*/
+
+/// handler for operators with one variable argument
+template <class Base, void (*kernel)(size_t, size_t, size_t, Base*)>
+void op_stream_unary(
+	const play::op_stream_op<Base>& op, play::op_stream_info<Base>& info
+)
+{	kernel(op.i_var, size_t(op.arg[0]), info.J, info.taylor); }
+
+/// handler for operators with two arguments and one primary result
+template <class Base,
+	void (*kernel)(size_t, const addr_t*, const Base*, size_t, Base*)
+>
+void op_stream_binary(
+	const play::op_stream_op<Base>& op, play::op_stream_info<Base>& info
+)
+{	kernel(op.i_var, op.arg, info.parameter, info.J, info.taylor); }
+
+/// handler for comparison operators with a variable argument
+template <class Base,
+	void (*kernel)(size_t&, const addr_t*, const Base*, size_t, Base*)
+>
+void op_stream_compare(
+	const play::op_stream_op<Base>& op, play::op_stream_info<Base>& info
+)
+{	if( info.compare_change_count == 0 )
+		return;
+	kernel(
+		info.compare_change_number, op.arg, info.parameter, info.J, info.taylor
+	);
+	if( info.compare_change_count == info.compare_change_number )
+		info.compare_change_op_index = op.op_index;
+}
+
+/// handler for comparison operators with two parameter arguments
+template <class Base,
+	void (*kernel)(size_t&, const addr_t*, const Base*)
+>
+void op_stream_compare_pp(
+	const play::op_stream_op<Base>& op, play::op_stream_info<Base>& info
+)
+{	if( info.compare_change_count == 0 )
+		return;
+	kernel(info.compare_change_number, op.arg, info.parameter);
+	if( info.compare_change_count == info.compare_change_number )
+		info.compare_change_op_index = op.op_index;
+}
+
+/// handler for CExpOp
+template <class Base>
+void op_stream_cexp(
+	const play::op_stream_op<Base>& op, play::op_stream_info<Base>& info
+)
+{	forward_cond_op_0(
+		op.i_var, op.arg, info.num_par, info.parameter, info.J, info.taylor
+	);
+}
+
+/// handler for CSkipOp
+template <class Base>
+void op_stream_cskip(
+	const play::op_stream_op<Base>& op, play::op_stream_info<Base>& info
+)
+{	forward_cskip_op_0(
+		op.i_var, op.arg, info.num_par, info.parameter,
+		info.J, info.taylor, info.cskip_op
+	);
+}
+
+/// handler for CSumOp
+template <class Base>
+void op_stream_csum(
+	const play::op_stream_op<Base>& op, play::op_stream_info<Base>& info
+)
+{	forward_csum_op(
+		0, 0, op.i_var, op.arg, info.num_par, info.parameter,
+		info.J, info.taylor
+	);
+}
+
+/// handler for CProdOp
+template <class Base>
+void op_stream_cprod(
+	const play::op_stream_op<Base>& op, play::op_stream_info<Base>& info
+)
+{	forward_cprod_op(
+		0, 0, op.i_var, op.arg, info.num_par, info.parameter,
+		info.J, info.taylor
+	);
+}
+
+/// handler for DisOp
+template <class Base>
+void op_stream_dis(
+	const play::op_stream_op<Base>& op, play::op_stream_info<Base>& info
+)
+{	forward_dis_op(0, 0, 1, op.i_var, op.arg, info.J, info.taylor); }
+
+/// handler for ParOp
+template <class Base>
+void op_stream_par(
+	const play::op_stream_op<Base>& op, play::op_stream_info<Base>& info
+)
+{	forward_par_op_0(
+		op.i_var, op.arg, info.num_par, info.parameter, info.J, info.taylor
+	);
+}
+
+/// handler for PriOp
+template <class Base>
+void op_stream_pri(
+	const play::op_stream_op<Base>& op, play::op_stream_info<Base>& info
+)
+{	if( info.print ) forward_pri_0(*info.s_out,
+		op.arg, info.num_text, info.text,
+		info.num_par, info.parameter, info.J, info.taylor
+	);
+}
+
+/*!
+Create the pre-decoded operator stream for an operation sequence
+(no work if it has already been created).
+
+\param play
+is the operation sequence. Upon return, play->op_stream() is
+the corresponding operator stream.
+*/
+template <class Base>
+void forward0_stream_setup(local::player<Base>* play)
+{	typedef play::op_stream_op<Base>   stream_op;
+	typedef play::op_stream_info<Base> stream_info;
+	play::op_stream<Base>& op_stream( play->op_stream() );
+	if( op_stream.setup )
+		return;
+	op_stream.setup     = true;
+	op_stream.supported = true;
+	op_stream.has_cskip = false;
+	//
+	// first pass: count the operators that need a handler
+	size_t num_op = play->num_op_rec();
+	size_t count  = 0;
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+	{	switch( play->GetOp(i_op) )
+		{	case BeginOp:
+			case EndOp:
+			case InvOp:
+			break;
+
+			case CSkipOp:
+			op_stream.has_cskip = true;
+			++count;
+			break;
+
+			case LdpOp:
+			case LdvOp:
+			case StppOp:
+			case StpvOp:
+			case StvpOp:
+			case StvvOp:
+			case UserOp:
+			case UsrapOp:
+			case UsravOp:
+			case UsrrpOp:
+			case UsrrvOp:
+			op_stream.supported = false;
+			break;
+
+			default:
+			++count;
+			break;
+		}
+	}
+	if( ! op_stream.supported )
+		return;
+	pod_vector_maybe<stream_op>& stream( op_stream.op_vec );
+	stream.extend(count);
+	//
+	// second pass: set the stream
+	play::const_sequential_iterator itr = play->begin();
+	OpCode        op;
+	size_t        i_var;
+	const addr_t* arg;
+	itr.op_info(op, arg, i_var);
+	CPPAD_ASSERT_UNKNOWN( op == BeginOp );
+	size_t index = 0;
+	bool more_operators = true;
+	while(more_operators)
+	{	(++itr).op_info(op, arg, i_var);
+		void (*handler)(const stream_op&, stream_info&);
+		handler = CPPAD_NULL;
+		switch( op )
+		{	// --------------------------------------------------------------
+			// unary operators
+			case AbsOp:
+			handler = op_stream_unary<Base, forward_abs_op_0<Base> >;
+			break;
+
+			case AcosOp:
+			handler = op_stream_unary<Base, forward_acos_op_0<Base> >;
+			break;
+
+			case AsinOp:
+			handler = op_stream_unary<Base, forward_asin_op_0<Base> >;
+			break;
+
+			case AtanOp:
+			handler = op_stream_unary<Base, forward_atan_op_0<Base> >;
+			break;
+
+			case CosOp:
+			handler = op_stream_unary<Base, forward_cos_op_0<Base> >;
+			break;
+
+			case CoshOp:
+			handler = op_stream_unary<Base, forward_cosh_op_0<Base> >;
+			break;
+
+			case ExpOp:
+			handler = op_stream_unary<Base, forward_exp_op_0<Base> >;
+			break;
+
+			case LogOp:
+			handler = op_stream_unary<Base, forward_log_op_0<Base> >;
+			break;
+
+			case SignOp:
+			handler = op_stream_unary<Base, forward_sign_op_0<Base> >;
+			break;
+
+			case SinOp:
+			handler = op_stream_unary<Base, forward_sin_op_0<Base> >;
+			break;
+
+			case SinhOp:
+			handler = op_stream_unary<Base, forward_sinh_op_0<Base> >;
+			break;
+
+			case SqrtOp:
+			handler = op_stream_unary<Base, forward_sqrt_op_0<Base> >;
+			break;
+
+			case TanOp:
+			handler = op_stream_unary<Base, forward_tan_op_0<Base> >;
+			break;
+
+			case TanhOp:
+			handler = op_stream_unary<Base, forward_tanh_op_0<Base> >;
+			break;
+
+# if CPPAD_USE_CPLUSPLUS_2011
+			case AcoshOp:
+			handler = op_stream_unary<Base, forward_acosh_op_0<Base> >;
+			break;
+
+			case AsinhOp:
+			handler = op_stream_unary<Base, forward_asinh_op_0<Base> >;
+			break;
+
+			case AtanhOp:
+			handler = op_stream_unary<Base, forward_atanh_op_0<Base> >;
+			break;
+
+			case Expm1Op:
+			handler = op_stream_unary<Base, forward_expm1_op_0<Base> >;
+			break;
+
+			case Log1pOp:
+			handler = op_stream_unary<Base, forward_log1p_op_0<Base> >;
+			break;
+
+			case ErfOp:
+			handler = op_stream_binary<Base, forward_erf_op_0<Base> >;
+			break;
+# endif
+			// --------------------------------------------------------------
+			// binary operators
+			case AddvvOp:
+			handler = op_stream_binary<Base, forward_addvv_op_0<Base> >;
+			break;
+
+			case AddpvOp:
+			handler = op_stream_binary<Base, forward_addpv_op_0<Base> >;
+			break;
+
+			case DivvvOp:
+			handler = op_stream_binary<Base, forward_divvv_op_0<Base> >;
+			break;
+
+			case DivpvOp:
+			handler = op_stream_binary<Base, forward_divpv_op_0<Base> >;
+			break;
+
+			case DivvpOp:
+			handler = op_stream_binary<Base, forward_divvp_op_0<Base> >;
+			break;
+
+			case MulvvOp:
+			handler = op_stream_binary<Base, forward_mulvv_op_0<Base> >;
+			break;
+
+			case MulpvOp:
+			handler = op_stream_binary<Base, forward_mulpv_op_0<Base> >;
+			break;
+
+			case PowvvOp:
+			handler = op_stream_binary<Base, forward_powvv_op_0<Base> >;
+			break;
+
+			case PowpvOp:
+			handler = op_stream_binary<Base, forward_powpv_op_0<Base> >;
+			break;
+
+			case PowvpOp:
+			handler = op_stream_binary<Base, forward_powvp_op_0<Base> >;
+			break;
+
+			case SubvvOp:
+			handler = op_stream_binary<Base, forward_subvv_op_0<Base> >;
+			break;
+
+			case SubpvOp:
+			handler = op_stream_binary<Base, forward_subpv_op_0<Base> >;
+			break;
+
+			case SubvpOp:
+			handler = op_stream_binary<Base, forward_subvp_op_0<Base> >;
+			break;
+
+			case ZmulvvOp:
+			handler = op_stream_binary<Base, forward_zmulvv_op_0<Base> >;
+			break;
+
+			case ZmulpvOp:
+			handler = op_stream_binary<Base, forward_zmulpv_op_0<Base> >;
+			break;
+
+			case ZmulvpOp:
+			handler = op_stream_binary<Base, forward_zmulvp_op_0<Base> >;
+			break;
+			// --------------------------------------------------------------
+			// comparison operators
+			case EqppOp:
+			handler = op_stream_compare_pp<Base, forward_eqpp_op_0<Base> >;
+			break;
+
+			case EqpvOp:
+			handler = op_stream_compare<Base, forward_eqpv_op_0<Base> >;
+			break;
+
+			case EqvvOp:
+			handler = op_stream_compare<Base, forward_eqvv_op_0<Base> >;
+			break;
+
+			case LeppOp:
+			handler = op_stream_compare_pp<Base, forward_lepp_op_0<Base> >;
+			break;
+
+			case LepvOp:
+			handler = op_stream_compare<Base, forward_lepv_op_0<Base> >;
+			break;
+
+			case LevpOp:
+			handler = op_stream_compare<Base, forward_levp_op_0<Base> >;
+			break;
+
+			case LevvOp:
+			handler = op_stream_compare<Base, forward_levv_op_0<Base> >;
+			break;
+
+			case LtppOp:
+			handler = op_stream_compare_pp<Base, forward_ltpp_op_0<Base> >;
+			break;
+
+			case LtpvOp:
+			handler = op_stream_compare<Base, forward_ltpv_op_0<Base> >;
+			break;
+
+			case LtvpOp:
+			handler = op_stream_compare<Base, forward_ltvp_op_0<Base> >;
+			break;
+
+			case LtvvOp:
+			handler = op_stream_compare<Base, forward_ltvv_op_0<Base> >;
+			break;
+
+			case NeppOp:
+			handler = op_stream_compare_pp<Base, forward_nepp_op_0<Base> >;
+			break;
+
+			case NepvOp:
+			handler = op_stream_compare<Base, forward_nepv_op_0<Base> >;
+			break;
+
+			case NevvOp:
+			handler = op_stream_compare<Base, forward_nevv_op_0<Base> >;
+			break;
+			// --------------------------------------------------------------
+			// other operators
+			case CExpOp:
+			handler = op_stream_cexp<Base>;
+			break;
+
+			case CSkipOp:
+			handler = op_stream_cskip<Base>;
+			itr.correct_before_increment();
+			break;
+
+			case CSumOp:
+			handler = op_stream_csum<Base>;
+			itr.correct_before_increment();
+			break;
+
+			case CProdOp:
+			handler = op_stream_cprod<Base>;
+			itr.correct_before_increment();
+			break;
+
+			case DisOp:
+			handler = op_stream_dis<Base>;
+			break;
+
+			case ParOp:
+			handler = op_stream_par<Base>;
+			break;
+
+			case PriOp:
+			handler = op_stream_pri<Base>;
+			break;
+			// --------------------------------------------------------------
+			// operators that do not need a handler
+			case InvOp:
+			break;
+
+			case EndOp:
+			more_operators = false;
+			break;
+			// --------------------------------------------------------------
+			default:
+			CPPAD_ASSERT_UNKNOWN(false);
+		}
+		if( handler != CPPAD_NULL )
+		{	stream[index].handler  = handler;
+			stream[index].op_index = itr.op_index();
+			stream[index].i_var    = i_var;
+			stream[index].arg      = arg;
+			++index;
+		}
+	}
+	CPPAD_ASSERT_UNKNOWN( index == count );
+}
+
+/*!
+Compute zero order forward mode Taylor coefficients using an operator stream.
+
+\param op_stream
+is the pre-decoded operator stream for the operation sequence;
+see forward0_stream_setup. It must be setup and supported.
+
+\param info
+contains the information that is the same for every operator;
+i.e., the parameters, the Taylor coefficients, and the conditional skip
+flags (which must be initialized as false).
+Upon return, the Taylor coefficients, conditional skip flags,
+and compare change information have been set
+(see the corresponding arguments to forward0).
+*/
+template <class Base>
+void forward0_stream(
+	const play::op_stream<Base>& op_stream ,
+	play::op_stream_info<Base>&  info      )
+{	CPPAD_ASSERT_UNKNOWN( op_stream.setup && op_stream.supported );
+	const play::op_stream_op<Base>* op  = op_stream.op_vec.data();
+	const play::op_stream_op<Base>* end = op + op_stream.op_vec.size();
+	if( op_stream.has_cskip )
+	{	const bool* cskip_op = info.cskip_op;
+		while( op != end )
+		{	if( ! cskip_op[op->op_index] )
+				op->handler(*op, info);
+			++op;
+		}
+	}
+	else
+	{	// no operators are conditionally skipped
+		while( op != end )
+		{	op->handler(*op, info);
+			++op;
+		}
+	}
+}
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
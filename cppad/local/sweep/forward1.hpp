@@ -324,6 +324,7 @@ void forward1(
 
 				case CSkipOp:
 				case CSumOp:
+				case CProdOp:
 				itr.correct_before_increment();
 				break;
 
@@ -439,6 +440,14 @@ void forward1(
 			break;
 			// -------------------------------------------------
 
+			case CProdOp:
+			forward_cprod_op(
+				p, q, i_var, arg, num_par, parameter, J, taylor
+			);
+			itr.correct_before_increment();
+			break;
+			// -------------------------------------------------
+
 			case DisOp:
 			forward_dis_op(p, q, r, i_var, arg, J, taylor);
 			break;
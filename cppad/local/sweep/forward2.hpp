@@ -230,6 +230,7 @@ void forward2(
 
 				case CSkipOp:
 				case CSumOp:
+				case CProdOp:
 				itr.correct_before_increment();
 				break;
 
@@ -342,6 +343,14 @@ void forward2(
 			break;
 			// -------------------------------------------------
 
+			case CProdOp:
+			forward_cprod_op_dir(
+				q, r, i_var, arg, num_par, parameter, J, taylor
+			);
+			itr.correct_before_increment();
+			break;
+			// -------------------------------------------------
+
 			case DisOp:
 			forward_dis_op(p, q, r, i_var, arg, J, taylor);
 			break;
@@ -0,0 +1,441 @@
+# ifndef CPPAD_LOCAL_SWEEP_FORWARD_BATCH_HPP
+# define CPPAD_LOCAL_SWEEP_FORWARD_BATCH_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+// BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/forward_batch.hpp
+Compute zero order forward mode Taylor coefficients for a batch of points.
+*/
+
+/*!
+Compute zero order forward mode Taylor coefficients for K points
+using one pass through the operation sequence.
+
+The Taylor coefficients are stored using a structure of arrays layout;
+i.e., the value of variable i for point ell is taylor[ K * i + ell ].
+This is the same as the layout used by the zero order operator kernels
+with cap_order equal to K. Hence each kernel is called with
+taylor + ell, for ell = 0, ..., K-1, in a loop that the compiler can
+vectorize.
+
+\tparam Base
+The type used during the forward mode computations; i.e., the corresponding
+recording of operations used the type AD<Base>.
+
+\param play
+The information stored in play
+is a recording of the operations corresponding to a function
+\f[
+	F : {\bf R}^n \rightarrow {\bf R}^m
+\f]
+where \f$ n \f$ is the number of independent variables and
+\f$ m \f$ is the number of dependent variables.
+
+\param n
+is the number of independent variables on the tape.
+
+\param numvar
+is the total number of variables on the tape.
+This is also equal to the number of rows in the matrix taylor; i.e.,
+play->num_var_rec().
+
+\param K
+is the number of points in the batch; i.e., the number of columns
+in the matrix taylor.
+
+\param taylor
+\n
+\b Input:
+For i = 1 , ... , n and ell = 0 , ... , K-1,
+taylor [ K * i + ell ]
+is the value of the i-th independent variable at point ell.
+\n
+\n
+\b Output:
+For i = n + 1, ... , numvar - 1 and ell = 0 , ... , K-1,
+taylor [ K * i + ell ]
+is the value of the i-th variable at point ell.
+
+\return
+is false if the recording contains an operation that is not supported
+by this routine (VecAD load and store operations and atomic function
+calls). In this case the contents of taylor are not specified.
+
+\par Restrictions
+Conditional skip operations are not used because the result of the
+comparison may be different for each point. Comparison operations are
+not counted and print operations do not generate output.
+*/
+
+template <class Base>
+bool forward_batch(
+	const local::player<Base>* play,
+	size_t                     n,
+	size_t                     numvar,
+	size_t                     K,
+	Base*                      taylor
+)
+{	CPPAD_ASSERT_UNKNOWN( K >= 1 );
+	CPPAD_ASSERT_UNKNOWN( play->num_var_rec() == numvar );
+
+	// length of the parameter vector (used by CppAD assert macros)
+	const size_t num_par = play->num_par_rec();
+
+	// pointer to the beginning of the parameter vector
+	const Base* parameter = CPPAD_NULL;
+	if( num_par > 0 )
+		parameter = play->GetPar();
+
+	// skip the BeginOp at the beginning of the recording
+	play::const_sequential_iterator itr = play->begin();
+	// op_info
+	OpCode op;
+	size_t i_var;
+	const addr_t* arg;
+	itr.op_info(op, arg, i_var);
+	CPPAD_ASSERT_UNKNOWN( op == BeginOp );
+	//
+	size_t ell; // index of a point in the batch
+	bool more_operators = true;
+	while(more_operators)
+	{
+		// next op
+		(++itr).op_info(op, arg, i_var);
+		CPPAD_ASSERT_UNKNOWN( itr.op_index() < play->num_op_rec() );
+		CPPAD_ASSERT_UNKNOWN( i_var < numvar || NumRes(op) == 0 );
+
+		// action to take depends on the case
+		switch( op )
+		{
+			case AbsOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_abs_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case AcosOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_acos_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+# if CPPAD_USE_CPLUSPLUS_2011
+			case AcoshOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_acosh_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+# endif
+			// -------------------------------------------------
+
+			case AddpvOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_addpv_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case AddvvOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_addvv_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case AsinOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_asin_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+# if CPPAD_USE_CPLUSPLUS_2011
+			case AsinhOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_asinh_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+# endif
+			// -------------------------------------------------
+
+			case AtanOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_atan_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+# if CPPAD_USE_CPLUSPLUS_2011
+			case AtanhOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_atanh_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+# endif
+			// -------------------------------------------------
+
+			case CExpOp:
+			for(ell = 0; ell < K; ++ell) forward_cond_op_0(
+				i_var, arg, num_par, parameter, K, taylor + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case CosOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_cos_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case CoshOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_cosh_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case CSumOp:
+			for(ell = 0; ell < K; ++ell) forward_csum_op(
+				0, 0, i_var, arg, num_par, parameter, K, taylor + ell
+			);
+			itr.correct_before_increment();
+			break;
+			// -------------------------------------------------
+
+			case CProdOp:
+			for(ell = 0; ell < K; ++ell) forward_cprod_op(
+				0, 0, i_var, arg, num_par, parameter, K, taylor + ell
+			);
+			itr.correct_before_increment();
+			break;
+			// -------------------------------------------------
+
+			case DisOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_dis_op(0, 0, 1, i_var, arg, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case DivpvOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_divpv_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case DivvpOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_divvp_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case DivvvOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_divvv_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+# if CPPAD_USE_CPLUSPLUS_2011
+			case ErfOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_erf_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+# endif
+			// -------------------------------------------------
+
+			case ExpOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_exp_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+# if CPPAD_USE_CPLUSPLUS_2011
+			case Expm1Op:
+			for(ell = 0; ell < K; ++ell)
+				forward_expm1_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+# endif
+			// -------------------------------------------------
+
+			case LogOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_log_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+# if CPPAD_USE_CPLUSPLUS_2011
+			case Log1pOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_log1p_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+# endif
+			// -------------------------------------------------
+
+			case MulpvOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_mulpv_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case MulvvOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_mulvv_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case ParOp:
+			for(ell = 0; ell < K; ++ell) forward_par_op_0(
+				i_var, arg, num_par, parameter, K, taylor + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case PowpvOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_powpv_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case PowvpOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_powvp_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case PowvvOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_powvv_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case SignOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_sign_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case SinOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_sin_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case SinhOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_sinh_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case SqrtOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_sqrt_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case SubpvOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_subpv_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case SubvpOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_subvp_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case SubvvOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_subvv_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case TanOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_tan_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case TanhOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_tanh_op_0(i_var, arg[0], K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case ZmulpvOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_zmulpv_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case ZmulvpOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_zmulvp_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case ZmulvvOp:
+			for(ell = 0; ell < K; ++ell)
+				forward_zmulvv_op_0(i_var, arg, parameter, K, taylor + ell);
+			break;
+			// -------------------------------------------------
+
+			case CSkipOp:
+			// do not skip operations; see Restrictions above
+			itr.correct_before_increment();
+			break;
+			// -------------------------------------------------
+
+			case EndOp:
+			CPPAD_ASSERT_NARG_NRES(op, 0, 0);
+			more_operators = false;
+			break;
+			// -------------------------------------------------
+
+			case InvOp:
+			CPPAD_ASSERT_NARG_NRES(op, 0, 1);
+			break;
+			// -------------------------------------------------
+
+			case EqppOp:
+			case EqpvOp:
+			case EqvvOp:
+			case LeppOp:
+			case LepvOp:
+			case LevpOp:
+			case LevvOp:
+			case LtppOp:
+			case LtpvOp:
+			case LtvpOp:
+			case LtvvOp:
+			case NeppOp:
+			case NepvOp:
+			case NevvOp:
+			case PriOp:
+			// comparisons are not counted and nothing is printed
+			break;
+			// -------------------------------------------------
+
+			case LdpOp:
+			case LdvOp:
+			case StppOp:
+			case StpvOp:
+			case StvpOp:
+			case StvvOp:
+			case UserOp:
+			// VecAD vectors and atomic functions are not supported
+			return false;
+			// -------------------------------------------------
+
+			default:
+			CPPAD_ASSERT_UNKNOWN(false);
+		}
+	}
+	return true;
+}
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
@@ -0,0 +1,802 @@
+# ifndef CPPAD_LOCAL_SWEEP_FORWARD_LEVEL_HPP
+# define CPPAD_LOCAL_SWEEP_FORWARD_LEVEL_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/local/team_run.hpp>
+
+// BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/forward_level.hpp
+Zero and first order forward mode using a level schedule and a team of threads.
+
+The operators in each level of the schedule do not depend on each other.
+Wide levels are split between the threads in the team.
+Narrow levels are run by the first thread in the team.
+There is a barrier between each group of levels.
+*/
+
+/// a level is run in parallel if it has at least this many operators
+/// per thread
+static const size_t level_min_width = 64;
+
+/// the level schedule is only used if the number of operators
+/// in the parallel levels is at least this value per thread
+static const size_t level_min_work  = 4096;
+
+/// the levels are computed separately for each window of this many
+/// consecutive operators so that the variables used by a level are
+/// likely to be in cache
+static const size_t level_window    = 1 << 14;
+
+/*!
+Create the level schedule for an operation sequence
+(no work if it has already been created).
+
+\param play
+is the operation sequence. Upon return, play->level_schedule() is
+the corresponding level schedule.
+*/
+template <class Base>
+void level_schedule_setup(local::player<Base>* play)
+{	typedef play::level_op level_op;
+	play::level_schedule& schedule( play->level_schedule() );
+	if( schedule.setup )
+		return;
+	schedule.setup     = true;
+	schedule.supported = true;
+	//
+	// check for operators that are not supported
+	size_t num_op = play->num_op_rec();
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+	{	switch( play->GetOp(i_op) )
+		{	case DisOp:
+			case LdpOp:
+			case LdvOp:
+			case StppOp:
+			case StpvOp:
+			case StvpOp:
+			case StvvOp:
+			case UserOp:
+			case UsrapOp:
+			case UsravOp:
+			case UsrrpOp:
+			case UsrrvOp:
+			schedule.supported = false;
+			break;
+
+			default:
+			break;
+		}
+	}
+	if( ! schedule.supported )
+		return;
+	//
+	// window and level (within the window) for each primary variable
+	// and each operator with a result
+	pod_vector<size_t>         var_window( play->num_var_rec() );
+	pod_vector<size_t>         var_level( play->num_var_rec() );
+	pod_vector<size_t>         op_level;
+	pod_vector<size_t>         window_num_level;
+	pod_vector_maybe<level_op> level_vec;
+	pod_vector<bool>           is_variable;
+	//
+	// variables that are not results of a level operator (e.g. InvOp)
+	// are not in any window
+	size_t no_window = std::numeric_limits<size_t>::max();
+	for(size_t j_var = 0; j_var < var_window.size(); ++j_var)
+	{	var_window[j_var] = no_window;
+		var_level[j_var]  = 0;
+	}
+	//
+	play::const_sequential_iterator itr = play->begin();
+	OpCode        op;
+	size_t        i_var;
+	const addr_t* arg;
+	itr.op_info(op, arg, i_var);
+	CPPAD_ASSERT_UNKNOWN( op == BeginOp );
+	var_level[i_var] = 0;
+	bool more_operators = true;
+	while(more_operators)
+	{	(++itr).op_info(op, arg, i_var);
+		level_op info;
+		info.op       = op;
+		info.op_index = itr.op_index();
+		info.i_var    = i_var;
+		info.arg      = arg;
+		switch( op )
+		{	case EndOp:
+			more_operators = false;
+			break;
+
+			case InvOp:
+			var_level[i_var] = 0;
+			break;
+
+			// conditional skipping is not used by the level sweeps
+			case CSkipOp:
+			itr.correct_before_increment();
+			break;
+
+			// operators that are run in order after the level sweep
+			case EqppOp:
+			case EqpvOp:
+			case EqvvOp:
+			case LeppOp:
+			case LepvOp:
+			case LevpOp:
+			case LevvOp:
+			case LtppOp:
+			case LtpvOp:
+			case LtvpOp:
+			case LtvvOp:
+			case NeppOp:
+			case NepvOp:
+			case NevvOp:
+			case PriOp:
+			schedule.serial_vec.push_back(info);
+			break;
+
+			default:
+			{	CPPAD_ASSERT_UNKNOWN( NumRes(op) > 0 );
+				arg_is_variable(op, arg, is_variable);
+				if( op == CSumOp || op == CProdOp )
+					itr.correct_before_increment();
+				if( op == CProdOp )
+				{	schedule.max_cprod = std::max(
+						schedule.max_cprod, size_t(arg[1]) - 3
+					);
+				}
+				size_t window = level_vec.size() / level_window;
+				if( window == window_num_level.size() )
+					window_num_level.push_back(0);
+				size_t level = 1;
+				for(size_t j = 0; j < is_variable.size(); ++j)
+				{	size_t j_var = size_t( arg[j] );
+					bool   same  = is_variable[j];
+					if( same )
+						same = var_window[j_var] == window;
+					if( same )
+						level = std::max(level, var_level[j_var] + 1);
+				}
+				var_window[i_var]        = window;
+				var_level[i_var]         = level;
+				window_num_level[window] =
+					std::max(window_num_level[window], level);
+				op_level.push_back(level);
+				level_vec.push_back(info);
+			}
+			break;
+		}
+	}
+	//
+	// convert the level within each window to a schedule level
+	size_t num_level = 0;
+	for(size_t k = 0; k < level_vec.size(); ++k)
+	{	size_t window = k / level_window;
+		if( k % level_window == 0 && window > 0 )
+			num_level += window_num_level[window - 1];
+		op_level[k] = num_level + op_level[k] - 1;
+	}
+	if( window_num_level.size() > 0 )
+		num_level += window_num_level[ window_num_level.size() - 1 ];
+	//
+	// sort the operators by level (stable so within a level they are in
+	// operation sequence order)
+	pod_vector<size_t>& level_begin( schedule.level_begin );
+	level_begin.extend(num_level + 1);
+	for(size_t ell = 0; ell <= num_level; ++ell)
+		level_begin[ell] = 0;
+	for(size_t k = 0; k < op_level.size(); ++k)
+		++level_begin[ op_level[k] + 1 ];
+	for(size_t ell = 0; ell < num_level; ++ell)
+		level_begin[ell + 1] += level_begin[ell];
+	pod_vector<size_t> next( num_level );
+	for(size_t ell = 0; ell < num_level; ++ell)
+		next[ell] = level_begin[ell];
+	schedule.op_vec.extend( level_vec.size() );
+	for(size_t k = 0; k < level_vec.size(); ++k)
+		schedule.op_vec[ next[ op_level[k] ]++ ] = level_vec[k];
+	CPPAD_ASSERT_UNKNOWN( level_begin[num_level] == level_vec.size() );
+}
+
+/*!
+Group the levels in a level schedule into segments and determine
+if the schedule should be used.
+
+\param schedule
+is the level schedule for the operation sequence.
+
+\param num_threads
+is the number of threads in the team.
+
+\param segment
+The input size and elements do not matter.
+Upon return, the s-th segment of operators is
+schedule.op_vec[ segment[s] ], ... , schedule.op_vec[ segment[s+1] - 1 ].
+Each segment is either one wide level or consecutive narrow levels.
+
+\param parallel
+The input size and elements do not matter.
+Upon return, its size is the number of segments and
+parallel[s] is true (false) if the s-th segment is a wide level
+(consecutive narrow levels).
+
+\return
+is true if the number of operators in the wide levels is large enough
+to use the team of threads.
+*/
+inline bool level_segment(
+	const play::level_schedule& schedule    ,
+	size_t                      num_threads ,
+	pod_vector<size_t>&         segment     ,
+	pod_vector<bool>&           parallel    )
+{	const pod_vector<size_t>& level_begin( schedule.level_begin );
+	size_t num_level = level_begin.size() - 1;
+	segment.resize(0);
+	parallel.resize(0);
+	size_t parallel_work = 0;
+	segment.push_back(0);
+	for(size_t ell = 0; ell < num_level; ++ell)
+	{	size_t width = level_begin[ell + 1] - level_begin[ell];
+		bool   wide  = width >= level_min_width * num_threads;
+		if( wide )
+			parallel_work += width;
+		bool merge = parallel.size() > 0;
+		if( merge )
+			merge = (! wide) & (! parallel[ parallel.size() - 1 ] );
+		if( merge )
+			segment[ segment.size() - 1 ] = level_begin[ell + 1];
+		else
+		{	segment.push_back( level_begin[ell + 1] );
+			parallel.push_back( wide );
+		}
+	}
+	return parallel_work >= level_min_work * num_threads;
+}
+
+/*!
+Compute zero or first order Taylor coefficients for one operator.
+
+\param q
+is the order of the Taylor coefficient being computed (zero or one).
+The Taylor coefficients of order less than q have already been computed
+for all the variables.
+
+\param info
+is the operator.
+
+\param num_par
+is the number of parameters in the operation sequence.
+
+\param parameter
+is the parameter vector for the operation sequence.
+
+\param J
+is the number of columns in the Taylor coefficient matrix.
+
+\param taylor
+is the Taylor coefficient matrix. The order q coefficient for the
+results of this operator are set.
+*/
+template <class Base>
+void forward_level_op(
+	size_t                 q         ,
+	const play::level_op&  info      ,
+	size_t                 num_par   ,
+	const Base*            parameter ,
+	size_t                 J         ,
+	Base*                  taylor    )
+{	size_t p             = q;
+	size_t i_var         = info.i_var;
+	const addr_t* arg    = info.arg;
+	switch( info.op )
+	{
+		case AbsOp:
+		forward_abs_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case AcosOp:
+		forward_acos_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case AddpvOp:
+		forward_addpv_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case AddvvOp:
+		forward_addvv_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case AsinOp:
+		forward_asin_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case AtanOp:
+		forward_atan_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case CExpOp:
+		forward_cond_op(p, q, i_var, arg, num_par, parameter, J, taylor);
+		break;
+
+		case CosOp:
+		forward_cos_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case CoshOp:
+		forward_cosh_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case CSumOp:
+		forward_csum_op(p, q, i_var, arg, num_par, parameter, J, taylor);
+		break;
+
+		case CProdOp:
+		forward_cprod_op(p, q, i_var, arg, num_par, parameter, J, taylor);
+		break;
+
+		case DivpvOp:
+		forward_divpv_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case DivvpOp:
+		forward_divvp_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case DivvvOp:
+		forward_divvv_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case ExpOp:
+		forward_exp_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case LogOp:
+		forward_log_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case MulpvOp:
+		forward_mulpv_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case MulvvOp:
+		forward_mulvv_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case ParOp:
+		if( q == 0 )
+			forward_par_op_0(i_var, arg, num_par, parameter, J, taylor);
+		else
+			taylor[ i_var * J + q ] = Base(0.0);
+		break;
+
+		case PowpvOp:
+		forward_powpv_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case PowvpOp:
+		forward_powvp_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case PowvvOp:
+		forward_powvv_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case SignOp:
+		forward_sign_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case SinOp:
+		forward_sin_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case SinhOp:
+		forward_sinh_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case SqrtOp:
+		forward_sqrt_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case SubpvOp:
+		forward_subpv_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case SubvpOp:
+		forward_subvp_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case SubvvOp:
+		forward_subvv_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case TanOp:
+		forward_tan_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case TanhOp:
+		forward_tanh_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case ZmulpvOp:
+		forward_zmulpv_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case ZmulvpOp:
+		forward_zmulvp_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case ZmulvvOp:
+		forward_zmulvv_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+# if CPPAD_USE_CPLUSPLUS_2011
+		case AcoshOp:
+		forward_acosh_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case AsinhOp:
+		forward_asinh_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case AtanhOp:
+		forward_atanh_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case ErfOp:
+		forward_erf_op(p, q, i_var, arg, parameter, J, taylor);
+		break;
+
+		case Expm1Op:
+		forward_expm1_op(p, q, i_var, arg[0], J, taylor);
+		break;
+
+		case Log1pOp:
+		forward_log1p_op(p, q, i_var, arg[0], J, taylor);
+		break;
+# endif
+
+		default:
+		CPPAD_ASSERT_UNKNOWN(false);
+		break;
+	}
+}
+
+# if CPPAD_USE_CPLUSPLUS_2011
+/// the work done by each thread in the team during a forward level sweep
+template <class Base>
+class forward_level_work {
+private:
+	const play::level_schedule& schedule_;
+	const pod_vector<size_t>&   segment_;
+	const pod_vector<bool>&     parallel_;
+	const size_t                num_threads_;
+	const size_t                q_;
+	const size_t                num_par_;
+	const Base*                 parameter_;
+	const size_t                J_;
+	Base*                       taylor_;
+	team_barrier                barrier_;
+public:
+	/*!
+	constructor
+
+	\param schedule
+	is the level schedule for the operation sequence.
+
+	\param segment
+	The s-th segment of operators is
+	schedule.op_vec[ segment[s] ], ... , schedule.op_vec[ segment[s+1] - 1 ].
+
+	\param parallel
+	is parallel[s] true (false) if the s-th segment is split between
+	the threads (run by thread zero).
+
+	\param num_threads
+	is the number of threads in the team.
+
+	\param q
+	is the order of the Taylor coefficients being computed.
+
+	\param num_par
+	is the number of parameters in the operation sequence.
+
+	\param parameter
+	is the parameter vector for the operation sequence.
+
+	\param J
+	is the number of columns in the Taylor coefficient matrix.
+
+	\param taylor
+	is the Taylor coefficient matrix.
+	*/
+	forward_level_work(
+		const play::level_schedule& schedule    ,
+		const pod_vector<size_t>&   segment     ,
+		const pod_vector<bool>&     parallel    ,
+		size_t                      num_threads ,
+		size_t                      q           ,
+		size_t                      num_par     ,
+		const Base*                 parameter   ,
+		size_t                      J           ,
+		Base*                       taylor      )
+	: schedule_(schedule)
+	, segment_(segment)
+	, parallel_(parallel)
+	, num_threads_(num_threads)
+	, q_(q)
+	, num_par_(num_par)
+	, parameter_(parameter)
+	, J_(J)
+	, taylor_(taylor)
+	, barrier_(num_threads)
+	{ }
+	/// the work for one thread in the team
+	void operator()(size_t thread)
+	{	size_t num_segment = parallel_.size();
+		for(size_t s = 0; s < num_segment; ++s)
+		{	size_t begin = segment_[s];
+			size_t end   = segment_[s + 1];
+			if( parallel_[s] )
+			{	size_t width = end - begin;
+				end    = begin + (width * (thread + 1)) / num_threads_;
+				begin  = begin + (width * thread) / num_threads_;
+			}
+			else if( thread != 0 )
+				end = begin;
+			for(size_t k = begin; k < end; ++k) forward_level_op(
+				q_, schedule_.op_vec[k], num_par_, parameter_, J_, taylor_
+			);
+			if( s + 1 < num_segment )
+				barrier_.wait();
+		}
+	}
+};
+# endif
+
+/*!
+Compute zero or first order forward mode Taylor coefficients using
+a level schedule and a team of threads.
+
+\tparam Base
+The type used during the forward mode computations; i.e., the corresponding
+recording of operations used the type AD<Base>.
+
+\param play
+The information stored in play
+is a recording of the operations corresponding to a function
+\f[
+	F : {\bf R}^n \rightarrow {\bf R}^m
+\f]
+The level schedule play->level_schedule() must have been setup
+(see level_schedule_setup).
+
+\param s_out
+Is the stream where output corresponding to PriOp operations will
+be written (only used when q is zero).
+
+\param print
+If print is false,
+suppress the output that is otherwise generated by the PriOp instructions.
+
+\param q
+is the order of the Taylor coefficients being computed (zero or one).
+The coefficients of order less than q have already been computed.
+
+\param J
+Is the number of columns in the coefficient matrix taylor.
+
+\param taylor
+The order q Taylor coefficients for the independent variables have
+been set. Upon return, the order q Taylor coefficients for all the
+other variables have been set.
+
+\param cskip_op
+If q is zero, all the elements of this vector are set to false;
+i.e., conditional skipping is not used when this routine returns true.
+
+\param num_threads
+is the number of threads in the team.
+
+\param compare_change_count
+is the count value for changing number and op_index during
+zero order foward mode (only used when q is zero).
+
+\param compare_change_number
+If q is zero, this is set to the number of comparison operators
+that changed value (zero if compare_change_count is zero).
+
+\param compare_change_op_index
+If q is zero, this is set to the operator index for the count-th
+comparison that changed value (zero if compare_change_count is zero
+or there is no such comparison).
+
+\return
+If the level schedule is not supported for this operation sequence,
+or the cost model determines that a serial sweep is better,
+the return value is false and nothing is changed.
+Otherwise, the return value is true.
+*/
+template <class Base>
+bool forward_level(
+	const local::player<Base>* play,
+	std::ostream&              s_out,
+	bool                       print,
+	size_t                     q,
+	size_t                     J,
+	Base*                      taylor,
+	bool*                      cskip_op,
+	size_t                     num_threads,
+	size_t                     compare_change_count,
+	size_t&                    compare_change_number,
+	size_t&                    compare_change_op_index
+)
+{	CPPAD_ASSERT_UNKNOWN( q <= 1 );
+	CPPAD_ASSERT_UNKNOWN( J > q );
+	const play::level_schedule& schedule( play->level_schedule() );
+	CPPAD_ASSERT_UNKNOWN( schedule.setup );
+# if ! CPPAD_USE_CPLUSPLUS_2011
+	return false;
+# else
+	if( (num_threads < 2) | (! schedule.supported) )
+		return false;
+	//
+	// segments of levels that are run in parallel or by thread zero
+	pod_vector<size_t> segment;
+	pod_vector<bool>   parallel;
+	if( ! level_segment(schedule, num_threads, segment, parallel) )
+		return false;
+	//
+	// length of the parameter vector
+	const size_t num_par = play->num_par_rec();
+	//
+	// pointer to the beginning of the parameter vector
+	const Base* parameter = CPPAD_NULL;
+	if( num_par > 0 )
+		parameter = play->GetPar();
+	//
+	// conditional skipping is not used
+	if( q == 0 )
+	{	size_t num_op = play->num_op_rec();
+		for(size_t i = 0; i < num_op; ++i)
+			cskip_op[i] = false;
+	}
+	//
+	// run the levels
+	forward_level_work<Base> work(
+		schedule, segment, parallel, num_threads,
+		q, num_par, parameter, J, taylor
+	);
+	team_run(num_threads, work);
+	//
+	if( q > 0 )
+		return true;
+	//
+	// comparison and print operators
+	compare_change_number   = 0;
+	compare_change_op_index = 0;
+	const size_t num_text   = play->num_text_rec();
+	const char*  text       = CPPAD_NULL;
+	if( num_text > 0 )
+		text = play->GetTxt(0);
+	const pod_vector_maybe<play::level_op>& serial_vec( schedule.serial_vec );
+	for(size_t k = 0; k < serial_vec.size(); ++k)
+	{	const addr_t* arg = serial_vec[k].arg;
+		switch( serial_vec[k].op )
+		{	case EqppOp:
+			if( compare_change_count ) forward_eqpp_op_0(
+				compare_change_number, arg, parameter
+			);
+			break;
+
+			case EqpvOp:
+			if( compare_change_count ) forward_eqpv_op_0(
+				compare_change_number, arg, parameter, J, taylor
+			);
+			break;
+
+			case EqvvOp:
+			if( compare_change_count ) forward_eqvv_op_0(
+				compare_change_number, arg, parameter, J, taylor
+			);
+			break;
+
+			case LeppOp:
+			if( compare_change_count ) forward_lepp_op_0(
+				compare_change_number, arg, parameter
+			);
+			break;
+
+			case LepvOp:
+			if( compare_change_count ) forward_lepv_op_0(
+				compare_change_number, arg, parameter, J, taylor
+			);
+			break;
+
+			case LevpOp:
+			if( compare_change_count ) forward_levp_op_0(
+				compare_change_number, arg, parameter, J, taylor
+			);
+			break;
+
+			case LevvOp:
+			if( compare_change_count ) forward_levv_op_0(
+				compare_change_number, arg, parameter, J, taylor
+			);
+			break;
+
+			case LtppOp:
+			if( compare_change_count ) forward_ltpp_op_0(
+				compare_change_number, arg, parameter
+			);
+			break;
+
+			case LtpvOp:
+			if( compare_change_count ) forward_ltpv_op_0(
+				compare_change_number, arg, parameter, J, taylor
+			);
+			break;
+
+			case LtvpOp:
+			if( compare_change_count ) forward_ltvp_op_0(
+				compare_change_number, arg, parameter, J, taylor
+			);
+			break;
+
+			case LtvvOp:
+			if( compare_change_count ) forward_ltvv_op_0(
+				compare_change_number, arg, parameter, J, taylor
+			);
+			break;
+
+			case NeppOp:
+			if( compare_change_count ) forward_nepp_op_0(
+				compare_change_number, arg, parameter
+			);
+			break;
+
+			case NepvOp:
+			if( compare_change_count ) forward_nepv_op_0(
+				compare_change_number, arg, parameter, J, taylor
+			);
+			break;
+
+			case NevvOp:
+			if( compare_change_count ) forward_nevv_op_0(
+				compare_change_number, arg, parameter, J, taylor
+			);
+			break;
+
+			case PriOp:
+			if( print ) forward_pri_0(s_out,
+				arg, num_text, text, num_par, parameter, J, taylor
+			);
+			break;
+
+			default:
+			CPPAD_ASSERT_UNKNOWN(false);
+			break;
+		}
+		bool compare = compare_change_count > 0;
+		compare     &= serial_vec[k].op != PriOp;
+		if( compare & (compare_change_count == compare_change_number) )
+			compare_change_op_index = serial_vec[k].op_index;
+	}
+	return true;
+# endif
+}
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
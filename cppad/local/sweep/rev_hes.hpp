@@ -301,6 +301,14 @@ void rev_hes(
 			break;
 			// -------------------------------------------------
 
+			case CProdOp:
+			itr.correct_after_decrement(arg);
+			reverse_sparse_hessian_cprod_op(
+				i_var, arg, RevJac, for_jac_sparse, rev_hes_sparse
+			);
+			break;
+			// -------------------------------------------------
+
 			case CExpOp:
 			reverse_sparse_hessian_cond_op(
 				i_var, arg, num_par, RevJac, rev_hes_sparse
@@ -277,6 +277,14 @@ void rev_jac(
 			break;
 			// -------------------------------------------------
 
+			case CProdOp:
+			itr.correct_after_decrement(arg);
+			reverse_sparse_jacobian_cprod_op(
+				i_var, arg, var_sparsity
+			);
+			break;
+			// -------------------------------------------------
+
 			case CExpOp:
 			reverse_sparse_jacobian_cond_op(
 				dependency, i_var, arg, num_par, var_sparsity
@@ -180,6 +180,13 @@ varaibles, that are not in the subgraph are not calculated.
 If part of an atomic function call is in the subgraph,
 the entire atomic function call must be in the subgraph.
 
+\param cprod_work
+If this is null, the work space for CProdOp operators is allocated
+by this routine (using thread_alloc).
+Otherwise, it has at least (m + 1) * (d + 1) elements where m is the
+maximum number of variables in a CProdOp operator
+(this is used by the team threads that do not allocate memory).
+
 \par Assumptions
 The first operator on the tape is a BeginOp,
 and the next \a n operators are InvOp operations for the
@@ -197,7 +204,8 @@ void reverse(
 	Base*                       Partial,
 	bool*                       cskip_op,
 	const pod_vector<Addr>&     var_by_load_op,
-	Iterator&                   play_itr
+	Iterator&                   play_itr,
+	Base*                       cprod_work = CPPAD_NULL
 )
 {
 	// check numvar argument
@@ -221,6 +229,9 @@ void reverse(
 	vector<Base> user_px;        // partials w.r.t argument vector
 	vector<Base> user_py;        // partials w.r.t. result vector
 	//
+	// work space used by CProdOp (grows to the largest product)
+	pod_vector_maybe<Base> cprod_vec;
+	//
 	atomic_base<Base>* user_atom = CPPAD_NULL; // user's atomic op calculator
 # ifndef NDEBUG
 	bool               user_ok   = false;      // atomic op return value
@@ -266,6 +277,12 @@ void reverse(
 				}
 				break;
 
+				case CSkipOp:
+				case CSumOp:
+				case CProdOp:
+				play_itr.correct_after_decrement(arg);
+				break;
+
 				default:
 				break;
 			}
@@ -398,6 +415,23 @@ void reverse(
 			break;
 			// -------------------------------------------------
 
+			case CProdOp:
+			play_itr.correct_after_decrement(arg);
+			{	Base* work = cprod_work;
+				if( work == CPPAD_NULL )
+				{	size_t n_work = (size_t(arg[1]) - 2) * (d + 1);
+					if( cprod_vec.size() < n_work )
+						cprod_vec.resize(n_work);
+					work = cprod_vec.data();
+				}
+				reverse_cprod_op(d, i_var, arg, num_par, parameter,
+					J, Taylor, K, Partial, work
+				);
+			}
+			// end of a cumulative product
+			break;
+			// -------------------------------------------------
+
 			case CExpOp:
 			reverse_cond_op(
 				d,
@@ -0,0 +1,475 @@
+# ifndef CPPAD_LOCAL_SWEEP_REVERSE_BATCH_HPP
+# define CPPAD_LOCAL_SWEEP_REVERSE_BATCH_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+// BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/reverse_batch.hpp
+Compute first order reverse mode derivatives for a batch of points.
+*/
+
+/*!
+Compute first order reverse mode derivatives for K points
+using one pass through the operation sequence.
+
+The values and partial derivatives are stored using a structure of arrays
+layout; i.e., the value and partial for variable i at point ell are
+taylor[ K * i + ell ] and partial[ K * i + ell ].
+This is the same as the layout used by the reverse mode operator kernels
+with d equal to zero and both cap_order and nc_partial equal to K.
+Hence each kernel is called with taylor + ell and partial + ell,
+for ell = 0, ..., K-1, in a loop that the compiler can vectorize.
+
+\tparam Base
+The type used during the reverse mode computations; i.e., the corresponding
+recording of operations used the type AD<Base>.
+
+\param play
+is the recording of the operations corresponding to the function
+\f[
+	F : {\bf R}^n \rightarrow {\bf R}^m
+\f]
+where \f$ n \f$ is the number of independent variables and
+\f$ m \f$ is the number of dependent variables.
+
+\param n
+is the number of independent variables on the tape.
+
+\param numvar
+is the total number of variables on the tape; i.e., play->num_var_rec().
+
+\param K
+is the number of points in the batch.
+
+\param taylor
+For i = 1 , ... , numvar - 1 and ell = 0 , ... , K-1,
+taylor [ K * i + ell ]
+is the value of the i-th variable at point ell; see forward_batch.
+
+\param partial
+\n
+\b Input:
+For i = 1 , ... , numvar - 1 and ell = 0 , ... , K-1,
+partial [ K * i + ell ]
+is the partial of the scalar function, that we are differentiating,
+with respect to the i-th variable at point ell (treating the variable
+as independent of the other variables).
+\n
+\b Output:
+For i = 1 , ... , n and ell = 0 , ... , K-1,
+partial [ K * i + ell ]
+is the partial of the scalar function with respect to the
+i-th independent variable at point ell.
+
+\return
+is false if the recording contains an operation that is not supported
+by this routine (VecAD load and store operations and atomic function
+calls). In this case the contents of partial are not specified.
+
+\par Restrictions
+Conditional skip operations are not used; see forward_batch.
+*/
+
+template <class Base>
+bool reverse_batch(
+	const local::player<Base>* play,
+	size_t                     n,
+	size_t                     numvar,
+	size_t                     K,
+	const Base*                taylor,
+	Base*                      partial
+)
+{	CPPAD_ASSERT_UNKNOWN( K >= 1 );
+	CPPAD_ASSERT_UNKNOWN( play->num_var_rec() == numvar );
+	CPPAD_ASSERT_UNKNOWN( numvar > 0 );
+
+	// length of the parameter vector (used by CppAD assert macros)
+	const size_t num_par = play->num_par_rec();
+
+	// pointer to the beginning of the parameter vector
+	const Base* parameter = CPPAD_NULL;
+	if( num_par > 0 )
+		parameter = play->GetPar();
+
+	// start at the EndOp at the end of the recording
+	play::const_sequential_iterator itr = play->end();
+	// op_info
+	OpCode op;
+	size_t i_var;
+	const addr_t* arg;
+	itr.op_info(op, arg, i_var);
+	CPPAD_ASSERT_UNKNOWN( op == EndOp );
+	//
+	size_t ell; // index of a point in the batch
+	//
+	// work space used by CProdOp (grows to the largest product)
+	pod_vector_maybe<Base> cprod_work;
+	//
+	while(op != BeginOp )
+	{
+		// next op
+		(--itr).op_info(op, arg, i_var);
+		CPPAD_ASSERT_UNKNOWN( i_var < numvar || NumRes(op) == 0 );
+
+		// action to take depends on the case
+		switch( op )
+		{
+			case AbsOp:
+			for(ell = 0; ell < K; ++ell) reverse_abs_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case AcosOp:
+			for(ell = 0; ell < K; ++ell) reverse_acos_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+# if CPPAD_USE_CPLUSPLUS_2011
+			case AcoshOp:
+			for(ell = 0; ell < K; ++ell) reverse_acosh_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+# endif
+			// -------------------------------------------------
+
+			case AddpvOp:
+			for(ell = 0; ell < K; ++ell) reverse_addpv_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case AddvvOp:
+			for(ell = 0; ell < K; ++ell) reverse_addvv_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case AsinOp:
+			for(ell = 0; ell < K; ++ell) reverse_asin_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+# if CPPAD_USE_CPLUSPLUS_2011
+			case AsinhOp:
+			for(ell = 0; ell < K; ++ell) reverse_asinh_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+# endif
+			// -------------------------------------------------
+
+			case AtanOp:
+			for(ell = 0; ell < K; ++ell) reverse_atan_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+# if CPPAD_USE_CPLUSPLUS_2011
+			case AtanhOp:
+			for(ell = 0; ell < K; ++ell) reverse_atanh_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+# endif
+			// -------------------------------------------------
+
+			case CExpOp:
+			for(ell = 0; ell < K; ++ell) reverse_cond_op(
+				0, i_var, arg, num_par, parameter,
+				K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case CosOp:
+			for(ell = 0; ell < K; ++ell) reverse_cos_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case CoshOp:
+			for(ell = 0; ell < K; ++ell) reverse_cosh_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case CSumOp:
+			itr.correct_after_decrement(arg);
+			for(ell = 0; ell < K; ++ell)
+				reverse_csum_op(0, i_var, arg, K, partial + ell);
+			break;
+			// -------------------------------------------------
+
+			case CProdOp:
+			itr.correct_after_decrement(arg);
+			if( cprod_work.size() < size_t(arg[1]) - 2 )
+				cprod_work.resize( size_t(arg[1]) - 2 );
+			for(ell = 0; ell < K; ++ell) reverse_cprod_op(
+				0, i_var, arg, num_par, parameter,
+				K, taylor + ell, K, partial + ell, cprod_work.data()
+			);
+			break;
+			// -------------------------------------------------
+
+			case DivpvOp:
+			for(ell = 0; ell < K; ++ell) reverse_divpv_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case DivvpOp:
+			for(ell = 0; ell < K; ++ell) reverse_divvp_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case DivvvOp:
+			for(ell = 0; ell < K; ++ell) reverse_divvv_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+# if CPPAD_USE_CPLUSPLUS_2011
+			case ErfOp:
+			for(ell = 0; ell < K; ++ell) reverse_erf_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+# endif
+			// -------------------------------------------------
+
+			case ExpOp:
+			for(ell = 0; ell < K; ++ell) reverse_exp_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+# if CPPAD_USE_CPLUSPLUS_2011
+			case Expm1Op:
+			for(ell = 0; ell < K; ++ell) reverse_expm1_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+# endif
+			// -------------------------------------------------
+
+			case LogOp:
+			for(ell = 0; ell < K; ++ell) reverse_log_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+# if CPPAD_USE_CPLUSPLUS_2011
+			case Log1pOp:
+			for(ell = 0; ell < K; ++ell) reverse_log1p_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+# endif
+			// -------------------------------------------------
+
+			case MulpvOp:
+			for(ell = 0; ell < K; ++ell) reverse_mulpv_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case MulvvOp:
+			for(ell = 0; ell < K; ++ell) reverse_mulvv_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case PowpvOp:
+			for(ell = 0; ell < K; ++ell) reverse_powpv_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case PowvpOp:
+			for(ell = 0; ell < K; ++ell) reverse_powvp_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case PowvvOp:
+			for(ell = 0; ell < K; ++ell) reverse_powvv_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case SignOp:
+			for(ell = 0; ell < K; ++ell) reverse_sign_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case SinOp:
+			for(ell = 0; ell < K; ++ell) reverse_sin_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case SinhOp:
+			for(ell = 0; ell < K; ++ell) reverse_sinh_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case SqrtOp:
+			for(ell = 0; ell < K; ++ell) reverse_sqrt_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case SubpvOp:
+			for(ell = 0; ell < K; ++ell) reverse_subpv_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case SubvpOp:
+			for(ell = 0; ell < K; ++ell) reverse_subvp_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case SubvvOp:
+			for(ell = 0; ell < K; ++ell) reverse_subvv_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case TanOp:
+			for(ell = 0; ell < K; ++ell) reverse_tan_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case TanhOp:
+			for(ell = 0; ell < K; ++ell) reverse_tanh_op(
+				0, i_var, arg[0], K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case ZmulpvOp:
+			for(ell = 0; ell < K; ++ell) reverse_zmulpv_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case ZmulvpOp:
+			for(ell = 0; ell < K; ++ell) reverse_zmulvp_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case ZmulvvOp:
+			for(ell = 0; ell < K; ++ell) reverse_zmulvv_op(
+				0, i_var, arg, parameter, K, taylor + ell, K, partial + ell
+			);
+			break;
+			// -------------------------------------------------
+
+			case CSkipOp:
+			// operations are not skipped; see Restrictions above
+			itr.correct_after_decrement(arg);
+			break;
+			// -------------------------------------------------
+
+			case BeginOp:
+			case DisOp:
+			case EndOp:
+			case InvOp:
+			case ParOp:
+			// no partials pass through these operations
+			break;
+			// -------------------------------------------------
+
+			case EqppOp:
+			case EqpvOp:
+			case EqvvOp:
+			case LeppOp:
+			case LepvOp:
+			case LevpOp:
+			case LevvOp:
+			case LtppOp:
+			case LtpvOp:
+			case LtvpOp:
+			case LtvvOp:
+			case NeppOp:
+			case NepvOp:
+			case NevvOp:
+			case PriOp:
+			// no result so nothing to do
+			break;
+			// -------------------------------------------------
+
+			case LdpOp:
+			case LdvOp:
+			case StppOp:
+			case StpvOp:
+			case StvpOp:
+			case StvvOp:
+			case UserOp:
+			case UsrapOp:
+			case UsravOp:
+			case UsrrpOp:
+			case UsrrvOp:
+			// VecAD vectors and atomic functions are not supported
+			return false;
+			// -------------------------------------------------
+
+			default:
+			CPPAD_ASSERT_UNKNOWN(false);
+		}
+	}
+	return true;
+}
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
@@ -0,0 +1,541 @@
+# ifndef CPPAD_LOCAL_SWEEP_REVERSE_LEVEL_HPP
+# define CPPAD_LOCAL_SWEEP_REVERSE_LEVEL_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/local/team_run.hpp>
+
+// BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/reverse_level.hpp
+Reverse mode using a level schedule and a team of threads.
+
+The levels are processed in reverse order.
+Operators in the same level can add to the partial derivative of the
+same argument, so each thread accumulates into its own partial
+derivative matrix. Before an operator is processed, the partials for its
+primary result are summed over the threads (all the contributions
+come from higher levels, so they are complete).
+*/
+
+/*!
+Reverse mode for one operator.
+
+\param d
+is the highest order Taylor coefficient that we are
+computing the derivative of.
+
+\param info
+is the operator.
+
+\param num_par
+is the number of parameters in the operation sequence.
+
+\param parameter
+is the parameter vector for the operation sequence.
+
+\param J
+is the number of columns in the Taylor coefficient matrix.
+
+\param Taylor
+is the Taylor coefficient matrix.
+
+\param K
+is the number of columns in the partial derivative matrix.
+
+\param Partial
+is the partial derivative matrix. The partials for the result of this
+operator are complete. Upon return, the partials for its arguments
+have been incremented by the contribution from this operator.
+
+\param cprod_work
+is work space for CProdOp operators with at least
+(schedule.max_cprod + 1) * (d + 1) elements.
+*/
+template <class Base>
+void reverse_level_op(
+	size_t                 d          ,
+	const play::level_op&  info       ,
+	size_t                 num_par    ,
+	const Base*            parameter  ,
+	size_t                 J          ,
+	const Base*            Taylor     ,
+	size_t                 K          ,
+	Base*                  Partial    ,
+	Base*                  cprod_work )
+{	size_t i_var         = info.i_var;
+	const addr_t* arg    = info.arg;
+	switch( info.op )
+	{
+		case AbsOp:
+		reverse_abs_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case AcosOp:
+		reverse_acos_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case AddpvOp:
+		reverse_addpv_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case AddvvOp:
+		reverse_addvv_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case AsinOp:
+		reverse_asin_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case AtanOp:
+		reverse_atan_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case CExpOp:
+		reverse_cond_op(
+			d, i_var, arg, num_par, parameter, J, Taylor, K, Partial
+		);
+		break;
+
+		case CosOp:
+		reverse_cos_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case CoshOp:
+		reverse_cosh_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case CSumOp:
+		reverse_csum_op(d, i_var, arg, K, Partial);
+		break;
+
+		case CProdOp:
+		reverse_cprod_op(d, i_var, arg, num_par, parameter,
+			J, Taylor, K, Partial, cprod_work
+		);
+		break;
+
+		case DivpvOp:
+		reverse_divpv_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case DivvpOp:
+		reverse_divvp_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case DivvvOp:
+		reverse_divvv_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case ExpOp:
+		reverse_exp_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case LogOp:
+		reverse_log_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case MulpvOp:
+		reverse_mulpv_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case MulvvOp:
+		reverse_mulvv_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case ParOp:
+		break;
+
+		case PowpvOp:
+		reverse_powpv_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case PowvpOp:
+		reverse_powvp_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case PowvvOp:
+		reverse_powvv_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case SignOp:
+		reverse_sign_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case SinOp:
+		reverse_sin_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case SinhOp:
+		reverse_sinh_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case SqrtOp:
+		reverse_sqrt_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case SubpvOp:
+		reverse_subpv_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case SubvpOp:
+		reverse_subvp_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case SubvvOp:
+		reverse_subvv_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case TanOp:
+		reverse_tan_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case TanhOp:
+		reverse_tanh_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case ZmulpvOp:
+		reverse_zmulpv_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case ZmulvpOp:
+		reverse_zmulvp_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case ZmulvvOp:
+		reverse_zmulvv_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+# if CPPAD_USE_CPLUSPLUS_2011
+		case AcoshOp:
+		reverse_acosh_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case AsinhOp:
+		reverse_asinh_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case AtanhOp:
+		reverse_atanh_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case ErfOp:
+		reverse_erf_op(d, i_var, arg, parameter, J, Taylor, K, Partial);
+		break;
+
+		case Expm1Op:
+		reverse_expm1_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+
+		case Log1pOp:
+		reverse_log1p_op(d, i_var, arg[0], J, Taylor, K, Partial);
+		break;
+# endif
+
+		default:
+		CPPAD_ASSERT_UNKNOWN(false);
+		break;
+	}
+}
+
+# if CPPAD_USE_CPLUSPLUS_2011
+/// the work done by each thread in the team during a reverse level sweep
+template <class Base>
+class reverse_level_work {
+private:
+	const play::level_schedule& schedule_;
+	const pod_vector<size_t>&   segment_;
+	const pod_vector<bool>&     parallel_;
+	const size_t                num_threads_;
+	const size_t                d_;
+	const size_t                num_par_;
+	const Base*                 parameter_;
+	const size_t                J_;
+	const Base*                 Taylor_;
+	const size_t                K_;
+	const size_t                num_partial_;
+	Base*                       Partial_;
+	Base*                       thread_partial_;
+	const size_t                num_cprod_;
+	Base*                       cprod_work_;
+	const bool*                 cskip_op_;
+	team_barrier                barrier_;
+public:
+	/*!
+	constructor
+
+	\param schedule
+	is the level schedule for the operation sequence.
+
+	\param segment
+	The s-th segment of operators is
+	schedule.op_vec[ segment[s] ], ... , schedule.op_vec[ segment[s+1] - 1 ].
+
+	\param parallel
+	is parallel[s] true (false) if the s-th segment is split between
+	the threads (run by thread zero).
+
+	\param num_threads
+	is the number of threads in the team.
+
+	\param d
+	is the highest order Taylor coefficient that we are
+	computing the derivative of.
+
+	\param num_par
+	is the number of parameters in the operation sequence.
+
+	\param parameter
+	is the parameter vector for the operation sequence.
+
+	\param J
+	is the number of columns in the Taylor coefficient matrix.
+
+	\param Taylor
+	is the Taylor coefficient matrix.
+
+	\param K
+	is the number of columns in the partial derivative matrices.
+
+	\param num_partial
+	is the number of elements in each partial derivative matrix.
+
+	\param Partial
+	is the partial derivative matrix for thread zero.
+
+	\param thread_partial
+	is the partial derivative matrices for the other threads;
+	thread_partial + (thread - 1) * num_partial is the matrix
+	for thread. The input value of its elements does not matter.
+
+	\param num_cprod
+	is the number of elements in the CProdOp work space for each thread.
+
+	\param cprod_work
+	is the CProdOp work space for the threads;
+	cprod_work + thread * num_cprod is the work space for thread.
+
+	\param cskip_op
+	is true for operators that are not used for the current
+	value of the independent variables.
+	*/
+	reverse_level_work(
+		const play::level_schedule& schedule       ,
+		const pod_vector<size_t>&   segment        ,
+		const pod_vector<bool>&     parallel       ,
+		size_t                      num_threads    ,
+		size_t                      d              ,
+		size_t                      num_par        ,
+		const Base*                 parameter      ,
+		size_t                      J              ,
+		const Base*                 Taylor         ,
+		size_t                      K              ,
+		size_t                      num_partial    ,
+		Base*                       Partial        ,
+		Base*                       thread_partial ,
+		size_t                      num_cprod      ,
+		Base*                       cprod_work     ,
+		const bool*                 cskip_op       )
+	: schedule_(schedule)
+	, segment_(segment)
+	, parallel_(parallel)
+	, num_threads_(num_threads)
+	, d_(d)
+	, num_par_(num_par)
+	, parameter_(parameter)
+	, J_(J)
+	, Taylor_(Taylor)
+	, K_(K)
+	, num_partial_(num_partial)
+	, Partial_(Partial)
+	, thread_partial_(thread_partial)
+	, num_cprod_(num_cprod)
+	, cprod_work_(cprod_work)
+	, cskip_op_(cskip_op)
+	, barrier_(num_threads)
+	{ }
+	/// partial derivative matrix for a thread
+	Base* partial(size_t thread)
+	{	if( thread == 0 )
+			return Partial_;
+		return thread_partial_ + (thread - 1) * num_partial_;
+	}
+	/// the work for one thread in the team
+	void operator()(size_t thread)
+	{	Base* my_partial = partial(thread);
+		Base* my_cprod   = cprod_work_ + thread * num_cprod_;
+		if( thread > 0 )
+		{	for(size_t i = 0; i < num_partial_; ++i)
+				my_partial[i] = Base(0.0);
+		}
+		barrier_.wait();
+		//
+		size_t s = parallel_.size();
+		while( s > 0 )
+		{	--s;
+			size_t begin = segment_[s];
+			size_t end   = segment_[s + 1];
+			if( parallel_[s] )
+			{	size_t width = end - begin;
+				end    = begin + (width * (thread + 1)) / num_threads_;
+				begin  = begin + (width * thread) / num_threads_;
+			}
+			else if( thread != 0 )
+				end = begin;
+			size_t k = end;
+			while( k > begin )
+			{	const play::level_op& info( schedule_.op_vec[--k] );
+				if( cskip_op_[info.op_index] )
+					continue;
+				// sum the partials for the primary result
+				Base* pz = my_partial + info.i_var * K_;
+				for(size_t t = 0; t < num_threads_; ++t) if( t != thread )
+				{	const Base* other = partial(t) + info.i_var * K_;
+					for(size_t ell = 0; ell <= d_; ++ell)
+						pz[ell] += other[ell];
+				}
+				reverse_level_op(d_, info, num_par_, parameter_,
+					J_, Taylor_, K_, my_partial, my_cprod
+				);
+			}
+			if( s > 0 )
+				barrier_.wait();
+		}
+	}
+};
+# endif
+
+/*!
+Compute derivative of forward mode Taylor coefficients using
+a level schedule and a team of threads.
+
+\tparam Base
+this operation sequence was recorded using AD<Base>
+and computations by this routine are done using type Base.
+
+\param d
+is the highest order Taylor coefficients that
+we are computing the derivative of.
+
+\param n
+is the number of independent variables on the tape.
+
+\param numvar
+is the total number of variables on the tape.
+
+\param play
+is the operation sequence.
+The level schedule play->level_schedule() must have been setup
+(see level_schedule_setup).
+
+\param J
+Is the number of columns in the coefficient matrix Taylor.
+
+\param Taylor
+is the Taylor coefficient matrix.
+
+\param K
+Is the number of columns in the partial derivative matrix Partial.
+
+\param Partial
+The input and output values are the same as for sweep::reverse
+except that the output value is only defined for the rows corresponding
+to the independent variables.
+
+\param cskip_op
+is a vector with size play->num_op_rec().
+If cskip_op[i] is true, the operator index i in the recording
+does not affect any of the dependent variable (given the value
+of the independent variables).
+
+\param num_threads
+is the number of threads in the team.
+
+\return
+If the level schedule is not supported for this operation sequence,
+or the cost model determines that a serial sweep is better,
+the return value is false and nothing is changed.
+Otherwise, the return value is true.
+*/
+template <class Base>
+bool reverse_level(
+	size_t                      d,
+	size_t                      n,
+	size_t                      numvar,
+	const local::player<Base>*  play,
+	size_t                      J,
+	const Base*                 Taylor,
+	size_t                      K,
+	Base*                       Partial,
+	const bool*                 cskip_op,
+	size_t                      num_threads
+)
+{	CPPAD_ASSERT_UNKNOWN( play->num_var_rec() == numvar );
+	CPPAD_ASSERT_UNKNOWN( d < J && d < K );
+	const play::level_schedule& schedule( play->level_schedule() );
+	CPPAD_ASSERT_UNKNOWN( schedule.setup );
+# if ! CPPAD_USE_CPLUSPLUS_2011
+	return false;
+# else
+	if( (num_threads < 2) | (! schedule.supported) )
+		return false;
+	//
+	// segments of levels that are run in parallel or by thread zero
+	pod_vector<size_t> segment;
+	pod_vector<bool>   parallel;
+	if( ! level_segment(schedule, num_threads, segment, parallel) )
+		return false;
+	//
+	// length of the parameter vector
+	const size_t num_par = play->num_par_rec();
+	//
+	// pointer to the beginning of the parameter vector
+	const Base* parameter = CPPAD_NULL;
+	if( num_par > 0 )
+		parameter = play->GetPar();
+	//
+	// partial derivative matrices for the other threads
+	size_t num_partial = numvar * K;
+	pod_vector_maybe<Base> thread_partial( (num_threads - 1) * num_partial );
+	//
+	// CProdOp work space for each thread
+	// (the threads in the team do not allocate memory)
+	size_t num_cprod = 0;
+	if( schedule.max_cprod > 0 )
+		num_cprod = (schedule.max_cprod + 1) * (d + 1);
+	pod_vector_maybe<Base> cprod_work( num_threads * num_cprod );
+	//
+	// run the levels
+	reverse_level_work<Base> work(
+		schedule, segment, parallel, num_threads, d,
+		num_par, parameter, J, Taylor,
+		K, num_partial, Partial, thread_partial.data(),
+		num_cprod, cprod_work.data(), cskip_op
+	);
+	team_run(num_threads, work);
+	//
+	// sum the partials for the independent variables
+	for(size_t t = 1; t < num_threads; ++t)
+	{	const Base* other = work.partial(t);
+		for(size_t j = 1; j <= n; ++j)
+		{	for(size_t ell = 0; ell <= d; ++ell)
+				Partial[j * K + ell] += other[j * K + ell];
+		}
+	}
+	return true;
+# endif
+}
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
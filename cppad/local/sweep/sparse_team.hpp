@@ -0,0 +1,681 @@
+# ifndef CPPAD_LOCAL_SWEEP_SPARSE_TEAM_HPP
+# define CPPAD_LOCAL_SWEEP_SPARSE_TEAM_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/local/team_run.hpp>
+# include <cppad/local/sparse_pack.hpp>
+
+// BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/sparse_team.hpp
+Sparsity pattern sweeps with the possible elements of the sets
+split into blocks and the blocks split between a team of threads.
+
+Each block is a range of Pack values in a sparse_pack object,
+so the sweeps for different blocks are independent.
+Each thread does a complete sweep for its block using its own sparse_pack.
+All the memory used by the threads is allocated by the current thread
+before the team is started (the team threads do not use thread_alloc).
+*/
+
+/*!
+Can the sparsity pattern sweeps for this operation sequence be split
+between a team.
+
+\param play
+is the operation sequence.
+
+\return
+is false if the operation sequence contains atomic function operators
+or VecAD operators (the sweeps allocate memory for these operators)
+or if C++11 threads are not available.
+*/
+template <class Base>
+bool sparse_team_supported(const local::player<Base>* play)
+{
+# if ! CPPAD_USE_CPLUSPLUS_2011
+	return false;
+# else
+	if( play->num_vecad_vec_rec() > 0 )
+		return false;
+	size_t num_op = play->num_op_rec();
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+	{	if( play->GetOp(i_op) == UserOp )
+			return false;
+	}
+	return true;
+# endif
+}
+
+/*!
+Split the Pack values for a sparsity pattern into blocks.
+
+\param end
+is the number of possible elements in each set.
+
+\param num_threads
+is the maximum number of threads in the team.
+
+\param first [out]
+is the index of the first Pack value in each block and
+first[n_block] is the number of Pack values in each set.
+
+\return
+is the number of blocks n_block (at most one for each Pack value).
+*/
+inline size_t sparse_team_split(
+	size_t                        end          ,
+	size_t                        num_threads  ,
+	pod_vector<size_t>&           first        )
+{	size_t n_bit   = std::numeric_limits<size_t>::digits;
+	size_t n_pack  = (end + n_bit - 1) / n_bit;
+	size_t n_block = std::min(num_threads, n_pack);
+	first.resize(n_block + 1);
+	for(size_t t = 0; t <= n_block; ++t)
+		first[t] = (t * n_pack) / n_block;
+	return n_block;
+}
+
+/*!
+Resize the sparsity pattern for each block (all the sets are empty).
+
+\param n_set
+is the number of sets in each block.
+
+\param end
+is the number of possible elements in each of the original sets.
+
+\param first
+is the index of the first Pack value in each block; see sparse_team_split.
+
+\param block [out]
+the possible elements of the sets in block[t] are the elements
+first[t] * n_bit, ... , first[t] * n_bit + block[t].end() - 1
+of the original sets (n_bit is the number of bits in a Pack value).
+The memory already allocated for block[t] is reused.
+*/
+inline void sparse_team_resize(
+	size_t                        n_set        ,
+	size_t                        end          ,
+	const pod_vector<size_t>&     first        ,
+	sparse_pack*                  block        )
+{	size_t n_bit   = std::numeric_limits<size_t>::digits;
+	size_t n_block = first.size() - 1;
+	for(size_t t = 0; t < n_block; ++t)
+	{	size_t block_end = std::min(end, first[t+1] * n_bit);
+		block[t].resize(n_set, block_end - first[t] * n_bit);
+	}
+}
+
+/// work done by each thread during a forward Jacobian sparsity sweep
+template <class Addr, class Base>
+class for_jac_team_work {
+private:
+	const local::player<Base>*    play_;
+	const bool                    dependency_;
+	const size_t                  n_;
+	const size_t                  numvar_;
+	const size_t*                 ind_taddr_;
+	const size_t*                 first_;
+	sparse_pack*                  block_;
+	sparse_pack&                  var_sparsity_;
+public:
+	/*!
+	constructor
+
+	\param play
+	is the operation sequence.
+
+	\param dependency
+	are the derivatives with respect to left and right of the expression
+	below considered to be non-zero:
+	\code
+		CondExpRel(left, right, if_true, if_false)
+	\endcode
+	This is used by the optimizer to obtain the correct dependency relations.
+
+	\param n
+	is the number of independent variables.
+
+	\param numvar
+	is the number of variables in the operation sequence.
+
+	\param ind_taddr
+	is the variable index for each independent variable.
+
+	\param first
+	is the index of the first Pack value in each block.
+
+	\param block
+	is the sparsity pattern for each block.
+
+	\param var_sparsity
+	is the sparsity pattern for all the blocks; see for_jac_team.
+	*/
+	for_jac_team_work(
+		const local::player<Base>*  play          ,
+		bool                        dependency    ,
+		size_t                      n             ,
+		size_t                      numvar        ,
+		const size_t*               ind_taddr     ,
+		const size_t*               first         ,
+		sparse_pack*                block         ,
+		sparse_pack&                var_sparsity  )
+	: play_(play)
+	, dependency_(dependency)
+	, n_(n)
+	, numvar_(numvar)
+	, ind_taddr_(ind_taddr)
+	, first_(first)
+	, block_(block)
+	, var_sparsity_(var_sparsity)
+	{ }
+	/// the work for one thread in the team
+	void operator()(size_t thread)
+	{	sparse_pack& block = block_[thread];
+		size_t       first = first_[thread];
+		//
+		// sparsity pattern for the independent variables in this block
+		for(size_t j = 0; j < n_; ++j)
+		{	size_t i_var = ind_taddr_[j];
+			block.assignment_from_block(i_var, i_var, first, var_sparsity_);
+		}
+		//
+		// sparsity pattern for the other variables in this block
+		for_jac<Addr>(play_, dependency_, n_, numvar_, block);
+		//
+		// store this block in the result
+		for(size_t i = 0; i < numvar_; ++i)
+			var_sparsity_.assignment_to_block(i, first, i, block);
+	}
+};
+
+/*!
+Forward Jacobian sparsity sweep with the possible elements of the sets
+split into blocks and the blocks split between a team of threads.
+
+\tparam Addr
+is the type used to record address on this tape
+This is allows for smaller tapes when sizeof(Addr) < sizeof(size_t).
+
+\param play
+is the operation sequence.
+
+\param dependency
+is the dependency argument for the for_jac sweep.
+
+\param n
+is the number of independent variables.
+
+\param numvar
+is the number of variables in the operation sequence.
+
+\param ind_taddr
+is the variable index for each independent variable.
+
+\param num_threads
+is the maximum number of threads in the team.
+
+\param block
+is workspace that holds the sparsity pattern for each block.
+Its memory is reused by the next call that uses the same workspace.
+
+\param var_sparsity [in,out]
+On input, the sets for the independent variables are the sparsity pattern
+for the independent variables.
+If the return value is true, on output it is the same as after the call
+\code
+	for_jac<Addr>(play, dependency, n, numvar, var_sparsity)
+\endcode
+
+\return
+is false (and nothing is computed) if there is only one Pack value
+in each set or the team cannot be used for this operation sequence;
+see sparse_team_supported.
+*/
+template <class Addr, class Base>
+bool for_jac_team(
+	const local::player<Base>*    play         ,
+	bool                          dependency   ,
+	size_t                        n            ,
+	size_t                        numvar       ,
+	const CppAD::vector<size_t>&  ind_taddr    ,
+	size_t                        num_threads  ,
+	CppAD::vector<sparse_pack>&   block        ,
+	sparse_pack&                  var_sparsity )
+{	CPPAD_ASSERT_UNKNOWN( var_sparsity.n_set() == numvar );
+	if( ! sparse_team_supported(play) )
+		return false;
+	//
+	// split the Pack values into blocks
+	pod_vector<size_t> first;
+	size_t end     = var_sparsity.end();
+	size_t n_block = sparse_team_split(end, num_threads, first);
+	if( n_block < 2 )
+		return false;
+	//
+	// a private sparsity pattern for each block
+	if( block.size() < n_block )
+		block.resize(n_block);
+	sparse_team_resize(numvar, end, first, block.data());
+	//
+	for_jac_team_work<Addr, Base> work(
+		play,
+		dependency,
+		n,
+		numvar,
+		ind_taddr.data(),
+		first.data(),
+		block.data(),
+		var_sparsity
+	);
+	team_run(n_block, work);
+	return true;
+}
+// ---------------------------------------------------------------------------
+/// work done by each thread during a reverse Jacobian sparsity sweep
+template <class Addr, class Base>
+class rev_jac_team_work {
+private:
+	const local::player<Base>*    play_;
+	const bool                    dependency_;
+	const size_t                  n_;
+	const size_t                  m_;
+	const size_t                  numvar_;
+	const size_t*                 ind_taddr_;
+	const size_t*                 dep_taddr_;
+	const size_t*                 first_;
+	sparse_pack*                  block_;
+	sparse_pack&                  var_sparsity_;
+public:
+	/*!
+	constructor
+
+	\param play
+	is the operation sequence.
+
+	\param dependency
+	is the dependency argument for the rev_jac sweep.
+
+	\param n
+	is the number of independent variables.
+
+	\param m
+	is the number of dependent variables.
+
+	\param numvar
+	is the number of variables in the operation sequence.
+
+	\param ind_taddr
+	is the variable index for each independent variable.
+
+	\param dep_taddr
+	is the variable index for each dependent variable.
+
+	\param first
+	is the index of the first Pack value in each block.
+
+	\param block
+	is the sparsity pattern for each block.
+
+	\param var_sparsity
+	is the sparsity pattern for all the blocks; see rev_jac_team.
+	*/
+	rev_jac_team_work(
+		const local::player<Base>*  play          ,
+		bool                        dependency    ,
+		size_t                      n             ,
+		size_t                      m             ,
+		size_t                      numvar        ,
+		const size_t*               ind_taddr     ,
+		const size_t*               dep_taddr     ,
+		const size_t*               first         ,
+		sparse_pack*                block         ,
+		sparse_pack&                var_sparsity  )
+	: play_(play)
+	, dependency_(dependency)
+	, n_(n)
+	, m_(m)
+	, numvar_(numvar)
+	, ind_taddr_(ind_taddr)
+	, dep_taddr_(dep_taddr)
+	, first_(first)
+	, block_(block)
+	, var_sparsity_(var_sparsity)
+	{ }
+	/// the work for one thread in the team
+	void operator()(size_t thread)
+	{	sparse_pack& block = block_[thread];
+		size_t       first = first_[thread];
+		//
+		// sparsity pattern for the dependent variables in this block
+		for(size_t i = 0; i < m_; ++i)
+		{	size_t i_var = dep_taddr_[i];
+			block.assignment_from_block(i_var, i_var, first, var_sparsity_);
+		}
+		//
+		// sparsity pattern for the other variables in this block
+		rev_jac<Addr>(play_, dependency_, n_, numvar_, block);
+		//
+		// store this block of the independent variables in the result
+		for(size_t j = 0; j < n_; ++j)
+		{	size_t i_var = ind_taddr_[j];
+			var_sparsity_.assignment_to_block(i_var, first, i_var, block);
+		}
+	}
+};
+
+/*!
+Reverse Jacobian sparsity sweep with the possible elements of the sets
+split into blocks and the blocks split between a team of threads.
+
+\tparam Addr
+is the type used to record address on this tape
+This is allows for smaller tapes when sizeof(Addr) < sizeof(size_t).
+
+\param play
+is the operation sequence.
+
+\param dependency
+is the dependency argument for the rev_jac sweep.
+
+\param n
+is the number of independent variables.
+
+\param numvar
+is the number of variables in the operation sequence.
+
+\param ind_taddr
+is the variable index for each independent variable.
+
+\param dep_taddr
+is the variable index for each dependent variable.
+
+\param num_threads
+is the maximum number of threads in the team.
+
+\param block
+is workspace that holds the sparsity pattern for each block.
+Its memory is reused by the next call that uses the same workspace.
+
+\param var_sparsity [in,out]
+On input, the sets for the dependent variables are the sparsity pattern
+for the dependent variables.
+If the return value is true, on output the sets for the independent
+variables are the same as after the call
+\code
+	rev_jac<Addr>(play, dependency, n, numvar, var_sparsity)
+\endcode
+(the other sets are not specified).
+
+\return
+is false (and nothing is computed) if there is only one Pack value
+in each set or the team cannot be used for this operation sequence;
+see sparse_team_supported.
+*/
+template <class Addr, class Base>
+bool rev_jac_team(
+	const local::player<Base>*    play         ,
+	bool                          dependency   ,
+	size_t                        n            ,
+	size_t                        numvar       ,
+	const CppAD::vector<size_t>&  ind_taddr    ,
+	const CppAD::vector<size_t>&  dep_taddr    ,
+	size_t                        num_threads  ,
+	CppAD::vector<sparse_pack>&   block        ,
+	sparse_pack&                  var_sparsity )
+{	CPPAD_ASSERT_UNKNOWN( var_sparsity.n_set() == numvar );
+	if( ! sparse_team_supported(play) )
+		return false;
+	//
+	// split the Pack values into blocks
+	pod_vector<size_t> first;
+	size_t end     = var_sparsity.end();
+	size_t n_block = sparse_team_split(end, num_threads, first);
+	if( n_block < 2 )
+		return false;
+	//
+	// a private sparsity pattern for each block
+	if( block.size() < n_block )
+		block.resize(n_block);
+	sparse_team_resize(numvar, end, first, block.data());
+	//
+	rev_jac_team_work<Addr, Base> work(
+		play,
+		dependency,
+		n,
+		dep_taddr.size(),
+		numvar,
+		ind_taddr.data(),
+		dep_taddr.data(),
+		first.data(),
+		block.data(),
+		var_sparsity
+	);
+	team_run(n_block, work);
+	return true;
+}
+// ---------------------------------------------------------------------------
+/// work done by each thread during a reverse Hessian sparsity sweep
+template <class Addr, class Base>
+class rev_hes_team_work {
+private:
+	const local::player<Base>*    play_;
+	const size_t                  n_;
+	const size_t                  numvar_;
+	const size_t*                 ind_taddr_;
+	const sparse_pack&            for_jac_sparse_;
+	const bool*                   rev_jac_;
+	const size_t*                 first_;
+	sparse_pack*                  for_jac_block_;
+	bool*                         rev_jac_thread_;
+	sparse_pack*                  block_;
+	sparse_pack&                  rev_hes_sparse_;
+public:
+	/*!
+	constructor
+
+	\param play
+	is the operation sequence.
+
+	\param n
+	is the number of independent variables.
+
+	\param numvar
+	is the number of variables in the operation sequence.
+
+	\param ind_taddr
+	is the variable index for each independent variable.
+
+	\param for_jac_sparse
+	is the forward Jacobian sparsity pattern for all the variables.
+
+	\param rev_jac
+	is the reverse Jacobian sparsity flag for each variable.
+
+	\param first
+	is the index of the first Pack value in each block.
+
+	\param for_jac_block
+	is the forward Jacobian sparsity pattern for each block.
+
+	\param rev_jac_thread
+	is the reverse Jacobian sparsity flags for each thread
+	(it has size numvar times the number of blocks).
+
+	\param block
+	is the reverse Hessian sparsity pattern for each block.
+
+	\param rev_hes_sparse
+	is the reverse Hessian sparsity pattern for all the blocks;
+	see rev_hes_team.
+	*/
+	rev_hes_team_work(
+		const local::player<Base>*  play            ,
+		size_t                      n               ,
+		size_t                      numvar          ,
+		const size_t*               ind_taddr       ,
+		const sparse_pack&          for_jac_sparse  ,
+		const bool*                 rev_jac         ,
+		const size_t*               first           ,
+		sparse_pack*                for_jac_block   ,
+		bool*                       rev_jac_thread  ,
+		sparse_pack*                block           ,
+		sparse_pack&                rev_hes_sparse  )
+	: play_(play)
+	, n_(n)
+	, numvar_(numvar)
+	, ind_taddr_(ind_taddr)
+	, for_jac_sparse_(for_jac_sparse)
+	, rev_jac_(rev_jac)
+	, first_(first)
+	, for_jac_block_(for_jac_block)
+	, rev_jac_thread_(rev_jac_thread)
+	, block_(block)
+	, rev_hes_sparse_(rev_hes_sparse)
+	{ }
+	/// the work for one thread in the team
+	void operator()(size_t thread)
+	{	sparse_pack& for_jac = for_jac_block_[thread];
+		sparse_pack& block   = block_[thread];
+		bool*        rev_jac = rev_jac_thread_ + thread * numvar_;
+		size_t       first   = first_[thread];
+		//
+		// forward Jacobian sparsity pattern for this block
+		for(size_t i = 0; i < numvar_; ++i)
+			for_jac.assignment_from_block(i, i, first, for_jac_sparse_);
+		//
+		// the sweep changes the reverse Jacobian flags
+		for(size_t i = 0; i < numvar_; ++i)
+			rev_jac[i] = rev_jac_[i];
+		//
+		// reverse Hessian sparsity pattern for this block
+		rev_hes<Addr>(play_, n_, numvar_, for_jac, rev_jac, block);
+		//
+		// store this block of the independent variables in the result
+		for(size_t j = 0; j < n_; ++j)
+		{	size_t i_var = ind_taddr_[j];
+			rev_hes_sparse_.assignment_to_block(i_var, first, i_var, block);
+		}
+	}
+};
+
+/*!
+Reverse Hessian sparsity sweep with the possible elements of the sets
+split into blocks and the blocks split between a team of threads.
+
+\tparam Addr
+is the type used to record address on this tape
+This is allows for smaller tapes when sizeof(Addr) < sizeof(size_t).
+
+\param play
+is the operation sequence.
+
+\param n
+is the number of independent variables.
+
+\param numvar
+is the number of variables in the operation sequence.
+
+\param ind_taddr
+is the variable index for each independent variable.
+
+\param for_jac_sparse
+is the forward Jacobian sparsity pattern for all the variables.
+
+\param rev_jac
+is the reverse Jacobian sparsity flag for each variable
+(it is not changed by this routine).
+
+\param num_threads
+is the maximum number of threads in the team.
+
+\param block
+is workspace that holds the sparsity patterns for each block.
+Its memory is reused by the next call that uses the same workspace.
+
+\param rev_jac_thread
+is workspace that holds the reverse Jacobian flags for each thread.
+Its memory is reused by the next call that uses the same workspace.
+
+\param rev_hes_sparse [in,out]
+On input, all its sets are empty.
+If the return value is true, on output the sets for the independent
+variables are the same as after the call
+\code
+	rev_hes<Addr>(play, n, numvar, for_jac_sparse, rev_jac, rev_hes_sparse)
+\endcode
+(the other sets are not specified).
+
+\return
+is false (and nothing is computed) if there is only one Pack value
+in each set or the team cannot be used for this operation sequence;
+see sparse_team_supported.
+*/
+template <class Addr, class Base>
+bool rev_hes_team(
+	const local::player<Base>*    play           ,
+	size_t                        n              ,
+	size_t                        numvar         ,
+	const CppAD::vector<size_t>&  ind_taddr      ,
+	const sparse_pack&            for_jac_sparse ,
+	const bool*                   rev_jac        ,
+	size_t                        num_threads    ,
+	CppAD::vector<sparse_pack>&   block          ,
+	pod_vector<bool>&             rev_jac_thread ,
+	sparse_pack&                  rev_hes_sparse )
+{	CPPAD_ASSERT_UNKNOWN( for_jac_sparse.n_set() == numvar );
+	CPPAD_ASSERT_UNKNOWN( rev_hes_sparse.n_set() == numvar );
+	CPPAD_ASSERT_UNKNOWN( for_jac_sparse.end() == rev_hes_sparse.end() );
+	if( ! sparse_team_supported(play) )
+		return false;
+	//
+	// split the Pack values into blocks
+	pod_vector<size_t> first;
+	size_t end     = rev_hes_sparse.end();
+	size_t n_block = sparse_team_split(end, num_threads, first);
+	if( n_block < 2 )
+		return false;
+	//
+	// private sparsity patterns for each block; i.e.,
+	// block[t] is the Hessian and block[n_block + t] is the Jacobian
+	if( block.size() < 2 * n_block )
+		block.resize(2 * n_block);
+	sparse_team_resize(numvar, end, first, block.data());
+	sparse_team_resize(numvar, end, first, block.data() + n_block);
+	//
+	// private reverse Jacobian flags for each thread
+	if( rev_jac_thread.size() < n_block * numvar )
+		rev_jac_thread.resize(n_block * numvar);
+	//
+	rev_hes_team_work<Addr, Base> work(
+		play,
+		n,
+		numvar,
+		ind_taddr.data(),
+		for_jac_sparse,
+		rev_jac,
+		first.data(),
+		block.data() + n_block,
+		rev_jac_thread.data(),
+		block.data(),
+		rev_hes_sparse
+	);
+	team_run(n_block, work);
+	return true;
+}
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
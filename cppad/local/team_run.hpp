@@ -0,0 +1,114 @@
+# ifndef CPPAD_LOCAL_TEAM_RUN_HPP
+# define CPPAD_LOCAL_TEAM_RUN_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/configure.hpp>
+# if CPPAD_USE_CPLUSPLUS_2011
+# include <atomic>
+# include <thread>
+# include <vector>
+# endif
+
+// BEGIN_CPPAD_LOCAL_NAMESPACE
+namespace CppAD { namespace local {
+
+/*!
+\file team_run.hpp
+A team of threads used by the parallel sweeps.
+
+The team threads are created and joined by team_run.
+They do not use thread_alloc, so they do not require
+thread_alloc::parallel_setup to be called.
+The work they do must not record AD operations, so ADFun::parallel_sweep
+does not allow a team when Base is an AD type.
+*/
+
+# if CPPAD_USE_CPLUSPLUS_2011
+/*!
+A barrier for the threads in a team.
+
+Each thread in the team calls wait and no thread returns from wait
+until all of the threads in the team have called it.
+The threads spin (and then yield) while waiting because the work between
+barriers is expected to be short.
+*/
+class team_barrier {
+private:
+	/// number of threads in the team
+	const size_t        num_threads_;
+	/// number of threads that have called wait for this generation
+	std::atomic<size_t> count_;
+	/// number of times all the threads have passed the barrier
+	std::atomic<size_t> generation_;
+public:
+	/// constructor
+	team_barrier(size_t num_threads)
+	: num_threads_(num_threads), count_(0), generation_(0)
+	{ }
+	/// wait for all the threads in the team to reach this point
+	void wait(void)
+	{	size_t generation = generation_.load();
+		if( count_.fetch_add(1) + 1 == num_threads_ )
+		{	count_.store(0);
+			generation_.fetch_add(1);
+			return;
+		}
+		size_t spin = 0;
+		while( generation_.load() == generation )
+		{	if( spin < 1000 )
+				++spin;
+			else
+				std::this_thread::yield();
+		}
+	}
+};
+
+/// function that runs the work for one of the threads in a team
+template <class Work>
+void team_run_one(Work* work, size_t thread)
+{	(*work)(thread); }
+# endif
+
+/*!
+Run work on a team of threads.
+
+\param num_threads
+is the number of threads in the team (must be greater than zero).
+If C++11 is not available, the team is run sequentially by the
+current thread and the work must not call team_barrier.
+
+\param work
+The call work(thread) is made once for each thread
+with thread = 0, ..., num_threads-1.
+The current thread is thread zero and this routine returns
+after all the calls to work have returned.
+*/
+template <class Work>
+void team_run(size_t num_threads, Work& work)
+{	CPPAD_ASSERT_UNKNOWN( num_threads > 0 );
+# if CPPAD_USE_CPLUSPLUS_2011
+	std::vector<std::thread> team;
+	for(size_t thread = 1; thread < num_threads; ++thread)
+		team.push_back( std::thread(team_run_one<Work>, &work, thread) );
+	work(0);
+	for(size_t i = 0; i < team.size(); ++i)
+		team[i].join();
+# else
+	for(size_t thread = 0; thread < num_threads; ++thread)
+		work(thread);
+# endif
+}
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+# endif
@@ -0,0 +1,86 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin forward_stream.cpp$$
+$spell
+	Cpp
+$$
+
+$section Pre-Decode Operators For Zero Order Forward: Example and Test$$
+
+$code
+$srcfile%example/general/forward_stream.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool forward_stream(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	double eps = 10. * std::numeric_limits<double>::epsilon();
+
+	// record a function with a comparison and a conditional expression
+	size_t n = 2, m = 2;
+	CPPAD_TESTVECTOR(AD<double>) ax(n), ay(m);
+	ax[0] = 0.5;
+	ax[1] = 1.5;
+	CppAD::Independent(ax);
+	AD<double> azero(0.0);
+	ay[0] = CppAD::CondExpLt(ax[0], ax[1], sin(ax[0]) * ax[1], azero);
+	if( ax[0] < ax[1] )
+		ay[1] = exp( ax[0] ) + ax[1];
+	else
+		ay[1] = exp( ax[1] ) + ax[0];
+	CppAD::ADFun<double> f(ax, ay);
+
+	// a copy of f that does not use pre-decoded operators
+	CppAD::ADFun<double> g;
+	g = f;
+
+	// use pre-decoded operators for zero order forward mode using f
+	ok &= f.forward_stream() == false;
+	f.forward_stream(true);
+	ok &= f.forward_stream() == true;
+
+	// the first call creates the list of pre-decoded operators
+	CPPAD_TESTVECTOR(double) x(n), y(m), check(m);
+	x[0] = 0.25;
+	x[1] = 0.75;
+	y     = f.Forward(0, x);
+	check = g.Forward(0, x);
+	for(size_t i = 0; i < m; i++)
+		ok &= NearEqual(y[i], check[i], eps, eps);
+	ok &= f.compare_change_number() == 0;
+
+	// the next call uses the list (at a point where the comparison changes)
+	x[0] = 0.75;
+	x[1] = 0.25;
+	y     = f.Forward(0, x);
+	check = g.Forward(0, x);
+	for(size_t i = 0; i < m; i++)
+		ok &= NearEqual(y[i], check[i], eps, eps);
+	ok &= f.compare_change_number() == 1;
+	ok &= g.compare_change_number() == 1;
+
+	// free the memory for the list
+	f.forward_stream(false);
+	y     = f.Forward(0, x);
+	for(size_t i = 0; i < m; i++)
+		ok &= NearEqual(y[i], check[i], eps, eps);
+
+	return ok;
+}
+// END C++
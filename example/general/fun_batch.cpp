@@ -0,0 +1,107 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin fun_batch.cpp$$
+$spell
+	Cpp
+$$
+
+$section Evaluating a Function at a Batch of Points: Example and Test$$
+
+$code
+$srcfile%example/general/fun_batch.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+	// record a function, optionally using a VecAD object
+	void record(CppAD::ADFun<double>& f, bool use_vecad)
+	{	using CppAD::AD;
+		size_t n = 2, m = 3;
+		CPPAD_TESTVECTOR(AD<double>) ax(n), ay(m);
+		ax[0] = 0.5;
+		ax[1] = 1.5;
+		CppAD::Independent(ax);
+		AD<double> azero(0.0);
+		ay[0] = exp( ax[0] ) * sin( ax[1] ) + pow(ax[0], 2.0);
+		ay[1] = CppAD::CondExpLt(ax[0], ax[1], ax[0] - ax[1], azero);
+		if( use_vecad )
+		{	CppAD::VecAD<double> av(1);
+			av[azero] = ax[0] + ax[1];
+			ay[2]     = av[azero];
+		}
+		else
+			ay[2] = ax[0] + ax[1];
+		f.Dependent(ax, ay);
+	}
+	// check forward_batch and reverse_batch against Forward and Reverse
+	bool check(bool use_vecad)
+	{	bool ok = true;
+		using CppAD::NearEqual;
+		double eps = 10. * std::numeric_limits<double>::epsilon();
+
+		CppAD::ADFun<double> f;
+		record(f, use_vecad);
+		size_t n = f.Domain();
+		size_t m = f.Range();
+
+		// a batch of K points
+		size_t K = 10;
+		CPPAD_TESTVECTOR(double) xb(K * n), yb(K * m);
+		for(size_t ell = 0; ell < K; ell++)
+		{	xb[ell * n + 0] = 0.1 * double(ell);
+			xb[ell * n + 1] = 0.5;
+		}
+
+		// evaluate all the points using one pass through the operations
+		CppAD::fun_work<double> work;
+		yb = f.forward_batch(K, xb, work);
+
+		// differentiate a different weighted sum at each point
+		CPPAD_TESTVECTOR(double) wb(K * m), dwb(K * n);
+		for(size_t ell = 0; ell < K; ell++)
+		{	for(size_t i = 0; i < m; i++)
+				wb[ell * m + i] = double(ell + i + 1);
+		}
+		dwb = f.reverse_batch(wb, work);
+
+		// evaluate one point at a time
+		CPPAD_TESTVECTOR(double) x(n), y(m), w(m), dw(n);
+		for(size_t ell = 0; ell < K; ell++)
+		{	for(size_t j = 0; j < n; j++)
+				x[j] = xb[ell * n + j];
+			y = f.Forward(0, x);
+			for(size_t i = 0; i < m; i++)
+				ok &= NearEqual(yb[ell * m + i], y[i], eps, eps);
+			for(size_t i = 0; i < m; i++)
+				w[i] = wb[ell * m + i];
+			dw = f.Reverse(1, w);
+			for(size_t j = 0; j < n; j++)
+				ok &= NearEqual(dwb[ell * n + j], dw[j], eps, eps);
+		}
+		return ok;
+	}
+}
+
+bool fun_batch(void)
+{	bool ok = true;
+	// all the operations are evaluated for all the points at once
+	ok &= check(false);
+	// VecAD operations cause the points to be evaluated one at a time
+	ok &= check(true);
+	return ok;
+}
+// END C++
@@ -0,0 +1,109 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin fun_file.cpp$$
+$spell
+	Cpp
+$$
+
+$section Save and Load an Operation Sequence: Example and Test$$
+
+$code
+$srcfile%example/general/fun_file.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cstdio>
+# include <cppad/cppad.hpp>
+
+bool fun_file(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	double eps = 10. * std::numeric_limits<double>::epsilon();
+
+	// independent dynamic parameter vector
+	size_t nd = 1;
+	CPPAD_TESTVECTOR(AD<double>) adynamic(nd);
+	adynamic[0] = 2.0;
+
+	// domain space vector
+	size_t nx = 2;
+	CPPAD_TESTVECTOR(AD<double>) ax(nx);
+	ax[0] = 0.5;
+	ax[1] = 1.5;
+
+	// declare independent variables, dynamic parammeters, starting recording
+	size_t abort_op_index = 0;
+	bool   record_compare = true;
+	CppAD::Independent(ax, abort_op_index, record_compare, adynamic);
+
+	// range space vector
+	size_t ny = 2;
+	CPPAD_TESTVECTOR(AD<double>) ay(ny);
+	ay[0] = adynamic[0] * ax[0] * ax[1];
+	ay[1] = exp( ax[0] ) + sin( ax[1] );
+
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(ax, ay);
+
+	// save the operation sequence in a file
+	std::string file_name = "fun_file.bin";
+	f.to_file(file_name);
+
+	// load the operation sequence into g
+	CppAD::ADFun<double> g;
+	g.from_file(file_name);
+	ok &= g.Domain()  == nx;
+	ok &= g.Range()   == ny;
+	ok &= g.size_var() == f.size_var();
+	ok &= g.size_op()  == f.size_op();
+	ok &= g.size_dyn_ind() == nd;
+	ok &= g.size_order() == 0;
+
+	// zero order forward mode using g
+	CPPAD_TESTVECTOR(double) x(nx), y(ny);
+	x[0] = 0.25;
+	x[1] = 0.75;
+	y    = g.Forward(0, x);
+	ok  &= NearEqual(y[0], 2.0 * x[0] * x[1], eps, eps);
+	ok  &= NearEqual(y[1], std::exp(x[0]) + std::sin(x[1]), eps, eps);
+
+	// first order reverse mode using g
+	CPPAD_TESTVECTOR(double) w(ny), dw(nx);
+	w[0] = 1.0;
+	w[1] = 0.0;
+	dw   = g.Reverse(1, w);
+	ok  &= NearEqual(dw[0], 2.0 * x[1], eps, eps);
+	ok  &= NearEqual(dw[1], 2.0 * x[0], eps, eps);
+
+	// change the dynamic parameter in g
+	CPPAD_TESTVECTOR(double) dynamic(nd);
+	dynamic[0] = 3.0;
+	g.new_dynamic(dynamic);
+	y    = g.Forward(0, x);
+	ok  &= NearEqual(y[0], 3.0 * x[0] * x[1], eps, eps);
+
+	// a copy of g does not depend on the file
+	CppAD::ADFun<double> h;
+	h = g;
+	g = f;
+	std::remove( file_name.c_str() );
+	y    = h.Forward(0, x);
+	ok  &= NearEqual(y[0], 3.0 * x[0] * x[1], eps, eps);
+	ok  &= NearEqual(y[1], std::exp(x[0]) + std::sin(x[1]), eps, eps);
+
+	return ok;
+}
+// END C++
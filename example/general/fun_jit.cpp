@@ -0,0 +1,126 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin fun_jit.cpp$$
+$spell
+	Cpp
+	jit
+$$
+
+$section Compiling a Function to Native Code: Example and Test$$
+
+$code
+$srcfile%example/general/fun_jit.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+// directory for the C source and shared object files (set by the build)
+# ifndef CPPAD_JIT_CACHE_DIR
+# define CPPAD_JIT_CACHE_DIR "."
+# endif
+
+bool fun_jit(void)
+{	bool ok = true;
+# if CPPAD_HAS_DLOPEN
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	double eps = 10. * std::numeric_limits<double>::epsilon();
+
+	// record a function with a dynamic parameter
+	size_t n = 2, m = 3;
+	CPPAD_TESTVECTOR(AD<double>) ax(n), ay(m), adynamic(1);
+	ax[0]       = 0.5;
+	ax[1]       = 1.5;
+	adynamic[0] = 2.0;
+	size_t abort_op_index = 0;
+	bool   record_compare = false;
+	CppAD::Independent(ax, abort_op_index, record_compare, adynamic);
+	AD<double> azero(0.0);
+	ay[0] = exp( ax[0] ) * sin( ax[1] ) / ax[1] + pow(ax[0], adynamic[0]);
+	ay[1] = CppAD::CondExpLt(ax[0], ax[1], ax[0] - ax[1], azero);
+	ay[2] = sqrt( ax[0] + ax[1] ) + erf( ax[0] ) + adynamic[0] * ax[1];
+	CppAD::ADFun<double> f(ax, ay);
+
+	// compile the function using the build directory for the cache
+	CppAD::fun_jit jit;
+	std::string msg = jit.compile(f, CPPAD_JIT_CACHE_DIR);
+	ok &= msg == "";
+	if( ! ok )
+		return ok;
+
+	// check the compiled function at a few points
+	CPPAD_TESTVECTOR(double) x(n), y(m), w(m), dw(n), check_y(m), check_dw(n);
+	w[0] = 1.0;
+	w[1] = 2.0;
+	w[2] = 3.0;
+	for(size_t k = 0; k < 4; k++)
+	{	// change the dynamic parameter; compile only updates parameters
+		CPPAD_TESTVECTOR(double) dynamic(1);
+		dynamic[0] = 2.0 + double(k);
+		f.new_dynamic(dynamic);
+		msg = jit.compile(f, CPPAD_JIT_CACHE_DIR);
+		ok &= msg == "";
+		//
+		x[0] = 0.25 * double(k + 1);
+		x[1] = 0.5;
+		y    = jit.forward(x);
+		dw   = jit.reverse(x, w);
+		//
+		check_y  = f.Forward(0, x);
+		for(size_t i = 0; i < m; i++)
+			ok &= NearEqual(y[i], check_y[i], eps, eps);
+		check_dw = f.Reverse(1, w);
+		for(size_t j = 0; j < n; j++)
+			ok &= NearEqual(dw[j], check_dw[j], eps, eps);
+	}
+	// free the shared object
+	jit.clear();
+
+	// function where a conditional expression does not use a result that
+	// is nan; e.g., sqrt(a) and log(a) when a is negative
+	CPPAD_TESTVECTOR(AD<double>) aa(n), az(m);
+	aa[0] = 0.5;
+	aa[1] = 1.0;
+	CppAD::Independent(aa);
+	az[0] = CppAD::CondExpLt(aa[0], aa[1], sqrt(aa[0]), aa[1]);
+	az[1] = CppAD::CondExpGt(aa[0], azero, log(aa[0]), aa[1]);
+	az[2] = pow(aa[0], 2.0) * aa[1];
+	CppAD::ADFun<double> g(aa, az);
+	msg = jit.compile(g, CPPAD_JIT_CACHE_DIR);
+	ok &= msg == "";
+	if( ! ok )
+		return ok;
+
+	// the derivatives are the same as for g.Reverse (not nan)
+	CPPAD_TESTVECTOR(double) a(n);
+	for(size_t k = 0; k < 3; k++)
+	{	a[0] = 0.5 * double(k) - 0.5; // -0.5, 0.0, 0.5
+		a[1] = -1.0;
+		y    = jit.forward(a);
+		dw   = jit.reverse(a, w);
+		//
+		check_y  = g.Forward(0, a);
+		for(size_t i = 0; i < m; i++)
+			ok &= NearEqual(y[i], check_y[i], eps, eps);
+		check_dw = g.Reverse(1, w);
+		for(size_t j = 0; j < n; j++)
+			ok &= NearEqual(dw[j], check_dw[j], eps, eps);
+	}
+	jit.clear();
+# endif
+	return ok;
+}
+// END C++
@@ -0,0 +1,112 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin fun_work.cpp$$
+$spell
+	Cpp
+$$
+
+$section Evaluating a Shared Function Using Work Spaces: Example and Test$$
+
+$code
+$srcfile%example/general/fun_work.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+	// evaluate the function and its derivative using a const function
+	bool check(
+		const CppAD::ADFun<double>& f    ,
+		CppAD::fun_work<double>&    work ,
+		double                      x0   ,
+		double                      x1   )
+	{	bool ok = true;
+		using CppAD::NearEqual;
+		double eps = 10. * std::numeric_limits<double>::epsilon();
+
+		// zero order forward
+		CPPAD_TESTVECTOR(double) x(2), y(1);
+		x[0] = x0;
+		x[1] = x1;
+		y    = f.Forward(0, x, work);
+		ok  &= NearEqual(y[0], x0 * x0 * x1, eps, eps);
+		ok  &= work.size_order() == 1;
+
+		// first order forward in the x[1] direction
+		CPPAD_TESTVECTOR(double) dx(2), dy(1);
+		dx[0] = 0.0;
+		dx[1] = 1.0;
+		dy    = f.Forward(1, dx, work);
+		ok  &= NearEqual(dy[0], x0 * x0, eps, eps);
+		ok  &= work.size_order() == 2;
+
+		// second order reverse
+		CPPAD_TESTVECTOR(double) w(1), dw(4);
+		w[0] = 1.0;
+		dw   = f.Reverse(2, w, work);
+		// derivative of y w.r.t. x
+		ok  &= NearEqual(dw[0 * 2 + 0], 2.0 * x0 * x1, eps, eps);
+		ok  &= NearEqual(dw[1 * 2 + 0], x0 * x0, eps, eps);
+		// derivative of dy w.r.t. x
+		ok  &= NearEqual(dw[0 * 2 + 1], 2.0 * x0, eps, eps);
+		ok  &= NearEqual(dw[1 * 2 + 1], 0.0, eps, eps);
+
+		return ok;
+	}
+}
+
+bool fun_work(void)
+{	bool ok = true;
+	using CppAD::AD;
+
+	// record the function f(x) = x[0] * x[0] * x[1]
+	CPPAD_TESTVECTOR(AD<double>) ax(2), ay(1);
+	ax[0] = 1.0;
+	ax[1] = 2.0;
+	CppAD::Independent(ax);
+	ay[0] = ax[0] * ax[0] * ax[1];
+	CppAD::ADFun<double> f(ax, ay);
+
+	// the zero order Taylor coefficients stored in f
+	ok &= f.size_order() == 1;
+
+	// two work spaces using the same function
+	// (each thread could use its own work space)
+	CppAD::fun_work<double> work_a, work_b;
+	ok &= check(f, work_a, 3.0, 4.0);
+	ok &= check(f, work_b, 5.0, 6.0);
+
+	// the Taylor coefficients in work_a were not changed by work_b
+	CPPAD_TESTVECTOR(double) w(1), dw(2);
+	w[0] = 1.0;
+	dw   = f.Reverse(1, w, work_a);
+	ok  &= dw[0] == 2.0 * 3.0 * 4.0;
+	ok  &= dw[1] == 3.0 * 3.0;
+
+	// the Taylor coefficients stored in f were not changed
+	ok &= f.size_order() == 1;
+	dw  = f.Reverse(1, w);
+	ok &= dw[0] == 2.0 * 1.0 * 2.0;
+	ok &= dw[1] == 1.0 * 1.0;
+
+	// free the memory in the work spaces
+	work_a.clear();
+	work_b.clear();
+	ok &= work_a.size_order() == 0;
+
+	return ok;
+}
+// END C++
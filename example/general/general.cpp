@@ -89,9 +89,14 @@ extern bool ForOne(void);
 extern bool ForTwo(void);
 extern bool forward_dir(void);
 extern bool forward_order(void);
+extern bool forward_stream(void);
 extern bool Forward(void);
 extern bool fun_assign(void);
+extern bool fun_batch(void);
 extern bool FunCheck(void);
+extern bool fun_file(void);
+extern bool fun_jit(void);
+extern bool fun_work(void);
 extern bool HesLagrangian(void);
 extern bool HesLuDet(void);
 extern bool HesMinorDet(void);
@@ -124,6 +129,7 @@ extern bool num_limits(void);
 extern bool OdeStiff(void);
 extern bool ode_taylor(void);
 extern bool opt_val_hes(void);
+extern bool parallel_sweep(void);
 extern bool con_dyn_var(void);
 extern bool Poly(void);
 extern bool pow_int(void);
@@ -203,8 +209,13 @@ int main(void)
 	Run( forward_dir,       "forward_dir"      );
 	Run( Forward,           "Forward"          );
 	Run( forward_order,     "forward_order"    );
+	Run( forward_stream,    "forward_stream"   );
 	Run( fun_assign,        "fun_assign"       );
+	Run( fun_batch,         "fun_batch"        );
 	Run( FunCheck,          "FunCheck"         );
+	Run( fun_file,          "fun_file"         );
+	Run( fun_jit,           "fun_jit"          );
+	Run( fun_work,          "fun_work"         );
 	Run( HesLagrangian,     "HesLagrangian"    );
 	Run( HesLuDet,          "HesLuDet"         );
 	Run( HesMinorDet,       "HesMinorDet"      );
@@ -235,6 +246,7 @@ int main(void)
 	Run( OdeStiff,          "OdeStiff"         );
 	Run( ode_taylor,        "ode_taylor"       );
 	Run( opt_val_hes,       "opt_val_hes"      );
+	Run( parallel_sweep,    "parallel_sweep"   );
 	Run( con_dyn_var,       "con_dyn_var"      );
 	Run( Poly,              "Poly"             );
 	Run( pow_int,           "pow_int"          );
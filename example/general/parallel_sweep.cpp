@@ -0,0 +1,93 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin parallel_sweep.cpp$$
+$spell
+	Cpp
+$$
+
+$section Using Multiple Threads During an ADFun Sweep: Example and Test$$
+
+$code
+$srcfile%example/general/parallel_sweep.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool parallel_sweep(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	double eps = 10. * std::numeric_limits<double>::epsilon();
+
+	// record a function with many operations that do not depend on each other
+	size_t n = 20000, m = n;
+	CPPAD_TESTVECTOR(AD<double>) ax(n), ay(m);
+	for(size_t j = 0; j < n; j++)
+		ax[j] = double(j + 1) / double(n);
+	CppAD::Independent(ax);
+	AD<double> azero(0.0);
+	for(size_t i = 0; i < m; i++)
+	{	size_t j = (i + 1) % n;
+		ay[i] = sin( ax[i] ) * exp( ax[j] ) + ax[i] * ax[j];
+		ay[i] = CppAD::CondExpLt(ax[i], ax[j], ay[i], azero);
+		if( ax[i] < 0.5 )
+			ay[i] += 1.0;
+	}
+	CppAD::ADFun<double> f(ax, ay);
+
+	// a copy of f that uses the usual sweeps
+	CppAD::ADFun<double> g;
+	g = f;
+
+	// use a team of four threads for the sweeps by f
+	ok &= f.parallel_sweep() == 1;
+	f.parallel_sweep(4);
+	ok &= f.parallel_sweep() == 4;
+
+	// zero order forward at a point where some comparisons change
+	CPPAD_TESTVECTOR(double) x(n), dx(n), y(m), check(m);
+	for(size_t j = 0; j < n; j++)
+	{	x[j]  = double(n - j) / double(n);
+		dx[j] = double(j % 3);
+	}
+	y     = f.Forward(0, x);
+	check = g.Forward(0, x);
+	for(size_t i = 0; i < m; i++)
+		ok &= NearEqual(y[i], check[i], eps, eps);
+	ok &= f.compare_change_number() == g.compare_change_number();
+	ok &= f.compare_change_number() > 0;
+
+	// first order forward
+	y     = f.Forward(1, dx);
+	check = g.Forward(1, dx);
+	for(size_t i = 0; i < m; i++)
+		ok &= NearEqual(y[i], check[i], eps, eps);
+
+	// first and second order reverse
+	CPPAD_TESTVECTOR(double) w(m);
+	for(size_t i = 0; i < m; i++)
+		w[i] = double(i % 5);
+	for(size_t q = 1; q <= 2; q++)
+	{	CPPAD_TESTVECTOR(double) dw(q * n), dw_check(q * n);
+		dw       = f.Reverse(q, w);
+		dw_check = g.Reverse(q, w);
+		for(size_t j = 0; j < q * n; j++)
+			ok &= NearEqual(dw[j], dw_check[j], eps, eps);
+	}
+
+	return ok;
+}
+// END C++
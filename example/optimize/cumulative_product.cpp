@@ -0,0 +1,125 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin optimize_cumulative_product.cpp$$
+
+$section Example Optimization and Cumulative Product Operations$$
+
+
+$code
+$srcfile%example/optimize/cumulative_product.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+	struct tape_size { size_t n_var; size_t n_op; };
+
+	template <class Vector> void fun(
+		const Vector& x, Vector& y, tape_size& before, tape_size& after
+	)
+	{	typedef typename Vector::value_type scalar;
+
+		// phantom variable with index 0 and independent variables
+		// begin operator, independent variable operators and end operator
+		before.n_var = 1 + x.size(); before.n_op  = 2 + x.size();
+		after.n_var  = 1 + x.size(); after.n_op   = 2 + x.size();
+
+		// operator that is used twice, so it is not removed as part of
+		// a cumulative product
+		scalar square = x[0] * x[0];
+		before.n_var += 1; before.n_op  += 1;
+		after.n_var  += 1; after.n_op   += 1;
+
+		// operator that is only used once, and that will be made part of
+		// the cumulative product
+		scalar first  = x[0] * x[1];
+		before.n_var += 1; before.n_op  += 1;
+		after.n_var  += 0; after.n_op   += 0;
+
+		// operator that is only used once, but is not part of the
+		// cumulative product because the multiplication that uses it
+		// already has first as an argument (this keeps the order of the
+		// multiplications unless the simplify option is used)
+		scalar second = 2.0 * x[2];
+		before.n_var += 1; before.n_op  += 1;
+		after.n_var  += 1; after.n_op   += 1;
+
+		// the final multiplication is converted to a cumulative product
+		// the other is removed.
+		scalar cprod = first * second * square;
+		before.n_var += 2; before.n_op  += 2;
+		after.n_var  += 1; after.n_op   += 1;
+
+		// results for this operation sequence
+		y[0] = cprod;
+		y[1] = square;
+		before.n_var += 0; before.n_op  += 0;
+		after.n_var  += 0; after.n_op   += 0;
+	}
+}
+bool cumulative_product(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	double eps10 = 10.0 * std::numeric_limits<double>::epsilon();
+
+	// domain space vector
+	size_t n  = 3;
+	CPPAD_TESTVECTOR(AD<double>) ax(n);
+	ax[0] = 0.5;
+	ax[1] = 1.5;
+	ax[2] = 2.5;
+
+	// declare independent variables and start tape recording
+	CppAD::Independent(ax);
+
+	// range space vector
+	size_t m = 2;
+	CPPAD_TESTVECTOR(AD<double>) ay(m);
+	tape_size before, after;
+	fun(ax, ay, before, after);
+
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(ax, ay);
+	ok &= f.size_var() == before.n_var;
+	ok &= f.size_op()  == before.n_op;
+
+	// Optimize the operation sequence
+	f.optimize();
+	ok &= f.size_var() == after.n_var;
+	ok &= f.size_op()  == after.n_op;
+
+	// Check result for a zero order calculation for a different x,
+	CPPAD_TESTVECTOR(double) x(n), y(m), check(m);
+	x[0] = 0.75;
+	x[1] = 2.25;
+	x[2] = 3.25;
+	y    = f.Forward(0, x);
+	fun(x, check, before, after);
+	for(size_t i = 0; i < m; i++)
+		ok  &= CppAD::NearEqual(y[i], check[i], eps10, eps10);
+
+	// Check the derivative of the cumulative product
+	CPPAD_TESTVECTOR(double) w(m), dw(n);
+	w[0] = 1.0;
+	w[1] = 0.0;
+	dw   = f.Reverse(1, w);
+	ok  &= NearEqual(dw[0], 6.0*x[0]*x[0]*x[1]*x[2], eps10, eps10);
+	ok  &= NearEqual(dw[1], 2.0*x[0]*x[0]*x[0]*x[2], eps10, eps10);
+	ok  &= NearEqual(dw[2], 2.0*x[0]*x[0]*x[0]*x[1], eps10, eps10);
+
+	return ok;
+}
+// END C++
@@ -23,6 +23,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 // external complied tests
 extern bool compare_op(void);
 extern bool conditional_skip(void);
+extern bool cumulative_product(void);
 extern bool cumulative_sum(void);
 extern bool forward_active(void);
 extern bool nest_conditional(void);
@@ -39,6 +40,7 @@ int main(void)
 
 	// external compiled tests
 	Run( cumulative_sum,      "compare_op"         );
+	Run( cumulative_product,  "cumulative_product" );
 	Run( cumulative_sum,      "cumulative_sum"     );
 	Run( conditional_skip,    "conditional_skip"   );
 	Run( forward_active,      "forward_active"     );
@@ -44,9 +44,12 @@ namespace {
 		for(size_t i = 2; i < size_t( x.size() ); i++)
 		{	if( i % 2 == 0 )
 			{	// prod_even will affect dependent variable
+				// (its multiplications become one cumulative product)
 				prod_even = prod_even * x[i];
 				before.n_var += 1; before.n_op += 1;
-				after.n_var  += 1; after.n_op  += 1;
+				if( i == 2 )
+				{	after.n_var  += 1; after.n_op  += 1;
+				}
 			}
 			else
 			{	// prod_odd will not affect dependent variable
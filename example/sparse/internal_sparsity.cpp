@@ -0,0 +1,239 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin internal_sparsity.cpp$$
+$spell
+	Cpp
+$$
+
+$section Hybrid and Automatic Internal Sparsity Patterns: Example and Test$$
+
+$code
+$srcfile%example/sparse/internal_sparsity.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+	typedef CPPAD_TESTVECTOR(size_t)     SizeVector;
+	typedef CppAD::sparse_rc<SizeVector> sparsity;
+
+	// check if two sparsity patterns are equal
+	bool equal(const sparsity& left, const sparsity& right)
+	{	bool ok = true;
+		ok &= left.nr()  == right.nr();
+		ok &= left.nc()  == right.nc();
+		ok &= left.nnz() == right.nnz();
+		if( ! ok )
+			return ok;
+		SizeVector left_major  = left.row_major();
+		SizeVector right_major = right.row_major();
+		for(size_t k = 0; k < left.nnz(); k++)
+		{	size_t ell = left_major[k];
+			size_t r   = right_major[k];
+			ok &= left.row()[ell] == right.row()[r];
+			ok &= left.col()[ell] == right.col()[r];
+		}
+		return ok;
+	}
+
+	// report function used for automatic internal sparsity choices
+	size_t      report_count_ = 0;
+	std::string report_routine_;
+	bool        report_bool_  = false;
+	double      report_fill_  = 0.0;
+	void report(const char* routine, bool internal_bool, double fill)
+	{	++report_count_;
+		report_routine_ = routine;
+		report_bool_    = internal_bool;
+		report_fill_    = fill;
+	}
+
+	// check automatic choice for a function with many independent variables
+	bool check_auto(bool dense)
+	{	bool ok = true;
+		using CppAD::AD;
+		//
+		size_t n = 1000;
+		CPPAD_TESTVECTOR(AD<double>) ax(n), ay(n);
+		for(size_t j = 0; j < n; j++)
+			ax[j] = double(j + 1);
+		CppAD::Independent(ax);
+		//
+		// if dense, y_i = x_0 + ... + x_i, otherwise y_i = x_i * x_i
+		for(size_t i = 0; i < n; i++)
+		{	if( dense )
+			{	ay[i] = ax[i];
+				if( i > 0 )
+					ay[i] += ay[i-1];
+			}
+			else
+				ay[i] = ax[i] * ax[i];
+		}
+		CppAD::ADFun<double> f(ax, ay);
+		f.internal_sparsity("auto", report);
+		ok &= f.internal_sparsity() == "auto";
+		//
+		sparsity pattern_in(n, n, n), pattern_out;
+		for(size_t k = 0; k < n; k++)
+			pattern_in.set(k, k, k);
+		bool transpose     = false;
+		bool dependency    = false;
+		bool internal_bool = false;
+		report_count_      = 0;
+		f.for_jac_sparsity(
+			pattern_in, transpose, dependency, internal_bool, pattern_out
+		);
+		ok &= report_count_ == 1;
+		ok &= report_routine_ == "for_jac_sparsity";
+		ok &= 0.0 < report_fill_ && report_fill_ <= 1.0;
+		//
+		// vector of boolean values for dense, sets of integers otherwise
+		ok &= report_bool_ == dense;
+		ok &= (f.size_forward_bool() > 0) == dense;
+		ok &= (f.size_forward_set() > 0) == ! dense;
+		if( dense )
+			ok &= pattern_out.nnz() == n * (n + 1) / 2;
+		else
+			ok &= pattern_out.nnz() == n;
+		//
+		// other sparsity calculations agree with using a vector of sets
+		CppAD::ADFun<double> g;
+		g = f;
+		g.internal_sparsity("");
+		sparsity check;
+		CPPAD_TESTVECTOR(bool) select(n);
+		for(size_t j = 0; j < n; j++)
+			select[j] = true;
+		//
+		g.for_jac_sparsity(
+			pattern_in, transpose, dependency, internal_bool, check
+		);
+		f.rev_hes_sparsity(select, transpose, internal_bool, pattern_out);
+		g.rev_hes_sparsity(select, transpose, internal_bool, check);
+		ok &= equal(pattern_out, check);
+		//
+		f.rev_jac_sparsity(
+			pattern_in, transpose, dependency, internal_bool, pattern_out
+		);
+		g.rev_jac_sparsity(
+			pattern_in, transpose, dependency, internal_bool, check
+		);
+		ok &= equal(pattern_out, check);
+		ok &= report_routine_ == "rev_jac_sparsity";
+		//
+		f.for_hes_sparsity(select, select, internal_bool, pattern_out);
+		g.for_hes_sparsity(select, select, internal_bool, check);
+		ok &= equal(pattern_out, check);
+		ok &= report_routine_ == "for_hes_sparsity";
+		ok &= report_count_ == 3;
+		//
+		return ok;
+	}
+}
+
+bool internal_sparsity(void)
+{	bool ok = true;
+	using CppAD::AD;
+	//
+	// domain space vector
+	size_t n = 6;
+	CPPAD_TESTVECTOR(AD<double>) ax(n);
+	for(size_t j = 0; j < n; j++)
+		ax[j] = double(j + 1);
+
+	// declare independent variables and start recording
+	CppAD::Independent(ax);
+
+	// range space vector
+	size_t m = 3;
+	CPPAD_TESTVECTOR(AD<double>) ay(m);
+	ay[0] = ax[0] * ax[1] + sin( ax[2] );
+	ay[1] = ax[3] / ax[4];
+	ay[2] = CppAD::CondExpLt(ax[0], ax[5], exp( ax[5] ), ax[1] * ax[5]);
+
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(ax, ay);
+
+	// the default is to use internal_bool
+	ok &= f.internal_sparsity() == "";
+
+	// a copy of f that uses hybrid internal sparsity patterns
+	CppAD::ADFun<double> g;
+	g = f;
+	g.internal_sparsity("hybrid");
+	ok &= g.internal_sparsity() == "hybrid";
+
+	// sparsity pattern for the identity matrix
+	sparsity pattern_in(n, n, n);
+	for(size_t k = 0; k < n; k++)
+		pattern_in.set(k, k, k);
+
+	// forward Jacobian sparsity
+	bool transpose       = false;
+	bool dependency      = false;
+	bool internal_bool   = true;
+	sparsity f_pattern, g_pattern;
+	f.for_jac_sparsity(
+		pattern_in, transpose, dependency, internal_bool, f_pattern
+	);
+	g.for_jac_sparsity(
+		pattern_in, transpose, dependency, internal_bool, g_pattern
+	);
+	ok &= equal(f_pattern, g_pattern);
+	ok &= f_pattern.nnz() == 7;
+
+	// g stores its forward Jacobian sparsity using the hybrid representation
+	ok &= g.size_forward_bool() == 0;
+	ok &= g.size_forward_set() > 0;
+
+	// reverse Hessian sparsity (uses results stored by for_jac_sparsity)
+	CPPAD_TESTVECTOR(bool) select_domain(n), select_range(m);
+	for(size_t j = 0; j < n; j++)
+		select_domain[j] = true;
+	for(size_t i = 0; i < m; i++)
+		select_range[i] = true;
+	f.rev_hes_sparsity(select_range, transpose, internal_bool, f_pattern);
+	g.rev_hes_sparsity(select_range, transpose, internal_bool, g_pattern);
+	ok &= equal(f_pattern, g_pattern);
+
+	// reverse Jacobian sparsity
+	sparsity range_in(m, m, m);
+	for(size_t k = 0; k < m; k++)
+		range_in.set(k, k, k);
+	f.rev_jac_sparsity(
+		range_in, transpose, dependency, internal_bool, f_pattern
+	);
+	g.rev_jac_sparsity(
+		range_in, transpose, dependency, internal_bool, g_pattern
+	);
+	ok &= equal(f_pattern, g_pattern);
+
+	// forward Hessian sparsity
+	f.for_hes_sparsity(
+		select_domain, select_range, internal_bool, f_pattern
+	);
+	g.for_hes_sparsity(
+		select_domain, select_range, internal_bool, g_pattern
+	);
+	ok &= equal(f_pattern, g_pattern);
+
+	// automatic choice of internal_bool
+	ok &= check_auto(true);
+	ok &= check_auto(false);
+
+	return ok;
+}
+// END C++
@@ -0,0 +1,188 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin sparse_cache.cpp$$
+$spell
+	Cpp
+$$
+
+$section Saving Sparsity Patterns and Coloring: Example and Test$$
+
+$code
+$srcfile%example/sparse/sparse_cache.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cstdio>
+# include <fstream>
+# include <sstream>
+# include <cppad/cppad.hpp>
+
+namespace {
+	typedef CPPAD_TESTVECTOR(CppAD::AD<double>) a_vector;
+	typedef CPPAD_TESTVECTOR(double)            d_vector;
+	typedef CPPAD_TESTVECTOR(size_t)            s_vector;
+	typedef CPPAD_TESTVECTOR(bool)              b_vector;
+	typedef CppAD::sparse_rc<s_vector>          sparsity;
+
+	// record y_i = x_i * x_{i+1} for i < n-1 and y_{n-1} = sum_j x_j^3
+	void record(size_t n, CppAD::ADFun<double>& f)
+	{	a_vector ax(n), ay(n);
+		for(size_t j = 0; j < n; j++)
+			ax[j] = 1.0;
+		CppAD::Independent(ax);
+		ay[n-1] = 0.0;
+		for(size_t i = 0; i < n - 1; i++)
+			ay[i] = ax[i] * ax[i+1];
+		for(size_t j = 0; j < n; j++)
+			ay[n-1] += ax[j] * ax[j] * ax[j];
+		f.Dependent(ax, ay);
+	}
+
+	// Jacobian and Hessian sparsity patterns and work structures
+	// (use the values saved in f when they are found)
+	void compute(
+		CppAD::ADFun<double>&   f           ,
+		size_t&                 n_found     ,
+		sparsity&               jac_pattern ,
+		CppAD::sparse_jac_work& jac_work    ,
+		sparsity&               hes_pattern ,
+		CppAD::sparse_hes_work& hes_work    )
+	{	size_t n = f.Domain();
+		size_t m = f.Range();
+		n_found  = 0;
+		d_vector x(n);
+		for(size_t j = 0; j < n; j++)
+			x[j] = double(j + 1);
+		//
+		// Jacobian
+		if( f.sparse_cache_find("jac_pattern", jac_pattern) )
+			++n_found;
+		else
+		{	sparsity identity(n, n, n);
+			for(size_t k = 0; k < n; k++)
+				identity.set(k, k, k);
+			bool transpose     = false;
+			bool dependency    = false;
+			bool internal_bool = false;
+			f.for_jac_sparsity(
+				identity, transpose, dependency, internal_bool, jac_pattern
+			);
+			f.sparse_cache_store("jac_pattern", jac_pattern);
+		}
+		CppAD::sparse_rcv<s_vector, d_vector> jac(jac_pattern);
+		if( f.sparse_cache_find("jac_work", jac_work) )
+			++n_found;
+		size_t group_max = 1;
+		f.sparse_jac_for(
+			group_max, x, jac, jac_pattern, "cppad", jac_work
+		);
+		f.sparse_cache_store("jac_work", jac_work);
+		//
+		// Hessian
+		if( f.sparse_cache_find("hes_pattern", hes_pattern) )
+			++n_found;
+		else
+		{	b_vector select_range(m);
+			for(size_t i = 0; i < m; i++)
+				select_range[i] = true;
+			bool transpose     = false;
+			bool internal_bool = false;
+			f.rev_hes_sparsity(
+				select_range, transpose, internal_bool, hes_pattern
+			);
+			f.sparse_cache_store("hes_pattern", hes_pattern);
+		}
+		CppAD::sparse_rcv<s_vector, d_vector> hes(hes_pattern);
+		if( f.sparse_cache_find("hes_work", hes_work) )
+			++n_found;
+		d_vector w(m);
+		for(size_t i = 0; i < m; i++)
+			w[i] = 1.0;
+		f.sparse_hes(x, w, hes, hes_pattern, "cppad.symmetric", hes_work);
+		f.sparse_cache_store("hes_work", hes_work);
+	}
+	bool equal(const sparsity& a, const sparsity& b)
+	{	bool ok = a.nr() == b.nr() && a.nc() == b.nc();
+		ok     &= a.nnz() == b.nnz();
+		for(size_t k = 0; ok && k < a.nnz(); k++)
+		{	ok &= a.row()[k] == b.row()[k];
+			ok &= a.col()[k] == b.col()[k];
+		}
+		return ok;
+	}
+}
+
+bool sparse_cache(void)
+{	bool ok = true;
+	std::string file_name = "sparse_cache.bin";
+	size_t n = 10;
+	//
+	// first run: compute the patterns and colorings and save them
+	CppAD::ADFun<double>   f;
+	size_t                 n_found;
+	sparsity               f_jac_pattern, f_hes_pattern;
+	CppAD::sparse_jac_work f_jac_work;
+	CppAD::sparse_hes_work f_hes_work;
+	record(n, f);
+	compute(f, n_found, f_jac_pattern, f_jac_work, f_hes_pattern, f_hes_work);
+	ok &= n_found == 0;
+	f.sparse_cache_to_file(file_name);
+	//
+	// second run: record the same function and load the saved values
+	CppAD::ADFun<double>   g;
+	sparsity               g_jac_pattern, g_hes_pattern;
+	CppAD::sparse_jac_work g_jac_work;
+	CppAD::sparse_hes_work g_hes_work;
+	record(n, g);
+	ok &= g.sparse_cache_from_file(file_name);
+	compute(g, n_found, g_jac_pattern, g_jac_work, g_hes_pattern, g_hes_work);
+	ok &= n_found == 4;
+	ok &= equal(f_jac_pattern, g_jac_pattern);
+	ok &= equal(f_hes_pattern, g_hes_pattern);
+	ok &= f_jac_work.color.size() == g_jac_work.color.size();
+	for(size_t j = 0; j < f_jac_work.color.size(); j++)
+		ok &= f_jac_work.color[j] == g_jac_work.color[j];
+	ok &= f_hes_work.color.size() == g_hes_work.color.size();
+	for(size_t j = 0; j < f_hes_work.color.size(); j++)
+		ok &= f_hes_work.color[j] == g_hes_work.color[j];
+	//
+	// a function with a different operation sequence does not use the file
+	CppAD::ADFun<double> h;
+	record(n + 1, h);
+	ok &= ! h.sparse_cache_from_file(file_name);
+	//
+	// recording a new operation sequence removes the saved values
+	record(n, g);
+	ok &= ! g.sparse_cache_find("jac_pattern", g_jac_pattern);
+	//
+	// a truncated file is not used
+	std::ostringstream contents;
+	std::ifstream in_file(file_name.c_str(), std::ios::binary);
+	contents << in_file.rdbuf();
+	in_file.close();
+	std::string truncated = contents.str();
+	truncated.resize( truncated.size() / 2 );
+	std::ofstream out_file(file_name.c_str(), std::ios::binary);
+	out_file << truncated;
+	out_file.close();
+	ok &= ! g.sparse_cache_from_file(file_name);
+	ok &= ! g.sparse_cache_find("jac_pattern", g_jac_pattern);
+	//
+	std::remove( file_name.c_str() );
+	ok &= ! g.sparse_cache_from_file(file_name);
+	//
+	return ok;
+}
+// END C++
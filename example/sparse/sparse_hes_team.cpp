@@ -0,0 +1,132 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin sparse_hes_team.cpp$$
+$spell
+	Cpp
+	Hessian
+$$
+
+$section Computing Sparse Hessian Using a Team of Threads: Example and Test$$
+
+$code
+$srcfile%example/sparse/sparse_hes_team.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+bool sparse_hes_team(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	//
+	typedef CPPAD_TESTVECTOR(AD<double>)               a_vector;
+	typedef CPPAD_TESTVECTOR(double)                   d_vector;
+	typedef CPPAD_TESTVECTOR(size_t)                   s_vector;
+	typedef CPPAD_TESTVECTOR(bool)                     b_vector;
+	double eps = 10. * std::numeric_limits<double>::epsilon();
+	//
+	// domain space vector
+	size_t n = 10;
+	a_vector a_x(n);
+	for(size_t j = 0; j < n; j++)
+		a_x[j] = AD<double> (0);
+	//
+	// declare independent variables and starting recording
+	CppAD::Independent(a_x);
+	//
+	// range space vector (Hessian of w^T * F is tri-diagonal)
+	size_t m = 2;
+	a_vector a_y(m);
+	a_y[0] = 0.0;
+	a_y[1] = 0.0;
+	for(size_t j = 0; j < n; j++)
+	{	if( j + 1 < n )
+			a_y[0] += sin( a_x[j] ) * a_x[j+1];
+		a_y[1] += a_x[j] * a_x[j] * a_x[j];
+	}
+	//
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(a_x, a_y);
+	//
+	// a copy of f that uses the current thread for all the sweeps
+	CppAD::ADFun<double> g;
+	g = f;
+	//
+	// use a team of three threads for the sweeps by f
+	f.parallel_sweep(3);
+	//
+	// new value for the independent variable vector, and weighting vector
+	d_vector w(m), x(n);
+	for(size_t j = 0; j < n; j++)
+		x[j] = double(j) / double(n);
+	w[0] = 2.0;
+	w[1] = 3.0;
+	//
+	// compute Hessian sparsity pattern
+	b_vector select_domain(n), select_range(m);
+	for(size_t j = 0; j < n; j++)
+		select_domain[j] = true;
+	for(size_t i = 0; i < m; i++)
+		select_range[i] = true;
+	//
+	CppAD::sparse_rc<s_vector> hes_pattern;
+	bool internal_bool = false;
+	f.for_hes_sparsity(
+		select_domain, select_range, internal_bool, hes_pattern
+	);
+	//
+	// compute entire sparse Hessian using two different colorings
+	for(size_t i_coloring = 0; i_coloring < 2; i_coloring++)
+	{	std::string coloring = "cppad.symmetric";
+		if( i_coloring == 1 )
+			coloring = "cppad.general";
+		CppAD::sparse_rcv<s_vector, d_vector> subset( hes_pattern );
+		CppAD::sparse_rcv<s_vector, d_vector> check( hes_pattern );
+		CppAD::sparse_hes_work work, check_work;
+		size_t n_sweep = f.sparse_hes(
+			x, w, subset, hes_pattern, coloring, work
+		);
+		size_t check_sweep = g.sparse_hes(
+			x, w, check, hes_pattern, coloring, check_work
+		);
+		ok &= n_sweep > 1;
+		ok &= n_sweep == check_sweep;
+		for(size_t k = 0; k < subset.nnz(); k++)
+			ok &= NearEqual(subset.val()[k], check.val()[k], eps, eps);
+	}
+	//
+	// compute entire sparse Hessian using the older interface
+	size_t K = hes_pattern.nnz();
+	b_vector p(n * n);
+	s_vector row(K), col(K);
+	for(size_t ij = 0; ij < n * n; ij++)
+		p[ij] = false;
+	for(size_t k = 0; k < K; k++)
+	{	row[k] = hes_pattern.row()[k];
+		col[k] = hes_pattern.col()[k];
+		p[ row[k] * n + col[k] ] = true;
+	}
+	d_vector hes(K), check(K);
+	CppAD::sparse_hessian_work work, check_work;
+	size_t n_sweep     = f.SparseHessian(x, w, p, row, col, hes, work);
+	size_t check_sweep = g.SparseHessian(x, w, p, row, col, check, check_work);
+	ok &= n_sweep > 1;
+	ok &= n_sweep == check_sweep;
+	for(size_t k = 0; k < K; k++)
+		ok &= NearEqual(hes[k], check[k], eps, eps);
+	//
+	return ok;
+}
+// END C++
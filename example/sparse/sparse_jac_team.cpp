@@ -0,0 +1,124 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin sparse_jac_team.cpp$$
+$spell
+	Cpp
+	Jacobian
+$$
+
+$section Computing Sparse Jacobian Using a Team of Threads: Example and Test$$
+
+$code
+$srcfile%example/sparse/sparse_jac_team.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+bool sparse_jac_team(void)
+{	bool ok = true;
+	//
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	using CppAD::sparse_rc;
+	using CppAD::sparse_rcv;
+	//
+	typedef CPPAD_TESTVECTOR(AD<double>) a_vector;
+	typedef CPPAD_TESTVECTOR(double)     d_vector;
+	typedef CPPAD_TESTVECTOR(size_t)     s_vector;
+	double eps = 10. * std::numeric_limits<double>::epsilon();
+	//
+	// domain space vector
+	size_t n = 10;
+	a_vector  a_x(n);
+	for(size_t j = 0; j < n; j++)
+		a_x[j] = AD<double> (j + 1);
+	//
+	// declare independent variables and starting recording
+	CppAD::Independent(a_x);
+	//
+	// Jacobian is tri-diagonal
+	size_t m = n;
+	a_vector  a_y(m);
+	for(size_t i = 0; i < m; i++)
+	{	a_y[i] = a_x[i] * a_x[i] + sin( a_x[i] );
+		if( i > 0 )
+			a_y[i] += a_x[i-1] * a_x[i];
+		if( i + 1 < n )
+			a_y[i] += CppAD::CondExpLt(a_x[i], a_x[i+1], a_x[i+1], a_x[i]);
+	}
+	//
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(a_x, a_y);
+	//
+	// a copy of f that uses the current thread for all the sweeps
+	CppAD::ADFun<double> g;
+	g = f;
+	//
+	// use a team of three threads for the sweeps by f
+	f.parallel_sweep(3);
+	//
+	// new value for the independent variable vector
+	d_vector x(n);
+	for(size_t j = 0; j < n; j++)
+		x[j] = double( (j * 7) % n );
+	//
+	// sparsity pattern for J(x)
+	sparse_rc<s_vector> pattern_in(n, n, n);
+	for(size_t k = 0; k < n; k++)
+		pattern_in.set(k, k, k);
+	bool transpose     = false;
+	bool dependency    = false;
+	bool internal_bool = true;
+	sparse_rc<s_vector> pattern_jac;
+	f.for_jac_sparsity(
+		pattern_in, transpose, dependency, internal_bool, pattern_jac
+	);
+	std::string coloring = "cppad";
+	//
+	// forward mode using one and two colors per sweep
+	for(size_t group_max = 1; group_max <= 2; group_max++)
+	{	sparse_rcv<s_vector, d_vector> subset( pattern_jac );
+		sparse_rcv<s_vector, d_vector> check( pattern_jac );
+		CppAD::sparse_jac_work work, check_work;
+		size_t n_sweep = f.sparse_jac_for(
+			group_max, x, subset, pattern_jac, coloring, work
+		);
+		size_t check_sweep = g.sparse_jac_for(
+			group_max, x, check, pattern_jac, coloring, check_work
+		);
+		ok &= n_sweep == 3;
+		ok &= n_sweep == check_sweep;
+		for(size_t k = 0; k < subset.nnz(); k++)
+			ok &= NearEqual(subset.val()[k], check.val()[k], eps, eps);
+	}
+	//
+	// reverse mode
+	sparse_rcv<s_vector, d_vector> subset( pattern_jac );
+	sparse_rcv<s_vector, d_vector> check( pattern_jac );
+	CppAD::sparse_jac_work work, check_work;
+	size_t n_sweep = f.sparse_jac_rev(
+		x, subset, pattern_jac, coloring, work
+	);
+	size_t check_sweep = g.sparse_jac_rev(
+		x, check, pattern_jac, coloring, check_work
+	);
+	ok &= n_sweep == 3;
+	ok &= n_sweep == check_sweep;
+	for(size_t k = 0; k < subset.nnz(); k++)
+		ok &= NearEqual(subset.val()[k], check.val()[k], eps, eps);
+	//
+	return ok;
+}
+// END C++
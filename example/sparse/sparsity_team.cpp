@@ -0,0 +1,165 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin sparsity_team.cpp$$
+$spell
+	Cpp
+$$
+
+$section Sparsity Patterns Using a Team of Threads: Example and Test$$
+
+$code
+$srcfile%example/sparse/sparsity_team.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+	typedef CPPAD_TESTVECTOR(size_t)     SizeVector;
+	typedef CppAD::sparse_rc<SizeVector> sparsity;
+
+	// check if two sparsity patterns are equal
+	bool equal(const sparsity& left, const sparsity& right)
+	{	bool ok = true;
+		ok &= left.nr()  == right.nr();
+		ok &= left.nc()  == right.nc();
+		ok &= left.nnz() == right.nnz();
+		if( ! ok )
+			return ok;
+		SizeVector left_major  = left.row_major();
+		SizeVector right_major = right.row_major();
+		for(size_t k = 0; k < left.nnz(); k++)
+		{	size_t ell = left_major[k];
+			size_t r   = right_major[k];
+			ok &= left.row()[ell] == right.row()[r];
+			ok &= left.col()[ell] == right.col()[r];
+		}
+		return ok;
+	}
+}
+
+bool sparsity_team(void)
+{	bool ok = true;
+	using CppAD::AD;
+	//
+	// domain space vector (more than one size_t worth of columns)
+	size_t n = 300;
+	CPPAD_TESTVECTOR(AD<double>) ax(n);
+	for(size_t j = 0; j < n; j++)
+		ax[j] = double(j + 1);
+	//
+	// declare independent variables and start recording
+	CppAD::Independent(ax);
+	//
+	// range space vector
+	size_t m = n / 2;
+	CPPAD_TESTVECTOR(AD<double>) ay(m);
+	AD<double> sum = 0.0;
+	for(size_t i = 0; i < m; i++)
+	{	sum   += ax[2 * i];
+		ay[i]  = sum * sin( ax[ (7 * i) % n ] );
+	}
+	//
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(ax, ay);
+	//
+	// a copy of f that uses the current thread for all the sweeps
+	CppAD::ADFun<double> g;
+	g = f;
+	//
+	// use a team of three threads for the sweeps by f
+	f.parallel_sweep(3);
+	//
+	// sparsity pattern for the identity matrix
+	sparsity pattern_in(n, n, n);
+	for(size_t k = 0; k < n; k++)
+		pattern_in.set(k, k, k);
+	//
+	// forward Jacobian sparsity
+	bool transpose       = false;
+	bool dependency      = false;
+	bool internal_bool   = true;
+	sparsity f_pattern, g_pattern;
+	f.for_jac_sparsity(
+		pattern_in, transpose, dependency, internal_bool, f_pattern
+	);
+	g.for_jac_sparsity(
+		pattern_in, transpose, dependency, internal_bool, g_pattern
+	);
+	ok &= equal(f_pattern, g_pattern);
+	ok &= f_pattern.nnz() > m * m / 4;
+	//
+	// forward Jacobian sparsity using the older interface
+	CppAD::vectorBool r(n * n), f_s(m * n), g_s(m * n);
+	for(size_t i = 0; i < n; i++)
+	{	for(size_t j = 0; j < n; j++)
+			r[i * n + j] = (i == j);
+	}
+	f_s = f.ForSparseJac(n, r);
+	g_s = g.ForSparseJac(n, r);
+	for(size_t k = 0; k < m * n; k++)
+		ok &= f_s[k] == g_s[k];
+	//
+	// reverse Hessian sparsity (uses results stored by ForSparseJac)
+	CppAD::vectorBool select_range(m), f_h(n * n), g_h(n * n);
+	for(size_t i = 0; i < m; i++)
+		select_range[i] = true;
+	f_h = f.RevSparseHes(n, select_range);
+	g_h = g.RevSparseHes(n, select_range);
+	for(size_t k = 0; k < n * n; k++)
+		ok &= f_h[k] == g_h[k];
+	//
+	// reverse Hessian sparsity (uses results stored by for_jac_sparsity)
+	f.for_jac_sparsity(
+		pattern_in, transpose, dependency, internal_bool, f_pattern
+	);
+	g.for_jac_sparsity(
+		pattern_in, transpose, dependency, internal_bool, g_pattern
+	);
+	CPPAD_TESTVECTOR(bool) select(m);
+	for(size_t i = 0; i < m; i++)
+		select[i] = true;
+	f.rev_hes_sparsity(select, transpose, internal_bool, f_pattern);
+	g.rev_hes_sparsity(select, transpose, internal_bool, g_pattern);
+	ok &= equal(f_pattern, g_pattern);
+	ok &= f_pattern.nnz() > 0;
+	//
+	// reverse Jacobian sparsity
+	sparsity range_in(m, m, m);
+	for(size_t k = 0; k < m; k++)
+		range_in.set(k, k, k);
+	f.rev_jac_sparsity(
+		range_in, transpose, dependency, internal_bool, f_pattern
+	);
+	g.rev_jac_sparsity(
+		range_in, transpose, dependency, internal_bool, g_pattern
+	);
+	ok &= equal(f_pattern, g_pattern);
+	ok &= f_pattern.nnz() > m * m / 4;
+	//
+	// reverse Jacobian sparsity using the older interface
+	CppAD::vectorBool s(m * m);
+	for(size_t i = 0; i < m; i++)
+	{	for(size_t j = 0; j < m; j++)
+			s[i * m + j] = (i == j);
+	}
+	f_s = f.RevSparseJac(m, s);
+	g_s = g.RevSparseJac(m, s);
+	for(size_t k = 0; k < m * n; k++)
+		ok &= f_s[k] == g_s[k];
+	//
+	return ok;
+}
+// END C++
@@ -0,0 +1,38 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/utility/vector.hpp>
+
+/*
+$begin adolc_optimize_tape.cpp$$
+$spell
+	Adolc
+	bool
+	CppAD
+	var
+$$
+
+$section Adolc Speed: Optimizing an Operation Sequence$$
+
+$srccode%cpp% */
+// A adolc version of this test is not available
+bool link_optimize_tape(
+	size_t                     size     ,
+	size_t                     repeat   ,
+	CppAD::vector<double>     &x        ,
+	CppAD::vector<double>     &y        ,
+	CppAD::vector<size_t>     &n_var    )
+{
+	return false;
+}
+/* %$$
+$end
+*/
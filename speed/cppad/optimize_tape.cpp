@@ -0,0 +1,138 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin cppad_optimize_tape.cpp$$
+$spell
+	onetape
+	ADScalar
+	typedef
+	cppad
+	CppAD
+	hpp
+	const
+	bool
+	var
+	std
+	sin
+	cos
+$$
+
+$section CppAD Speed: Optimizing an Operation Sequence$$
+$mindex link_optimize_tape speed$$
+
+
+$head Specifications$$
+See $cref link_optimize_tape$$.
+
+$head Implementation$$
+
+$srccode%cpp% */
+# include <cppad/cppad.hpp>
+# include <cppad/speed/uniform_01.hpp>
+
+// Note that CppAD uses global_option["memory"] at the main program level
+# include <map>
+extern std::map<std::string, bool> global_option;
+// see comments in main program for this external
+extern size_t global_cppad_thread_alloc_inuse;
+
+namespace {
+	typedef CppAD::AD<double>       ADScalar;
+	typedef CppAD::vector<ADScalar> ADVector;
+
+	// record the function f(x) in link_optimize_tape
+	void record(size_t size, const CppAD::vector<double>& x,
+		CppAD::ADFun<double>& f)
+	{	ADVector X(2), Y(1);
+		X[0] = x[0];
+		X[1] = x[1];
+
+		// do not even record comparison operators
+		size_t abort_op_index = 0;
+		bool record_compare   = false;
+		CppAD::Independent(X, abort_op_index, record_compare);
+
+		ADScalar Z = X[0];
+		for(size_t k = 0; k < size; k++)
+			Z = sin( Z * X[k % 2] ) + cos( X[k % 2] * Z );
+		Y[0] = Z;
+
+		f.Dependent(X, Y);
+	}
+}
+
+bool link_optimize_tape(
+	size_t                     size     ,
+	size_t                     repeat   ,
+	CppAD::vector<double>     &x        ,  // argument value
+	CppAD::vector<double>     &y        ,  // function value
+	CppAD::vector<size_t>     &n_var    )  // variables before and after
+{	global_cppad_thread_alloc_inuse = 0;
+
+	// --------------------------------------------------------------------
+	// check global options
+	const char* valid[] = { "memory", "onetape", "optimize"};
+	size_t n_valid = sizeof(valid) / sizeof(valid[0]);
+	typedef std::map<std::string, bool>::iterator iterator;
+	//
+	for(iterator itr=global_option.begin(); itr!=global_option.end(); ++itr)
+	{	if( itr->second )
+		{	bool ok = false;
+			for(size_t i = 0; i < n_valid; i++)
+				ok |= itr->first == valid[i];
+			if( ! ok )
+				return false;
+		}
+	}
+	// --------------------------------------------------------------------
+	// optimization options: no conditional skips or compare operators
+	std::string optimize_options =
+		"no_conditional_skip no_compare_op no_print_for_op";
+	// -----------------------------------------------------
+	// AD function objects (g is the optimized version of f)
+	CppAD::ADFun<double> f, g;
+
+	// --------------------------------------------------------------------
+	if( ! global_option["onetape"] ) while(repeat--)
+	{	// choose an argument value
+		CppAD::uniform_01(2, x);
+
+		// record the function and then optimize it
+		record(size, x, g);
+		n_var[0] = g.size_var();
+		g.optimize(optimize_options);
+	}
+	else
+	{	// choose an argument value
+		CppAD::uniform_01(2, x);
+
+		// record the function once
+		record(size, x, f);
+		n_var[0] = f.size_var();
+
+		while(repeat--)
+		{	// optimize a copy of the recording
+			g = f;
+			g.optimize(optimize_options);
+		}
+	}
+	n_var[1] = g.size_var();
+
+	// evaluate the function using the optimized operation sequence
+	y = g.Forward(0, x);
+
+	size_t thread                   = CppAD::thread_alloc::thread_num();
+	global_cppad_thread_alloc_inuse = CppAD::thread_alloc::inuse(thread);
+	return true;
+}
+/* %$$
+$end
+*/
@@ -66,6 +66,17 @@ namespace {
 	typedef CppAD::sparse_rc<s_vector>            sparsity_pattern;
 	typedef CppAD::sparse_rcv<s_vector, d_vector> sparse_matrix;
 	// ------------------------------------------------------------------------
+	// suffix that selects the order for the cppad coloring methods
+	std::string order_suffix(void)
+	{	if( global_option["smallest_last"] )
+			return ".smallest_last";
+		if( global_option["incidence_degree"] )
+			return ".incidence_degree";
+		if( global_option["saturation_degree"] )
+			return ".saturation_degree";
+		return "";
+	}
+	// ------------------------------------------------------------------------
 	void create_fun(
 		const d_vector&             x        ,
 		const s_vector&             row      ,
@@ -247,6 +258,8 @@ namespace {
 				coloring += ".symmetric";
 			else
 				coloring += ".general";
+			if( coloring == "cppad.general" )
+				coloring += order_suffix();
 			//
 			// only one function component
 			d_vector w(1);
@@ -273,6 +286,8 @@ namespace {
 				if( global_option["colpack"] )
 					coloring = "colpack";
 # endif
+				if( coloring == "cppad" )
+					coloring += order_suffix();
 				size_t group_max = 1;
 				n_sweep = fun.sparse_jac_for(
 					group_max, x, subset, sparsity, coloring, jac_work
@@ -303,7 +318,8 @@ bool link_sparse_hessian(
 	// check global options
 	const char* valid[] = {
 		"memory", "onetape", "optimize", "hes2jac", "subgraph",
-		"boolsparsity", "revsparsity", "symmetric"
+		"boolsparsity", "revsparsity", "symmetric",
+		"smallest_last", "incidence_degree", "saturation_degree"
 # if CPPAD_HAS_COLPACK
 		, "colpack"
 # else
@@ -336,6 +352,15 @@ bool link_sparse_hessian(
 	if( global_option["colpack"] )
 		return false;
 # endif
+	size_t n_order = size_t( global_option["smallest_last"] )
+		+ size_t( global_option["incidence_degree"] )
+		+ size_t( global_option["saturation_degree"] );
+	if( n_order > 1 )
+		return false;
+	if( n_order == 1 )
+	{	if( global_option["colpack"] || global_option["symmetric"] )
+			return false;
+	}
 	// -----------------------------------------------------------------------
 	// setup
 	size_t n = size;          // number of independent variables
@@ -119,7 +119,8 @@ bool link_sparse_jacobian(
 	// check global options
 	const char* valid[] = {
 		"memory", "onetape", "optimize", "subgraph",
-		"boolsparsity", "revsparsity", "subsparsity"
+		"boolsparsity", "revsparsity", "subsparsity",
+		"smallest_last", "incidence_degree", "saturation_degree"
 # if CPPAD_HAS_COLPACK
 		, "colpack"
 # endif
@@ -178,6 +179,20 @@ bool link_sparse_jacobian(
 	if( global_option["colpack"] )
 		coloring = "colpack";
 # endif
+	//
+	// order for cppad coloring method
+	const char* color_order[] = {
+		"smallest_last", "incidence_degree", "saturation_degree"
+	};
+	size_t n_order = sizeof(color_order) / sizeof(color_order[0]);
+	for(size_t i = 0; i < n_order; i++)
+	{	if( global_option[ color_order[i] ] )
+		{	// colpack or more than one order
+			if( coloring != "cppad" )
+				return false;
+			coloring += std::string(".") + color_order[i];
+		}
+	}
 	//
 	// maximum number of colors at once
 	//
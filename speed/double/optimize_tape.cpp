@@ -0,0 +1,70 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin double_optimize_tape.cpp$$
+$spell
+	onetape
+	bool
+	cppad
+	CppAD
+	hpp
+	var
+	std
+	sin
+	cos
+$$
+
+$section Double Speed: Evaluate Function Used by Optimization Test$$
+$mindex link_optimize_tape speed$$
+
+
+
+$head Specifications$$
+See $cref link_optimize_tape$$.
+
+$head Implementation$$
+
+$srccode%cpp% */
+# include <cmath>
+# include <cppad/utility/vector.hpp>
+# include <cppad/speed/uniform_01.hpp>
+
+// Note that CppAD uses global_option["memory"] at the main program level
+# include <map>
+extern std::map<std::string, bool> global_option;
+
+bool link_optimize_tape(
+	size_t                     size     ,
+	size_t                     repeat   ,
+	CppAD::vector<double>     &x        ,  // argument value
+	CppAD::vector<double>     &y        ,  // function value
+	CppAD::vector<size_t>     &n_var    )  // no operation sequence
+{
+	if(global_option["onetape"]||global_option["atomic"]||global_option["optimize"])
+		return false;
+	// ------------------------------------------------------
+	while(repeat--)
+	{	// get the next argument value
+		CppAD::uniform_01(2, x);
+
+		// evaluate the function
+		double z = x[0];
+		for(size_t k = 0; k < size; k++)
+			z = std::sin( z * x[k % 2] ) + std::cos( x[k % 2] * z );
+		y[0] = z;
+	}
+	n_var[0] = 0;
+	n_var[1] = 0;
+	return true;
+}
+/* %$$
+$end
+*/
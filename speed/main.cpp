@@ -48,11 +48,15 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 $begin speed_main$$
 $spell
 	jac
+	var
 	subgraph
 	Jacobians
 	hes
 	subgraphs
 	subsparsity
+	smallest_last
+	incidence_degree
+	saturation_degree
 	revsparsity
 	colpack
 	onetape
@@ -127,6 +131,7 @@ $cref/det_minor/link_det_minor/$$,
 $cref/det_lu/link_det_lu/$$,
 $cref/mat_mul/link_mat_mul/$$,
 $cref/ode/link_ode/$$,
+$cref/optimize_tape/link_optimize_tape/$$,
 $cref/poly/link_poly/$$,
 $cref/sparse_hessian/link_sparse_hessian/$$,
 $cref/sparse_jacobian/link_sparse_jacobian/$$.
@@ -274,6 +279,30 @@ The CppAD
 $cref/sparse_hessian/link_sparse_hessian/$$ test
 is implemented for this option.
 
+$subhead smallest_last$$
+If this option is present, CppAD will use the
+$cref/cppad.smallest_last/sparse_jac/coloring/cppad.smallest_last/$$
+order for its own coloring algorithm.
+This option cannot be combined with $code colpack$$ or $code symmetric$$.
+
+$subhead incidence_degree$$
+If this option is present, CppAD will use the
+$cref/cppad.incidence_degree/sparse_jac/coloring/cppad.incidence_degree/$$
+order for its own coloring algorithm.
+This option cannot be combined with $code colpack$$ or $code symmetric$$.
+
+$subhead saturation_degree$$
+If this option is present, CppAD will use the
+$cref/cppad.saturation_degree/sparse_jac/coloring/cppad.saturation_degree/$$
+order for its own coloring algorithm.
+This option cannot be combined with $code colpack$$ or $code symmetric$$.
+Comparing the
+$cref/n_sweep/speed_main/Speed Results/n_sweep/$$ and rate results
+for these options shows the effect of the coloring order; e.g.,
+$codei%
+	speed/cppad/speed_cppad sparse_jacobian 123 onetape smallest_last
+%$$
+
 $head Correctness Results$$
 One, but not both, of the following two output lines
 $codei%
@@ -316,12 +345,25 @@ $icode n_sweep$$ for
 $cref/sparse_jacobian/sparse_jacobian/n_sweep/$$ and
 $cref/sparse_hessian/sparse_hessian/n_sweep/$$.
 
+$subhead n_var$$
+The $cref/optimize_tape/link_optimize_tape/$$ test has an extra output
+line with the following form
+$codei%
+	%package%_optimize_tape_n_var = [ %before_1% -> %after_1%, %...% ]
+%$$
+The values $icode before_1$$, ... ($icode after_1$$, ...)
+are the number of variables in the operation sequence
+before (after) it was optimized for each size of the test.
+This relates the speed of the optimizer to the size of the
+operation sequence.
+
 
 $children%
 	speed/src/link_det_lu.cpp%
 	speed/src/link_det_minor.cpp%
 	speed/src/link_mat_mul.cpp%
 	speed/src/link_ode.cpp%
+	speed/src/link_optimize_tape.cpp%
 	speed/src/link_poly.cpp%
 	speed/src/link_sparse_hessian.cpp%
 	speed/src/link_sparse_jacobian.cpp%
@@ -337,6 +379,7 @@ $rref link_det_lu$$
 $rref link_det_minor$$
 $rref link_mat_mul$$
 $rref link_ode$$
+$rref link_optimize_tape$$
 $rref link_poly$$
 $rref link_sparse_hessian$$
 $rref link_sparse_jacobian$$
@@ -357,6 +400,7 @@ CPPAD_DECLARE_SPEED(det_lu);
 CPPAD_DECLARE_SPEED(det_minor);
 CPPAD_DECLARE_SPEED(mat_mul);
 CPPAD_DECLARE_SPEED(ode);
+CPPAD_DECLARE_SPEED(optimize_tape);
 CPPAD_DECLARE_SPEED(poly);
 CPPAD_DECLARE_SPEED(sparse_hessian);
 CPPAD_DECLARE_SPEED(sparse_jacobian);
@@ -364,6 +408,9 @@ CPPAD_DECLARE_SPEED(sparse_jacobian);
 // info is different for each test
 extern void info_sparse_jacobian(size_t size, size_t& n_sweep);
 extern void info_sparse_hessian(size_t size, size_t& n_sweep);
+extern void info_optimize_tape(
+	size_t size, size_t& n_var_before, size_t& n_var_after
+);
 
 // --------------------------------------------------------------------------
 std::map<std::string, bool> global_option;
@@ -389,7 +436,10 @@ namespace {
 		"revsparsity",
 		"subsparsity",
 		"colpack",
-		"symmetric"
+		"symmetric",
+		"smallest_last",
+		"incidence_degree",
+		"saturation_degree"
 	};
 	size_t num_option = sizeof(option_list) / sizeof( option_list[0] );
 	// ----------------------------------------------------------------
@@ -505,6 +555,7 @@ int main(int argc, char *argv[])
 		test_det_minor,
 		test_mat_mul,
 		test_ode,
+		test_optimize_tape,
 		test_poly,
 		test_sparse_hessian,
 		test_sparse_jacobian,
@@ -521,6 +572,7 @@ int main(int argc, char *argv[])
 		{ "det_minor",          test_det_minor       },
 		{ "mat_mul",            test_mat_mul         },
 		{ "ode",                test_ode             },
+		{ "optimize_tape",      test_optimize_tape   },
 		{ "poly",               test_poly            },
 		{ "sparse_hessian",     test_sparse_hessian  },
 		{ "sparse_jacobian",    test_sparse_jacobian }
@@ -589,6 +641,7 @@ int main(int argc, char *argv[])
 	CppAD::vector<size_t> size_det_minor(n_size);
 	CppAD::vector<size_t> size_mat_mul(n_size);
 	CppAD::vector<size_t> size_ode(n_size);
+	CppAD::vector<size_t> size_optimize_tape(n_size);
 	CppAD::vector<size_t> size_poly(n_size);
 	CppAD::vector<size_t> size_sparse_hessian(n_size);
 	CppAD::vector<size_t> size_sparse_jacobian(n_size);
@@ -597,6 +650,7 @@ int main(int argc, char *argv[])
 		size_det_lu[i]      = 10 * i + 1;
 		size_mat_mul[i]     = 10 * i + 1;
 		size_ode[i]         = 10 * i + 1;
+		size_optimize_tape[i] = 1000 * (i + 1) * (i + 1);
 		size_poly[i]        = 10 * i + 1;
 		size_sparse_hessian[i]  = 150 * (i + 1) * (i + 1);
 		size_sparse_jacobian[i] = 150 * (i + 1) * (i + 1);
@@ -617,6 +671,9 @@ int main(int argc, char *argv[])
 		ok &= run_correct(
 			available_ode, correct_ode, "ode"
 		);
+		ok &= run_correct(
+			available_optimize_tape, correct_optimize_tape, "optimize_tape"
+		);
 		ok &= run_correct( available_poly, correct_poly, "poly"
 		);
 		ok &= run_correct(
@@ -655,6 +712,9 @@ int main(int argc, char *argv[])
 		if( available_ode() ) run_speed(
 		speed_ode,             size_ode,             "ode"
 		);
+		if( available_optimize_tape() ) run_speed(
+		speed_optimize_tape,   size_optimize_tape,   "optimize_tape"
+		);
 		if( available_poly() ) run_speed(
 		speed_poly,            size_poly,            "poly"
 		);
@@ -716,6 +776,32 @@ int main(int argc, char *argv[])
 		break;
 		// ---------------------------------------------------------
 
+		case test_optimize_tape:
+		if( ! available_optimize_tape() )
+		{	not_available_message( argv[1] );
+			exit(1);
+		}
+		ok &= run_correct(
+			available_optimize_tape, correct_optimize_tape, "optimize_tape"
+		);
+		run_speed(
+			speed_optimize_tape, size_optimize_tape, "optimize_tape"
+		);
+		cout << AD_PACKAGE << "_optimize_tape_n_var = ";
+		for(size_t i = 0; i < size_optimize_tape.size(); i++)
+		{	if( i == 0 )
+				cout << "[ ";
+			else	cout << ", ";
+			size_t n_var_before, n_var_after;
+			info_optimize_tape(
+				size_optimize_tape[i], n_var_before, n_var_after
+			);
+			cout << n_var_before << " -> " << n_var_after;
+		}
+		cout << " ]" << endl;
+		break;
+		// ---------------------------------------------------------
+
 		case test_poly:
 		if( ! available_poly() )
 		{	not_available_message( argv[1] );
@@ -789,6 +875,7 @@ int main(int argc, char *argv[])
 	size_det_minor.clear();
 	size_mat_mul.clear();
 	size_ode.clear();
+	size_optimize_tape.clear();
 	size_poly.clear();
 	size_sparse_hessian.clear();
 	size_sparse_jacobian.clear();
@@ -0,0 +1,159 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin link_optimize_tape$$
+$spell
+	bool
+	CppAD
+	var
+$$
+
+
+$section Speed Testing Optimization of an Operation Sequence$$
+$mindex link_optimize_tape test$$
+
+$head Prototype$$
+$codei%extern bool link_optimize_tape(
+	size_t                 %size%    ,
+	size_t                 %repeat%  ,
+	CppAD::vector<double> &%x%       ,
+	CppAD::vector<double> &%y%       ,
+	CppAD::vector<size_t> &%n_var%
+);
+%$$
+
+$head Purpose$$
+Each $cref/package/speed_main/package/$$
+must define a version of this routine as specified below.
+This is used by the $cref speed_main$$ program
+to run the corresponding speed and correctness tests.
+It measures how the time to $cref optimize$$ an operation sequence
+scales with the size of the operation sequence.
+
+$head f$$
+The function $latex f : \B{R}^2 \rightarrow \B{R}$$ is defined by
+$latex f(x) = z_s$$ where $latex s$$ is $icode size$$,
+$latex z_0 = x_0$$, and for $latex k = 0 , \ldots , s-1$$,
+$latex \[
+	z_{k+1} = \sin( z_k x_j ) + \cos( x_j z_k )
+\] $$
+where $latex j$$ is zero (one) when $latex k$$ is even (odd).
+The product $latex x_j z_k$$ is recorded with its
+arguments in the opposite order from $latex z_k x_j$$.
+Hence each step of the recording contains a common subexpression
+that the optimizer should remove and
+the number of distinct operators it must keep track of
+grows with $icode size$$.
+
+$head Return Value$$
+If this speed test is not yet
+supported by a particular $icode package$$,
+the corresponding return value for $code link_optimize_tape$$
+should be $code false$$.
+
+$head size$$
+The argument $icode size$$ is the number of steps $latex s$$
+in the definition of $latex f$$
+(the size of the operation sequence is proportional to $icode size$$).
+
+$head repeat$$
+The argument $icode repeat$$ is the number of times the
+operation sequence is optimized.
+
+$head x$$
+The argument $icode x$$ is a vector with two elements.
+The input value of its elements does not matter.
+The output value of its elements is the argument value
+at which $latex f(x)$$ was last computed.
+
+$head y$$
+The argument $icode y$$ is a vector with one element.
+The input value of its element does not matter.
+The output value of its element is $latex f(x)$$ computed
+using the optimized operation sequence.
+
+$head n_var$$
+The argument $icode n_var$$ is a vector with two elements.
+The input value of its elements does not matter.
+The output value of $icode%n_var%[0]%$$
+($icode%n_var%[1]%$$)
+is the number of variables in the operation sequence before (after)
+the optimization.
+
+$subhead double$$
+In the case where $icode package$$ is $code double$$,
+the output value of $icode y$$ is computed using double precision
+(no operation sequence is recorded) and the elements of $icode n_var$$
+are zero.
+
+$end
+-----------------------------------------------------------------------------
+*/
+# include <cmath>
+# include <cppad/utility/vector.hpp>
+# include <cppad/utility/near_equal.hpp>
+
+extern bool link_optimize_tape(
+	size_t                     size     ,
+	size_t                     repeat   ,
+	CppAD::vector<double>      &x       ,
+	CppAD::vector<double>      &y       ,
+	CppAD::vector<size_t>      &n_var
+);
+bool available_optimize_tape(void)
+{	size_t size   = 10;
+	size_t repeat = 1;
+	CppAD::vector<double> x(2), y(1);
+	CppAD::vector<size_t> n_var(2);
+
+	return link_optimize_tape(size, repeat, x, y, n_var);
+}
+bool correct_optimize_tape(bool is_package_double)
+{	size_t size   = 10;
+	size_t repeat = 1;
+	CppAD::vector<double> x(2), y(1);
+	CppAD::vector<size_t> n_var(2);
+	double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+
+	link_optimize_tape(size, repeat, x, y, n_var);
+
+	double z = x[0];
+	for(size_t k = 0; k < size; k++)
+		z = std::sin( z * x[k % 2] ) + std::cos( x[k % 2] * z );
+
+	bool ok = CppAD::NearEqual(z, y[0], eps99, eps99);
+	if( ! is_package_double )
+		ok &= n_var[1] < n_var[0];
+	return ok;
+}
+void speed_optimize_tape(size_t size, size_t repeat)
+{	// free statically allocated memory
+	if( size == 0 && repeat == 0 )
+		return;
+	//
+	CppAD::vector<double> x(2), y(1);
+	CppAD::vector<size_t> n_var(2);
+
+	link_optimize_tape(size, repeat, x, y, n_var);
+	return;
+}
+void info_optimize_tape(
+	size_t size, size_t& n_var_before, size_t& n_var_after)
+{	size_t repeat = 1;
+	CppAD::vector<double> x(2), y(1);
+	CppAD::vector<size_t> n_var(2);
+
+	link_optimize_tape(size, repeat, x, y, n_var);
+	n_var_before = n_var[0];
+	n_var_after  = n_var[1];
+	return;
+}
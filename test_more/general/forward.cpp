@@ -1,5 +1,5 @@
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-17 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the
@@ -185,6 +185,63 @@ bool ForwardOlder(void)
 	return ok;
 }
 
+// zero order forward using the pre-decoded operators
+bool forward_stream_ops(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+
+	size_t n = 3, m = 12;
+	CPPAD_TESTVECTOR(AD<double>) ax(n), ay(m);
+	ax[0] = 0.25;
+	ax[1] = 0.50;
+	ax[2] = 0.75;
+	CppAD::Independent(ax);
+	AD<double> a0 = ax[0], a1 = ax[1], a2 = ax[2];
+	ay[0]  = abs(a0) + acos(a1) + asin(a2) + atan(a0) + cos(a1);
+	ay[1]  = cosh(a2) + exp(a0) + log(a1) + sign(a2) + sin(a0);
+	ay[2]  = sinh(a1) + sqrt(a2) + tan(a0) + tanh(a1) + erf(a2);
+	ay[3]  = acosh(1.0 + a0) + asinh(a1) + atanh(a2);
+	ay[4]  = (a0 + 2.0) * (3.0 - a1) * (a2 - 4.0) * (a0 - a1);
+	ay[5]  = (a0 / a1) + (2.0 / a2) + (a1 / 3.0) + a0 * a1 * a2 * 5.0;
+	ay[6]  = pow(a0, a1) + pow(2.0, a2) + pow(a1, 3.0);
+	ay[7]  = azmul(a0, a1) + azmul(2.0, a2) + azmul(a1, 3.0);
+	ay[8]  = CppAD::CondExpLt(a0, a1, sin(a2) * cos(a2), exp(a2) * a2);
+	ay[9]  = CppAD::CondExpGt(a2, a1, a0 + a1 + a2, a0 * a1 * a2);
+	ay[10] = a0 + 1.0;
+	ay[11] = a2;
+	if( a0 < a1 )
+		ay[10] += a1;
+	if( a0 == a2 )
+		ay[10] += a2;
+	if( a1 <= 0.5 )
+		ay[10] += a0;
+	if( a0 != a1 )
+		ay[11] += a0;
+	CppAD::ADFun<double> f(ax, ay);
+	//
+	// optimize to create cumulative sums, products, and conditional skips
+	f.optimize();
+	CppAD::ADFun<double> g;
+	g = f;
+	f.forward_stream(true);
+	//
+	CPPAD_TESTVECTOR(double) x(n), yf(m), yg(m);
+	for(size_t k = 0; k < 2; ++k)
+	{	x[0] = 0.25 + 0.5 * double(k);
+		x[1] = 0.50 - 0.25 * double(k);
+		x[2] = 0.75 - 0.5 * double(k);
+		yf   = f.Forward(0, x);
+		yg   = g.Forward(0, x);
+		for(size_t i = 0; i < m; ++i)
+			ok &= NearEqual(yf[i], yg[i], eps99, eps99);
+		ok &= f.compare_change_number() == g.compare_change_number();
+		ok &= f.compare_change_op_index() == g.compare_change_op_index();
+	}
+	return ok;
+}
+
 # ifndef NDEBUG
 # ifndef CPPAD_DEBUG_AND_RELEASE
 void my_error_handler(
@@ -244,6 +301,7 @@ bool Forward(void)
 	ok &= ForwardCases< std::vector    <double> >();
 	ok &= ForwardCases< std::valarray  <double> >();
 	ok &= ForwardOlder();
+	ok &= forward_stream_ops();
 # ifndef NDEBUG
 # ifndef CPPAD_DEBUG_AND_RELEASE
 	// CppAD does not check for nan when NDEBUG is defined
@@ -103,6 +103,7 @@ extern bool SimpleVector(void);
 extern bool SinCos(void);
 extern bool Sinh(void);
 extern bool Sin(void);
+extern bool sparse_coloring(void);
 extern bool sparse_hessian(void);
 extern bool sparse_jacobian(void);
 extern bool sparse_jac_work(void);
@@ -210,6 +211,7 @@ int main(void)
 	Run( SinCos,          "SinCos"         );
 	Run( Sinh,            "Sinh"           );
 	Run( Sin,             "Sin"            );
+	Run( sparse_coloring, "sparse_coloring");
 	Run( sparse_hessian,  "sparse_hessian" );
 	Run( sparse_jacobian, "sparse_jacobian");
 	Run( sparse_jac_work, "sparse_jac_work");
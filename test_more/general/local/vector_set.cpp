@@ -1,5 +1,5 @@
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-17 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the
@@ -233,6 +233,150 @@ bool test_post(void)
 	return ok;
 }
 
+// check that set i in vec_set is { e : e % mod_a == 0 and e % mod_b == 0 }
+template<class VectorSet>
+bool check_large(
+	const VectorSet& vec_set, size_t i, size_t mod_a, size_t mod_b)
+{	bool ok = true;
+	size_t end   = vec_set.end();
+	size_t count = 0;
+	typename VectorSet::const_iterator itr(vec_set, i);
+	for(size_t e = 0; e < end; ++e)
+	{	if( e % mod_a == 0 && e % mod_b == 0 )
+		{	ok &= *itr == e;
+			++itr;
+			++count;
+		}
+	}
+	ok &= *itr == end;
+	ok &= vec_set.number_elements(i) == count;
+	ok &= vec_set.is_element(i, 0);
+	ok &= ! vec_set.is_element(i, end - 1);
+	return ok;
+}
+
+template<class VectorSet>
+bool test_large(void)
+{	bool ok = true;
+	//
+	// end is large enough so that sets span more than one 2^16 block
+	VectorSet vec_set;
+	size_t n_set = 8;
+	size_t end   = 200003;
+	vec_set.resize(n_set, end);
+	//
+	// set[0] = multiples of 3, set[1] = multiples of 7,
+	// set[2] = multiples of 20, set[3] = multiples of 30
+	size_t mod[] = {3, 7, 20, 30};
+	for(size_t i = 0; i < 4; ++i)
+	{	for(size_t e = 0; e < end; e += mod[i])
+			vec_set.post_element(i, e);
+		vec_set.process_post(i);
+		ok &= check_large(vec_set, i, mod[i], 1);
+	}
+	//
+	// set[4] = set[0] union set[2]
+	vec_set.binary_union(4, 0, 2, vec_set);
+	typename VectorSet::const_iterator itr(vec_set, 4);
+	for(size_t e = 0; e < end; ++e)
+	{	if( e % 3 == 0 || e % 20 == 0 )
+		{	ok &= *itr == e;
+			++itr;
+		}
+	}
+	ok &= *itr == end;
+	//
+	// set[5] = set[2] union set[3]
+	vec_set.binary_union(5, 2, 3, vec_set);
+	ok &= vec_set.is_element(5, 60);
+	ok &= vec_set.is_element(5, 80);
+	ok &= vec_set.is_element(5, 90);
+	ok &= ! vec_set.is_element(5, 70);
+	//
+	// set[6] = set[0] intersection set[1]
+	vec_set.binary_intersection(6, 0, 1, vec_set);
+	ok &= check_large(vec_set, 6, 3, 7);
+	//
+	// set[7] = set[1] intersection set[2]
+	vec_set.binary_intersection(7, 1, 2, vec_set);
+	ok &= check_large(vec_set, 7, 7, 20);
+	//
+	// set[0] = set[6] in another vector of sets
+	VectorSet other;
+	other.resize(n_set, end);
+	other.assignment(0, 6, vec_set);
+	ok &= check_large(other, 0, 3, 7);
+	//
+	// set[6] = set[6] union {1}
+	vec_set.add_element(6, 1);
+	ok &= vec_set.is_element(6, 1);
+	ok &= vec_set.number_elements(6) == other.number_elements(0) + 1;
+	//
+	// clear and reuse set[0]
+	vec_set.clear(0);
+	ok &= vec_set.number_elements(0) == 0;
+	vec_set.assignment(0, 7, vec_set);
+	ok &= check_large(vec_set, 0, 7, 20);
+	//
+	return ok;
+}
+
+// sparse_list live and garbage counts and reuse of its chunks of memory
+bool test_list_arena(void)
+{	bool ok = true;
+	//
+	CppAD::local::sparse_list vec_set;
+	size_t n_set = 3;
+	size_t end   = 5000;
+	vec_set.resize(n_set, end);
+	ok &= vec_set.number_live() == 0;
+	ok &= vec_set.number_garbage() == 0;
+	//
+	// set[0] = {0, 2, 4, ... }, uses more than one chunk
+	for(size_t e = 0; e < end; e += 2)
+		vec_set.add_element(0, e);
+	size_t n_element = vec_set.number_elements(0);
+	ok &= n_element == end / 2;
+	//
+	// one entry for each element and one for the reference count
+	ok &= vec_set.number_live() == n_element + 1;
+	ok &= vec_set.number_garbage() == 0;
+	size_t memory = vec_set.memory();
+	//
+	// set[1] = set[0] shares the same list
+	vec_set.assignment(1, 0, vec_set);
+	ok &= vec_set.number_live() == n_element + 1;
+	//
+	// dropping both references to the list makes it garbage
+	vec_set.clear(0);
+	ok &= vec_set.number_live() == n_element + 1;
+	vec_set.clear(1);
+	ok &= vec_set.number_live() == 0;
+	ok &= vec_set.number_garbage() == n_element + 1;
+	//
+	// garbage is reused before more memory is allocated
+	for(size_t e = 1; e < end; e += 2)
+		vec_set.add_element(2, e);
+	ok &= vec_set.number_live() == n_element + 1;
+	ok &= vec_set.number_garbage() == 0;
+	ok &= vec_set.memory() == memory;
+	//
+	// resize keeps the memory and starts with no live or garbage entries
+	vec_set.resize(n_set, end);
+	ok &= vec_set.number_live() == 0;
+	ok &= vec_set.number_garbage() == 0;
+	ok &= vec_set.memory() == memory;
+	for(size_t e = 0; e < end; e += 2)
+		vec_set.add_element(0, e);
+	ok &= vec_set.memory() == memory;
+	//
+	// resize to zero frees the memory
+	vec_set.resize(0, 0);
+	ok &= vec_set.memory() == 0;
+	//
+	return ok;
+}
+
 } // END empty namespace
 
 bool vector_set(void)
@@ -241,18 +385,27 @@ bool vector_set(void)
 	ok     &= test_no_other<CppAD::local::sparse_pack>();
 	ok     &= test_no_other<CppAD::local::sparse_list>();
 	ok     &= test_no_other<CppAD::local::sparse_sizevec>();
+	ok     &= test_no_other<CppAD::local::sparse_hybrid>();
 	//
 	ok     &= test_yes_other<CppAD::local::sparse_pack>();
 	ok     &= test_yes_other<CppAD::local::sparse_list>();
 	ok     &= test_yes_other<CppAD::local::sparse_sizevec>();
+	ok     &= test_yes_other<CppAD::local::sparse_hybrid>();
 	//
 	ok     &= test_intersection<CppAD::local::sparse_pack>();
 	ok     &= test_intersection<CppAD::local::sparse_list>();
 	ok     &= test_intersection<CppAD::local::sparse_sizevec>();
+	ok     &= test_intersection<CppAD::local::sparse_hybrid>();
 	//
 	ok     &= test_post<CppAD::local::sparse_pack>();
 	ok     &= test_post<CppAD::local::sparse_list>();
 	ok     &= test_post<CppAD::local::sparse_sizevec>();
+	ok     &= test_post<CppAD::local::sparse_hybrid>();
+	//
+	ok     &= test_large<CppAD::local::sparse_pack>();
+	ok     &= test_large<CppAD::local::sparse_hybrid>();
+	//
+	ok     &= test_list_arena();
 	//
 	return ok;
 }
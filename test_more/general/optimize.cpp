@@ -10,6 +10,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 -------------------------------------------------------------------------- */
 // 2DO: Test that optimize.hpp use of base_atomic<Base>::rev_sparse_jac works.
 
+# include <cstdio>
 # include <limits>
 # include <cppad/cppad.hpp>
 
@@ -2020,6 +2021,432 @@ namespace {
 		//
 		return ok;
 	}
+	// -----------------------------------------------------------------------
+	// Check that a team of threads gives the same optimized recording
+	bool parallel_optimize(void)
+	{	bool ok = true;
+		using CppAD::AD;
+		using CppAD::vector;
+		//
+		double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+		//
+		// dynamic parameters p and independent variables x
+		size_t np = 3, nx = 2, nterm = 200;
+		vector< AD<double> > ap(np), ax(nx), ay(1);
+		for(size_t j = 0; j < np; ++j)
+			ap[j] = double(j + 1);
+		for(size_t j = 0; j < nx; ++j)
+			ax[j] = double(j + 1) / 10.0;
+		size_t abort_op_index = 0;
+		bool   record_compare = true;
+		CppAD::Independent(ax, abort_op_index, record_compare, ap);
+		//
+		// constant parameters, dynamic parameters, and terms
+		// where every other one is not used
+		AD<double> adyn = ap[0] * ap[1];
+		AD<double> asum = 0.0;
+		for(size_t k = 0; k < nterm; ++k)
+		{	AD<double> aterm = ax[k % nx] * double(k + 1) + adyn;
+			AD<double> aunused = aterm * ap[2] - double(2 * k + 1);
+			if( k % 2 == 0 )
+				asum += aterm;
+			else
+				asum += aterm * aunused;
+		}
+		ay[0] = asum;
+		CppAD::ADFun<double> f(ax, ay), g;
+		g = f;
+		//
+		// optimize f using one thread and g using a team of threads
+		f.optimize();
+		g.parallel_sweep(3);
+		g.optimize();
+		g.parallel_sweep(1);
+		//
+		ok &= f.size_var() == g.size_var();
+		ok &= f.size_op()  == g.size_op();
+		ok &= f.size_par() == g.size_par();
+		//
+		vector<double> p(np), x(nx), yf(1), yg(1);
+		for(size_t j = 0; j < np; ++j)
+			p[j] = double(j + 2);
+		for(size_t j = 0; j < nx; ++j)
+			x[j] = double(j + 3) / 10.0;
+		f.new_dynamic(p);
+		g.new_dynamic(p);
+		yf = f.Forward(0, x);
+		yg = g.Forward(0, x);
+		ok &= CppAD::NearEqual(yf[0], yg[0], eps99, eps99);
+		//
+		return ok;
+	}
+	// -----------------------------------------------------------------------
+	// Check folding and removal of duplicate dynamic parameters
+	bool dynamic_fold(void)
+	{	bool ok = true;
+		using CppAD::AD;
+		using CppAD::vector;
+		//
+		double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+		//
+		size_t np = 2, nx = 1, ny = 7;
+		vector< AD<double> > ap(np), ax(nx), ay(ny);
+		ap[0] = 0.5;
+		ap[1] = 1.5;
+		ax[0] = 2.0;
+		size_t abort_op_index = 0;
+		bool   record_compare = true;
+		CppAD::Independent(ax, abort_op_index, record_compare, ap);
+		//
+		// comments give the dynamic parameter after optimization
+		AD<double> a0  = ap[0] * 1.0;                          // p0
+		AD<double> a1  = 0.0 + ap[1];                          // p1
+		AD<double> a2  = sin( ap[0] );
+		AD<double> a3  = sin( ap[0] );                         // a2
+		AD<double> a4  = ap[0] * ap[1];
+		AD<double> a5  = a1 * a0;                              // a4
+		AD<double> a6  = CppAD::CondExpLt(ap[0], ap[1], a0, ap[0]); // p0
+		AD<double> a7  = CppAD::CondExpLt(a0, a1, a2, a3);     // a2
+		AD<double> a8  = exp( a6 + a0 );
+		ay[0] = ax[0] * a0;
+		ay[1] = ax[0] * a1;
+		ay[2] = ax[0] * a2 + ax[0] * a3;
+		ay[3] = ax[0] * a4 + ax[0] * a5;
+		ay[4] = ax[0] * a6;
+		ay[5] = ax[0] * a7;
+		ay[6] = ax[0] * a8;
+		CppAD::ADFun<double> f(ax, ay), g;
+		g = f;
+		//
+		// dynamic parameters are ind, ind, mul, add, sin, sin, mul, mul,
+		// cond_exp, cond_exp, add, exp
+		ok &= f.size_dyn_par() == 12;
+		f.optimize();
+		//
+		// dynamic parameters are ind, ind, sin, mul, add, exp
+		ok &= f.size_dyn_par() == 6;
+		//
+		vector<double> p(np), x(nx), yf(ny), yg(ny);
+		p[0] = 0.25;
+		p[1] = 2.0;
+		x[0] = 3.0;
+		f.new_dynamic(p);
+		g.new_dynamic(p);
+		yf = f.Forward(0, x);
+		yg = g.Forward(0, x);
+		for(size_t i = 0; i < ny; ++i)
+			ok &= CppAD::NearEqual(yf[i], yg[i], eps99, eps99);
+		//
+		return ok;
+	}
+	// -----------------------------------------------------------------------
+	// algebraic simplifications
+	bool simplify(void)
+	{	bool ok = true;
+		using CppAD::AD;
+		using CppAD::vector;
+		//
+		double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+		//
+		size_t nx = 2, ny = 4;
+		vector< AD<double> > ax(nx), ay(ny);
+		ax[0] = 0.5;
+		ax[1] = 1.5;
+		CppAD::Independent(ax);
+		//
+		ay[0] = exp( log( ax[0] ) );              // exp_log:   x0
+		ay[1] = pow( ax[0], 2.0 );                // pow_two:   x0 * x0
+		ay[2] = ax[1] / 4.0;                      // div_con:   0.25 * x1
+		ay[3] = 2.0 * ( 3.0 * ( 5.0 * ax[1] ) );  // mul_chain: 30 * x1
+		CppAD::ADFun<double> f(ax, ay), g, h;
+		g = f;
+		h = f;
+		ok &= f.simplify_count("pow_two") == 0;
+		//
+		// begin, x0, x1, log, exp, pow (3), div, mul (3)
+		ok &= f.size_var() == 12;
+		//
+		f.optimize("simplify");
+		g.optimize("no_simplify");
+		h.optimize();
+		//
+		// begin, x0, x1, mul, mul, mul
+		ok &= f.size_var() == 6;
+		// the multiplications by constants are not cumulative products in g
+		ok &= g.size_var() == 12;
+		// these simplifications change values so they are not the default
+		ok &= h.size_var() == 12;
+		ok &= h.simplify_count("exp_log")   == 0;
+		ok &= h.simplify_count("pow_two")   == 0;
+		ok &= h.simplify_count("div_con")   == 0;
+		ok &= h.simplify_count("mul_chain") == 0;
+		//
+		ok &= f.simplify_count("mul_one")   == 0;
+		ok &= f.simplify_count("add_zero")  == 0;
+		ok &= f.simplify_count("exp_log")   == 1;
+		ok &= f.simplify_count("pow_two")   == 1;
+		ok &= f.simplify_count("div_con")   == 1;
+		ok &= f.simplify_count("mul_chain") == 1;
+		ok &= g.simplify_count("exp_log")   == 0;
+		ok &= g.simplify_count("mul_chain") == 0;
+		//
+		// check values and derivatives
+		vector<double> x(nx), dx(nx), w(ny), yf, yg;
+		x[0] = 2.0;
+		x[1] = 3.0;
+		yf = f.Forward(0, x);
+		yg = g.Forward(0, x);
+		for(size_t i = 0; i < ny; ++i)
+			ok &= CppAD::NearEqual(yf[i], yg[i], eps99, eps99);
+		dx[0] = 1.0;
+		dx[1] = 2.0;
+		yf = f.Forward(1, dx);
+		yg = g.Forward(1, dx);
+		for(size_t i = 0; i < ny; ++i)
+			ok &= CppAD::NearEqual(yf[i], yg[i], eps99, eps99);
+		dx[0] = 0.0;
+		dx[1] = 0.0;
+		yf = f.Forward(2, dx);
+		yg = g.Forward(2, dx);
+		for(size_t i = 0; i < ny; ++i)
+			ok &= CppAD::NearEqual(yf[i], yg[i], eps99, eps99);
+		for(size_t i = 0; i < ny; ++i)
+			w[i] = double(i + 1);
+		vector<double> dwf = f.Reverse(1, w);
+		vector<double> dwg = g.Reverse(1, w);
+		for(size_t j = 0; j < nx; ++j)
+			ok &= CppAD::NearEqual(dwf[j], dwg[j], eps99, eps99);
+		//
+		// the counts do not carry over when loading a different tape
+		std::string file_name = "optimize_simplify.bin";
+		g.to_file(file_name);
+		f.from_file(file_name);
+		std::remove( file_name.c_str() );
+		ok &= f.simplify_count("exp_log")   == 0;
+		ok &= f.simplify_count("mul_chain") == 0;
+		//
+		return ok;
+	}
+	// -----------------------------------------------------------------------
+	// chains of multiplications converted to cumulative products
+	bool cumulative_product(void)
+	{	bool ok = true;
+		using CppAD::AD;
+		using CppAD::vector;
+		//
+		double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+		//
+		size_t nx = 4, ny = 3;
+		vector< AD<double> > ax(nx), ap(1), ay(ny);
+		for(size_t j = 0; j < nx; ++j)
+			ax[j] = 0.5 + double(j);
+		ap[0] = 3.0;
+		size_t abort_op_index = 0;
+		bool   record_compare = true;
+		CppAD::Independent(ax, abort_op_index, record_compare, ap);
+		//
+		// product with constant, dynamic parameter, and repeated variable
+		AD<double> aprod = 2.0 * ( ax[0] * ax[1] );
+		aprod            = ( aprod * ax[2] ) * ap[0];
+		ay[0]            = ( aprod * ax[0] ) * ax[3];
+		//
+		// product that is the argument to a unary function
+		ay[1] = sin( ax[1] * ax[2] * ax[3] );
+		//
+		// products that can be conditionally skipped
+		AD<double> if_true  = ax[0] * ax[1] * ax[2];
+		AD<double> if_false = ax[3] * ax[3] * ax[2];
+		ay[2] = CondExpLt(ax[0], ax[1], if_true, if_false);
+		//
+		CppAD::ADFun<double> f(ax, ay), g;
+		g = f;
+		//
+		// begin, x0, ..., x3, mul (6), mul (2), sin (2), mul (4), cexp
+		ok &= f.size_var() == 20;
+		f.optimize("simplify");
+		//
+		// begin, x0, ..., x3, cprod, cprod, sin (2), cprod (2), cexp
+		ok &= f.size_var() == 12;
+		//
+		// check values and derivatives for both branches of the conditional
+		vector<double> p(1), x(nx), dx(nx), ddx(nx), yf, yg;
+		p[0] = 1.5;
+		f.new_dynamic(p);
+		g.new_dynamic(p);
+		for(size_t k = 0; k < 2; ++k)
+		{	for(size_t j = 0; j < nx; ++j)
+			{	x[j]   = 0.3 + double(j);
+				dx[j]  = 1.0 + double(j);
+				ddx[j] = 0.5 - double(j);
+			}
+			if( k == 1 )
+				x[0] = 2.0;
+			yf = f.Forward(0, x);
+			yg = g.Forward(0, x);
+			for(size_t i = 0; i < ny; ++i)
+				ok &= CppAD::NearEqual(yf[i], yg[i], eps99, eps99);
+			yf = f.Forward(1, dx);
+			yg = g.Forward(1, dx);
+			for(size_t i = 0; i < ny; ++i)
+				ok &= CppAD::NearEqual(yf[i], yg[i], eps99, eps99);
+			yf = f.Forward(2, ddx);
+			yg = g.Forward(2, ddx);
+			for(size_t i = 0; i < ny; ++i)
+				ok &= CppAD::NearEqual(yf[i], yg[i], eps99, eps99);
+			vector<double> w(ny * 3);
+			for(size_t i = 0; i < ny * 3; ++i)
+				w[i] = double(i + 1);
+			vector<double> dwf = f.Reverse(3, w);
+			vector<double> dwg = g.Reverse(3, w);
+			for(size_t j = 0; j < nx * 3; ++j)
+				ok &= CppAD::NearEqual(dwf[j], dwg[j], eps99, eps99);
+			//
+			// multiple direction forward mode
+			size_t r = 2;
+			vector<double> xr(nx * r);
+			for(size_t j = 0; j < nx * r; ++j)
+				xr[j] = 1.0 + 0.1 * double(j);
+			f.Forward(0, x);
+			g.Forward(0, x);
+			vector<double> yrf = f.Forward(1, r, xr);
+			vector<double> yrg = g.Forward(1, r, xr);
+			for(size_t i = 0; i < ny * r; ++i)
+				ok &= CppAD::NearEqual(yrf[i], yrg[i], eps99, eps99);
+			yrf = f.Forward(2, r, xr);
+			yrg = g.Forward(2, r, xr);
+			for(size_t i = 0; i < ny * r; ++i)
+				ok &= CppAD::NearEqual(yrf[i], yrg[i], eps99, eps99);
+		}
+		//
+		// sparsity patterns
+		typedef vector< std::set<size_t> > set_vector;
+		set_vector r_set(nx), s_set(1), rj_set(ny);
+		for(size_t j = 0; j < nx; ++j)
+			r_set[j].insert(j);
+		for(size_t i = 0; i < ny; ++i)
+		{	s_set[0].insert(i);
+			rj_set[i].insert(i);
+		}
+		set_vector jac_f = f.ForSparseJac(nx, r_set);
+		set_vector jac_g = g.ForSparseJac(nx, r_set);
+		for(size_t i = 0; i < ny; ++i)
+			ok &= jac_f[i] == jac_g[i];
+		set_vector hes_f = f.RevSparseHes(nx, s_set);
+		set_vector hes_g = g.RevSparseHes(nx, s_set);
+		for(size_t j = 0; j < nx; ++j)
+			ok &= hes_f[j] == hes_g[j];
+		jac_f = f.RevSparseJac(ny, rj_set);
+		jac_g = g.RevSparseJac(ny, rj_set);
+		for(size_t i = 0; i < ny; ++i)
+			ok &= jac_f[i] == jac_g[i];
+		vector<bool> select_x(nx), select_y(ny);
+		for(size_t j = 0; j < nx; ++j)
+			select_x[j] = true;
+		for(size_t i = 0; i < ny; ++i)
+			select_y[i] = true;
+		CppAD::sparse_rc< vector<size_t> > pattern_f, pattern_g;
+		f.for_hes_sparsity(select_x, select_y, false, pattern_f);
+		g.for_hes_sparsity(select_x, select_y, false, pattern_g);
+		ok &= pattern_f.nnz() == pattern_g.nnz();
+		vector<size_t> order_f = pattern_f.row_major();
+		vector<size_t> order_g = pattern_g.row_major();
+		for(size_t k = 0; k < pattern_f.nnz() && ok; ++k)
+		{	size_t kf = order_f[k];
+			size_t kg = order_g[k];
+			ok &= pattern_f.row()[kf] == pattern_g.row()[kg];
+			ok &= pattern_f.col()[kf] == pattern_g.col()[kg];
+		}
+		//
+		// sparse Jacobian and Hessian with the colors split between a team
+		// (the reverse sweeps use a separate CProdOp work space for each
+		// thread)
+		CppAD::sparse_rc< vector<size_t> > jac_pattern(ny, nx, ny * nx);
+		for(size_t i = 0; i < ny; ++i)
+		{	for(size_t j = 0; j < nx; ++j)
+				jac_pattern.set(i * nx + j, i, j);
+		}
+		CppAD::sparse_rc< vector<size_t> > hes_pattern(nx, nx, nx * nx);
+		for(size_t i = 0; i < nx; ++i)
+		{	for(size_t j = 0; j < nx; ++j)
+				hes_pattern.set(i * nx + j, i, j);
+		}
+		CppAD::sparse_rcv< vector<size_t>, vector<double> >
+			jac_f_val(jac_pattern), jac_g_val(jac_pattern),
+			hes_f_val(hes_pattern), hes_g_val(hes_pattern);
+		CppAD::sparse_jac_work jac_f_work, jac_g_work;
+		CppAD::sparse_hes_work hes_f_work, hes_g_work;
+		vector<double> w(ny);
+		for(size_t i = 0; i < ny; ++i)
+			w[i] = double(i + 1);
+		f.parallel_sweep(3);
+		f.sparse_jac_rev(
+			x, jac_f_val, jac_pattern, "cppad", jac_f_work
+		);
+		g.sparse_jac_rev(
+			x, jac_g_val, jac_pattern, "cppad", jac_g_work
+		);
+		for(size_t k = 0; k < ny * nx; ++k)
+		{	ok &= CppAD::NearEqual(
+				jac_f_val.val()[k], jac_g_val.val()[k], eps99, eps99
+			);
+		}
+		f.sparse_hes(
+			x, w, hes_f_val, hes_pattern, "cppad.general", hes_f_work
+		);
+		g.sparse_hes(
+			x, w, hes_g_val, hes_pattern, "cppad.general", hes_g_work
+		);
+		for(size_t k = 0; k < nx * nx; ++k)
+		{	ok &= CppAD::NearEqual(
+				hes_f_val.val()[k], hes_g_val.val()[k], eps99, eps99
+			);
+		}
+		f.parallel_sweep(1);
+		//
+		return ok;
+	}
+	// -----------------------------------------------------------------------
+	// default cumulative products give the same values as the original
+	bool cumulative_product_exact(void)
+	{	bool ok = true;
+		using CppAD::AD;
+		using CppAD::vector;
+		//
+		size_t nx = 4, ny = 4;
+		vector< AD<double> > ax(nx), ay(ny);
+		for(size_t j = 0; j < nx; ++j)
+			ax[j] = 0.5 + double(j);
+		CppAD::Independent(ax);
+		//
+		// chain of constant factors
+		ay[0] = ( ax[0] * 0.1 ) * 3.0;
+		// chain with a constant factor in the middle
+		ay[1] = ( ( ax[0] * 0.1 ) * ax[1] ) * 3.0;
+		// chain with a multiplication of two products
+		ay[2] = ( ax[0] * ax[1] ) * ( ax[2] * ax[3] );
+		// chain where each multiplication has one product argument
+		ay[3] = ax[3] * ( ( ax[0] * ax[1] ) * ax[2] );
+		//
+		CppAD::ADFun<double> f(ax, ay), g;
+		g = f;
+		f.optimize();
+		//
+		// the last chain is a cumulative product
+		ok &= f.size_var() < g.size_var();
+		//
+		// values must be bitwise equal
+		vector<double> x(nx), yf, yg;
+		size_t n_point = 1000;
+		for(size_t k = 0; k < n_point; ++k)
+		{	for(size_t j = 0; j < nx; ++j)
+				x[j] = double(k + 1) / double(n_point) + 0.1 * double(j);
+			yf = f.Forward(0, x);
+			yg = g.Forward(0, x);
+			for(size_t i = 0; i < ny; ++i)
+				ok &= yf[i] == yg[i];
+		}
+		return ok;
+	}
 }
 
 bool optimize(void)
@@ -2103,6 +2530,19 @@ bool optimize(void)
 	// not using conditional_skip or atomic functions
 	ok &= only_check_variables_when_hash_codes_match();
 
+	// team of threads used by the optimizer
+	ok &= parallel_optimize();
+
+	// folding and removal of duplicate dynamic parameters
+	ok &= dynamic_fold();
+
+	// algebraic simplifications
+	ok &= simplify();
+
+	// cumulative products
+	ok &= cumulative_product();
+	ok &= cumulative_product_exact();
+
 	//
 	CppAD::user_atomic<double>::clear();
 	return ok;
@@ -0,0 +1,302 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+Check the coloring orderings for sparse_jac_for, sparse_jac_rev, and sparse_hes
+*/
+# include <cppad/cppad.hpp>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+
+typedef CPPAD_TESTVECTOR(size_t)                    s_vector;
+typedef CPPAD_TESTVECTOR(bool)                      b_vector;
+typedef CPPAD_TESTVECTOR(double)                    d_vector;
+typedef CPPAD_TESTVECTOR( CppAD::AD<double> )       a_vector;
+typedef CppAD::sparse_rc<s_vector>                  sparsity;
+typedef CppAD::sparse_rcv<s_vector, d_vector>       sparse_matrix;
+
+// simple linear congruential generator so the test is repeatable
+size_t next_random(size_t& seed)
+{	seed = (seed * 1103515245 + 12345) % 2147483648ul;
+	return seed / 65536;
+}
+
+// record a function with a pseudo random sparsity pattern
+void record(size_t m, size_t n, CppAD::ADFun<double>& f)
+{	a_vector ax(n), ay(m);
+	for(size_t j = 0; j < n; ++j)
+		ax[j] = double(j + 1) / double(n);
+	CppAD::Independent(ax);
+	size_t seed = 17;
+	for(size_t i = 0; i < m; ++i)
+	{	ay[i] = ax[i % n] * ax[i % n];
+		size_t n_term = 1 + next_random(seed) % 4;
+		for(size_t ell = 0; ell < n_term; ++ell)
+		{	size_t j1 = next_random(seed) % n;
+			size_t j2 = next_random(seed) % n;
+			ay[i] += ax[j1] * ax[j2];
+		}
+	}
+	f.Dependent(ax, ay);
+}
+
+// check the values in a subset against a dense matrix
+bool check(
+	const sparse_matrix& subset, const d_vector& dense, size_t nc )
+{	bool ok    = true;
+	double eps = 100. * std::numeric_limits<double>::epsilon();
+	for(size_t k = 0; k < subset.nnz(); ++k)
+	{	double check = dense[ subset.row()[k] * nc + subset.col()[k] ];
+		ok &= CppAD::NearEqual(subset.val()[k], check, eps, eps);
+	}
+	return ok;
+}
+
+// Hessian of a function with banded (band > 0) or arrow (band == 0) Hessian
+bool check_hessian(size_t n, size_t band)
+{	bool ok = true;
+	a_vector ax(n), ay(1);
+	for(size_t j = 0; j < n; ++j)
+		ax[j] = double(j + 1) / double(n);
+	CppAD::Independent(ax);
+	ay[0] = 0.0;
+	for(size_t j = 0; j < n; ++j)
+	{	if( band == 0 )
+			ay[0] += ax[0] * ax[j] * ax[j];
+		for(size_t k = 1; k <= band && j + k < n; ++k)
+			ay[0] += double(k) * ax[j] * ax[j] * ax[j + k];
+	}
+	CppAD::ADFun<double> f(ax, ay);
+	//
+	d_vector x(n), w(1);
+	for(size_t j = 0; j < n; ++j)
+		x[j] = double(j + 2) / double(n);
+	w[0] = 2.0;
+	d_vector hes = f.Hessian(x, w);
+	//
+	sparsity identity(n, n, n);
+	for(size_t k = 0; k < n; ++k)
+		identity.set(k, k, k);
+	b_vector select_range(1);
+	select_range[0]    = true;
+	bool transpose     = false;
+	bool dependency    = false;
+	bool internal_bool = false;
+	sparsity pattern;
+	f.for_jac_sparsity(identity, transpose, dependency, internal_bool, pattern);
+	f.rev_hes_sparsity(select_range, transpose, internal_bool, pattern);
+	//
+	// lower triangle of the pattern
+	size_t n_lower = 0;
+	for(size_t k = 0; k < pattern.nnz(); ++k)
+		if( pattern.col()[k] <= pattern.row()[k] )
+			++n_lower;
+	sparsity lower(n, n, n_lower);
+	n_lower = 0;
+	for(size_t k = 0; k < pattern.nnz(); ++k)
+		if( pattern.col()[k] <= pattern.row()[k] )
+			lower.set(n_lower++, pattern.row()[k], pattern.col()[k]);
+	//
+	// number of sweeps for each method
+	const char* coloring[] = {
+		"cppad.symmetric", "cppad.star", "cppad.acyclic"
+	};
+	size_t n_coloring = sizeof(coloring) / sizeof(coloring[0]);
+	size_t n_sweep[3];
+	for(size_t i_coloring = 0; i_coloring < n_coloring; ++i_coloring)
+	{	for(size_t i_subset = 0; i_subset < 2; ++i_subset)
+		{	sparse_matrix subset( pattern );
+			if( i_subset == 1 )
+				subset = sparse_matrix( lower );
+			CppAD::sparse_hes_work work;
+			n_sweep[i_coloring] = f.sparse_hes(
+				x, w, subset, pattern, coloring[i_coloring], work
+			);
+			ok &= check(subset, hes, n);
+			//
+			// use the work information a second time
+			for(size_t k = 0; k < subset.nnz(); ++k)
+				subset.set(k, 0.0);
+			f.sparse_hes(x, w, subset, pattern, coloring[i_coloring], work);
+			ok &= check(subset, hes, n);
+			//
+			// use a team of threads for the sweeps
+			f.parallel_sweep(2);
+			for(size_t k = 0; k < subset.nnz(); ++k)
+				subset.set(k, 0.0);
+			f.sparse_hes(x, w, subset, pattern, coloring[i_coloring], work);
+			ok &= check(subset, hes, n);
+			f.parallel_sweep(1);
+		}
+	}
+	if( band == 0 )
+	{	// arrow
+		ok &= n_sweep[1] == 2;
+		ok &= n_sweep[2] == 2;
+	}
+	else
+	{	ok &= n_sweep[2] <= n_sweep[1];
+		if( band == 1 )
+		{	ok &= n_sweep[1] == 3;
+			ok &= n_sweep[2] == 2;
+		}
+	}
+	return ok;
+}
+
+} // END_EMPTY_NAMESPACE
+
+bool sparse_coloring(void)
+{	bool ok = true;
+	size_t m = 40;
+	size_t n = 30;
+	CppAD::ADFun<double> f;
+	record(m, n, f);
+	//
+	d_vector x(n);
+	for(size_t j = 0; j < n; ++j)
+		x[j] = double(j + 2) / double(n);
+	d_vector jac = f.Jacobian(x);
+	d_vector w(m);
+	for(size_t i = 0; i < m; ++i)
+		w[i] = double(i + 1);
+	d_vector hes = f.Hessian(x, w);
+	//
+	// Jacobian sparsity pattern
+	sparsity identity(n, n, n);
+	for(size_t k = 0; k < n; ++k)
+		identity.set(k, k, k);
+	bool transpose     = false;
+	bool dependency    = false;
+	bool internal_bool = false;
+	sparsity jac_pattern;
+	f.for_jac_sparsity(
+		identity, transpose, dependency, internal_bool, jac_pattern
+	);
+	//
+	// Hessian sparsity pattern
+	b_vector select_range(m);
+	for(size_t i = 0; i < m; ++i)
+		select_range[i] = true;
+	sparsity hes_pattern;
+	f.rev_hes_sparsity(select_range, transpose, internal_bool, hes_pattern);
+	//
+	// subset that is every other element of the Jacobian pattern
+	size_t half = (jac_pattern.nnz() + 1) / 2;
+	sparsity jac_half(m, n, half);
+	for(size_t k = 0; k < half; ++k)
+		jac_half.set(k, jac_pattern.row()[2*k], jac_pattern.col()[2*k]);
+	//
+	const char* order[] = {
+		"", ".smallest_last", ".incidence_degree", ".saturation_degree",
+		".parallel"
+	};
+	size_t n_order = sizeof(order) / sizeof(order[0]);
+	for(size_t i_order = 0; i_order < n_order; ++i_order)
+	{	std::string coloring = std::string("cppad") + order[i_order];
+		size_t group_max = 3;
+		//
+		// full Jacobian, forward mode
+		sparse_matrix subset( jac_pattern );
+		CppAD::sparse_jac_work work;
+		size_t n_sweep = f.sparse_jac_for(
+			group_max, x, subset, jac_pattern, coloring, work
+		);
+		ok &= 0 < n_sweep && n_sweep <= n;
+		ok &= check(subset, jac, n);
+		//
+		// half of Jacobian, forward mode
+		sparse_matrix subset_half( jac_half );
+		work.clear();
+		n_sweep = f.sparse_jac_for(
+			group_max, x, subset_half, jac_pattern, coloring, work
+		);
+		ok &= 0 < n_sweep && n_sweep <= n;
+		ok &= check(subset_half, jac, n);
+		//
+		// full Jacobian, reverse mode
+		work.clear();
+		n_sweep = f.sparse_jac_rev(x, subset, jac_pattern, coloring, work);
+		ok &= 0 < n_sweep && n_sweep <= m;
+		ok &= check(subset, jac, n);
+		//
+		// half of Jacobian, reverse mode
+		work.clear();
+		n_sweep = f.sparse_jac_rev(
+			x, subset_half, jac_pattern, coloring, work
+		);
+		ok &= 0 < n_sweep && n_sweep <= m;
+		ok &= check(subset_half, jac, n);
+		//
+		// Hessian
+		coloring = std::string("cppad.general") + order[i_order];
+		sparse_matrix hes_subset( hes_pattern );
+		CppAD::sparse_hes_work hes_work;
+		n_sweep = f.sparse_hes(
+			x, w, hes_subset, hes_pattern, coloring, hes_work
+		);
+		ok &= 0 < n_sweep && n_sweep <= n;
+		ok &= check(hes_subset, hes, n);
+	}
+	// parallel coloring using a team of threads
+	f.parallel_sweep(3);
+	for(size_t i_repeat = 0; i_repeat < 2; ++i_repeat)
+	{	size_t group_max = 2;
+		sparse_matrix subset( jac_pattern );
+		CppAD::sparse_jac_work work[2];
+		for(size_t i = 0; i < 2; ++i)
+		{	size_t n_sweep = f.sparse_jac_for(
+				group_max, x, subset, jac_pattern, "cppad.parallel", work[i]
+			);
+			ok &= 0 < n_sweep && n_sweep <= n;
+			ok &= check(subset, jac, n);
+		}
+		// same coloring for the same number of threads
+		for(size_t j = 0; j < n; ++j)
+			ok &= work[0].color[j] == work[1].color[j];
+		//
+		sparse_matrix subset_half( jac_half );
+		CppAD::sparse_jac_work rev_work;
+		size_t n_sweep = f.sparse_jac_rev(
+			x, subset_half, jac_pattern, "cppad.parallel", rev_work
+		);
+		ok &= 0 < n_sweep && n_sweep <= m;
+		ok &= check(subset_half, jac, n);
+		//
+		sparse_matrix hes_subset( hes_pattern );
+		CppAD::sparse_hes_work hes_work;
+		n_sweep = f.sparse_hes(
+			x, w, hes_subset, hes_pattern, "cppad.general.parallel", hes_work
+		);
+		ok &= 0 < n_sweep && n_sweep <= n;
+		ok &= check(hes_subset, hes, n);
+		//
+		f.parallel_sweep(7);
+	}
+	f.parallel_sweep(1);
+	//
+	// symmetric methods that do not require colpack
+	const char* symmetric[] = { "cppad.star", "cppad.acyclic" };
+	for(size_t i_symmetric = 0; i_symmetric < 2; ++i_symmetric)
+	{	sparse_matrix hes_subset( hes_pattern );
+		CppAD::sparse_hes_work hes_work;
+		size_t n_sweep = f.sparse_hes(
+			x, w, hes_subset, hes_pattern, symmetric[i_symmetric], hes_work
+		);
+		ok &= 0 < n_sweep && n_sweep <= n;
+		ok &= check(hes_subset, hes, n);
+	}
+	// banded and arrow shaped Hessians
+	ok &= check_hessian(20, 1);
+	ok &= check_hessian(20, 2);
+	ok &= check_hessian(25, 4);
+	ok &= check_hessian(15, 0);
+	return ok;
+}